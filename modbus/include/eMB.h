@@ -27,19 +27,62 @@ extern "C" {
 #include "eMB_Func.h"
 #include "eMB_Port.h"
 #include "eMB_CRC.h"
+#include "eMB_Shadow.h"
 
-#ifdef eMB_MASTER_RTU_ENABLED
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_SLAVE_RTU_ENABLED)
 #include "eMB_RTU.h"
 #endif
 
+#ifdef eMB_RTU_BUS_ENABLED
+#include "eMB_Bus.h"
+#endif
+
+#ifdef eMB_MASTER_RTU_CAPTURE_ENABLED
+#include "eMB_Capture.h"
+#endif
+
 #ifdef eMB_MASTER_ASCII_ENABLED
 #include "eMB_ASCII.h"
 #endif
 
-#ifdef eMB_MASTER_TCP_ENABLED
+#if (defined eMB_MASTER_TCP_ENABLED) || (defined eMB_SLAVE_TCP_ENABLED)
 #include "eMB_TCP.h"
 #endif
 
+#ifdef eMB_GATEWAY_ENABLED
+#include "eMB_Gateway.h"
+#endif
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+#include "eMB_History.h"
+#endif
+
+#include "eMB_Rtt.h"
+
+#ifdef eMB_MASTER_HEALTH_ENABLED
+#include "eMB_Health.h"
+#endif
+
+#ifdef eMB_MASTER_RETRY_ENABLED
+#include "eMB_Retry.h"
+#endif
+
+#ifdef eMB_MASTER_STATS_ENABLED
+#include "eMB_Stats.h"
+#endif
+
+#ifdef eMB_MASTER_PHASE_ENABLED
+#include "eMB_Phase.h"
+#endif
+
+#ifdef eMB_MASTER_TRACE_ENABLED
+#include "eMB_Trace.h"
+#endif
+
+#ifdef eMB_MASTER_PROFILE_ENABLED
+#include "eMB_Profile.h"
+#endif
+
 
 
 /*===============================================================================================
@@ -94,14 +137,46 @@ typedef struct _eMB_ConfigStruct
   eMB_PortTimersInit          pPortTimersInit;
   eMB_PortTimersEnable        pPortTimersEnable;
   eMB_PortTimersDisable       pPortTimersDisable;
+  /* Port time function pointer (monotonic milliseconds, optional) */
+  eMB_PortTimeGet             pPortTimeGet;
+  /* Port time function pointer (monotonic microseconds, optional, also called from
+   * the serial and timer interrupts). Measures the round trip time of slaves. */
+  eMB_PortTimeGetUs           pPortTimeGetUs;
+  /* Own address (1 - 247) if role is eMB_ROLE_SLAVE */
+  uint8_t                     slaveAddr;
 } eMB_ConfigStruct;
 
 
 
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+/*! \brief Size in bytes of the coil and discrete input stores of the slave. One spare
+ * byte is kept because eMB_Util_GetBits() always accesses two bytes. */
+#define eMB_SLAVE_COIL_BYTES                      ( (eMB_SLAVE_COIL_NCOILS + 7) / 8 + 1 )
+#define eMB_SLAVE_DISCRETE_BYTES                  ( (eMB_SLAVE_DISCRETE_INPUT_NDISCRETES + 7) / 8 + 1 )
+#endif
+
+
+
 /*===============================================================================================
 *                                          VARIABLES
 ===============================================================================================*/
 
+/*! \brief Serial and timer interrupt callouts, set by eMB_Init() for the configured
+ * role and mode. The port calls them instead of the RTU/ASCII callbacks. */
+extern eMB_FrameByteReceivedCallout               eMB_FrameByteReceivedCalloutArr;
+extern eMB_FrameTransmitterEmptyCallout           eMB_FrameTransmitterEmptyCalloutArr;
+extern eMB_FrameTimerExpiredCallout               eMB_FrameTimerExpiredCalloutArr;
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+/*! \brief Register store of the slave. Replies are read directly from it, so the
+ * application must update values of more than one register from the task of
+ * eMB_MainFunction() or inside eMB_PortEnterCriticalSection(). */
+extern uint8_t                                    eMB_Slave_CoilBuf[eMB_SLAVE_COIL_BYTES];
+extern uint8_t                                    eMB_Slave_DiscreteBuf[eMB_SLAVE_DISCRETE_BYTES];
+extern uint16_t                                   eMB_Slave_RegInputBuf[eMB_SLAVE_REG_INPUT_NREGS];
+extern uint16_t                                   eMB_Slave_RegHoldingBuf[eMB_SLAVE_REG_HOLDING_NREGS];
+#endif
+
 
 
 
@@ -158,16 +233,45 @@ eMB_ErrorCodeType eMB_Disable(void);
  * function calls xMBMasterPortEventGet() and waits for an event from the receiver or
  * transmitter state machines.
  *
+ * In the slave role a received request is executed and answered within the
+ * same call.
+ *
  * \return If the protocol stack is not in the enabled state the function
  *   returns eMB_ErrorCodeType::MB_EILLSTATE. Otherwise it returns
  *   eMB_ErrorCodeType::MB_ENOERR.
  */
 void eMB_MainFunction(void);
 
+/*! \ingroup modbus
+ * \brief Register a handler for a Modbus function code.
+ *
+ * It replaces the handler of the stack, if any, and NULL removes the handler.
+ * In the slave role the handler gets a received request and builds the
+ * response in the same buffer, so custom and vendor specific function codes
+ * can be served. In the master role it gets the received response. The
+ * eMB_Master_Request* functions only send the standard function codes, a
+ * response with another code only arrives for a request forwarded by the
+ * gateway (eMB_GATEWAY_ENABLED). eMB_Init() restores the handlers of the
+ * stack, register handlers after it.
+ *
+ * \param funcCode function code (1 - 127)
+ * \param pFuncCbk handler or NULL
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if the function code is invalid or
+ *   eMB_EILLSTATE if eMB_Init() was not called.
+ */
+eMB_ErrorCodeType eMB_RegisterFunctionHandler(uint8_t funcCode, eMB_FuncCallback pFuncCbk);
+
 
 
 /*! \ingroup modbus
  *\brief These Modbus functions are called for user when Modbus run in Master Mode.
+ *
+ * They return eMB_EBUSY while another request is on the line. A read which is
+ * identical to the read on the line (same slave, function, address and
+ * number) returns eMB_ENOERR without sending: the one response updates the
+ * registers for all callers. With eMB_MASTER_HEALTH_ENABLED requests to an
+ * offline slave return eMB_EOFFLINE until its next probe is due.
  */
 #if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
 #ifdef eMB_FUNC_READ_COILS_ENABLED
@@ -177,14 +281,18 @@ eMB_ErrorCodeType eMB_Master_RequestReadCoils
   uint16_t coilAddr,
   uint16_t coilNum
 );
+#endif
 
+#ifdef eMB_FUNC_WRITE_COIL_ENABLED
 eMB_ErrorCodeType eMB_Master_RequestWriteSingleCoil
 (
   uint8_t  slaveAddr,
   uint16_t coilAddr,
   uint16_t coilData
 );
+#endif
 
+#ifdef eMB_FUNC_WRITE_MULTIPLE_COILS_ENABLED
 eMB_ErrorCodeType eMB_Master_RequestWriteMultipleCoils
 (
   uint8_t  slaveAddr,
@@ -214,7 +322,9 @@ eMB_ErrorCodeType eMB_Master_RequestWriteHoldingRegister
   uint16_t holdingAddr,
   uint16_t holdingData
 );
+#endif
 
+#ifdef eMB_FUNC_WRITE_MULTIPLE_HOLDING_ENABLED
 eMB_ErrorCodeType eMB_Master_RequestWriteMultipleHoldingRegister
 (
   uint8_t  slaveAddr,
@@ -222,14 +332,18 @@ eMB_ErrorCodeType eMB_Master_RequestWriteMultipleHoldingRegister
   uint16_t holdingNum,
   uint16_t *holdingData
 );
+#endif
 
+#ifdef eMB_FUNC_READ_HOLDING_ENABLED
 eMB_ErrorCodeType eMB_Master_RequestReadHoldingRegister
 (
   uint8_t  slaveAddr,
   uint16_t holdingAddr,
   uint16_t holdingNum
 );
+#endif
 
+#ifdef eMB_FUNC_READWRITE_HOLDING_ENABLED
 eMB_ErrorCodeType eMB_Master_RequestReadWriteMultipleHoldingRegister
 (
   uint8_t  slaveAddr,
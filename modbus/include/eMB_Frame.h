@@ -107,6 +107,11 @@ typedef uint16_t (*eMB_FrameGetSendPduLengthCallout)(void);
 
 typedef bool (*eMB_FrameIsBroadcastCallout)(void);
 
+/* Called by the port from the serial and timer interrupts */
+typedef bool (*eMB_FrameByteReceivedCallout)(void);
+typedef bool (*eMB_FrameTransmitterEmptyCallout)(void);
+typedef bool (*eMB_FrameTimerExpiredCallout)(void);
+
 
 
 #ifdef __cplusplus
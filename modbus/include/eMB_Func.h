@@ -48,6 +48,9 @@ extern "C" {
 #define eMB_FUNC_OTHER_REPORT_SLAVEID             ( 17 )
 #define eMB_FUNC_ERROR                            (128 )
 
+/* Highest valid function code, codes above are exception responses */
+#define eMB_FUNC_CODE_MAX                         (127 )
+
 
 
 /* Modbus function Handler when received PDU from other nodes */
@@ -0,0 +1,140 @@
+/*
+ * File:   eMB_Gateway.h
+ * Author: Long
+ *
+ * TCP to RTU gateway. Requests of network clients are queued per client and
+ * forwarded to the RTU line of the master one at a time. The next request is
+ * taken round robin from the clients with queued requests, so a client with
+ * many requests (or one which does not read its responses) can't starve the
+ * others. The response PDU of the slave (also an exception) is returned
+ * unchanged.
+ *
+ * The stack drives one RTU line, every unit id 1 - eMB_MASTER_TOTAL_SLAVE_NUM
+ * is routed to it. Other unit ids and requests which don't fit into the
+ * queues are answered with eMB_EX_GATEWAY_PATH_FAILED, requests without a
+ * valid response of the slave with eMB_EX_GATEWAY_TGT_FAILED. Broadcasts are
+ * not forwarded.
+ *
+ * Responses of reads (function code 1 - 4) are cached for a time to live
+ * (eMB_GATEWAY_CACHE_TTL_MS, per range with eMB_Gateway_SetCacheTtl()), an
+ * identical read within that time is answered from the cache. An identical
+ * read which arrives while one is waiting for the line joins it and gets the
+ * same response. Writes of clients and of the application drop the cached
+ * reads they overlap. The cache needs eMB_ConfigStruct::pPortTimeGet.
+ *
+ * All functions must be called from the task which runs eMB_MainFunction().
+ *
+ * Created on October 19, 2026, 06:00 PM
+ */
+
+#ifndef EMB_GATEWAY_H
+#define EMB_GATEWAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_GATEWAY_ENABLED
+/*! \brief Called once for every request passed to eMB_Gateway_Submit().
+ *
+ * \param ctx       ctx of eMB_Gateway_Submit()
+ * \param tag       tag of eMB_Gateway_Submit()
+ * \param pduBuf    response PDU, only valid during the call
+ * \param pduLength response PDU length
+ */
+typedef void (*eMB_GatewayRespondCallback)(void *ctx, uint32_t tag, const uint8_t *pduBuf, uint16_t pduLength);
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#ifdef eMB_GATEWAY_ENABLED
+/*! \ingroup modbus
+ * \brief Queue a request for the RTU line.
+ *
+ * The respond callback is called exactly once for the request, immediately if
+ * the request is not queued. Requests of a client are forwarded in order.
+ *
+ * \param clientId  client (connection) number, 0 - eMB_GATEWAY_CLIENT_MAX - 1
+ * \param ctx       passed to respond, e.g. the connection
+ * \param tag       passed to respond, e.g. the transaction id
+ * \param unitId    slave address
+ * \param pduBuf    request PDU, copied
+ * \param pduLength request PDU length
+ * \param respond   response callback
+ *
+ * \return eMB_ENOERR if the request was queued, eMB_ENORES if the queues are
+ *   full or eMB_EINVAL for an unknown unit id or client.
+ */
+eMB_ErrorCodeType eMB_Gateway_Submit(uint16_t clientId, void *ctx, uint32_t tag, uint8_t unitId,
+                                     const uint8_t *pduBuf, uint16_t pduLength, eMB_GatewayRespondCallback respond);
+
+/*! \ingroup modbus
+ * \brief Drop the queued requests of a client, e.g. when its connection is closed.
+ *
+ * The respond callback is not called for dropped requests. A request which is
+ * already on the line is completed without a callback.
+ */
+void eMB_Gateway_CancelClient(uint16_t clientId);
+
+/*! \ingroup modbus
+ * \brief Set the time to live of cached reads of a register range.
+ *
+ * A read which overlaps several ranges takes the shortest time, a read which
+ * overlaps none eMB_GATEWAY_CACHE_TTL_MS. 0 disables the cache for the range.
+ *
+ * \param regType   register type
+ * \param unitId    slave address
+ * \param regAddr   first register address
+ * \param regNum    number of registers
+ * \param ttlMs     time to live in milliseconds
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if an argument is invalid or
+ *   eMB_ENORES if eMB_GATEWAY_CACHE_RANGES_MAX ranges are set.
+ */
+eMB_ErrorCodeType eMB_Gateway_SetCacheTtl(eMB_RegType regType, uint8_t unitId, uint16_t regAddr, uint16_t regNum,
+                                          uint32_t ttlMs);
+
+/* Called by eMB_Init(). Free all requests and empty the cache, the ranges of
+ * eMB_Gateway_SetCacheTtl() are kept. */
+void eMB_Gateway_Init(void);
+
+/* Called by the master main function. Forward the next request if the line is free. */
+void eMB_Gateway_Dispatch(void);
+
+/* Called by the master main function when the response of the current request
+ * was received (pduBuf) or the request failed (pduBuf is NULL). */
+void eMB_Gateway_Complete(const uint8_t *pduBuf, uint16_t pduLength);
+
+/* Check if the request on the line was forwarded for a client. */
+bool eMB_Gateway_IsForwarding(void);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_GATEWAY_H */
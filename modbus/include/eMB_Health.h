@@ -0,0 +1,99 @@
+/*
+ * File:   eMB_Health.h
+ * Author: Long
+ *
+ * Health of the slaves of the master. A respond timeout makes an online slave
+ * suspect, eMB_MASTER_HEALTH_OFFLINE_TIMEOUTS timeouts in a row make it offline.
+ * Requests to an offline slave are refused with eMB_EOFFLINE, except one probe
+ * every probe interval. The interval starts at eMB_MASTER_HEALTH_PROBE_MS_MIN
+ * and doubles with every unanswered probe up to eMB_MASTER_HEALTH_PROBE_MS_MAX.
+ * Any response, also an exception, makes the slave online again.
+ *
+ * Created on October 19, 2026, 09:10 PM
+ */
+
+#ifndef EMB_HEALTH_H
+#define EMB_HEALTH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Health states of a slave.
+ */
+typedef enum _eMB_HealthStateType
+{
+  eMB_HEALTH_ONLINE,                              /*!< Slave answered the last request. */
+  eMB_HEALTH_SUSPECT,                             /*!< Slave missed requests, it is still polled. */
+  eMB_HEALTH_OFFLINE                              /*!< Slave is only probed. */
+} eMB_HealthStateType;
+
+/*! \ingroup modbus
+ * \brief Health of one slave.
+ */
+typedef struct _eMB_HealthStatsStruct
+{
+  eMB_HealthStateType         state;              /*!< Health state. */
+  uint16_t                    timeoutNum;         /*!< Respond timeouts in a row. */
+  uint32_t                    probeMs;            /*!< Probe interval if offline. */
+  uint32_t                    probeTime;          /*!< Time of the next probe if offline. */
+} eMB_HealthStatsStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Get the health of a slave.
+ *
+ * \param slaveAddr slave address
+ * \param stats     health
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if the slave address is invalid.
+ */
+eMB_ErrorCodeType eMB_Health_GetStats(uint8_t slaveAddr, eMB_HealthStatsStruct *stats);
+
+/*! \ingroup modbus
+ * \brief Make a slave online again, e.g. after it was replaced.
+ *
+ * \param slaveAddr slave address
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if the slave address is invalid.
+ */
+eMB_ErrorCodeType eMB_Health_Reset(uint8_t slaveAddr);
+
+/* Check if a request may be sent to a slave: it is not offline or its probe is due. */
+bool eMB_Health_IsAvailable(uint8_t slaveAddr);
+
+/* Called by the main function. The slave answered or did not answer in time. */
+void eMB_Health_Answer(uint8_t slaveAddr);
+void eMB_Health_Timeout(uint8_t slaveAddr);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_HEALTH_H */
@@ -0,0 +1,96 @@
+/* 
+ * File:   eMB_History.h
+ * Author: Long
+ *
+ * Sample history of selected input and holding registers. Every tracked
+ * register (point) owns a ring of fixed size blocks. A block stores the
+ * timestamps and the values in two separate bit columns:
+ *
+ *  - timestamps are delta-of-delta encoded,
+ *  - values are XOR encoded against the previous value.
+ *
+ * Samples are appended by the master when a read/write response updates
+ * the register. When the ring is full the oldest block is dropped.
+ * 
+ * Created on October 19, 2026, 09:12 AM
+ */
+
+#ifndef EMB_HISTORY_H
+#define EMB_HISTORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+/*! \ingroup modbus
+ * \brief Start recording the history of a register range.
+ *
+ * Every register of the range takes one point of eMB_MASTER_HISTORY_POINTS_MAX.
+ *
+ * \param regType   eMB_REG_INPUT or eMB_REG_HOLDING
+ * \param slaveAddr slave address
+ * \param regAddr   first register address
+ * \param regNum    number of registers
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if an argument is invalid or
+ *   eMB_ENORES if there are not enough free points or ranges.
+ */
+eMB_ErrorCodeType eMB_History_AddRange(eMB_RegType regType, uint8_t slaveAddr, uint16_t regAddr, uint16_t regNum);
+
+/*! \ingroup modbus
+ * \brief Decode the history of one register.
+ *
+ * The samples are returned oldest first. If more samples are stored than
+ * sampleMax, only the most recent sampleMax samples are returned. This function
+ * must be called from the context of eMB_MainFunction().
+ *
+ * \param regType   eMB_REG_INPUT or eMB_REG_HOLDING
+ * \param slaveAddr slave address
+ * \param regAddr   register address
+ * \param timeBuf   buffer for the timestamps (milliseconds of eMB_ConfigStruct::pPortTimeGet)
+ * \param valueBuf  buffer for the values
+ * \param sampleMax size of timeBuf and valueBuf
+ *
+ * \return number of samples written to the buffers.
+ */
+uint16_t eMB_History_Read(eMB_RegType regType, uint8_t slaveAddr, uint16_t regAddr,
+                          uint32_t *timeBuf, uint16_t *valueBuf, uint16_t sampleMax);
+
+/* Append samples of registers regAddr..regAddr+regNum-1. Called by the register callbacks. */
+void eMB_History_Append(eMB_RegType regType, uint8_t slaveAddr, uint16_t regAddr, uint16_t regNum,
+                        const uint16_t *regBuf);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_HISTORY_H */
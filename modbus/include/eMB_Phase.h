@@ -0,0 +1,114 @@
+/*
+ * File:   eMB_Phase.h
+ * Author: Long
+ *
+ * Phases of the transactions of the master. Every transaction gets a record
+ * with the time of its lifecycle points, taken with eMB_ConfigStruct::pPortTimeGetUs
+ * (or the millisecond clock without it):
+ *
+ *   TAKE     the request took the line (queueing ends)
+ *   SENT     eMB_MainFunction() started to send it
+ *   TX_DONE  the last byte of the request was sent
+ *   RX_FIRST the first byte of the response was received (slave turnaround ends)
+ *   RX_END   the response was complete (T3.5 expired)
+ *   DONE     the handlers completed or the transaction failed
+ *
+ * A point which was not reached has no bit in eMB_PhaseRecordStruct::pointMask.
+ * Completed records are passed to the callback of eMB_Phase_SetCallback() and
+ * kept in a ring of eMB_MASTER_PHASE_RECORD_NUM records for eMB_Phase_Read().
+ *
+ * Created on October 19, 2026, 10:45 PM
+ */
+
+#ifndef EMB_PHASE_H
+#define EMB_PHASE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Lifecycle points of a transaction.
+ */
+typedef enum _eMB_PhasePointType
+{
+  eMB_PHASE_TAKE,                                 /*!< Line taken. */
+  eMB_PHASE_SENT,                                 /*!< Sending started. */
+  eMB_PHASE_TX_DONE,                              /*!< Last request byte sent. */
+  eMB_PHASE_RX_FIRST,                             /*!< First response byte received. */
+  eMB_PHASE_RX_END,                               /*!< Response complete. */
+  eMB_PHASE_DONE,                                 /*!< Transaction completed. */
+  eMB_PHASE_NUM
+} eMB_PhasePointType;
+
+/*! \ingroup modbus
+ * \brief Record of one transaction.
+ */
+typedef struct _eMB_PhaseRecordStruct
+{
+  uint32_t                    time[eMB_PHASE_NUM];  /*!< Time of the points in us. */
+  uint8_t                     pointMask;          /*!< Bit (1 << point) of the reached points. */
+  uint8_t                     slaveAddr;          /*!< Slave address. */
+  uint8_t                     funcCode;           /*!< Function code of the request. */
+  uint8_t                     exception;          /*!< Exception of the slave or eMB_EX_NONE. */
+  eMB_ErrorCodeType           status;             /*!< eMB_ENOERR, eMB_ETIMEDOUT or eMB_EIO. */
+} eMB_PhaseRecordStruct;
+
+/*! \ingroup modbus
+ * \brief Called in the context of eMB_MainFunction() for every completed transaction.
+ * The record is only valid during the call.
+ */
+typedef void (*eMB_PhaseCallback)(const eMB_PhaseRecordStruct *record);
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Set the callback for completed transactions, NULL removes it.
+ */
+void eMB_Phase_SetCallback(eMB_PhaseCallback callback);
+
+/*! \ingroup modbus
+ * \brief Take the oldest completed records out of the ring.
+ *
+ * \param records buffer for the records
+ * \param maxNum  size of the buffer in records
+ *
+ * \return Number of records copied. Records are lost if the ring is not read in time.
+ */
+uint16_t eMB_Phase_Read(eMB_PhaseRecordStruct *records, uint16_t maxNum);
+
+/* Called by the stack and the frame layer. */
+void eMB_Phase_Begin(void);
+void eMB_Phase_Mark(eMB_PhasePointType point);
+void eMB_Phase_Sent(uint8_t slaveAddr, uint8_t funcCode);
+void eMB_Phase_End(eMB_ErrorCodeType status, eMB_ExceptionType exception);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PHASE_H */
@@ -75,6 +75,9 @@ typedef bool (*eMB_PortTimersInit)(void);
 typedef void (*eMB_PortTimersEnable)(eMB_PortTimerModeType timerMode);
 typedef void (*eMB_PortTimersDisable)(void);
 
+typedef uint32_t (*eMB_PortTimeGet)(void);
+typedef uint32_t (*eMB_PortTimeGetUs)(void);
+
 
 
 #ifdef __cplusplus
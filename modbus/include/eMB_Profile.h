@@ -0,0 +1,238 @@
+/*
+ * File:   eMB_Profile.h
+ * Author: Long
+ *
+ * Register map and poll plan generated from the device profile in
+ * eMB_ProfileCfg.h. Everything is resolved by the compiler:
+ *
+ *  - the tables of the shadow store are sized to the lowest and the highest
+ *    address used by the profile (eMB_PROFILE_xxx_START/NUM),
+ *  - every point gets constants for its slave, table and slot, the slot is the
+ *    index of the point in the shadow table of its slave,
+ *  - the poll plan is a const table, one request per poll table entry.
+ *
+ * The table limits use sizeof() of a union which has one member per poll
+ * entry, so they are constant expressions but cannot be used in #if.
+ *
+ * Created on October 19, 2026, 01:15 PM
+ */
+
+#ifndef EMB_PROFILE_H
+#define EMB_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_ProfileCfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Number of addresses of a Modbus table. */
+#define eMB_PROFILE_ADDR_SPACE                    ( 0x10000L )
+
+/* Size of a union member: end address (or begin distance) of an entry of table t, 1 for other tables. */
+#define eMB_PROFILE_GEN_END(t, type, addr, num)   ( ((int)(type) == (int)(t)) ? ((addr) + (num)) : 1 )
+#define eMB_PROFILE_GEN_BEGIN(t, type, addr)      ( ((int)(type) == (int)(t)) ? (eMB_PROFILE_ADDR_SPACE - (addr)) : 1 )
+
+#define eMB_PROFILE_GEN_COIL_END(name, slave, type, addr, num, period)                            \
+  uint8_t name[eMB_PROFILE_GEN_END(eMB_REG_COILS, type, addr, num)];
+#define eMB_PROFILE_GEN_DISCRETE_END(name, slave, type, addr, num, period)                        \
+  uint8_t name[eMB_PROFILE_GEN_END(eMB_REG_DISCRETE_INPUTS, type, addr, num)];
+#define eMB_PROFILE_GEN_INPUT_END(name, slave, type, addr, num, period)                           \
+  uint8_t name[eMB_PROFILE_GEN_END(eMB_REG_INPUT, type, addr, num)];
+#define eMB_PROFILE_GEN_HOLDING_END(name, slave, type, addr, num, period)                         \
+  uint8_t name[eMB_PROFILE_GEN_END(eMB_REG_HOLDING, type, addr, num)];
+
+#define eMB_PROFILE_GEN_COIL_BEGIN(name, slave, type, addr, num, period)                          \
+  uint8_t name[eMB_PROFILE_GEN_BEGIN(eMB_REG_COILS, type, addr)];
+#define eMB_PROFILE_GEN_DISCRETE_BEGIN(name, slave, type, addr, num, period)                      \
+  uint8_t name[eMB_PROFILE_GEN_BEGIN(eMB_REG_DISCRETE_INPUTS, type, addr)];
+#define eMB_PROFILE_GEN_INPUT_BEGIN(name, slave, type, addr, num, period)                         \
+  uint8_t name[eMB_PROFILE_GEN_BEGIN(eMB_REG_INPUT, type, addr)];
+#define eMB_PROFILE_GEN_HOLDING_BEGIN(name, slave, type, addr, num, period)                       \
+  uint8_t name[eMB_PROFILE_GEN_BEGIN(eMB_REG_HOLDING, type, addr)];
+
+/* The member "none" keeps the begin at 0 if the profile does not use the table. */
+typedef union { eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_COIL_END) } eMB_ProfileCoilEndUnion;
+typedef union { eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_DISCRETE_END) } eMB_ProfileDiscreteEndUnion;
+typedef union { eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_INPUT_END) } eMB_ProfileInputEndUnion;
+typedef union { eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_HOLDING_END) } eMB_ProfileHoldingEndUnion;
+
+typedef union
+{
+  uint8_t none[eMB_PROFILE_ADDR_SPACE + 1 - sizeof(eMB_ProfileCoilEndUnion)];
+  eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_COIL_BEGIN)
+} eMB_ProfileCoilBeginUnion;
+
+typedef union
+{
+  uint8_t none[eMB_PROFILE_ADDR_SPACE + 1 - sizeof(eMB_ProfileDiscreteEndUnion)];
+  eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_DISCRETE_BEGIN)
+} eMB_ProfileDiscreteBeginUnion;
+
+typedef union
+{
+  uint8_t none[eMB_PROFILE_ADDR_SPACE + 1 - sizeof(eMB_ProfileInputEndUnion)];
+  eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_INPUT_BEGIN)
+} eMB_ProfileInputBeginUnion;
+
+typedef union
+{
+  uint8_t none[eMB_PROFILE_ADDR_SPACE + 1 - sizeof(eMB_ProfileHoldingEndUnion)];
+  eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_HOLDING_BEGIN)
+} eMB_ProfileHoldingBeginUnion;
+
+/*! \brief Tables of the shadow store derived from the profile. */
+#define eMB_PROFILE_COIL_START                    ( (int)(eMB_PROFILE_ADDR_SPACE - sizeof(eMB_ProfileCoilBeginUnion)) )
+#define eMB_PROFILE_COIL_NUM                      ( (int)sizeof(eMB_ProfileCoilEndUnion) - eMB_PROFILE_COIL_START )
+#define eMB_PROFILE_DISCRETE_START                ( (int)(eMB_PROFILE_ADDR_SPACE - sizeof(eMB_ProfileDiscreteBeginUnion)) )
+#define eMB_PROFILE_DISCRETE_NUM                  ( (int)sizeof(eMB_ProfileDiscreteEndUnion) - eMB_PROFILE_DISCRETE_START )
+#define eMB_PROFILE_INPUT_START                   ( (int)(eMB_PROFILE_ADDR_SPACE - sizeof(eMB_ProfileInputBeginUnion)) )
+#define eMB_PROFILE_INPUT_NUM                     ( (int)sizeof(eMB_ProfileInputEndUnion) - eMB_PROFILE_INPUT_START )
+#define eMB_PROFILE_HOLDING_START                 ( (int)(eMB_PROFILE_ADDR_SPACE - sizeof(eMB_ProfileHoldingBeginUnion)) )
+#define eMB_PROFILE_HOLDING_NUM                   ( (int)sizeof(eMB_ProfileHoldingEndUnion) - eMB_PROFILE_HOLDING_START )
+
+/*! \brief First address of the shadow table of regType. */
+#define eMB_PROFILE_START(regType)                                                                \
+  ( ((int)(regType) == (int)eMB_REG_COILS)           ? eMB_PROFILE_COIL_START     :               \
+    ((int)(regType) == (int)eMB_REG_DISCRETE_INPUTS) ? eMB_PROFILE_DISCRETE_START :               \
+    ((int)(regType) == (int)eMB_REG_INPUT)           ? eMB_PROFILE_INPUT_START    :               \
+                                                       eMB_PROFILE_HOLDING_START )
+
+/*! \brief Maximum number of values of one read request of regType. */
+#define eMB_PROFILE_PDU_MAX(regType)                                                              \
+  ( (((int)(regType) == (int)eMB_REG_COILS) ||                                                   \
+     ((int)(regType) == (int)eMB_REG_DISCRETE_INPUTS)) ? 2000 : 125 )
+
+/*! \ingroup modbus
+ * \brief Poll table entries, eMB_PROFILE_POLL_<name>.
+ */
+typedef enum _eMB_ProfilePollType
+{
+#define eMB_PROFILE_GEN_POLL_ID(name, slave, type, addr, num, period)                             \
+  eMB_PROFILE_POLL_##name,
+  eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_POLL_ID)
+#undef eMB_PROFILE_GEN_POLL_ID
+  eMB_PROFILE_POLL_NUM
+} eMB_ProfilePollType;
+
+/*! \ingroup modbus
+ * \brief Points, eMB_PROFILE_POINT_<name>.
+ */
+typedef enum _eMB_ProfilePointType
+{
+#define eMB_PROFILE_GEN_POINT_ID(name, poll, offset, num)                                         \
+  eMB_PROFILE_POINT_##name,
+  eMB_PROFILE_POINT_TABLE(eMB_PROFILE_GEN_POINT_ID)
+#undef eMB_PROFILE_GEN_POINT_ID
+  eMB_PROFILE_POINT_NUM
+} eMB_ProfilePointType;
+
+/* Attributes of every poll table entry, used to resolve the points. */
+enum
+{
+#define eMB_PROFILE_GEN_POLL_ATTR(name, slave, type, addr, num, period)                           \
+  eMB_PROFILE_POLL_SLAVE_##name = (slave),                                                        \
+  eMB_PROFILE_POLL_TYPE_##name  = (type),                                                         \
+  eMB_PROFILE_POLL_ADDR_##name  = (addr),                                                         \
+  eMB_PROFILE_POLL_NREG_##name  = (num),                                                          \
+  eMB_PROFILE_POLL_PERIOD_##name = (period),
+  eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_POLL_ATTR)
+#undef eMB_PROFILE_GEN_POLL_ATTR
+  eMB_PROFILE_POLL_ATTR_END
+};
+
+/*! \brief Attributes of every point:
+ *    - eMB_PROFILE_SLAVE_<name> slave address
+ *    - eMB_PROFILE_TYPE_<name>  eMB_RegType of the table
+ *    - eMB_PROFILE_ADDR_<name>  address on the slave
+ *    - eMB_PROFILE_NREG_<name>  number of values
+ *    - eMB_PROFILE_SLOT_<name>  index in the shadow table, e.g.
+ *      eMB_gShadowPtr->inputBuf[eMB_PROFILE_SLAVE_VOLTAGE_L1 - 1][eMB_PROFILE_SLOT_VOLTAGE_L1]
+ */
+enum
+{
+#define eMB_PROFILE_GEN_POINT_ATTR(name, poll, offset, num)                                       \
+  eMB_PROFILE_SLAVE_##name = eMB_PROFILE_POLL_SLAVE_##poll,                                       \
+  eMB_PROFILE_TYPE_##name  = eMB_PROFILE_POLL_TYPE_##poll,                                        \
+  eMB_PROFILE_ADDR_##name  = eMB_PROFILE_POLL_ADDR_##poll + (offset),                             \
+  eMB_PROFILE_NREG_##name  = (num),                                                               \
+  eMB_PROFILE_SLOT_##name  = eMB_PROFILE_POLL_ADDR_##poll + (offset) -                            \
+                             eMB_PROFILE_START(eMB_PROFILE_POLL_TYPE_##poll),
+  eMB_PROFILE_POINT_TABLE(eMB_PROFILE_GEN_POINT_ATTR)
+#undef eMB_PROFILE_GEN_POINT_ATTR
+  eMB_PROFILE_POINT_ATTR_END
+};
+
+/*! \ingroup modbus
+ * \brief One read request of the poll plan or one point.
+ */
+typedef struct _eMB_ProfileEntryStruct
+{
+  uint32_t                    periodMs;           /*!< Poll period, of the poll entry for points. */
+  uint16_t                    addr;               /*!< First address on the slave. */
+  uint16_t                    num;                /*!< Number of values. */
+  uint8_t                     slaveAddr;
+  uint8_t                     regType;            /*!< eMB_RegType. */
+} eMB_ProfileEntryStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Issue the next due request of the poll plan.
+ *
+ * Call periodically from the application, at most one request is issued per
+ * call. Entries are served round robin so a late entry cannot starve the
+ * others. The function requires eMB_ConfigStruct::pPortTimeGet.
+ *
+ * \return eMB_ENOERR if a request was issued or none is due, eMB_EBUSY if the
+ *   master is busy (call again later) or the error of the request function,
+ *   the failed entry is tried again after its period.
+ */
+eMB_ErrorCodeType eMB_Profile_PollFunction(void);
+
+/*! \ingroup modbus
+ * \brief Get a poll plan entry or a point.
+ *
+ * \return pointer to the const entry or NULL if the index is invalid.
+ */
+const eMB_ProfileEntryStruct *eMB_Profile_GetPoll(eMB_ProfilePollType poll);
+const eMB_ProfileEntryStruct *eMB_Profile_GetPoint(eMB_ProfilePointType point);
+
+/*! \ingroup modbus
+ * \brief Read a consistent copy of a point from the shadow store.
+ *
+ * \param point    the point
+ * \param valueBuf uint16_t values for register points, bits packed LSB first
+ *                 for coil and discrete input points
+ *
+ * \return see eMB_Shadow_ReadRegisters().
+ */
+eMB_ErrorCodeType eMB_Profile_ReadPoint(eMB_ProfilePointType point, void *valueBuf);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PROFILE_H */
@@ -0,0 +1,90 @@
+/*
+ * File:   eMB_Retry.h
+ * Author: Long
+ *
+ * Retries of the master. A failed request of the application is copied into
+ * the retry queue and the line is released, so other slaves are polled while
+ * the request waits. eMB_MainFunction() sends it again when it is due:
+ *
+ *   - respond timeout or damaged response: after delayMs, retryNum times,
+ *   - exception 0x06 (slave busy): after busyDelayMs, doubled for every busy
+ *     response, busyRetryNum times,
+ *   - exception 0x05 (acknowledge): the request is repeated every ackPollMs
+ *     until the slave returns the result, ackPollNum times.
+ *
+ * Other exceptions and requests forwarded for TCP clients are not retried.
+ *
+ * Created on October 19, 2026, 09:40 PM
+ */
+
+#ifndef EMB_RETRY_H
+#define EMB_RETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Retry policy of a slave, 0 retries disable a case.
+ */
+typedef struct _eMB_RetryPolicyStruct
+{
+  uint8_t                     retryNum;           /*!< Retries after a timeout or damaged response. */
+  uint8_t                     busyRetryNum;       /*!< Retries after exception 0x06. */
+  uint8_t                     ackPollNum;         /*!< Repetitions after exception 0x05. */
+  uint16_t                    delayMs;            /*!< Delay of a retry after a timeout. */
+  uint16_t                    busyDelayMs;        /*!< Delay of the first retry after 0x06. */
+  uint16_t                    ackPollMs;          /*!< Delay of a repetition after 0x05. */
+} eMB_RetryPolicyStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Set the retry policy of a slave.
+ *
+ * \param slaveAddr slave address, eMB_ADDRESS_BROADCAST sets the policy of all slaves
+ * \param policy    retry policy, copied
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if an argument is invalid.
+ */
+eMB_ErrorCodeType eMB_Retry_SetPolicy(uint8_t slaveAddr, const eMB_RetryPolicyStruct *policy);
+
+/* Called by the master main function. Send the next due retry if the line is free. */
+void eMB_Retry_Dispatch(void);
+
+/* Called by the master main function. The request on the line was answered. */
+void eMB_Retry_Done(void);
+
+/* Called by the master main function. The request on the line failed, the
+ * exception is eMB_EX_NONE unless the slave returned one. */
+void eMB_Retry_Failed(eMB_ErrorEventType errorType, eMB_ExceptionType exptStatus);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_RETRY_H */
@@ -0,0 +1,103 @@
+/*
+ * File:   eMB_Rtt.h
+ * Author: Long
+ *
+ * Respond timeout of the master per slave. The time from the end of a request
+ * to the first byte of the response is measured for every answered request.
+ * A smoothed round trip time and its mean deviation are kept per slave
+ * (RFC 6298):
+ *
+ *   RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|
+ *   SRTT   = 7/8 SRTT + 1/8 R
+ *   RTO    = SRTT + max(G, 4 RTTVAR)
+ *
+ * G is the resolution of the clock. A timeout doubles RTO until the next
+ * answer. RTO is limited to eMB_MASTER_RTT_TIMEOUT_MIN_US and
+ * eMB_MASTER_RTT_TIMEOUT_MAX_US. A slave without samples uses
+ * eMB_MASTER_TIMEOUT_MS_RESPOND.
+ *
+ * Created on October 19, 2026, 07:30 PM
+ */
+
+#ifndef EMB_RTT_H
+#define EMB_RTT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/*! \ingroup modbus
+ * \brief Round trip time estimate of one slave, all times in microseconds.
+ */
+typedef struct _eMB_RttStatsStruct
+{
+  uint32_t                    srtt;               /*!< Smoothed round trip time, 0 without samples. */
+  uint32_t                    rttvar;             /*!< Mean deviation of the round trip time. */
+  uint32_t                    rto;                /*!< Respond timeout of the next request. */
+  uint32_t                    last;               /*!< Last measured round trip time. */
+  uint32_t                    sampleNum;          /*!< Number of measured round trips. */
+  uint32_t                    timeoutNum;         /*!< Number of respond timeouts. */
+} eMB_RttStatsStruct;
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/*! \ingroup modbus
+ * \brief Respond timeout of the request which is sent now, in microseconds.
+ *
+ * Called by the port when it starts eMB_PORT_TIMER_RESPOND_TIMEOUT. Without
+ * eMB_MASTER_RTT_ENABLED this is eMB_MASTER_TIMEOUT_MS_RESPOND.
+ */
+uint32_t eMB_Rtt_GetTimeout(void);
+
+#ifdef eMB_MASTER_RTT_ENABLED
+/*! \ingroup modbus
+ * \brief Get the round trip time estimate of a slave.
+ *
+ * \param slaveAddr slave address
+ * \param stats     estimate
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if the slave address is invalid.
+ */
+eMB_ErrorCodeType eMB_Rtt_GetStats(uint8_t slaveAddr, eMB_RttStatsStruct *stats);
+
+/* Called by the frame layer. Time of the end of the request and of the first
+ * byte of the response, the response was received for slaveAddr. */
+void eMB_Rtt_Sample(uint8_t slaveAddr, uint32_t sendTime, uint32_t recvTime);
+
+/* Called by the frame layer. The request to slaveAddr was not answered. */
+void eMB_Rtt_Timeout(uint8_t slaveAddr);
+#endif
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_RTT_H */
@@ -0,0 +1,242 @@
+/*
+ * File:   eMB_Shadow.h
+ * Author: Long
+ *
+ * Shadow store of the Modbus master. It keeps the last known coils, discrete
+ * inputs, input registers and holding registers of every slave. The store is
+ * one flat structure so it can be placed in memory shared with other
+ * processes (see eMB_Shadow_Attach()):
+ *
+ *  +------------------+-------------------+-----------------+---------------------------+
+ *  | Header           | Sequence counters | Block info      | Coils | Discretes | Regs  |
+ *  | (magic, version, | (one per slave    | (time, status,  |                           |
+ *  |  layout, change) |  and table)       |  checksum)      |                           |
+ *  +------------------+-------------------+-----------------+---------------------------+
+ *
+ * The master is the only writer. A block (one table of one slave) is updated
+ * between two increments of its sequence counter, readers retry while the
+ * counter is odd or has changed during the copy.
+ *
+ * If the store is placed in a file mapping (see eMB_Shadow_Restore()) the
+ * values of the previous run are kept over a restart. Every block then carries
+ * a CRC so blocks torn by a crash are dropped, the others are marked stale until
+ * the slave is polled again. A store placed by eMB_Shadow_Attach() is not kept,
+ * so its blocks are updated without a CRC.
+ *
+ * The time of a block is eMB_ConfigStruct::pPortTimeGet, which starts again on
+ * every boot. It can only be compared with the times of other blocks and the
+ * clock of the master if the generation of the block equals the one of the
+ * header. A restored block has no known age.
+ *
+ * Created on October 19, 2026, 10:40 AM
+ */
+
+#ifndef EMB_SHADOW_H
+#define EMB_SHADOW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/*! \brief Shadow store magic number ("eMBS"). */
+#define eMB_SHADOW_MAGIC                          ( 0x53424D65UL )
+
+/*! \brief Shadow store layout version. Changed on every incompatible layout change. */
+#define eMB_SHADOW_VERSION                        (  2U )
+
+/*! \brief Number of tables in the shadow store, indexed by eMB_RegType. */
+#define eMB_SHADOW_TABLE_NUM                      (  4U )
+
+/*! \brief Maximum number of read attempts while the master updates a block. */
+#define eMB_SHADOW_READ_RETRY_MAX                 (1000U )
+
+/*! \brief Size in bytes of the coil and discrete input tables of one slave. One spare
+ * byte is kept because eMB_Util_SetBits() always accesses two bytes. */
+#define eMB_SHADOW_COIL_BYTES                     ( (eMB_MASTER_COIL_NCOILS + 7) / 8 + 1 )
+#define eMB_SHADOW_DISCRETE_BYTES                 ( (eMB_MASTER_DISCRETE_INPUT_NDISCRETES + 7) / 8 + 1 )
+
+/*! \ingroup modbus
+ * \brief Shadow store header. Consumers check it before using a mapped store.
+ */
+typedef struct _eMB_ShadowHeaderStruct
+{
+  uint32_t                    magic;              /*!< eMB_SHADOW_MAGIC. */
+  uint16_t                    version;            /*!< eMB_SHADOW_VERSION. */
+  uint16_t                    headerSize;         /*!< sizeof(eMB_ShadowHeaderStruct). */
+  uint32_t                    totalSize;          /*!< sizeof(eMB_ShadowStruct). */
+  uint16_t                    slaveNum;           /*!< eMB_MASTER_TOTAL_SLAVE_NUM. */
+  uint16_t                    coilStart;
+  uint16_t                    coilNum;
+  uint16_t                    discreteStart;
+  uint16_t                    discreteNum;
+  uint16_t                    inputStart;
+  uint16_t                    inputNum;
+  uint16_t                    holdingStart;
+  uint16_t                    holdingNum;
+  uint16_t                    crc;                /*!< CRC16 of the fields above. */
+  uint16_t                    generation;         /*!< Incremented on every restore. */
+  uint16_t                    reserved;
+  volatile uint32_t           changeCount;        /*!< Incremented after every block update. */
+} eMB_ShadowHeaderStruct;
+
+/*! \ingroup modbus
+ * \brief State of a shadow block.
+ */
+typedef enum _eMB_ShadowBlockStatusType
+{
+  eMB_SHADOW_BLOCK_EMPTY,                         /*!< Block was never updated. */
+  eMB_SHADOW_BLOCK_VALID,                         /*!< Block was updated in this generation. */
+  eMB_SHADOW_BLOCK_STALE                          /*!< Block was restored from a previous generation. */
+} eMB_ShadowBlockStatusType;
+
+/*! \ingroup modbus
+ * \brief Information of one shadow block.
+ */
+typedef struct _eMB_ShadowBlockInfoStruct
+{
+  uint32_t                    time;               /*!< pPortTimeGet of the last update, in the clock of generation. */
+  uint16_t                    generation;         /*!< Header generation of the last update. */
+  uint16_t                    crc;                /*!< CRC16 of the block data, 0 unless placed by eMB_Shadow_Restore(). */
+  uint8_t                     status;             /*!< eMB_ShadowBlockStatusType. */
+  uint8_t                     reserved[3];
+} eMB_ShadowBlockInfoStruct;
+
+/*! \ingroup modbus
+ * \brief Shadow store. Slave address N is stored at index N - 1.
+ */
+typedef struct _eMB_ShadowStruct
+{
+  eMB_ShadowHeaderStruct      header;
+  volatile uint32_t           seq[eMB_MASTER_TOTAL_SLAVE_NUM][eMB_SHADOW_TABLE_NUM];
+  eMB_ShadowBlockInfoStruct   info[eMB_MASTER_TOTAL_SLAVE_NUM][eMB_SHADOW_TABLE_NUM];
+  uint8_t                     coilBuf[eMB_MASTER_TOTAL_SLAVE_NUM][eMB_SHADOW_COIL_BYTES];
+  uint8_t                     discreteBuf[eMB_MASTER_TOTAL_SLAVE_NUM][eMB_SHADOW_DISCRETE_BYTES];
+  uint16_t                    inputBuf[eMB_MASTER_TOTAL_SLAVE_NUM][eMB_MASTER_REG_INPUT_NREGS];
+  uint16_t                    holdingBuf[eMB_MASTER_TOTAL_SLAVE_NUM][eMB_MASTER_REG_HOLDING_NREGS];
+} eMB_ShadowStruct;
+
+/*! \brief Called after a block was updated. May signal consumers (futex, eventfd). */
+typedef void (*eMB_ShadowNotifyCallback)(void);
+
+
+
+/*===============================================================================================
+*                                          VARIABLES
+===============================================================================================*/
+
+/*! \brief The shadow store used by the master. */
+extern eMB_ShadowStruct *eMB_gShadowPtr;
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/*! \ingroup modbus
+ * \brief Place the shadow store in the given memory.
+ *
+ * This function must be called before eMB_Enable(). The memory is initialized
+ * with a new header and cleared. Passing NULL returns to the internal store.
+ *
+ * \param mem    memory for the store, at least sizeof(eMB_ShadowStruct) bytes
+ * \param size   size of mem in bytes
+ * \param notify called after every block update, may be NULL
+ *
+ * \return eMB_ENOERR on success or eMB_EINVAL if the memory is too small.
+ */
+eMB_ErrorCodeType eMB_Shadow_Attach(void *mem, uint32_t size, eMB_ShadowNotifyCallback notify);
+
+/*! \ingroup modbus
+ * \brief Place the shadow store in memory holding the store of a previous run.
+ *
+ * Like eMB_Shadow_Attach(), but the content is kept if the header matches this
+ * layout. Every block with a correct CRC is marked eMB_SHADOW_BLOCK_STALE, the
+ * other blocks are cleared. The header generation is incremented, so the times
+ * of the restored blocks, taken in the previous run, are told apart by their
+ * generation.
+ *
+ * \return eMB_ENOERR if the content was restored, eMB_EIO if the memory did not
+ *   hold a valid store and was initialized like eMB_Shadow_Attach() does, or
+ *   eMB_EINVAL if the memory is too small.
+ */
+eMB_ErrorCodeType eMB_Shadow_Restore(void *mem, uint32_t size, eMB_ShadowNotifyCallback notify);
+
+/*! \ingroup modbus
+ * \brief Check that a mapped store was written with the same layout.
+ *
+ * \return eMB_ENOERR if header and layout match, eMB_EINVAL otherwise.
+ */
+eMB_ErrorCodeType eMB_Shadow_Validate(const eMB_ShadowStruct *shadow, uint32_t size);
+
+/*! \ingroup modbus
+ * \brief Read consistent input or holding register values from a store.
+ *
+ * The function never blocks the master. It can be used on a read only mapping.
+ *
+ * \return eMB_ENOERR, eMB_EINVAL for invalid arguments, eMB_ENOREG if the
+ *   range is outside the store or eMB_EBUSY if no consistent copy was taken.
+ */
+eMB_ErrorCodeType eMB_Shadow_ReadRegisters(const eMB_ShadowStruct *shadow, eMB_RegType regType, uint8_t slaveAddr,
+                                           uint16_t regAddr, uint16_t regNum, uint16_t *regBuf);
+
+/*! \ingroup modbus
+ * \brief Like eMB_Shadow_ReadRegisters(), but the values are written big endian
+ * into pduBuf like in a Modbus frame. Used to build responses without a copy.
+ *
+ * \return see eMB_Shadow_ReadRegisters().
+ */
+eMB_ErrorCodeType eMB_Shadow_ReadRegistersPdu(const eMB_ShadowStruct *shadow, eMB_RegType regType, uint8_t slaveAddr,
+                                              uint16_t regAddr, uint16_t regNum, uint8_t *pduBuf);
+
+/*! \ingroup modbus
+ * \brief Read consistent coil or discrete input values from a store.
+ *
+ * The bits are packed LSB first into bitBuf like in a Modbus frame.
+ *
+ * \return see eMB_Shadow_ReadRegisters().
+ */
+eMB_ErrorCodeType eMB_Shadow_ReadBits(const eMB_ShadowStruct *shadow, eMB_RegType regType, uint8_t slaveAddr,
+                                      uint16_t bitAddr, uint16_t bitNum, uint8_t *bitBuf);
+
+/*! \ingroup modbus
+ * \brief Read the information of one block of a store.
+ *
+ * \return see eMB_Shadow_ReadRegisters().
+ */
+eMB_ErrorCodeType eMB_Shadow_ReadBlockInfo(const eMB_ShadowStruct *shadow, eMB_RegType regType, uint8_t slaveAddr,
+                                           eMB_ShadowBlockInfoStruct *info);
+
+/* Mark the begin and the end of a block update. Used by the register callbacks. */
+void eMB_Shadow_WriteBegin(eMB_RegType regType, uint8_t slaveAddr);
+void eMB_Shadow_WriteEnd(eMB_RegType regType, uint8_t slaveAddr, uint32_t time);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_SHADOW_H */
@@ -0,0 +1,136 @@
+/*
+ * File:   eMB_Stats.h
+ * Author: Long
+ *
+ * Statistics of the master per slave: counters per function code and a
+ * histogram of the response latency (end of the request to the first byte
+ * of the response). The histogram is log-linear: values below 2^SUB_BITS us
+ * have a bucket each, above every power of two is split into 2^SUB_BITS
+ * buckets, so a bucket is at most 1/2^SUB_BITS of its value wide. Latencies
+ * of 2^eMB_STATS_HIST_MAX_BITS us and more fall into the last bucket.
+ * All updates take constant time and no memory is allocated.
+ *
+ * Created on October 19, 2026, 10:15 PM
+ */
+
+#ifndef EMB_STATS_H
+#define EMB_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \brief Latencies up to 2^22 us (about 4 s) are resolved. */
+#define eMB_STATS_HIST_MAX_BITS                   ( 22 )
+
+#define eMB_STATS_HIST_SUB_NUM                    ( 1U << eMB_MASTER_STATS_HIST_SUB_BITS )
+#define eMB_STATS_HIST_SIZE                       ( (eMB_STATS_HIST_MAX_BITS - eMB_MASTER_STATS_HIST_SUB_BITS + 1) * \
+                                                    eMB_STATS_HIST_SUB_NUM )
+
+/*! \ingroup modbus
+ * \brief Function codes with their own counters.
+ */
+typedef enum _eMB_StatsFuncType
+{
+  eMB_STATS_FUNC_READ_COILS,                      /*!< 0x01 */
+  eMB_STATS_FUNC_READ_DISCRETE_INPUTS,            /*!< 0x02 */
+  eMB_STATS_FUNC_READ_HOLDING_REGISTER,           /*!< 0x03 */
+  eMB_STATS_FUNC_READ_INPUT_REGISTER,             /*!< 0x04 */
+  eMB_STATS_FUNC_WRITE_SINGLE_COIL,               /*!< 0x05 */
+  eMB_STATS_FUNC_WRITE_REGISTER,                  /*!< 0x06 */
+  eMB_STATS_FUNC_WRITE_MULTIPLE_COILS,            /*!< 0x0F */
+  eMB_STATS_FUNC_WRITE_MULTIPLE_REGISTERS,        /*!< 0x10 */
+  eMB_STATS_FUNC_READWRITE_MULTIPLE_REGISTERS,    /*!< 0x17 */
+  eMB_STATS_FUNC_OTHER,                           /*!< All other function codes. */
+  eMB_STATS_FUNC_NUM
+} eMB_StatsFuncType;
+
+/*! \ingroup modbus
+ * \brief Counters of the requests of one function code.
+ */
+typedef struct _eMB_StatsCountStruct
+{
+  uint32_t                    requestNum;         /*!< Requests sent. */
+  uint32_t                    responseNum;        /*!< Normal responses. */
+  uint32_t                    exceptionNum;       /*!< Exception responses. */
+  uint32_t                    timeoutNum;         /*!< Respond timeouts. */
+  uint32_t                    crcErrorNum;        /*!< Responses with CRC, framing or address errors. */
+} eMB_StatsCountStruct;
+
+/*! \ingroup modbus
+ * \brief Statistics of one slave.
+ */
+typedef struct _eMB_StatsSlaveStruct
+{
+  eMB_StatsCountStruct        count[eMB_STATS_FUNC_NUM];
+  uint32_t                    latencyNum;         /*!< Latency samples. */
+  uint32_t                    latencyMax;         /*!< Largest latency in us. */
+  uint32_t                    hist[eMB_STATS_HIST_SIZE];
+} eMB_StatsSlaveStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Copy the statistics of a slave.
+ *
+ * \param slaveAddr slave address
+ * \param stats     snapshot
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if an argument is invalid.
+ */
+eMB_ErrorCodeType eMB_Stats_GetSlave(uint8_t slaveAddr, eMB_StatsSlaveStruct *stats);
+
+/*! \ingroup modbus
+ * \brief Clear the statistics of a slave.
+ *
+ * \param slaveAddr slave address, eMB_ADDRESS_BROADCAST clears all slaves
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if the slave address is invalid.
+ */
+eMB_ErrorCodeType eMB_Stats_Reset(uint8_t slaveAddr);
+
+/*! \ingroup modbus
+ * \brief Latency percentile of a snapshot.
+ *
+ * \param stats     snapshot of eMB_Stats_GetSlave()
+ * \param permille  percentile in 1/1000, e.g. 990 for p99
+ *
+ * \return Upper bound in us of the bucket which holds the percentile, 0 without samples.
+ */
+uint32_t eMB_Stats_GetLatency(const eMB_StatsSlaveStruct *stats, uint16_t permille);
+
+/* Called by the master main function and the frame layer. */
+void eMB_Stats_Request(uint8_t slaveAddr, uint8_t funcCode);
+void eMB_Stats_Response(bool isException);
+void eMB_Stats_Error(eMB_ErrorEventType errorType);
+void eMB_Stats_Latency(uint8_t slaveAddr, uint32_t latencyUs);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_STATS_H */
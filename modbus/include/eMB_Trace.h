@@ -0,0 +1,122 @@
+/*
+ * File:   eMB_Trace.h
+ * Author: Long
+ *
+ * Trace of the internal events of the master: events posted and taken by
+ * eMB_MainFunction(), timers armed, expired and stopped, the send and receive
+ * states of the RTU frame layer (sampled after every interrupt callout) and
+ * the function handlers. Re-arming a running timer with the same mode (T3.5
+ * after every byte) is not recorded.
+ *
+ * eMB_Init() puts shims in front of the event and timer hooks of the port
+ * and the interrupt callouts, the port needs no change. Events go into one
+ * ring per context: the line interrupts write theirs without a lock, the
+ * tasks (eMB_MainFunction() and the request functions) inside
+ * eMB_PortEnterCriticalSection(). A full ring drops events and counts them.
+ *
+ * The exporter merges the rings in time order into the JSON array format of
+ * the Chrome trace events, which chrome://tracing and ui.perfetto.dev open.
+ * Timestamps are microseconds of eMB_ConfigStruct::pPortTimeGetUs.
+ *
+ * Created on October 19, 2026, 11:55 PM
+ */
+
+#ifndef EMB_TRACE_H
+#define EMB_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \brief Largest JSON text of a record, a buffer of this size always takes one. */
+#define eMB_TRACE_JSON_SIZE_MAX                   ( 192U )
+
+/*! \ingroup modbus
+ * \brief Traced events.
+ */
+typedef enum _eMB_TraceEventType
+{
+  eMB_TRACE_EVENT_POST,                           /*!< Event posted, arg eMB_EventType. */
+  eMB_TRACE_EVENT_GET,                            /*!< Event taken by eMB_MainFunction(), arg eMB_EventType. */
+  eMB_TRACE_TIMER_ENABLE,                         /*!< Timer armed, arg eMB_PortTimerModeType. */
+  eMB_TRACE_TIMER_DISABLE,                        /*!< Timer stopped. */
+  eMB_TRACE_TIMER_EXPIRE,                         /*!< Timer expired. */
+  eMB_TRACE_SEND_STATE,                           /*!< New send state of the RTU master. */
+  eMB_TRACE_RECV_STATE,                           /*!< New receive state of the RTU master. */
+  eMB_TRACE_HANDLER_BEGIN,                        /*!< Function handler called, arg function code. */
+  eMB_TRACE_HANDLER_END                           /*!< Function handler returned, arg function code. */
+} eMB_TraceEventType;
+
+/*! \ingroup modbus
+ * \brief Traced event.
+ */
+typedef struct _eMB_TraceRecordStruct
+{
+  uint32_t                    timeUs;             /*!< Time of the event. */
+  uint8_t                     event;              /*!< eMB_TraceEventType */
+  uint8_t                     arg;                /*!< Argument of the event. */
+} eMB_TraceRecordStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Number of events dropped because a ring was full.
+ */
+uint32_t eMB_Trace_GetLostNum(void);
+
+/*! \ingroup modbus
+ * \brief Write the start of the JSON array and the names of the timeline rows.
+ *
+ * \param buf  buffer for the text, not terminated
+ * \param size size of the buffer
+ *
+ * \return Bytes written, 0 if the buffer is too small.
+ */
+uint16_t eMB_Trace_ExportHeader(char *buf, uint16_t size);
+
+/*! \ingroup modbus
+ * \brief Take events out of the rings and write them as trace events.
+ *
+ * Call it until it returns 0 and append the output to the header. The
+ * array needs no closing bracket. Events which do not fit stay in the rings.
+ *
+ * \param buf  buffer for the text, not terminated
+ * \param size size of the buffer, at least eMB_TRACE_JSON_SIZE_MAX
+ *
+ * \return Bytes written, 0 if the rings are empty.
+ */
+uint16_t eMB_Trace_ExportRecords(char *buf, uint16_t size);
+
+/* Called by the stack. */
+void eMB_Trace_Install(void);
+void eMB_Trace_Put(eMB_TraceEventType event, uint8_t arg);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_TRACE_H */
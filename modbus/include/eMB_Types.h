@@ -22,6 +22,7 @@ extern "C" {
 ===============================================================================================*/
 
 #include "stdio.h"
+#include "stddef.h"
 #include "stdint.h"
 #include "stdbool.h"
 #include "stdlib.h"
@@ -64,7 +65,8 @@ typedef enum _eMB_ErrorCodeType
   eMB_EIO,                                                            /*!< I/O error. */
   eMB_EILLSTATE,                                                      /*!< protocol stack in illegal state. */
   eMB_EBUSY,                                                          /*!< busy. */
-  eMB_ETIMEDOUT                                                       /*!< timeout error occurred. */
+  eMB_ETIMEDOUT,                                                      /*!< timeout error occurred. */
+  eMB_EOFFLINE                                                        /*!< slave is offline. */
 } eMB_ErrorCodeType;
 
 typedef enum _eMB_ExceptionType
@@ -81,6 +83,26 @@ typedef enum _eMB_ExceptionType
   eMB_EX_GATEWAY_TGT_FAILED                       = 0x0B
 } eMB_ExceptionType;
 
+/*! \ingroup modbus
+ * \brief Modbus data tables.
+ */
+typedef enum _eMB_RegType
+{
+  eMB_REG_COILS,                                                      /*!< Coils. */
+  eMB_REG_DISCRETE_INPUTS,                                            /*!< Discrete inputs. */
+  eMB_REG_INPUT,                                                      /*!< Input registers. */
+  eMB_REG_HOLDING                                                     /*!< Holding registers. */
+} eMB_RegType;
+
+/*! \ingroup modbus
+ * \brief Direction of a register access of the slave.
+ */
+typedef enum _eMB_RegModeType
+{
+  eMB_REG_READ,                                                       /*!< Copy values from the store into the frame. */
+  eMB_REG_WRITE                                                       /*!< Copy values from the frame into the store. */
+} eMB_RegModeType;
+
 
 
 #ifdef __cplusplus
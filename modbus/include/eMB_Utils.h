@@ -61,6 +61,7 @@ extern eMB_ConfigStruct *eMB_gConfigPtr;
 *                                       FUNCTION PROTOTYPES
 ===============================================================================================*/
 
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
 eMB_ErrorCodeType eMB_Util_FuncCoilsCallback(uint16_t coilAddr, uint16_t coilNum, uint8_t *recvPduFrame);
 
 eMB_ErrorCodeType eMB_Util_FuncDiscreteInputsCallback(uint16_t disInputAddr, uint16_t disInputNum, uint8_t *recvPduFrame);
@@ -69,8 +70,82 @@ eMB_ErrorCodeType eMB_Util_FuncHoldingRegisterCallback(uint16_t holdingAddr, uin
 
 eMB_ErrorCodeType eMB_Util_FuncInputRegisterCallback(uint16_t inputAddr, uint16_t inputNum, uint8_t *recvPduFrame);
 
+bool eMB_Util_ResourceTake(void);
+
+void eMB_Util_SetPendingRead(uint8_t slaveAddr, uint8_t funcCode, uint16_t regAddr, uint16_t regNum);
+void eMB_Util_ClearPendingRead(void);
+bool eMB_Util_JoinPendingRead(uint8_t slaveAddr, uint8_t funcCode, uint16_t regAddr, uint16_t regNum);
+#endif
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+eMB_ErrorCodeType eMB_Util_SlaveFuncCoilsCallback(uint16_t coilAddr, uint16_t coilNum, uint8_t *pduBuf, eMB_RegModeType mode);
+
+eMB_ErrorCodeType eMB_Util_SlaveFuncDiscreteInputsCallback(uint16_t disInputAddr, uint16_t disInputNum, uint8_t *pduBuf);
+
+eMB_ErrorCodeType eMB_Util_SlaveFuncHoldingRegisterCallback(uint16_t holdingAddr, uint16_t holdingNum, uint8_t *pduBuf, eMB_RegModeType mode);
+
+eMB_ErrorCodeType eMB_Util_SlaveFuncInputRegisterCallback(uint16_t inputAddr, uint16_t inputNum, uint8_t *pduBuf);
+#endif
+
+/*! \brief Function to set bits in a byte buffer.
+ *
+ * This function allows the efficient use of an array to implement bitfields.
+ * The array used for storing the bits must always be a multiple of two
+ * bytes. Up to eight bits can be set or cleared in one operation.
+ *
+ * \param byteArr A buffer where the bit values are stored. Must be a
+ *   multiple of 2 bytes. No length checking is performed and if
+ *   offset / 8 is greater than the size of the buffer memory contents
+ *   is overwritten.
+ * \param offset The starting address of the bits to set. The first
+ *   bit has the offset 0.
+ * \param bitNum Number of bits to modify. The value must always be smaller
+ *   than 8.
+ * \param value Thew new values for the bits. The value for the first bit
+ *   starting at <code>offset</code> is the LSB of the value
+ *   <code>value</code>
+ *
+ * \code
+ * ucBits[2] = {0, 0};
+ *
+ * // Set bit 4 to 1 (read: set 1 bit starting at bit offset 4 to value 1)
+ * eMB_Util_SetBits( ucBits, 4, 1, 1 );
+ *
+ * // Set bit 7 to 1 and bit 8 to 0.
+ * eMB_Util_SetBits( ucBits, 7, 2, 0x01 );
+ *
+ * // Set bits 8 - 11 to 0x05 and bits 12 - 15 to 0x0A;
+ * eMB_Util_SetBits( ucBits, 8, 8, 0x5A);
+ * \endcode
+ */
+void eMB_Util_SetBits(uint8_t * byteArr, uint16_t offset, uint8_t bitNum, uint8_t value);
+
+/*! \brief Function to read bits in a byte buffer.
+ *
+ * This function is used to extract up bit values from an array. Up to eight
+ * bit values can be extracted in one step.
+ *
+ * \param byteArr A buffer where the bit values are stored.
+ * \param offset The starting address of the bits to set. The first
+ *   bit has the offset 0.
+ * \param bitNum Number of bits to modify. The value must always be smaller
+ *   than 8.
+ *
+ * \code
+ * uint8_t ucBits[2] = {0, 0};
+ * uint8_t ucResult;
+ *
+ * // Extract the bits 3 - 10.
+ * ucResult = eMB_Util_GetBits( ucBits, 3, 8 );
+ * \endcode
+ */
+uint8_t eMB_Util_GetBits(uint8_t * byteArr, uint16_t offset, uint8_t bitNum);
+
 eMB_ExceptionType eMB_Util_ErrorToException(eMB_ErrorCodeType errorCode);
 
+uint32_t eMB_Util_GetTime(void);
+uint32_t eMB_Util_GetTimeUs(void);
+
 eMB_ErrorEventType eMB_Util_GetErrorEvent(void);
 void eMB_Util_SetErrorEvent(eMB_ErrorEventType errorType);
 
@@ -0,0 +1,188 @@
+/*
+ * File:   eMB_Bus.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 11:10 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+#ifdef eMB_RTU_BUS_ENABLED
+/* Length of the window, extended from the 32 bit clock at every frame, wait and read */
+static volatile uint64_t eMB_BusElapsedUs;
+static volatile uint32_t eMB_BusLastTime;
+
+static volatile uint32_t eMB_BusTxBytes;
+static volatile uint32_t eMB_BusRxBytes;
+static volatile uint32_t eMB_BusFrameNum;
+static volatile uint64_t eMB_BusWaitUs;
+
+/* Start of the current wait, valid if eMB_BusIsWaiting */
+static volatile uint32_t eMB_BusWaitTime;
+static volatile bool     eMB_BusIsWaiting;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_Bus_Advance(void);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_Bus_GetStats(eMB_BusStatsStruct *stats, bool reset)
+{
+  uint64_t busyUs;
+
+  if (stats == NULL)
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_PortEnterCriticalSection();
+
+  eMB_Bus_Advance();
+
+  stats->elapsedUs = eMB_BusElapsedUs;
+  stats->txBytes   = eMB_BusTxBytes;
+  stats->rxBytes   = eMB_BusRxBytes;
+  stats->frameNum  = eMB_BusFrameNum;
+  stats->waitUs    = eMB_BusWaitUs;
+
+  if (reset == true)
+  {
+    eMB_Bus_Start();
+  }
+
+  eMB_PortExitCriticalSection();
+
+  stats->txUs  = (uint64_t)stats->txBytes * eMB_RTU_GetCharTime();
+  stats->rxUs  = (uint64_t)stats->rxBytes * eMB_RTU_GetCharTime();
+  stats->gapUs = (uint64_t)stats->frameNum * eMB_RTU_GetT35();
+
+  busyUs = stats->txUs + stats->rxUs + stats->gapUs + stats->waitUs;
+
+  if (busyUs > stats->elapsedUs)
+  {
+    busyUs = stats->elapsedUs;
+  }
+
+  stats->idleUs = stats->elapsedUs - busyUs;
+
+  stats->usePermille = (uint16_t)1000U;
+
+  if (stats->elapsedUs != 0ULL)
+  {
+    stats->usePermille = (uint16_t)((busyUs * 1000U) / stats->elapsedUs);
+  }
+
+  stats->freePermille = (uint16_t)(1000U - stats->usePermille);
+
+  return eMB_ENOERR;
+}
+
+/* Start a new window, called inside eMB_PortEnterCriticalSection(). */
+void eMB_Bus_Start(void)
+{
+  eMB_BusLastTime  = eMB_Util_GetTimeUs();
+  eMB_BusElapsedUs = 0ULL;
+  eMB_BusTxBytes   = 0UL;
+  eMB_BusRxBytes   = 0UL;
+  eMB_BusFrameNum  = 0UL;
+  eMB_BusWaitUs    = 0ULL;
+
+  /* A running wait is counted from the start of the window. */
+  if (eMB_BusIsWaiting == true)
+  {
+    eMB_BusWaitTime = eMB_BusLastTime;
+  }
+}
+
+/* A frame of byteNum bytes was sent or received. */
+void eMB_Bus_Frame(uint16_t byteNum, bool isSent)
+{
+  if (isSent == true)
+  {
+    eMB_BusTxBytes += byteNum;
+  }
+  else
+  {
+    eMB_BusRxBytes += byteNum;
+  }
+
+  eMB_BusFrameNum++;
+
+  eMB_Bus_Advance();
+}
+
+/* The master waits for a response or after a broadcast. */
+void eMB_Bus_WaitBegin(void)
+{
+  eMB_BusWaitTime = eMB_Util_GetTimeUs();
+  eMB_BusIsWaiting = true;
+}
+
+/* The response starts or the wait expired. The wait begins with the
+ * silence of T3.5 after the request, which is counted as its gap. */
+void eMB_Bus_WaitEnd(void)
+{
+  uint32_t waitUs;
+
+  if (eMB_BusIsWaiting == true)
+  {
+    waitUs = eMB_Util_GetTimeUs() - eMB_BusWaitTime;
+
+    if (waitUs > eMB_RTU_GetT35())
+    {
+      eMB_BusWaitUs += waitUs - eMB_RTU_GetT35();
+    }
+
+    eMB_BusIsWaiting = false;
+  }
+}
+
+
+
+
+
+/* Add the time since the last call to the window. Called often enough, the
+ * 32 bit microsecond clock wraps at most once in between. */
+static void eMB_Bus_Advance(void)
+{
+  uint32_t now = eMB_Util_GetTimeUs();
+
+  eMB_BusElapsedUs += (uint32_t)(now - eMB_BusLastTime);
+  eMB_BusLastTime = now;
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
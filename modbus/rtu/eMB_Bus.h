@@ -0,0 +1,94 @@
+/*
+ * File:   eMB_Bus.h
+ * Author: Long
+ *
+ * Utilisation of the RTU line. The frame layer counts the bytes of the
+ * frames on the line and the time the master waits for responses. The
+ * busy time of a window is
+ *
+ *   tx + rx + gaps + wait = (txBytes + rxBytes) * char time
+ *                         + frames * T3.5 + wait
+ *
+ * with the char time and T3.5 of eMB_RTU_SetBaudrate(). The rest of the
+ * window is idle and can take further polls.
+ *
+ * Created on October 19, 2026, 11:10 PM
+ */
+
+#ifndef EMB_BUS_H
+#define EMB_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Utilisation of the line since the start of the window, times in microseconds.
+ */
+typedef struct _eMB_BusStatsStruct
+{
+  uint64_t                    elapsedUs;          /*!< Length of the window. */
+  uint64_t                    txUs;               /*!< Time of the sent bytes. */
+  uint64_t                    rxUs;               /*!< Time of the received bytes. */
+  uint64_t                    gapUs;              /*!< T3.5 after every frame. */
+  uint64_t                    waitUs;             /*!< Master waited for responses and after broadcasts. */
+  uint64_t                    idleUs;             /*!< Line was free. */
+  uint32_t                    txBytes;            /*!< Bytes sent. */
+  uint32_t                    rxBytes;            /*!< Bytes received. */
+  uint32_t                    frameNum;           /*!< Frames sent and received. */
+  uint16_t                    usePermille;        /*!< Busy time per mille of the window. */
+  uint16_t                    freePermille;       /*!< Capacity left for polls per mille of the window. */
+} eMB_BusStatsStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Get the utilisation of the line.
+ *
+ * The window starts with eMB_Enable() and with every reset. Its length is
+ * kept in 64 bits from the 32 bit microsecond clock of the port, which wraps
+ * after 71 minutes: a frame on the line or a call of this function at least
+ * once in that time keeps it exact.
+ *
+ * \param stats utilisation
+ * \param reset start a new window
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if stats is NULL.
+ */
+eMB_ErrorCodeType eMB_Bus_GetStats(eMB_BusStatsStruct *stats, bool reset);
+
+/* Called by the frame layer, also from the serial and timer interrupts. */
+void eMB_Bus_Start(void);
+void eMB_Bus_Frame(uint16_t byteNum, bool isSent);
+void eMB_Bus_WaitBegin(void);
+void eMB_Bus_WaitEnd(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_BUS_H */
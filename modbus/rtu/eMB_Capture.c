@@ -0,0 +1,281 @@
+/*
+ * File:   eMB_Capture.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 11:35 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_RTU_CAPTURE_ENABLED
+/* Enhanced packet block with epb_flags, without the data */
+#define eMB_PCAPNG_EPB_SIZE                       ( 44U )
+
+#define eMB_CAPTURE_PAD4(n)                       ( ((n) + 3U) & ~3U )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* Ring with one free entry, written at eMB_CaptureHead by the interrupts and
+ * read at eMB_CaptureTail by the task. Each index has a single writer. */
+static volatile eMB_CaptureRecordStruct eMB_CaptureRing[eMB_MASTER_RTU_CAPTURE_RECORD_NUM + 1];
+static volatile uint16_t                eMB_CaptureHead;
+static volatile uint16_t                eMB_CaptureTail;
+static volatile uint32_t                eMB_CaptureLostNum;
+
+/* Upper 32 bits of the exported timestamps, the clock wraps after 71 minutes */
+static uint32_t                         eMB_CaptureTimeHigh;
+static uint32_t                         eMB_CaptureTimeLast;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static bool eMB_Capture_Take(eMB_CaptureRecordStruct *record, uint16_t sizeMax);
+static uint8_t *eMB_Capture_Write16(uint8_t *buf, uint16_t value);
+static uint8_t *eMB_Capture_Write32(uint8_t *buf, uint32_t value);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+uint16_t eMB_Capture_Read(eMB_CaptureRecordStruct *records, uint16_t maxNum)
+{
+  uint16_t readNum = (uint16_t)0U;
+
+  if (records == NULL)
+  {
+    return readNum;
+  }
+
+  while ((readNum < maxNum) && (eMB_Capture_Take(&records[readNum], (uint16_t)0xFFFFU) == true))
+  {
+    readNum++;
+  }
+
+  return readNum;
+}
+
+uint32_t eMB_Capture_GetLostNum(void)
+{
+  return eMB_CaptureLostNum;
+}
+
+uint16_t eMB_Capture_ExportHeader(uint8_t *buf, uint16_t size)
+{
+  uint8_t *pos = buf;
+
+  if ((buf == NULL) || (size < (uint16_t)eMB_CAPTURE_PCAPNG_HEADER_SIZE))
+  {
+    return (uint16_t)0U;
+  }
+
+  /* Section header block, section length unknown. */
+  pos = eMB_Capture_Write32(pos, eMB_PCAPNG_BLOCK_SHB);
+  pos = eMB_Capture_Write32(pos, 28UL);
+  pos = eMB_Capture_Write32(pos, eMB_PCAPNG_BYTE_ORDER_MAGIC);
+  pos = eMB_Capture_Write16(pos, (uint16_t)1U);
+  pos = eMB_Capture_Write16(pos, (uint16_t)0U);
+  pos = eMB_Capture_Write32(pos, 0xFFFFFFFFUL);
+  pos = eMB_Capture_Write32(pos, 0xFFFFFFFFUL);
+  pos = eMB_Capture_Write32(pos, 28UL);
+
+  /* Interface description block, timestamps in us. */
+  pos = eMB_Capture_Write32(pos, eMB_PCAPNG_BLOCK_IDB);
+  pos = eMB_Capture_Write32(pos, 20UL);
+  pos = eMB_Capture_Write16(pos, (uint16_t)eMB_PCAPNG_LINKTYPE_USER0);
+  pos = eMB_Capture_Write16(pos, (uint16_t)0U);
+  pos = eMB_Capture_Write32(pos, (uint32_t)eMB_SDU_SIZE_MAX);
+  pos = eMB_Capture_Write32(pos, 20UL);
+
+  eMB_CaptureTimeHigh = 0UL;
+  eMB_CaptureTimeLast = 0UL;
+
+  return (uint16_t)(pos - buf);
+}
+
+uint16_t eMB_Capture_ExportRecords(uint8_t *buf, uint16_t size)
+{
+  eMB_CaptureRecordStruct record;
+  uint8_t *pos = buf;
+  uint32_t blockSize;
+  uint32_t epbFlags;
+
+  if (buf == NULL)
+  {
+    return (uint16_t)0U;
+  }
+
+  while (eMB_Capture_Take(&record, (uint16_t)(size - (uint16_t)(pos - buf))) == true)
+  {
+    blockSize = eMB_PCAPNG_EPB_SIZE + eMB_CAPTURE_PAD4((uint32_t)record.length);
+
+    if (record.timeUs < eMB_CaptureTimeLast)
+    {
+      eMB_CaptureTimeHigh++;
+    }
+
+    eMB_CaptureTimeLast = record.timeUs;
+
+    epbFlags = ((record.flags & eMB_CAPTURE_FLAG_SENT) != 0U) ? eMB_PCAPNG_FLAG_OUTBOUND : eMB_PCAPNG_FLAG_INBOUND;
+    epbFlags |= ((record.flags & eMB_CAPTURE_FLAG_GAP) != 0U) ? eMB_PCAPNG_FLAG_WRONG_GAP : 0UL;
+    epbFlags |= ((record.flags & eMB_CAPTURE_FLAG_TOO_SHORT) != 0U) ? eMB_PCAPNG_FLAG_TOO_SHORT : 0UL;
+    epbFlags |= ((record.flags & eMB_CAPTURE_FLAG_TOO_LONG) != 0U) ? eMB_PCAPNG_FLAG_TOO_LONG : 0UL;
+    epbFlags |= ((record.flags & eMB_CAPTURE_FLAG_CRC) != 0U) ? eMB_PCAPNG_FLAG_CRC : 0UL;
+
+    pos = eMB_Capture_Write32(pos, eMB_PCAPNG_BLOCK_EPB);
+    pos = eMB_Capture_Write32(pos, blockSize);
+    pos = eMB_Capture_Write32(pos, 0UL);
+    pos = eMB_Capture_Write32(pos, eMB_CaptureTimeHigh);
+    pos = eMB_Capture_Write32(pos, record.timeUs);
+    pos = eMB_Capture_Write32(pos, (uint32_t)record.length);
+    pos = eMB_Capture_Write32(pos, (uint32_t)record.length);
+
+    memcpy(pos, record.data, record.length);
+    memset(&pos[record.length], 0, eMB_CAPTURE_PAD4((uint32_t)record.length) - record.length);
+    pos += eMB_CAPTURE_PAD4((uint32_t)record.length);
+
+    pos = eMB_Capture_Write16(pos, (uint16_t)eMB_PCAPNG_OPT_EPB_FLAGS);
+    pos = eMB_Capture_Write16(pos, (uint16_t)4U);
+    pos = eMB_Capture_Write32(pos, epbFlags);
+    pos = eMB_Capture_Write32(pos, (uint32_t)eMB_PCAPNG_OPT_END);
+    pos = eMB_Capture_Write32(pos, blockSize);
+  }
+
+  return (uint16_t)(pos - buf);
+}
+
+/* Put a frame into the ring, a full ring drops it. */
+void eMB_Capture_Put(const volatile uint8_t *frame, uint16_t length, uint8_t flags)
+{
+  volatile eMB_CaptureRecordStruct *pRecord;
+  uint16_t nextHead = (uint16_t)((eMB_CaptureHead + 1U) % (uint16_t)(eMB_MASTER_RTU_CAPTURE_RECORD_NUM + 1));
+  uint16_t i;
+
+  if (nextHead == eMB_CaptureTail)
+  {
+    eMB_CaptureLostNum++;
+    return;
+  }
+
+  if (length > (uint16_t)eMB_SDU_SIZE_MAX)
+  {
+    length = (uint16_t)eMB_SDU_SIZE_MAX;
+    flags |= (uint8_t)eMB_CAPTURE_FLAG_TOO_LONG;
+  }
+
+  pRecord = &eMB_CaptureRing[eMB_CaptureHead];
+
+  pRecord->timeUs = eMB_Util_GetTimeUs();
+  pRecord->length = length;
+  pRecord->flags  = flags;
+
+  for (i = (uint16_t)0U; i < length; i++)
+  {
+    pRecord->data[i] = frame[i];
+  }
+
+  /* Publish the record after it is complete. */
+  eMB_CaptureHead = nextHead;
+}
+
+
+
+
+
+/* Take the oldest record if it fits into an export block of sizeMax bytes
+ * and check its length and CRC. */
+static bool eMB_Capture_Take(eMB_CaptureRecordStruct *record, uint16_t sizeMax)
+{
+  volatile eMB_CaptureRecordStruct *pRecord;
+  uint16_t i;
+
+  if (eMB_CaptureTail == eMB_CaptureHead)
+  {
+    return false;
+  }
+
+  pRecord = &eMB_CaptureRing[eMB_CaptureTail];
+
+  if (((uint32_t)eMB_PCAPNG_EPB_SIZE + eMB_CAPTURE_PAD4((uint32_t)pRecord->length)) > sizeMax)
+  {
+    return false;
+  }
+
+  record->timeUs = pRecord->timeUs;
+  record->length = pRecord->length;
+  record->flags  = pRecord->flags;
+
+  for (i = (uint16_t)0U; i < record->length; i++)
+  {
+    record->data[i] = pRecord->data[i];
+  }
+
+  /* Free the entry after it is copied. */
+  eMB_CaptureTail = (uint16_t)((eMB_CaptureTail + 1U) % (uint16_t)(eMB_MASTER_RTU_CAPTURE_RECORD_NUM + 1));
+
+  if (record->length < (uint16_t)eMB_SDU_SIZE_MIN)
+  {
+    record->flags |= (uint8_t)eMB_CAPTURE_FLAG_TOO_SHORT;
+  }
+  else if (eMB_GetCRC(record->data, record->length) != (uint16_t)0U)
+  {
+    record->flags |= (uint8_t)eMB_CAPTURE_FLAG_CRC;
+  }
+  else
+  {
+    /* Valid frame. */
+  }
+
+  return true;
+}
+
+/* Write little endian. */
+static uint8_t *eMB_Capture_Write16(uint8_t *buf, uint16_t value)
+{
+  buf[0] = (uint8_t)(value & 0xFFU);
+  buf[1] = (uint8_t)(value >> 8U);
+
+  return &buf[2];
+}
+
+static uint8_t *eMB_Capture_Write32(uint8_t *buf, uint32_t value)
+{
+  buf = eMB_Capture_Write16(buf, (uint16_t)(value & 0xFFFFUL));
+
+  return eMB_Capture_Write16(buf, (uint16_t)(value >> 16U));
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
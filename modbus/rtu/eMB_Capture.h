@@ -0,0 +1,147 @@
+/*
+ * File:   eMB_Capture.h
+ * Author: Long
+ *
+ * Capture of the frames of the RTU master. The frame layer puts every sent
+ * and received ADU (address, PDU and CRC) into a ring when its last byte
+ * went out or T3.5 ended it. Putting a frame takes no lock and never waits,
+ * a full ring drops the frame and counts it. The ring has one writer, the
+ * serial and timer interrupts of the line, and one reader, the task which
+ * calls eMB_Capture_Read() or the exporter.
+ *
+ * The exporter writes the records as pcapng for Wireshark. The blocks use
+ * link type USER0, map it to the Modbus RTU dissector in Wireshark with
+ * Preferences > Protocols > DLT_USER: DLT = 147, payload protocol "mbrtu".
+ * Direction and errors are in the flags of the packets:
+ *
+ *   inbound / outbound       received / sent
+ *   CRC error                CRC of the frame is invalid
+ *   packet too short         frame shorter than eMB_SDU_SIZE_MIN
+ *   packet too long          frame longer than eMB_SDU_SIZE_MAX
+ *   wrong inter-frame gap    silence of more than T1.5 inside the frame
+ *
+ * Created on October 19, 2026, 11:35 PM
+ */
+
+#ifndef EMB_CAPTURE_H
+#define EMB_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+#include "eMB_Frame.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Flags of a record */
+#define eMB_CAPTURE_FLAG_SENT                     ( 0x01U )   /*!< Sent by the master. */
+#define eMB_CAPTURE_FLAG_GAP                      ( 0x02U )   /*!< Silence of more than T1.5 inside. */
+#define eMB_CAPTURE_FLAG_TOO_LONG                 ( 0x04U )   /*!< Longer than eMB_SDU_SIZE_MAX, cut. */
+#define eMB_CAPTURE_FLAG_TOO_SHORT                ( 0x08U )   /*!< Shorter than eMB_SDU_SIZE_MIN, set by the reader. */
+#define eMB_CAPTURE_FLAG_CRC                      ( 0x10U )   /*!< CRC is invalid, set by the reader. */
+
+/* pcapng block types and fields, also read by the replay of port/sim */
+#define eMB_PCAPNG_BLOCK_SHB                      ( 0x0A0D0D0AUL )
+#define eMB_PCAPNG_BLOCK_IDB                      ( 0x00000001UL )
+#define eMB_PCAPNG_BLOCK_EPB                      ( 0x00000006UL )
+#define eMB_PCAPNG_BYTE_ORDER_MAGIC               ( 0x1A2B3C4DUL )
+#define eMB_PCAPNG_LINKTYPE_USER0                 ( 147U )
+#define eMB_PCAPNG_OPT_END                        ( 0U )
+#define eMB_PCAPNG_OPT_EPB_FLAGS                  ( 2U )
+
+/* Bits of the epb_flags option: direction in bits 0..1, link-layer errors in bits 24..31 */
+#define eMB_PCAPNG_FLAG_INBOUND                   ( 0x00000001UL )
+#define eMB_PCAPNG_FLAG_OUTBOUND                  ( 0x00000002UL )
+#define eMB_PCAPNG_FLAG_CRC                       ( 0x01000000UL )
+#define eMB_PCAPNG_FLAG_TOO_LONG                  ( 0x02000000UL )
+#define eMB_PCAPNG_FLAG_TOO_SHORT                 ( 0x04000000UL )
+#define eMB_PCAPNG_FLAG_WRONG_GAP                 ( 0x08000000UL )
+
+/* Size of the pcapng section and interface header of eMB_Capture_ExportHeader() */
+#define eMB_CAPTURE_PCAPNG_HEADER_SIZE            ( 48U )
+
+/* Largest pcapng block of a record */
+#define eMB_CAPTURE_PCAPNG_BLOCK_SIZE_MAX         ( 44U + eMB_SDU_SIZE_MAX )
+
+/*! \ingroup modbus
+ * \brief Captured frame.
+ */
+typedef struct _eMB_CaptureRecordStruct
+{
+  uint32_t                    timeUs;             /*!< End of the frame, eMB_ConfigStruct::pPortTimeGetUs. */
+  uint16_t                    length;             /*!< Bytes in data. */
+  uint8_t                     flags;              /*!< eMB_CAPTURE_FLAG_... */
+  uint8_t                     data[eMB_SDU_SIZE_MAX];
+} eMB_CaptureRecordStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \ingroup modbus
+ * \brief Take the oldest frames out of the ring.
+ *
+ * \param records buffer for the frames
+ * \param maxNum  size of the buffer in frames
+ *
+ * \return Number of frames copied.
+ */
+uint16_t eMB_Capture_Read(eMB_CaptureRecordStruct *records, uint16_t maxNum);
+
+/*! \ingroup modbus
+ * \brief Number of frames dropped because the ring was full.
+ */
+uint32_t eMB_Capture_GetLostNum(void);
+
+/*! \ingroup modbus
+ * \brief Write the pcapng section header and interface description, which start a file.
+ *
+ * \param buf  buffer of at least eMB_CAPTURE_PCAPNG_HEADER_SIZE bytes
+ * \param size size of the buffer
+ *
+ * \return Bytes written, 0 if the buffer is too small.
+ */
+uint16_t eMB_Capture_ExportHeader(uint8_t *buf, uint16_t size);
+
+/*! \ingroup modbus
+ * \brief Take frames out of the ring and write them as pcapng packet blocks.
+ *
+ * Call it until it returns 0 and append the output to the header. Frames
+ * which do not fit stay in the ring, a buffer of
+ * eMB_CAPTURE_PCAPNG_BLOCK_SIZE_MAX bytes always takes a frame.
+ *
+ * \param buf  buffer for the blocks
+ * \param size size of the buffer
+ *
+ * \return Bytes written, 0 if the ring is empty.
+ */
+uint16_t eMB_Capture_ExportRecords(uint8_t *buf, uint16_t size);
+
+/* Called by the frame layer from the serial and timer interrupts. */
+void eMB_Capture_Put(const volatile uint8_t *frame, uint16_t length, uint8_t flags);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_CAPTURE_H */
@@ -27,13 +27,14 @@ extern "C" {
 *                                       DEFINES AND MACROS
 ===============================================================================================*/
 
-#ifdef eMB_MASTER_RTU_ENABLED
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_SLAVE_RTU_ENABLED)
 typedef enum _eMB_RTU_RecvStateType
 {
   eMB_RTU_RECV_STATE_INIT,                        /*!< Receiver is in initial state. */
   eMB_RTU_RECV_STATE_IDLE,                        /*!< Receiver is in idle state. */
   eMB_RTU_RECV_STATE_RCV,                         /*!< Frame is being received. */
   eMB_RTU_RECV_STATE_ERROR,                       /*!< If the frame is invalid. */
+  eMB_RTU_RECV_STATE_DONE,                        /*!< Frame is complete by its length, later bytes are dropped. */
 } eMB_RTU_RecvStateType;
 
 typedef enum _eMB_RTU_SendStateType
@@ -42,6 +43,20 @@ typedef enum _eMB_RTU_SendStateType
   eMB_RTU_SEND_STATE_XMIT,                        /*!< Transmitter is in transfer state. */
   eMB_RTU_SEND_STATE_DONE,                        /*!< Transmitter is in transfer finish and wait receive state. */
 } eMB_RTU_SendStateType;
+
+/* Above 19200 baud the spec fixes T1.5 and T3.5 at 750us and 1750us. */
+#define eMB_RTU_BAUDRATE_FIXED_TIMING             ( 19200UL )
+#define eMB_RTU_T15_FIXED_US                      (   750UL )
+#define eMB_RTU_T35_FIXED_US                      (  1750UL )
+
+/* Character time and n/2 character times in microseconds, rounded up */
+#define eMB_RTU_CHAR_US(baud, bits)               ( ((uint32_t)(bits) * 1000000UL + (baud) - 1UL) / (baud) )
+#define eMB_RTU_HALF_CHARS_US(n, baud, bits)      ( ((uint32_t)(bits) * (n) * 500000UL + (baud) - 1UL) / (baud) )
+
+#define eMB_RTU_T15_US(baud, bits)                ( ((baud) > eMB_RTU_BAUDRATE_FIXED_TIMING) ? \
+                                                    eMB_RTU_T15_FIXED_US : eMB_RTU_HALF_CHARS_US(3UL, baud, bits) )
+#define eMB_RTU_T35_US(baud, bits)                ( ((baud) > eMB_RTU_BAUDRATE_FIXED_TIMING) ? \
+                                                    eMB_RTU_T35_FIXED_US : eMB_RTU_HALF_CHARS_US(7UL, baud, bits) )
 #endif
 
 
@@ -50,13 +65,25 @@ typedef enum _eMB_RTU_SendStateType
 *                                           VARIABLES
 ===============================================================================================*/
 
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_SLAVE_RTU_ENABLED)
+/* Character time, T1.5 and T3.5 of the serial line in microseconds */
+static volatile uint32_t eMB_RTU_CharUs = eMB_RTU_CHAR_US(eMB_RTU_BAUDRATE, eMB_RTU_CHAR_BITS);
+static volatile uint32_t eMB_RTU_T15Us  = eMB_RTU_T15_US(eMB_RTU_BAUDRATE, eMB_RTU_CHAR_BITS);
+static volatile uint32_t eMB_RTU_T35Us  = eMB_RTU_T35_US(eMB_RTU_BAUDRATE, eMB_RTU_CHAR_BITS);
+
+#ifdef eMB_RTU_T15_CHECK_ENABLED
+/* Time of the last received character */
+static volatile uint32_t eMB_RTU_LastCharTime;
+#endif
+#endif
+
 #ifdef eMB_MASTER_RTU_ENABLED
 static volatile eMB_RTU_SendStateType eMB_RTU_SendState;
 static volatile eMB_RTU_RecvStateType eMB_RTU_RecvState;
 
 static volatile uint8_t  eMB_RTU_SlaveAddr;
 
-static volatile uint8_t  eMB_RTU_SendBuf[eMB_PDU_SIZE_MAX];
+static volatile uint8_t  eMB_RTU_SendBuf[eMB_SDU_SIZE_MAX];
 static volatile uint8_t *eMB_RTU_SendBufPos;
 static volatile uint16_t eMB_RTU_SendLength;
 static volatile uint16_t eMB_RTU_SendCount;
@@ -65,6 +92,38 @@ static volatile uint8_t  eMB_RTU_RecvBuf[eMB_SDU_SIZE_MAX];
 static volatile uint16_t eMB_RTU_RecvLength;
 
 static volatile bool eMB_RTU_FrameIsBroadcast = false;
+
+#if (defined eMB_MASTER_RTT_ENABLED) || (defined eMB_MASTER_STATS_ENABLED)
+/* End of the request and first byte of its response, valid if eMB_RTU_RespondIsTimed */
+static volatile uint32_t eMB_RTU_SendDoneTime;
+static volatile uint32_t eMB_RTU_RespondTime;
+static volatile bool     eMB_RTU_RespondIsTimed;
+#endif
+#endif
+
+#ifdef eMB_SLAVE_RTU_ENABLED
+static volatile eMB_RTU_SendStateType eMB_RTU_SlaveSendState;
+static volatile eMB_RTU_RecvStateType eMB_RTU_SlaveRecvState;
+
+/* The reply is built in place of the request, so one buffer serves both directions. */
+static volatile uint8_t  eMB_RTU_SlaveBuf[eMB_SDU_SIZE_MAX];
+static volatile uint8_t *eMB_RTU_SlaveSendBufPos;
+static volatile uint16_t eMB_RTU_SlaveSendCount;
+static volatile uint16_t eMB_RTU_SlaveRecvLength;
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#ifdef eMB_RTU_T15_CHECK_ENABLED
+static bool eMB_RTU_CharGapIsValid(bool frameStart);
+#endif
+
+#ifdef eMB_MASTER_RTU_LENGTH_FRAMING_ENABLED
+static uint16_t eMB_RTU_GetResponseLength(const volatile uint8_t *frame, uint16_t length);
 #endif
 
 
@@ -73,6 +132,62 @@ static volatile bool eMB_RTU_FrameIsBroadcast = false;
 *                                   FUNCTIONS IMPLEMENTATIONS
 ===============================================================================================*/
 
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_SLAVE_RTU_ENABLED)
+eMB_ErrorCodeType eMB_RTU_SetBaudrate(uint32_t baudrate, uint8_t charBits)
+{
+  if ((baudrate == 0UL) || (charBits < (uint8_t)eMB_RTU_CHAR_BITS_MIN) || (charBits > (uint8_t)eMB_RTU_CHAR_BITS_MAX))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_PortEnterCriticalSection();
+
+  eMB_RTU_CharUs = eMB_RTU_CHAR_US(baudrate, charBits);
+  eMB_RTU_T15Us  = eMB_RTU_T15_US(baudrate, charBits);
+  eMB_RTU_T35Us  = eMB_RTU_T35_US(baudrate, charBits);
+
+  eMB_PortExitCriticalSection();
+
+  return eMB_ENOERR;
+}
+
+eMB_ErrorCodeType eMB_RTU_SetCharTimeouts(uint32_t t15Us, uint32_t t35Us)
+{
+  if ((t15Us == 0UL) || (t35Us < t15Us))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_PortEnterCriticalSection();
+
+  eMB_RTU_T15Us = t15Us;
+  eMB_RTU_T35Us = t35Us;
+
+  eMB_PortExitCriticalSection();
+
+  return eMB_ENOERR;
+}
+
+uint32_t eMB_RTU_GetCharTime(void)
+{
+  return eMB_RTU_CharUs;
+}
+
+uint32_t eMB_RTU_GetT15(void)
+{
+  return eMB_RTU_T15Us;
+}
+
+uint32_t eMB_RTU_GetT35(void)
+{
+  return eMB_RTU_T35Us;
+}
+#endif
+
+
+
+
+
 #ifdef eMB_MASTER_RTU_ENABLED
 eMB_ErrorCodeType eMB_Master_RTUInit(void)
 {
@@ -110,6 +225,13 @@ void eMB_Master_RTUStart(void)
   eMB_RTU_SendState = eMB_RTU_SEND_STATE_IDLE;
   eMB_RTU_RecvState = eMB_RTU_RECV_STATE_INIT;
 
+  /* No request of a previous start is on the line. */
+  eMB_RTU_FrameIsBroadcast = false;
+
+#ifdef eMB_RTU_BUS_ENABLED
+  eMB_Bus_Start();
+#endif
+
   eMB_gConfigPtr->pPortSerialSetMode(eMB_PORT_SERIAL_RX);
   eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
 
@@ -146,12 +268,29 @@ eMB_ErrorCodeType eMB_Master_RTUReceive(uint8_t *pucRcvAddress, uint8_t **pucFra
 
     /* Return the start of the Modbus PDU to the caller. */
     *pucFrame = (uint8_t *)&eMB_RTU_RecvBuf[eMB_SDU_FUNC_OFFSET];
+
+#if (defined eMB_MASTER_RTT_ENABLED) || (defined eMB_MASTER_STATS_ENABLED)
+    /* Only a valid response of the addressed slave is a round trip sample. */
+    if ((eMB_RTU_RespondIsTimed == true) && (*pucRcvAddress == eMB_RTU_SendBuf[eMB_SDU_ADDR_OFFSET]))
+    {
+#ifdef eMB_MASTER_RTT_ENABLED
+      eMB_Rtt_Sample(*pucRcvAddress, eMB_RTU_SendDoneTime, eMB_RTU_RespondTime);
+#endif
+#ifdef eMB_MASTER_STATS_ENABLED
+      eMB_Stats_Latency(*pucRcvAddress, (uint32_t)(eMB_RTU_RespondTime - eMB_RTU_SendDoneTime));
+#endif
+    }
+#endif
   }
   else
   {
     errStatus = eMB_EIO;
   }
 
+#if (defined eMB_MASTER_RTT_ENABLED) || (defined eMB_MASTER_STATS_ENABLED)
+  eMB_RTU_RespondIsTimed = false;
+#endif
+
   eMB_PortExitCriticalSection();
 
   return errStatus;
@@ -167,6 +306,16 @@ eMB_ErrorCodeType eMB_Master_RTUSend(uint8_t ucSlaveAddress, const uint8_t *pucF
 
   eMB_PortEnterCriticalSection();
 
+#ifdef eMB_MASTER_RTU_LENGTH_FRAMING_ENABLED
+  /* The response ended by its length was processed, stop waiting for t3.5. */
+  if (eMB_RTU_RecvState == eMB_RTU_RECV_STATE_DONE)
+  {
+    eMB_gConfigPtr->pPortTimersDisable();
+
+    eMB_RTU_RecvState = eMB_RTU_RECV_STATE_IDLE;
+  }
+#endif
+
   /* Check if the receiver is still in idle state. If not we where to
    * slow with processing the received frame and the master sent another
    * frame on the network. We have to abort sending the frame. */
@@ -227,6 +376,15 @@ bool eMB_Master_RTUFrameByteReceivedCallback(void)
       eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
       break;
     }
+#ifdef eMB_MASTER_RTU_LENGTH_FRAMING_ENABLED
+    /* The frame ended by its length is not processed yet. Bytes which follow
+     * it (a burst of a USB adapter) must not overwrite it, drop them until t3.5. */
+    case eMB_RTU_RECV_STATE_DONE:
+    {
+      eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
+      break;
+    }
+#endif
     /* In the idle state we wait for a new character. If a character
      * is received the t3.5 timers are started and the receiver
      * is in the state STATE_RX_RECEIVCE and disable early the timer
@@ -236,6 +394,20 @@ bool eMB_Master_RTUFrameByteReceivedCallback(void)
       /* In time of respond timeout, the receiver receive a frame.
        * Disable timer of respond timeout and change the transmiter state to idle. */
       eMB_gConfigPtr->pPortTimersDisable();
+
+#if (defined eMB_MASTER_RTT_ENABLED) || (defined eMB_MASTER_STATS_ENABLED)
+      eMB_RTU_RespondIsTimed = (eMB_RTU_SendState == eMB_RTU_SEND_STATE_DONE) ? true : false;
+      eMB_RTU_RespondTime = eMB_Util_GetTimeUs();
+#endif
+
+#ifdef eMB_MASTER_PHASE_ENABLED
+      eMB_Phase_Mark(eMB_PHASE_RX_FIRST);
+#endif
+
+#ifdef eMB_RTU_BUS_ENABLED
+      eMB_Bus_WaitEnd();
+#endif
+
       eMB_RTU_SendState = eMB_RTU_SEND_STATE_IDLE;
 
       eMB_RTU_RecvLength = 0;
@@ -243,6 +415,10 @@ bool eMB_Master_RTUFrameByteReceivedCallback(void)
 
       eMB_RTU_RecvState = eMB_RTU_RECV_STATE_RCV;
 
+#ifdef eMB_RTU_T15_CHECK_ENABLED
+      (void)eMB_RTU_CharGapIsValid(true);
+#endif
+
       /* Enable t3.5 timers. */
       eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
 
@@ -263,6 +439,44 @@ bool eMB_Master_RTUFrameByteReceivedCallback(void)
         eMB_RTU_RecvState = eMB_RTU_RECV_STATE_ERROR;
       }
 
+#ifdef eMB_RTU_T15_CHECK_ENABLED
+      /* A silence of more than t1.5 inside the frame damages it. */
+      if (eMB_RTU_CharGapIsValid(false) != true)
+      {
+        eMB_RTU_RecvState = eMB_RTU_RECV_STATE_ERROR;
+      }
+#endif
+
+#ifdef eMB_MASTER_RTU_LENGTH_FRAMING_ENABLED
+      /* The response is complete when it has the length predicted by its function
+       * code and byte count and its CRC is valid. Process it now instead of after t3.5. */
+      if ((eMB_RTU_RecvState == eMB_RTU_RECV_STATE_RCV) &&
+          (eMB_RTU_RecvLength == eMB_RTU_GetResponseLength(eMB_RTU_RecvBuf, eMB_RTU_RecvLength)) &&
+          (eMB_GetCRC((uint8_t *)eMB_RTU_RecvBuf, eMB_RTU_RecvLength) == 0U))
+      {
+        /* t3.5 still runs, it ends the dropping of later bytes. */
+        eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
+
+        eMB_RTU_RecvState = eMB_RTU_RECV_STATE_DONE;
+
+#ifdef eMB_MASTER_PHASE_ENABLED
+        eMB_Phase_Mark(eMB_PHASE_RX_END);
+#endif
+
+#ifdef eMB_RTU_BUS_ENABLED
+        eMB_Bus_Frame(eMB_RTU_RecvLength, false);
+#endif
+
+#ifdef eMB_MASTER_RTU_CAPTURE_ENABLED
+        eMB_Capture_Put(eMB_RTU_RecvBuf, eMB_RTU_RecvLength, 0U);
+#endif
+
+        eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_RECEIVED);
+
+        break;
+      }
+#endif
+
       /* Restart t3.5 timers. */
       eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
 
@@ -306,6 +520,20 @@ bool eMB_Master_RTUFrameTransmitterEmptyCallback(void)
 
         eMB_RTU_SendState = eMB_RTU_SEND_STATE_DONE;
 
+#ifdef eMB_MASTER_PHASE_ENABLED
+        eMB_Phase_Mark(eMB_PHASE_TX_DONE);
+#endif
+
+#ifdef eMB_RTU_BUS_ENABLED
+        eMB_Bus_Frame((uint16_t)(eMB_RTU_SendBufPos - eMB_RTU_SendBuf), true);
+        eMB_Bus_WaitBegin();
+#endif
+
+#ifdef eMB_MASTER_RTU_CAPTURE_ENABLED
+        eMB_Capture_Put(eMB_RTU_SendBuf, (uint16_t)(eMB_RTU_SendBufPos - eMB_RTU_SendBuf),
+                        (uint8_t)eMB_CAPTURE_FLAG_SENT);
+#endif
+
         /* If the frame is broadcast, master will enable timer of convert delay,
          * else master will enable timer of respond timeout. */
         if (eMB_RTU_FrameIsBroadcast == true)
@@ -314,6 +542,9 @@ bool eMB_Master_RTUFrameTransmitterEmptyCallback(void)
         }
         else
         {
+#if (defined eMB_MASTER_RTT_ENABLED) || (defined eMB_MASTER_STATS_ENABLED)
+          eMB_RTU_SendDoneTime = eMB_Util_GetTimeUs();
+#endif
           eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_RESPOND_TIMEOUT);
         }
       }
@@ -341,6 +572,15 @@ bool eMB_Master_RTUTimerExpiredCallback(void)
      * a new frame was received. */
     case eMB_RTU_RECV_STATE_RCV:
     {
+#ifdef eMB_MASTER_PHASE_ENABLED
+      eMB_Phase_Mark(eMB_PHASE_RX_END);
+#endif
+#ifdef eMB_RTU_BUS_ENABLED
+      eMB_Bus_Frame(eMB_RTU_RecvLength, false);
+#endif
+#ifdef eMB_MASTER_RTU_CAPTURE_ENABLED
+      eMB_Capture_Put(eMB_RTU_RecvBuf, eMB_RTU_RecvLength, 0U);
+#endif
       eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_RECEIVED);
 
       break;
@@ -348,11 +588,26 @@ bool eMB_Master_RTUTimerExpiredCallback(void)
     /* An error occured while receiving the frame. */
     case eMB_RTU_RECV_STATE_ERROR:
     {
+#ifdef eMB_RTU_BUS_ENABLED
+      eMB_Bus_Frame(eMB_RTU_RecvLength, false);
+#endif
+#ifdef eMB_MASTER_RTU_CAPTURE_ENABLED
+      /* The frame overflowed the buffer or had a silence of more than t1.5. */
+      eMB_Capture_Put(eMB_RTU_RecvBuf, eMB_RTU_RecvLength,
+                      (eMB_RTU_RecvLength >= (uint16_t)eMB_SDU_SIZE_MAX) ? (uint8_t)eMB_CAPTURE_FLAG_TOO_LONG :
+                                                                          (uint8_t)eMB_CAPTURE_FLAG_GAP);
+#endif
       eMB_Util_SetErrorEvent(eMB_EV_ERROR_RECEIVE_DATA);
       eMB_gConfigPtr->pPortEventPost(eMB_EV_ERROR);
 
       break;
     }
+    /* The line is silent after a frame ended by its length, which was
+     * already notified. */
+    case eMB_RTU_RECV_STATE_DONE:
+    {
+      break;
+    }
     /* Function called in an illegal state. */
     default:
       break;
@@ -367,8 +622,15 @@ bool eMB_Master_RTUTimerExpiredCallback(void)
      * broadcast, then notify the listener process error. */
     case eMB_RTU_SEND_STATE_DONE:
     {
+#ifdef eMB_RTU_BUS_ENABLED
+      eMB_Bus_WaitEnd();
+#endif
+
       if (eMB_RTU_FrameIsBroadcast == false)
       {
+#ifdef eMB_MASTER_RTT_ENABLED
+        eMB_Rtt_Timeout(eMB_RTU_SendBuf[eMB_SDU_ADDR_OFFSET]);
+#endif
         eMB_Util_SetErrorEvent(eMB_EV_ERROR_RESPOND_TIMEOUT);
         eMB_gConfigPtr->pPortEventPost(eMB_EV_ERROR);
       }
@@ -432,6 +694,352 @@ bool eMB_Master_RTUIsBroadcast(void)
 {
   return eMB_RTU_FrameIsBroadcast;
 }
+
+void eMB_Master_RTUGetState(uint8_t *sendState, uint8_t *recvState)
+{
+  *sendState = (uint8_t)eMB_RTU_SendState;
+  *recvState = (uint8_t)eMB_RTU_RecvState;
+}
+#endif
+
+
+
+#ifdef eMB_SLAVE_RTU_ENABLED
+eMB_ErrorCodeType eMB_Slave_RTUInit(void)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+
+  eMB_PortEnterCriticalSection();
+
+  /* Initialize Modbus serial and timer. */
+  if ((eMB_gConfigPtr->pPortSerialInit() != true) || (eMB_gConfigPtr->pPortTimersInit() != true))
+  {
+    errStatus = eMB_EPORTERR;
+  }
+
+  eMB_PortExitCriticalSection();
+
+  return errStatus;
+}
+
+void eMB_Slave_RTUStart(void)
+{
+  eMB_PortEnterCriticalSection();
+
+  /* Wait t3.5 of silence before the first frame, see eMB_Master_RTUStart(). */
+  eMB_RTU_SlaveSendState = eMB_RTU_SEND_STATE_IDLE;
+  eMB_RTU_SlaveRecvState = eMB_RTU_RECV_STATE_INIT;
+
+#ifdef eMB_RTU_BUS_ENABLED
+  eMB_Bus_Start();
+#endif
+
+  eMB_gConfigPtr->pPortSerialSetMode(eMB_PORT_SERIAL_RX);
+  eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
+
+  eMB_PortExitCriticalSection();
+}
+
+void eMB_Slave_RTUStop(void)
+{
+  eMB_PortEnterCriticalSection();
+
+  eMB_gConfigPtr->pPortSerialSetMode(eMB_PORT_SERIAL_RX);
+  eMB_gConfigPtr->pPortTimersDisable();
+
+  eMB_PortExitCriticalSection();
+}
+
+eMB_ErrorCodeType eMB_Slave_RTUReceive(uint8_t *pucRcvAddress, uint8_t **pucFrame, uint16_t *pusLength)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+
+  eMB_PortEnterCriticalSection();
+
+  /* Length and CRC check */
+  if ((eMB_RTU_SlaveRecvLength >= eMB_SDU_SIZE_MIN) &&
+      (eMB_GetCRC((uint8_t *)eMB_RTU_SlaveBuf, eMB_RTU_SlaveRecvLength) == (uint16_t)0U))
+  {
+    *pucRcvAddress = eMB_RTU_SlaveBuf[eMB_SDU_ADDR_OFFSET];
+    *pusLength = (uint16_t)(eMB_RTU_SlaveRecvLength - eMB_SDU_FUNC_OFFSET - eMB_SDU_CRC_SIZE);
+    *pucFrame = (uint8_t *)&eMB_RTU_SlaveBuf[eMB_SDU_FUNC_OFFSET];
+  }
+  else
+  {
+    errStatus = eMB_EIO;
+  }
+
+  eMB_PortExitCriticalSection();
+
+  return errStatus;
+}
+
+eMB_ErrorCodeType eMB_Slave_RTUSend(uint8_t ucSlaveAddress, const uint8_t *pucFrame, uint16_t usLength)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint16_t          crcVal;
+
+  eMB_PortEnterCriticalSection();
+
+  /* The reply may only be sent while the bus is idle. If the receiver is not
+   * idle a new frame has started and the reply is dropped. */
+  if ((eMB_RTU_SlaveRecvState == eMB_RTU_RECV_STATE_IDLE) && (usLength <= (uint16_t)eMB_PDU_SIZE_MAX))
+  {
+    /* pucFrame is the PDU in eMB_RTU_SlaveBuf, the address goes in front of it. */
+    eMB_RTU_SlaveSendBufPos = (uint8_t *)pucFrame - 1U;
+    eMB_RTU_SlaveSendBufPos[eMB_SDU_ADDR_OFFSET] = ucSlaveAddress;
+    eMB_RTU_SlaveSendCount = (uint16_t)(1U + usLength);
+
+    /* Calculate CRC16 checksum for Modbus-Serial-Line-PDU. */
+    crcVal = eMB_GetCRC((uint8_t *)eMB_RTU_SlaveSendBufPos, eMB_RTU_SlaveSendCount);
+
+    eMB_RTU_SlaveSendBufPos[eMB_RTU_SlaveSendCount++] = (uint8_t)(crcVal & 0xFF);
+    eMB_RTU_SlaveSendBufPos[eMB_RTU_SlaveSendCount++] = (uint8_t)(crcVal >> 8U);
+
+    /* Activate the transmitter. */
+    eMB_RTU_SlaveSendState = eMB_RTU_SEND_STATE_XMIT;
+    eMB_gConfigPtr->pPortSerialSetMode(eMB_PORT_SERIAL_TX);
+  }
+  else
+  {
+    errStatus = eMB_EIO;
+  }
+
+  eMB_PortExitCriticalSection();
+
+  return errStatus;
+}
+
+
+
+
+
+bool eMB_Slave_RTUFrameByteReceivedCallback(void)
+{
+  uint8_t recvByte;
+
+  /* Always read the character. */
+  (void) eMB_gConfigPtr->pPortSerialGetByte(&recvByte);
+
+  switch (eMB_RTU_SlaveRecvState)
+  {
+    /* Wait until the damaged or the first partial frame is finished. */
+    case eMB_RTU_RECV_STATE_INIT:
+    case eMB_RTU_RECV_STATE_ERROR:
+    {
+      eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
+      break;
+    }
+    /* First character of a new frame. */
+    case eMB_RTU_RECV_STATE_IDLE:
+    {
+      eMB_RTU_SlaveRecvLength = 0;
+      eMB_RTU_SlaveBuf[eMB_RTU_SlaveRecvLength++] = recvByte;
+
+      eMB_RTU_SlaveRecvState = eMB_RTU_RECV_STATE_RCV;
+
+#ifdef eMB_RTU_T15_CHECK_ENABLED
+      (void)eMB_RTU_CharGapIsValid(true);
+#endif
+
+      eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
+      break;
+    }
+    /* Restart t3.5 after every character. Too long frames are dropped. */
+    case eMB_RTU_RECV_STATE_RCV:
+    {
+      if (eMB_RTU_SlaveRecvLength < eMB_SDU_SIZE_MAX)
+      {
+        eMB_RTU_SlaveBuf[eMB_RTU_SlaveRecvLength++] = recvByte;
+      }
+      else
+      {
+        eMB_RTU_SlaveRecvState = eMB_RTU_RECV_STATE_ERROR;
+      }
+
+#ifdef eMB_RTU_T15_CHECK_ENABLED
+      if (eMB_RTU_CharGapIsValid(false) != true)
+      {
+        eMB_RTU_SlaveRecvState = eMB_RTU_RECV_STATE_ERROR;
+      }
+#endif
+
+      eMB_gConfigPtr->pPortTimersEnable(eMB_PORT_TIMER_T35);
+      break;
+    }
+    default:
+      break;
+  }
+
+  return true;
+}
+
+bool eMB_Slave_RTUFrameTransmitterEmptyCallback(void)
+{
+  switch (eMB_RTU_SlaveSendState)
+  {
+    /* We should not get a transmitter event if the transmitter is in idle state.  */
+    case eMB_RTU_SEND_STATE_IDLE:
+    {
+      eMB_gConfigPtr->pPortSerialSetMode(eMB_PORT_SERIAL_RX);
+      break;
+    }
+    case eMB_RTU_SEND_STATE_XMIT:
+    {
+      if (eMB_RTU_SlaveSendCount != 0)
+      {
+        eMB_gConfigPtr->pPortSerialPutByte(*eMB_RTU_SlaveSendBufPos);
+
+        eMB_RTU_SlaveSendBufPos++;
+        eMB_RTU_SlaveSendCount--;
+      }
+      else
+      {
+        /* Reply sent, listen for the next request. */
+        eMB_gConfigPtr->pPortSerialSetMode(eMB_PORT_SERIAL_RX);
+
+        eMB_RTU_SlaveSendState = eMB_RTU_SEND_STATE_IDLE;
+
+#ifdef eMB_RTU_BUS_ENABLED
+        eMB_Bus_Frame((uint16_t)(eMB_RTU_SlaveSendBufPos - eMB_RTU_SlaveBuf), true);
+#endif
+
+        (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_SENT);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  return true;
+}
+
+bool eMB_Slave_RTUTimerExpiredCallback(void)
+{
+  switch (eMB_RTU_SlaveRecvState)
+  {
+    /* Timer t35 expired. Startup phase is finished. */
+    case eMB_RTU_RECV_STATE_INIT:
+    {
+      (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_READY);
+      break;
+    }
+    /* A frame was received and t35 expired. */
+    case eMB_RTU_RECV_STATE_RCV:
+    {
+#ifdef eMB_RTU_BUS_ENABLED
+      eMB_Bus_Frame(eMB_RTU_SlaveRecvLength, false);
+#endif
+      (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_RECEIVED);
+      break;
+    }
+    /* A damaged frame is dropped silently. */
+    case eMB_RTU_RECV_STATE_ERROR:
+    {
+#ifdef eMB_RTU_BUS_ENABLED
+      eMB_Bus_Frame(eMB_RTU_SlaveRecvLength, false);
+#endif
+      break;
+    }
+    default:
+      break;
+  }
+
+  eMB_RTU_SlaveRecvState = eMB_RTU_RECV_STATE_IDLE;
+
+  eMB_gConfigPtr->pPortTimersDisable();
+
+  return true;
+}
+#endif
+
+
+
+
+
+#ifdef eMB_MASTER_RTU_LENGTH_FRAMING_ENABLED
+/* Length of a response including address and CRC, predicted from the first bytes.
+ * 0 if it is not known yet or the function code has no predictable length. */
+static uint16_t eMB_RTU_GetResponseLength(const volatile uint8_t *frame, uint16_t length)
+{
+  uint16_t respLength = (uint16_t)0U;
+
+  if (length > (uint16_t)eMB_SDU_FUNC_OFFSET)
+  {
+    if ((frame[eMB_SDU_FUNC_OFFSET] & (uint8_t)eMB_FUNC_ERROR) != 0U)
+    {
+      /* Address, function, exception code and CRC */
+      respLength = (uint16_t)5U;
+    }
+    else
+    {
+      switch (frame[eMB_SDU_FUNC_OFFSET])
+      {
+        case eMB_FUNC_READ_COILS:
+        case eMB_FUNC_READ_DISCRETE_INPUTS:
+        case eMB_FUNC_READ_HOLDING_REGISTER:
+        case eMB_FUNC_READ_INPUT_REGISTER:
+        case eMB_FUNC_READWRITE_MULTIPLE_REGISTERS:
+        case eMB_FUNC_DIAG_GET_COM_EVENT_LOG:
+        case eMB_FUNC_OTHER_REPORT_SLAVEID:
+        {
+          /* Address, function, byte count, data and CRC */
+          if (length > (uint16_t)(eMB_SDU_FUNC_OFFSET + 1))
+          {
+            respLength = (uint16_t)5U + (uint16_t)frame[eMB_SDU_FUNC_OFFSET + 1];
+          }
+          break;
+        }
+        case eMB_FUNC_WRITE_SINGLE_COIL:
+        case eMB_FUNC_WRITE_MULTIPLE_COILS:
+        case eMB_FUNC_WRITE_REGISTER:
+        case eMB_FUNC_WRITE_MULTIPLE_REGISTERS:
+        case eMB_FUNC_DIAG_GET_COM_EVENT_CNT:
+        {
+          /* Address, function, two 16 bit fields and CRC */
+          respLength = (uint16_t)8U;
+          break;
+        }
+        case eMB_FUNC_DIAG_READ_EXCEPTION:
+        {
+          /* Address, function, status and CRC */
+          respLength = (uint16_t)5U;
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+
+  return respLength;
+}
+#endif
+
+#ifdef eMB_RTU_T15_CHECK_ENABLED
+/* Check the silence before a received character. The character interrupt comes at
+ * the end of a character, so two interrupts are one character time plus the silence
+ * apart. Without a microsecond clock the silence can't be measured. */
+static bool eMB_RTU_CharGapIsValid(bool frameStart)
+{
+  uint32_t now;
+  bool isValid = true;
+
+  if (eMB_gConfigPtr->pPortTimeGetUs != NULL)
+  {
+    now = eMB_gConfigPtr->pPortTimeGetUs();
+
+    if ((frameStart != true) && ((uint32_t)(now - eMB_RTU_LastCharTime) > (eMB_RTU_CharUs + eMB_RTU_T15Us)))
+    {
+      isValid = false;
+    }
+
+    eMB_RTU_LastCharTime = now;
+  }
+
+  return isValid;
+}
 #endif
 
 
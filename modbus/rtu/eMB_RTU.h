@@ -30,6 +30,9 @@ extern "C" {
 *                                       DEFINES AND MACROS
 ===============================================================================================*/
 
+/* Limits of the bits per character (start, data, parity and stop bits) */
+#define eMB_RTU_CHAR_BITS_MIN                     (  7 )
+#define eMB_RTU_CHAR_BITS_MAX                     ( 12 )
 
 
 
@@ -37,6 +40,34 @@ extern "C" {
 *                                   FUNCTION PROTOTYPES
 ===============================================================================================*/
 
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_SLAVE_RTU_ENABLED)
+/*! \ingroup modbus
+ * \brief Derive T1.5 and T3.5 from the serial line settings.
+ *
+ * T1.5 and T3.5 are 1.5 and 3.5 character times, above 19200 baud they are
+ * fixed at 750us and 1750us. Call it when the baud rate of the port changes,
+ * while the line is idle.
+ *
+ * \param baudrate baud rate of the serial line
+ * \param charBits bits per character including start, parity and stop bits
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if a parameter is invalid.
+ */
+eMB_ErrorCodeType   eMB_RTU_SetBaudrate(uint32_t baudrate, uint8_t charBits);
+
+/*! \ingroup modbus
+ * \brief Set T1.5 and T3.5 in microseconds, e.g. for a line with a larger latency.
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if t15Us is 0 or larger than t35Us.
+ */
+eMB_ErrorCodeType   eMB_RTU_SetCharTimeouts(uint32_t t15Us, uint32_t t35Us);
+
+/* Character time, T1.5 and T3.5 in microseconds, the port starts eMB_PORT_TIMER_T35 with T3.5. */
+uint32_t            eMB_RTU_GetCharTime(void);
+uint32_t            eMB_RTU_GetT15(void);
+uint32_t            eMB_RTU_GetT35(void);
+#endif
+
 #ifdef eMB_SLAVE_RTU_ENABLED
 eMB_ErrorCodeType   eMB_Slave_RTUInit(void);
 void                eMB_Slave_RTUStart(void);
@@ -68,6 +99,9 @@ void                eMB_Master_RTUSetSendPduLength(uint16_t length);
 uint16_t            eMB_Master_RTUGetSendPduLength(void);
 
 bool                eMB_Master_RTUIsBroadcast(void);
+
+/* Send and receive state of the frame layer, for the trace. */
+void                eMB_Master_RTUGetState(uint8_t *sendState, uint8_t *recvState);
 #endif
 
 
@@ -41,6 +41,11 @@ static enum
   STATE_ENABLED,
 } eMB_gState = STATE_NOT_INITIALIZED;
 
+#ifdef eMB_GATEWAY_ENABLED
+/* Set by eMB_EV_READY: requests which were queued before are not sent during the startup phase. */
+static bool eMB_gIsLineReady;
+#endif
+
 /* Frame callout function pointer which are initialized in eMB_Init(). Depending on the
  * mode (RTU or ASCII) they are set to the correct implementations. */
 eMB_FrameStartCallout                             eMB_FrameStartCalloutArr;
@@ -57,9 +62,15 @@ eMB_FrameGetSendPduLengthCallout                  eMB_FrameGetSendPduLengthCallo
 
 eMB_FrameIsBroadcastCallout                       eMB_FrameIsBroadcastCalloutArr;
 
+eMB_FrameByteReceivedCallout                      eMB_FrameByteReceivedCalloutArr;
+eMB_FrameTransmitterEmptyCallout                  eMB_FrameTransmitterEmptyCalloutArr;
+eMB_FrameTimerExpiredCallout                      eMB_FrameTimerExpiredCalloutArr;
+
 
 
 extern eMB_ExceptionType eMB_FuncReportSlaveIDHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
 extern eMB_ExceptionType eMB_Master_FuncReadInputRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
 extern eMB_ExceptionType eMB_Master_FuncReadHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
 extern eMB_ExceptionType eMB_Master_FuncWriteMultipleHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
@@ -69,10 +80,24 @@ extern eMB_ExceptionType eMB_Master_FuncReadCoilsHandler(uint8_t *recvPduFrame,
 extern eMB_ExceptionType eMB_Master_FuncWriteSingleCoilHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
 extern eMB_ExceptionType eMB_Master_FuncWriteMultipleCoilsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
 extern eMB_ExceptionType eMB_Master_FuncReadDiscreteInputsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+#endif
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+extern eMB_ExceptionType eMB_Slave_FuncReadInputRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Slave_FuncReadHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Slave_FuncWriteMultipleHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Slave_FuncWriteHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Slave_FuncReadWriteMultipleHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Slave_FuncReadCoilsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Slave_FuncWriteSingleCoilHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Slave_FuncWriteMultipleCoilsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Slave_FuncReadDiscreteInputsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+#endif
 
-/* An array of Modbus functions handlers which associates Modbus function
- * codes with implementing functions. */
-static eMB_FuncCallbackStruct eMB_FuncHandlerCfg[eMB_FUNC_HANDLERS_MAX] = 
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/* Modbus functions handlers of the stack which are copied to eMB_FuncHandlerTable
+ * by eMB_Init(). */
+static const eMB_FuncCallbackStruct eMB_FuncHandlerCfg[] =
 {
 #ifdef eMB_FUNC_OTHER_REP_SLAVEID_ENABLED
   { eMB_FUNC_OTHER_REPORT_SLAVEID,                eMB_FuncReportSlaveIDHandler                                },
@@ -104,7 +129,50 @@ static eMB_FuncCallbackStruct eMB_FuncHandlerCfg[eMB_FUNC_HANDLERS_MAX] =
 #ifdef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
   { eMB_FUNC_READ_DISCRETE_INPUTS,                eMB_Master_FuncReadDiscreteInputsHandler                    },
 #endif
+  { eMB_FUNC_NONE,                                NULL                                                        }
+};
+#endif
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+/* Modbus functions handlers of the slave role. They build the reply in place of the request. */
+static const eMB_FuncCallbackStruct eMB_SlaveFuncHandlerCfg[] =
+{
+#ifdef eMB_FUNC_OTHER_REP_SLAVEID_ENABLED
+  { eMB_FUNC_OTHER_REPORT_SLAVEID,                eMB_FuncReportSlaveIDHandler                                },
+#endif
+#ifdef eMB_FUNC_READ_INPUT_ENABLED
+  { eMB_FUNC_READ_INPUT_REGISTER,                 eMB_Slave_FuncReadInputRegisterHandler                      },
+#endif
+#ifdef eMB_FUNC_READ_HOLDING_ENABLED
+  { eMB_FUNC_READ_HOLDING_REGISTER,               eMB_Slave_FuncReadHoldingRegisterHandler                    },
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_HOLDING_ENABLED
+  { eMB_FUNC_WRITE_MULTIPLE_REGISTERS,            eMB_Slave_FuncWriteMultipleHoldingRegisterHandler           },
+#endif
+#ifdef eMB_FUNC_WRITE_HOLDING_ENABLED
+  { eMB_FUNC_WRITE_REGISTER,                      eMB_Slave_FuncWriteHoldingRegisterHandler                   },
+#endif
+#ifdef eMB_FUNC_READWRITE_HOLDING_ENABLED
+  { eMB_FUNC_READWRITE_MULTIPLE_REGISTERS,        eMB_Slave_FuncReadWriteMultipleHoldingRegisterHandler       },
+#endif
+#ifdef eMB_FUNC_READ_COILS_ENABLED
+  { eMB_FUNC_READ_COILS,                          eMB_Slave_FuncReadCoilsHandler                              },
+#endif
+#ifdef eMB_FUNC_WRITE_COIL_ENABLED
+  { eMB_FUNC_WRITE_SINGLE_COIL,                   eMB_Slave_FuncWriteSingleCoilHandler                        },
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_COILS_ENABLED
+  { eMB_FUNC_WRITE_MULTIPLE_COILS,                eMB_Slave_FuncWriteMultipleCoilsHandler                     },
+#endif
+#ifdef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
+  { eMB_FUNC_READ_DISCRETE_INPUTS,                eMB_Slave_FuncReadDiscreteInputsHandler                     },
+#endif
+  { eMB_FUNC_NONE,                                NULL                                                        }
 };
+#endif
+
+/* Modbus functions handlers indexed by function code, NULL if not supported. */
+static eMB_FuncCallback eMB_FuncHandlerTable[eMB_FUNC_CODE_MAX + 1];
 
 
 
@@ -113,6 +181,20 @@ eMB_ConfigStruct *eMB_gConfigPtr;
 
 
 
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+static void eMB_Master_MainFunction(void);
+#endif
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+static void eMB_Slave_MainFunction(void);
+#endif
+
+
+
 /*===============================================================================================
 *                                   FUNCTIONS IMPLEMENTATIONS
 ===============================================================================================*/
@@ -120,6 +202,8 @@ eMB_ConfigStruct *eMB_gConfigPtr;
 eMB_ErrorCodeType eMB_Init(const eMB_ConfigStruct *config)
 {
   eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  const eMB_FuncCallbackStruct *pFuncHandlerCfg = NULL;
+  uint8_t funcCodeHdlrIdx;
 
   if (config == NULL)
   {
@@ -129,26 +213,84 @@ eMB_ErrorCodeType eMB_Init(const eMB_ConfigStruct *config)
   {
     eMB_gConfigPtr = (eMB_ConfigStruct *)config;
 
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+    if (eMB_gConfigPtr->role == eMB_ROLE_MASTER)
+    {
+      pFuncHandlerCfg = eMB_FuncHandlerCfg;
+    }
+#endif
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+    if (eMB_gConfigPtr->role == eMB_ROLE_SLAVE)
+    {
+      pFuncHandlerCfg = eMB_SlaveFuncHandlerCfg;
+    }
+#endif
+
+    memset(eMB_FuncHandlerTable, 0, sizeof(eMB_FuncHandlerTable));
+
+    /* The frame callouts below reject a role which is not enabled. */
+    for (funcCodeHdlrIdx = (uint8_t)0U;
+         (pFuncHandlerCfg != NULL) && (pFuncHandlerCfg[funcCodeHdlrIdx].funcCode != eMB_FUNC_NONE);
+         funcCodeHdlrIdx++)
+    {
+      eMB_FuncHandlerTable[pFuncHandlerCfg[funcCodeHdlrIdx].funcCode] = pFuncHandlerCfg[funcCodeHdlrIdx].pFuncCbk;
+    }
+
     switch (eMB_gConfigPtr->comm)
     {
-#ifdef eMB_MASTER_RTU_ENABLED
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_SLAVE_RTU_ENABLED)
       case eMB_COMM_RTU:
       {
-        eMB_FrameStartCalloutArr                  = eMB_Master_RTUStart;
-        eMB_FrameStopCalloutArr                   = eMB_Master_RTUStop;
-        eMB_FrameSendCalloutArr                   = eMB_Master_RTUSend;
-        eMB_FrameReceiveCalloutArr                = eMB_Master_RTUReceive;
+        if (eMB_gConfigPtr->role == eMB_ROLE_SLAVE)
+        {
+#ifdef eMB_SLAVE_RTU_ENABLED
+          eMB_FrameStartCalloutArr                = eMB_Slave_RTUStart;
+          eMB_FrameStopCalloutArr                 = eMB_Slave_RTUStop;
+          eMB_FrameSendCalloutArr                 = eMB_Slave_RTUSend;
+          eMB_FrameReceiveCalloutArr              = eMB_Slave_RTUReceive;
 
-        eMB_FrameGetSlaveAddressCalloutArr        = eMB_Master_RTUGetSlaveAddress;
-        eMB_FrameSetSlaveAddressCalloutArr        = eMB_Master_RTUSetSlaveAddress;
+          eMB_FrameByteReceivedCalloutArr         = eMB_Slave_RTUFrameByteReceivedCallback;
+          eMB_FrameTransmitterEmptyCalloutArr     = eMB_Slave_RTUFrameTransmitterEmptyCallback;
+          eMB_FrameTimerExpiredCalloutArr         = eMB_Slave_RTUTimerExpiredCallback;
 
-        eMB_FrameGetSendPduBufferCalloutArr       = eMB_Master_RTUGetSendPduBuffer;
-        eMB_FrameSetSendPduLengthCalloutArr       = eMB_Master_RTUSetSendPduLength;
-        eMB_FrameGetSendPduLengthCalloutArr       = eMB_Master_RTUGetSendPduLength;
+          if ((eMB_gConfigPtr->slaveAddr < eMB_ADDRESS_MIN) || (eMB_gConfigPtr->slaveAddr > eMB_ADDRESS_MAX))
+          {
+            errStatus = eMB_EINVAL;
+          }
+          else
+          {
+            errStatus = eMB_Slave_RTUInit();
+          }
+#else
+          errStatus = eMB_EINVAL;
+#endif
+        }
+        else
+        {
+#ifdef eMB_MASTER_RTU_ENABLED
+          eMB_FrameStartCalloutArr                = eMB_Master_RTUStart;
+          eMB_FrameStopCalloutArr                 = eMB_Master_RTUStop;
+          eMB_FrameSendCalloutArr                 = eMB_Master_RTUSend;
+          eMB_FrameReceiveCalloutArr              = eMB_Master_RTUReceive;
 
-        eMB_FrameIsBroadcastCalloutArr            = eMB_Master_RTUIsBroadcast;
-        
-        errStatus = eMB_Master_RTUInit();
+          eMB_FrameGetSlaveAddressCalloutArr      = eMB_Master_RTUGetSlaveAddress;
+          eMB_FrameSetSlaveAddressCalloutArr      = eMB_Master_RTUSetSlaveAddress;
+
+          eMB_FrameGetSendPduBufferCalloutArr     = eMB_Master_RTUGetSendPduBuffer;
+          eMB_FrameSetSendPduLengthCalloutArr     = eMB_Master_RTUSetSendPduLength;
+          eMB_FrameGetSendPduLengthCalloutArr     = eMB_Master_RTUGetSendPduLength;
+
+          eMB_FrameIsBroadcastCalloutArr          = eMB_Master_RTUIsBroadcast;
+
+          eMB_FrameByteReceivedCalloutArr         = eMB_Master_RTUFrameByteReceivedCallback;
+          eMB_FrameTransmitterEmptyCalloutArr     = eMB_Master_RTUFrameTransmitterEmptyCallback;
+          eMB_FrameTimerExpiredCalloutArr         = eMB_Master_RTUTimerExpiredCallback;
+
+          errStatus = eMB_Master_RTUInit();
+#else
+          errStatus = eMB_EINVAL;
+#endif
+        }
 
         break;
       }
@@ -183,6 +325,20 @@ eMB_ErrorCodeType eMB_Init(const eMB_ConfigStruct *config)
       }
     }
 
+#ifdef eMB_MASTER_TRACE_ENABLED
+    if ((errStatus == eMB_ENOERR) && (eMB_gConfigPtr->role == eMB_ROLE_MASTER))
+    {
+      eMB_Trace_Install();
+    }
+#endif
+
+#ifdef eMB_GATEWAY_ENABLED
+    if ((errStatus == eMB_ENOERR) && (eMB_gConfigPtr->role == eMB_ROLE_MASTER))
+    {
+      eMB_Gateway_Init();
+    }
+#endif
+
     if (errStatus == eMB_ENOERR)
     {
       if (eMB_gConfigPtr->pPortEventInit() == false)
@@ -209,6 +365,10 @@ eMB_ErrorCodeType eMB_Enable(void)
 
   if (eMB_gState == STATE_DISABLED)
   {
+#ifdef eMB_GATEWAY_ENABLED
+    eMB_gIsLineReady = false;
+#endif
+
     /* Activate the protocol stack. */
     eMB_FrameStartCalloutArr();
 
@@ -245,7 +405,56 @@ eMB_ErrorCodeType eMB_Disable(void)
   return errStatus;
 }
 
+eMB_ErrorCodeType eMB_RegisterFunctionHandler(uint8_t funcCode, eMB_FuncCallback pFuncCbk)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+
+  if ((funcCode == (uint8_t)eMB_FUNC_NONE) || (funcCode > (uint8_t)eMB_FUNC_CODE_MAX))
+  {
+    errStatus = eMB_EINVAL;
+  }
+  else if (eMB_gConfigPtr == NULL)
+  {
+    /* eMB_Init() would overwrite the handler. */
+    errStatus = eMB_EILLSTATE;
+  }
+  else
+  {
+    eMB_FuncHandlerTable[funcCode] = pFuncCbk;
+  }
+
+  return errStatus;
+}
+
 void eMB_MainFunction(void)
+{
+  /* Check if the protocol stack is ready. */
+  if (eMB_gState != STATE_ENABLED)
+  {
+    return;
+  }
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+  if (eMB_gConfigPtr->role == eMB_ROLE_SLAVE)
+  {
+    eMB_Slave_MainFunction();
+
+    return;
+  }
+#endif
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+  eMB_Master_MainFunction();
+#endif
+}
+
+
+
+
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/* Main function of the master role. */
+static void eMB_Master_MainFunction(void)
 {
   static uint8_t   *pduFrame;
   static uint8_t    slaveAddr;
@@ -253,16 +462,24 @@ void eMB_MainFunction(void)
   static uint16_t   pduLength;
   static eMB_ExceptionType exptStatus;
 
-  uint8_t           funcCodeHdlrIdx , j;
+  uint8_t           j;
+  eMB_FuncCallback  pFuncCbk;
   eMB_ErrorCodeType errStatus = eMB_ENOERR;
   eMB_EventType     eEvent;
   eMB_ErrorEventType errorType;
 
-  /* Check if the protocol stack is ready. */
-  if (eMB_gState != STATE_ENABLED)
+#ifdef eMB_GATEWAY_ENABLED
+  /* Forward a queued request of a TCP client if the line is free. */
+  if (eMB_gIsLineReady == true)
   {
-    return;
+    eMB_Gateway_Dispatch();
   }
+#endif
+
+#ifdef eMB_MASTER_RETRY_ENABLED
+  /* Send a failed request again if it is due and the line is free. */
+  eMB_Retry_Dispatch();
+#endif
 
   /* Check if there is a event available. If not return control to caller.
     * Otherwise we will handle the event. */
@@ -272,6 +489,9 @@ void eMB_MainFunction(void)
     {
       case eMB_EV_READY:
       {
+#ifdef eMB_GATEWAY_ENABLED
+        eMB_gIsLineReady = true;
+#endif
         break;
       }
       case eMB_EV_FRAME_RECEIVED:
@@ -281,6 +501,10 @@ void eMB_MainFunction(void)
         /* Check if the frame is for us. If not, send an error process event. */
         if ((errStatus == eMB_ENOERR) && (slaveAddr == eMB_FrameGetSlaveAddressCalloutArr()))
         {
+#ifdef eMB_MASTER_HEALTH_ENABLED
+          /* Also an exception response shows the slave is alive. */
+          eMB_Health_Answer(slaveAddr);
+#endif
           (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_EXECUTE);
         }
         else
@@ -293,9 +517,18 @@ void eMB_MainFunction(void)
       }
       case eMB_EV_EXECUTE:
       {
+#ifdef eMB_GATEWAY_ENABLED
+        /* The response goes back to the client unchanged, the handlers below still see it. */
+        eMB_Gateway_Complete(pduFrame, pduLength);
+#endif
+
         funcCode = pduFrame[eMB_PDU_FUNC_OFFSET];
         exptStatus = eMB_EX_ILLEGAL_FUNCTION;
 
+#ifdef eMB_MASTER_STATS_ENABLED
+        eMB_Stats_Response(((uint8_t)0U != (funcCode >> 7U)) ? true : false);
+#endif
+
         /* If receive frame has exception. The receive function code highest bit is 1. */
         if ((uint8_t)0U != (funcCode >> 7U))
         {
@@ -303,41 +536,48 @@ void eMB_MainFunction(void)
         }
         else
         {
-          for (funcCodeHdlrIdx = (uint8_t)0U; funcCodeHdlrIdx < eMB_FUNC_HANDLERS_MAX; funcCodeHdlrIdx++)
+          pFuncCbk = eMB_FuncHandlerTable[funcCode];
+
+          if (pFuncCbk != NULL)
           {
-            /* No more function handlers registered. Abort. */
-            if (eMB_FuncHandlerCfg[funcCodeHdlrIdx].funcCode == funcCode)
+            /* If master request is broadcast,
+              * the master need execute function for all slave. */
+            if (eMB_FrameIsBroadcastCalloutArr())
             {
-              /* If master request is broadcast,
-                * the master need execute function for all slave. */
-              if (eMB_FrameIsBroadcastCalloutArr())
-              {
-                pduLength = eMB_FrameGetSendPduLengthCalloutArr();
+              pduLength = eMB_FrameGetSendPduLengthCalloutArr();
 
-                for (j = 1; j <= eMB_MASTER_TOTAL_SLAVE_NUM; j++)
-                {
-                  eMB_FrameSetSlaveAddressCalloutArr(j);
-                  exptStatus = eMB_FuncHandlerCfg[funcCodeHdlrIdx].pFuncCbk(pduFrame, &pduLength);
-                }
-              }
-              else
+              for (j = 1; j <= eMB_MASTER_TOTAL_SLAVE_NUM; j++)
               {
-                exptStatus = eMB_FuncHandlerCfg[funcCodeHdlrIdx].pFuncCbk(pduFrame, &pduLength);
+                eMB_FrameSetSlaveAddressCalloutArr(j);
+#ifdef eMB_MASTER_TRACE_ENABLED
+                eMB_Trace_Put(eMB_TRACE_HANDLER_BEGIN, funcCode);
+#endif
+                exptStatus = pFuncCbk(pduFrame, &pduLength);
+#ifdef eMB_MASTER_TRACE_ENABLED
+                eMB_Trace_Put(eMB_TRACE_HANDLER_END, funcCode);
+#endif
               }
-
-              break;
-            }
-            else if (eMB_FuncHandlerCfg[funcCodeHdlrIdx].funcCode == (uint8_t)0U)
-            {
-              break;
             }
             else
             {
-              /* Do nothing. Continue looping */
+#ifdef eMB_MASTER_TRACE_ENABLED
+              eMB_Trace_Put(eMB_TRACE_HANDLER_BEGIN, funcCode);
+#endif
+              exptStatus = pFuncCbk(pduFrame, &pduLength);
+#ifdef eMB_MASTER_TRACE_ENABLED
+              eMB_Trace_Put(eMB_TRACE_HANDLER_END, funcCode);
+#endif
             }
           }
         }
 
+#ifdef eMB_MASTER_PHASE_ENABLED
+        eMB_Phase_End(eMB_ENOERR, exptStatus);
+#endif
+
+        /* Requests which joined the read got their registers updated (or not, on an exception). */
+        eMB_Util_ClearPendingRead();
+
         /* If master has exception, Master will send error process. Otherwise the Master is idle.*/
         if (exptStatus != eMB_EX_NONE)
         {
@@ -346,6 +586,9 @@ void eMB_MainFunction(void)
         }
         else
         {
+#ifdef eMB_MASTER_RETRY_ENABLED
+          eMB_Retry_Done();
+#endif
           eMB_gConfigPtr->pPortResourceRelease();
         }
 
@@ -355,6 +598,15 @@ void eMB_MainFunction(void)
       {
         /* Master is busy now. */
         eMB_FrameGetSendPduBufferCalloutArr(&pduFrame);
+
+#ifdef eMB_MASTER_STATS_ENABLED
+        eMB_Stats_Request(eMB_FrameGetSlaveAddressCalloutArr(), pduFrame[eMB_PDU_FUNC_OFFSET]);
+#endif
+
+#ifdef eMB_MASTER_PHASE_ENABLED
+        eMB_Phase_Sent(eMB_FrameGetSlaveAddressCalloutArr(), pduFrame[eMB_PDU_FUNC_OFFSET]);
+#endif
+
         errStatus = eMB_FrameSendCalloutArr(eMB_FrameGetSlaveAddressCalloutArr(), pduFrame, eMB_FrameGetSendPduLengthCalloutArr());
         
         break;
@@ -364,6 +616,36 @@ void eMB_MainFunction(void)
         /* Execute specified error process callback function. */
         errorType = eMB_Util_GetErrorEvent();
 
+#ifdef eMB_MASTER_STATS_ENABLED
+        eMB_Stats_Error(errorType);
+#endif
+
+#ifdef eMB_MASTER_PHASE_ENABLED
+        /* Transactions with an exception were completed by eMB_EV_EXECUTE. */
+        eMB_Phase_End((errorType == eMB_EV_ERROR_RESPOND_TIMEOUT) ? eMB_ETIMEDOUT : eMB_EIO, eMB_EX_NONE);
+#endif
+
+#ifdef eMB_MASTER_HEALTH_ENABLED
+        if (errorType == eMB_EV_ERROR_RESPOND_TIMEOUT)
+        {
+          eMB_Health_Timeout(eMB_FrameGetSlaveAddressCalloutArr());
+        }
+#endif
+
+#ifdef eMB_MASTER_RETRY_ENABLED
+        /* Queue the request for a retry, it is still in the send buffer. Only a
+         * response with the exception bit carries the exception of the slave. */
+        eMB_Retry_Failed(errorType, ((errorType == eMB_EV_ERROR_EXECUTE_FUNCTION) &&
+                                     ((funcCode & (uint8_t)eMB_FUNC_ERROR) != 0U)) ? exptStatus : eMB_EX_NONE);
+#endif
+
+#ifdef eMB_GATEWAY_ENABLED
+        /* No response of the slave. Does nothing if the response was already returned. */
+        eMB_Gateway_Complete(NULL, (uint16_t)0U);
+#endif
+
+        eMB_Util_ClearPendingRead();
+
         eMB_gConfigPtr->pPortResourceRelease();
 
         break;
@@ -373,7 +655,70 @@ void eMB_MainFunction(void)
     }
   }
 }
+#endif
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+/* Main function of the slave role. A request is executed as soon as it is
+ * received and the reply is built in the receive buffer, so the turnaround
+ * does not depend on another pass of the event loop. */
+static void eMB_Slave_MainFunction(void)
+{
+  uint8_t           *pduFrame;
+  uint8_t           recvAddr;
+  uint8_t           funcCode;
+  uint16_t          pduLength;
+  eMB_FuncCallback  pFuncCbk = NULL;
+  eMB_ExceptionType exptStatus;
+  eMB_EventType     eEvent;
 
+  if (eMB_gConfigPtr->pPortEventGet(&eEvent) == true)
+  {
+    switch (eEvent)
+    {
+      case eMB_EV_FRAME_RECEIVED:
+      {
+        /* Frames with CRC errors and frames for other slaves are ignored. */
+        if ((eMB_FrameReceiveCalloutArr(&recvAddr, &pduFrame, &pduLength) == eMB_ENOERR) &&
+            ((recvAddr == eMB_gConfigPtr->slaveAddr) || (recvAddr == (uint8_t)eMB_ADDRESS_BROADCAST)))
+        {
+          funcCode = pduFrame[eMB_PDU_FUNC_OFFSET];
+
+          if (funcCode <= (uint8_t)eMB_FUNC_CODE_MAX)
+          {
+            pFuncCbk = eMB_FuncHandlerTable[funcCode];
+          }
+
+          if (pFuncCbk != NULL)
+          {
+            exptStatus = pFuncCbk(pduFrame, &pduLength);
+          }
+          else
+          {
+            exptStatus = eMB_EX_ILLEGAL_FUNCTION;
+          }
+
+          /* Broadcast requests are never answered. */
+          if (recvAddr != (uint8_t)eMB_ADDRESS_BROADCAST)
+          {
+            if (exptStatus != eMB_EX_NONE)
+            {
+              pduLength = (uint16_t)0U;
+              pduFrame[pduLength++] = (uint8_t)(funcCode | eMB_FUNC_ERROR);
+              pduFrame[pduLength++] = (uint8_t)exptStatus;
+            }
+
+            (void)eMB_FrameSendCalloutArr(eMB_gConfigPtr->slaveAddr, pduFrame, pduLength);
+          }
+        }
+
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+#endif
 
 
 #ifdef __cplusplus
@@ -33,6 +33,7 @@ extern "C" {
 #define eMB_PDU_FUNC_READ_COILCNT_OFF             ( eMB_PDU_DATA_OFFSET + 0 )
 #define eMB_PDU_FUNC_READ_VALUES_OFF              ( eMB_PDU_DATA_OFFSET + 1 )
 #define eMB_PDU_FUNC_READ_SIZE_MIN                ( 1 )
+#define eMB_PDU_REQ_READ_COILCNT_MAX              ( 0x07D0 )
 
 #define eMB_PDU_REQ_WRITE_ADDR_OFF                ( eMB_PDU_DATA_OFFSET )
 #define eMB_PDU_REQ_WRITE_VALUE_OFF               ( eMB_PDU_DATA_OFFSET + 2 )
@@ -83,8 +84,20 @@ eMB_ErrorCodeType eMB_Master_RequestReadCoils
   {
     errStatus = eMB_EINVAL;
   }
+  /* An identical read is on the line, its response updates the same registers. */
+  else if (eMB_Util_JoinPendingRead(slaveAddr, eMB_FUNC_READ_COILS, coilAddr, coilNum) == true)
+  {
+    errStatus = eMB_ENOERR;
+  }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -106,6 +119,8 @@ eMB_ErrorCodeType eMB_Master_RequestReadCoils
     /* Set PDU buffer length */
     eMB_FrameSetSendPduLengthCalloutArr(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE);
 
+    eMB_Util_SetPendingRead(slaveAddr, eMB_FUNC_READ_COILS, coilAddr, coilNum);
+
     (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_SENT);
   }
 
@@ -160,7 +175,8 @@ eMB_ExceptionType eMB_Master_FuncReadCoilsHandler(uint8_t *recvPduFrame, uint16_
 
     /* Check if the number of registers to read is valid. If not
      * return Modbus illegal data value exception. */
-    if ((coilNum > (uint16_t)0U) && (byteCount == recvPduFrame[eMB_PDU_FUNC_READ_COILCNT_OFF]))
+    if ((coilNum > (uint16_t)0U) && (byteCount == recvPduFrame[eMB_PDU_FUNC_READ_COILCNT_OFF]) &&
+        (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + byteCount)))
     {
       /* Make callback to fill the buffer. */
       errStatus = eMB_Util_FuncCoilsCallback(coilAddr, coilNum, &recvPduFrame[eMB_PDU_FUNC_READ_VALUES_OFF]);
@@ -220,8 +236,15 @@ eMB_ErrorCodeType eMB_Master_RequestWriteSingleCoil
   {
     errStatus = eMB_EINVAL;
   }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -350,8 +373,15 @@ eMB_ErrorCodeType eMB_Master_RequestWriteMultipleCoils
   {
     errStatus = eMB_EINVAL;
   }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -430,7 +460,7 @@ eMB_ExceptionType eMB_Master_FuncWriteMultipleCoilsHandler(uint8_t *recvPduFrame
     coilNum  = (uint16_t)(recvPduFrame[eMB_PDU_FUNC_WRITE_MUL_COILCNT_OFF] << 8U);
     coilNum |= (uint16_t)(recvPduFrame[eMB_PDU_FUNC_WRITE_MUL_COILCNT_OFF + 1]  );
 
-    byteCount = pPduBuffer[eMB_PDU_REQ_WRITE_MUL_BYTECNT_OFF];
+    byteCountVerify = pPduBuffer[eMB_PDU_REQ_WRITE_MUL_BYTECNT_OFF];
 
     /* Compute the number of expected bytes in the request. */
     if ((coilNum & (uint16_t)0x0007U) != (uint16_t)0U)
@@ -469,6 +499,194 @@ eMB_ExceptionType eMB_Master_FuncWriteMultipleCoilsHandler(uint8_t *recvPduFrame
 
 #endif
 
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+#ifdef eMB_FUNC_READ_COILS_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle read coils request from master.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncReadCoilsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t coilAddr;
+  uint16_t coilNum;
+  uint8_t  byteCount;
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE))
+  {
+    coilAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_ADDR_OFF] << 8U);
+    coilAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_ADDR_OFF + 1]  );
+
+    coilNum  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_COILCNT_OFF] << 8U);
+    coilNum |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_COILCNT_OFF + 1]  );
+
+    if ((coilNum >= (uint16_t)1U) && (coilNum <= (uint16_t)eMB_PDU_REQ_READ_COILCNT_MAX))
+    {
+      byteCount = (uint8_t)((coilNum + 7U) / 8U);
+
+      /* Make callback to fill the buffer. */
+      errStatus = eMB_Util_SlaveFuncCoilsCallback(coilAddr, coilNum, &recvPduFrame[eMB_PDU_FUNC_READ_VALUES_OFF],
+                                                  eMB_REG_READ);
+
+      if (errStatus == eMB_ENOERR)
+      {
+        recvPduFrame[eMB_PDU_FUNC_READ_COILCNT_OFF] = byteCount;
+        *recvPduLength = (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + byteCount);
+      }
+      else
+      {
+        exptStatus = eMB_Util_ErrorToException(errStatus);
+      }
+    }
+    else
+    {
+      exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#ifdef eMB_FUNC_WRITE_COIL_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle write single coil request from master.
+ * The response is the echo of the request, so the frame is left as it is.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncWriteSingleCoilHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t coilAddr;
+  uint8_t  ucBuf[2];
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_WRITE_SIZE))
+  {
+    coilAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_ADDR_OFF] << 8U);
+    coilAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_ADDR_OFF + 1]  );
+
+    /* Coil value must be 0xFF00 (ON) or 0x0000 (OFF) */
+    if (
+        (recvPduFrame[eMB_PDU_REQ_WRITE_VALUE_OFF + 1] == 0x00) &&
+        (
+          (recvPduFrame[eMB_PDU_REQ_WRITE_VALUE_OFF] == 0xFF) ||
+          (recvPduFrame[eMB_PDU_REQ_WRITE_VALUE_OFF] == 0x00)
+        )
+       )
+    {
+      ucBuf[1] = 0;
+
+      if (recvPduFrame[eMB_PDU_REQ_WRITE_VALUE_OFF] == 0xFF)
+      {
+        ucBuf[0] = 1;
+      }
+      else
+      {
+        ucBuf[0] = 0;
+      }
+
+      errStatus = eMB_Util_SlaveFuncCoilsCallback(coilAddr, (uint16_t)1U, ucBuf, eMB_REG_WRITE);
+
+      /* If an error occurred convert it into a Modbus exception. */
+      if (errStatus != eMB_ENOERR)
+      {
+        exptStatus = eMB_Util_ErrorToException(errStatus);
+      }
+    }
+    else
+    {
+      exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#ifdef eMB_FUNC_WRITE_MULTIPLE_COILS_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle write multiple coils request from master.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncWriteMultipleCoilsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t coilAddr;
+  uint16_t coilNum;
+  uint8_t  byteCount;
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength >= (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_WRITE_MUL_SIZE_MIN))
+  {
+    coilAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_MUL_ADDR_OFF] << 8U);
+    coilAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_MUL_ADDR_OFF + 1]  );
+
+    coilNum  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_MUL_COILCNT_OFF] << 8U);
+    coilNum |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_MUL_COILCNT_OFF + 1]  );
+
+    byteCount = recvPduFrame[eMB_PDU_REQ_WRITE_MUL_BYTECNT_OFF];
+
+    if ((coilNum >= (uint16_t)1U) && (coilNum <= (uint16_t)eMB_PDU_REQ_WRITE_MUL_COILCNT_MAX) &&
+        (byteCount == (uint8_t)((coilNum + 7U) / 8U)) &&
+        (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_WRITE_MUL_SIZE_MIN + byteCount)))
+    {
+      errStatus = eMB_Util_SlaveFuncCoilsCallback(coilAddr, coilNum, &recvPduFrame[eMB_PDU_REQ_WRITE_MUL_VALUES_OFF],
+                                                  eMB_REG_WRITE);
+
+      if (errStatus == eMB_ENOERR)
+      {
+        /* The response is the request without byte count and values. */
+        *recvPduLength = (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_WRITE_MUL_SIZE_MIN - 1U);
+      }
+      else
+      {
+        exptStatus = eMB_Util_ErrorToException(errStatus);
+      }
+    }
+    else
+    {
+      exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,7 @@ extern "C" {
 #define eMB_PDU_FUNC_READ_DISCCNT_OFF             ( eMB_PDU_DATA_OFFSET + 0 )
 #define eMB_PDU_FUNC_READ_VALUES_OFF              ( eMB_PDU_DATA_OFFSET + 1 )
 #define eMB_PDU_FUNC_READ_SIZE_MIN                ( 1 )
+#define eMB_PDU_REQ_READ_DISCCNT_MAX              ( 0x07D0 )
 
 
 
@@ -66,8 +67,20 @@ eMB_ErrorCodeType eMB_Master_RequestReadDiscreteInputs
   {
     errStatus = eMB_EINVAL;
   }
+  /* An identical read is on the line, its response updates the same registers. */
+  else if (eMB_Util_JoinPendingRead(slaveAddr, eMB_FUNC_READ_DISCRETE_INPUTS, disInputAddr, disInputNum) == true)
+  {
+    errStatus = eMB_ENOERR;
+  }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -89,6 +102,8 @@ eMB_ErrorCodeType eMB_Master_RequestReadDiscreteInputs
     /* Set PDU buffer length */
     eMB_FrameSetSendPduLengthCalloutArr(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE);
 
+    eMB_Util_SetPendingRead(slaveAddr, eMB_FUNC_READ_DISCRETE_INPUTS, disInputAddr, disInputNum);
+
     (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_SENT);
   }
 
@@ -142,7 +157,8 @@ eMB_ExceptionType eMB_Master_FuncReadDiscreteInputsHandler(uint8_t *recvPduFrame
 
     /* Check if the number of registers to read is valid. If not
      * return Modbus illegal data value exception. */
-    if ((disInputNum > (uint16_t)0U) && (byteCount == recvPduFrame[eMB_PDU_FUNC_READ_DISCCNT_OFF]))
+    if ((disInputNum > (uint16_t)0U) && (byteCount == recvPduFrame[eMB_PDU_FUNC_READ_DISCCNT_OFF]) &&
+        (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + byteCount)))
     {
       /* Make callback to fill the buffer. */
       errStatus = eMB_Util_FuncDiscreteInputsCallback(disInputAddr, disInputNum, &recvPduFrame[eMB_PDU_FUNC_READ_VALUES_OFF]);
@@ -171,6 +187,68 @@ eMB_ExceptionType eMB_Master_FuncReadDiscreteInputsHandler(uint8_t *recvPduFrame
 
 #endif
 
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+#ifdef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle read discrete inputs request from master.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncReadDiscreteInputsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t disInputAddr;
+  uint16_t disInputNum;
+  uint8_t  byteCount;
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE))
+  {
+    disInputAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_ADDR_OFF] << 8U);
+    disInputAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_ADDR_OFF + 1]  );
+
+    disInputNum  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_DISCCNT_OFF] << 8U);
+    disInputNum |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_DISCCNT_OFF + 1]  );
+
+    if ((disInputNum >= (uint16_t)1U) && (disInputNum <= (uint16_t)eMB_PDU_REQ_READ_DISCCNT_MAX))
+    {
+      byteCount = (uint8_t)((disInputNum + 7U) / 8U);
+
+      /* Make callback to fill the buffer. */
+      errStatus = eMB_Util_SlaveFuncDiscreteInputsCallback(disInputAddr, disInputNum,
+                                                           &recvPduFrame[eMB_PDU_FUNC_READ_VALUES_OFF]);
+
+      if (errStatus == eMB_ENOERR)
+      {
+        recvPduFrame[eMB_PDU_FUNC_READ_DISCCNT_OFF] = byteCount;
+        *recvPduLength = (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + byteCount);
+      }
+      else
+      {
+        exptStatus = eMB_Util_ErrorToException(errStatus);
+      }
+    }
+    else
+    {
+      exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
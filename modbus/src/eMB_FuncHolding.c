@@ -62,6 +62,8 @@ extern "C" {
 #define eMB_PDU_FUNC_READWRITE_READ_BYTECNT_OFF   ( eMB_PDU_DATA_OFFSET + 0 )
 #define eMB_PDU_FUNC_READWRITE_READ_VALUES_OFF    ( eMB_PDU_DATA_OFFSET + 1 )
 #define eMB_PDU_FUNC_READWRITE_SIZE_MIN           ( 1 )
+#define eMB_PDU_REQ_READWRITE_READ_REGCNT_MAX     ( 0x007D )
+#define eMB_PDU_REQ_READWRITE_WRITE_REGCNT_MAX    ( 0x0079 )
 
 
 
@@ -95,8 +97,15 @@ eMB_ErrorCodeType eMB_Master_RequestWriteHoldingRegister
   {
     errStatus = eMB_EINVAL;
   }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -193,8 +202,20 @@ eMB_ErrorCodeType eMB_Master_RequestWriteMultipleHoldingRegister
   {
     errStatus = eMB_EINVAL;
   }
+  /* Check if number of write register data exceeds maximum number */
+  else if (holdingNum > eMB_PDU_REQ_WRITE_MUL_REGCNT_MAX)
+  {
+    errStatus = eMB_EINVAL;
+  }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -316,8 +337,20 @@ eMB_ErrorCodeType eMB_Master_RequestReadHoldingRegister
   {
     errStatus = eMB_EINVAL;
   }
+  /* An identical read is on the line, its response updates the same registers. */
+  else if (eMB_Util_JoinPendingRead(slaveAddr, eMB_FUNC_READ_HOLDING_REGISTER, holdingAddr, holdingNum) == true)
+  {
+    errStatus = eMB_ENOERR;
+  }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -339,6 +372,8 @@ eMB_ErrorCodeType eMB_Master_RequestReadHoldingRegister
     /* Set PDU buffer length */
     eMB_FrameSetSendPduLengthCalloutArr(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE);
 
+    eMB_Util_SetPendingRead(slaveAddr, eMB_FUNC_READ_HOLDING_REGISTER, holdingAddr, holdingNum);
+
     (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_SENT);
   }
 
@@ -380,7 +415,8 @@ eMB_ExceptionType eMB_Master_FuncReadHoldingRegisterHandler(uint8_t *recvPduFram
 
     /* Check if the number of registers to read is valid. If not
      * return Modbus illegal data value exception. */
-    if ((holdingNum > (uint16_t)0U) && ((uint8_t)(holdingNum * 2U) == recvPduFrame[eMB_PDU_FUNC_READ_BYTECNT_OFF]))
+    if ((holdingNum > (uint16_t)0U) && ((uint8_t)(holdingNum * 2U) == recvPduFrame[eMB_PDU_FUNC_READ_BYTECNT_OFF]) &&
+        (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + holdingNum * 2U)))
     {
       /* Make callback to fill the buffer. */
       errStatus = eMB_Util_FuncHoldingRegisterCallback(holdingAddr, holdingNum, &recvPduFrame[eMB_PDU_FUNC_READ_VALUES_OFF]);
@@ -439,8 +475,20 @@ eMB_ErrorCodeType eMB_Master_RequestReadWriteMultipleHoldingRegister
   {
     errStatus = eMB_EINVAL;
   }
+  /* Check if number of write register data exceeds maximum number */
+  else if (holdingWriteNum > eMB_PDU_REQ_READWRITE_WRITE_REGCNT_MAX)
+  {
+    errStatus = eMB_EINVAL;
+  }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -522,7 +570,8 @@ eMB_ExceptionType eMB_Master_FuncReadWriteMultipleHoldingRegisterHandler(uint8_t
     holdingWriteNum  = (uint16_t)(pPduBuffer[eMB_PDU_REQ_READWRITE_WRITE_REGCNT_OFF] << 8U);
     holdingWriteNum |= (uint16_t)(pPduBuffer[eMB_PDU_REQ_READWRITE_WRITE_REGCNT_OFF + 1]  );
 
-    if ((uint8_t)(holdingReadNum * 2U) == recvPduFrame[eMB_PDU_FUNC_READWRITE_READ_BYTECNT_OFF])
+    if (((uint8_t)(holdingReadNum * 2U) == recvPduFrame[eMB_PDU_FUNC_READWRITE_READ_BYTECNT_OFF]) &&
+        (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READWRITE_SIZE_MIN + holdingReadNum * 2U)))
     {
       /* Make callback to update the register values. */
       errStatus = eMB_Util_FuncHoldingRegisterCallback(holdingWriteAddr, holdingWriteNum,
@@ -557,6 +606,251 @@ eMB_ExceptionType eMB_Master_FuncReadWriteMultipleHoldingRegisterHandler(uint8_t
 
 #endif
 
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+#ifdef eMB_FUNC_WRITE_HOLDING_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle write holding register request from master.
+ * The response is the echo of the request, so the frame is left as it is.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncWriteHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t holdingAddr;
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_WRITE_SIZE))
+  {
+    holdingAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_ADDR_OFF] << 8U);
+    holdingAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_ADDR_OFF + 1]  );
+
+    /* Make callback to update the value. */
+    errStatus = eMB_Util_SlaveFuncHoldingRegisterCallback(holdingAddr, (uint16_t)1U,
+                                                          &recvPduFrame[eMB_PDU_REQ_WRITE_VALUE_OFF], eMB_REG_WRITE);
+
+    /* If an error occured convert it into a Modbus exception. */
+    if (errStatus != eMB_ENOERR)
+    {
+      exptStatus = eMB_Util_ErrorToException(errStatus);
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#ifdef eMB_FUNC_WRITE_MULTIPLE_HOLDING_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle write multiple holding register request from master.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncWriteMultipleHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t holdingAddr;
+  uint16_t holdingNum;
+  uint8_t  byteCount;
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength >= (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_WRITE_MUL_SIZE_MIN))
+  {
+    holdingAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_MUL_ADDR_OFF] << 8U);
+    holdingAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_MUL_ADDR_OFF + 1]  );
+
+    holdingNum  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_MUL_REGCNT_OFF] << 8U);
+    holdingNum |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_WRITE_MUL_REGCNT_OFF + 1]  );
+
+    byteCount = recvPduFrame[eMB_PDU_REQ_WRITE_MUL_BYTECNT_OFF];
+
+    if ((holdingNum >= (uint16_t)1U) && (holdingNum <= (uint16_t)eMB_PDU_REQ_WRITE_MUL_REGCNT_MAX) &&
+        (byteCount == (uint8_t)(holdingNum * 2U)) &&
+        (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_WRITE_MUL_SIZE_MIN + byteCount)))
+    {
+      /* Make callback to update the register values. */
+      errStatus = eMB_Util_SlaveFuncHoldingRegisterCallback(holdingAddr, holdingNum,
+                                                            &recvPduFrame[eMB_PDU_REQ_WRITE_MUL_VALUES_OFF], eMB_REG_WRITE);
+
+      if (errStatus == eMB_ENOERR)
+      {
+        /* The response is the request without byte count and values. */
+        *recvPduLength = (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_WRITE_MUL_SIZE);
+      }
+      else
+      {
+        exptStatus = eMB_Util_ErrorToException(errStatus);
+      }
+    }
+    else
+    {
+      exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#ifdef eMB_FUNC_READ_HOLDING_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle read holding register request from master.
+ * The register values are written directly into the frame.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncReadHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t holdingAddr;
+  uint16_t holdingNum;
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE))
+  {
+    holdingAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_ADDR_OFF] << 8U);
+    holdingAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_ADDR_OFF + 1]  );
+
+    holdingNum  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_REGCNT_OFF] << 8U);
+    holdingNum |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_REGCNT_OFF + 1]  );
+
+    /* Check if the number of registers to read is valid. If not
+     * return Modbus illegal data value exception. */
+    if ((holdingNum >= (uint16_t)1U) && (holdingNum <= (uint16_t)eMB_PDU_FUNC_READ_REGCNT_MAX))
+    {
+      /* Make callback to fill the buffer. */
+      errStatus = eMB_Util_SlaveFuncHoldingRegisterCallback(holdingAddr, holdingNum,
+                                                            &recvPduFrame[eMB_PDU_FUNC_READ_VALUES_OFF], eMB_REG_READ);
+
+      if (errStatus == eMB_ENOERR)
+      {
+        recvPduFrame[eMB_PDU_FUNC_READ_BYTECNT_OFF] = (uint8_t)(holdingNum * 2U);
+        *recvPduLength = (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + holdingNum * 2U);
+      }
+      else
+      {
+        exptStatus = eMB_Util_ErrorToException(errStatus);
+      }
+    }
+    else
+    {
+      exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#ifdef eMB_FUNC_READWRITE_HOLDING_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle read and write holding register request from master.
+ * The write is done first, then the read values overwrite the request.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncReadWriteMultipleHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t holdingReadAddr;
+  uint16_t holdingReadNum;
+  uint16_t holdingWriteAddr;
+  uint16_t holdingWriteNum;
+  uint8_t  byteCount;
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength >= (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READWRITE_SIZE_MIN))
+  {
+    holdingReadAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READWRITE_READ_ADDR_OFF] << 8U);
+    holdingReadAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READWRITE_READ_ADDR_OFF + 1]  );
+
+    holdingReadNum  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READWRITE_READ_REGCNT_OFF] << 8U);
+    holdingReadNum |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READWRITE_READ_REGCNT_OFF + 1]  );
+
+    holdingWriteAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READWRITE_WRITE_ADDR_OFF] << 8U);
+    holdingWriteAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READWRITE_WRITE_ADDR_OFF + 1]  );
+
+    holdingWriteNum  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READWRITE_WRITE_REGCNT_OFF] << 8U);
+    holdingWriteNum |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READWRITE_WRITE_REGCNT_OFF + 1]  );
+
+    byteCount = recvPduFrame[eMB_PDU_REQ_READWRITE_WRITE_BYTECNT_OFF];
+
+    if ((holdingReadNum >= (uint16_t)1U) && (holdingReadNum <= (uint16_t)eMB_PDU_REQ_READWRITE_READ_REGCNT_MAX) &&
+        (holdingWriteNum >= (uint16_t)1U) && (holdingWriteNum <= (uint16_t)eMB_PDU_REQ_READWRITE_WRITE_REGCNT_MAX) &&
+        (byteCount == (uint8_t)(holdingWriteNum * 2U)) &&
+        (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READWRITE_SIZE_MIN + byteCount)))
+    {
+      /* Make callback to update the register values. */
+      errStatus = eMB_Util_SlaveFuncHoldingRegisterCallback(holdingWriteAddr, holdingWriteNum,
+                                                            &recvPduFrame[eMB_PDU_REQ_READWRITE_WRITE_VALUES_OFF],
+                                                            eMB_REG_WRITE);
+
+      if (errStatus == eMB_ENOERR)
+      {
+        /* Make the read callback. */
+        errStatus = eMB_Util_SlaveFuncHoldingRegisterCallback(holdingReadAddr, holdingReadNum,
+                                                              &recvPduFrame[eMB_PDU_FUNC_READWRITE_READ_VALUES_OFF],
+                                                              eMB_REG_READ);
+      }
+
+      if (errStatus == eMB_ENOERR)
+      {
+        recvPduFrame[eMB_PDU_FUNC_READWRITE_READ_BYTECNT_OFF] = (uint8_t)(holdingReadNum * 2U);
+        *recvPduLength = (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READWRITE_SIZE_MIN + holdingReadNum * 2U);
+      }
+      else
+      {
+        exptStatus = eMB_Util_ErrorToException(errStatus);
+      }
+    }
+    else
+    {
+      exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,7 @@ extern "C" {
 #define eMB_PDU_FUNC_READ_SIZE_MIN                ( 1 )
 
 #define eMB_PDU_FUNC_READ_RSP_BYTECNT_OFF         ( eMB_PDU_DATA_OFFSET )
+#define eMB_PDU_FUNC_READ_REGCNT_MAX              ( 0x007D )
 
 
 
@@ -68,8 +69,20 @@ eMB_ErrorCodeType eMB_Master_RequestReadInputRegister
   {
     errStatus = eMB_EINVAL;
   }
+  /* An identical read is on the line, its response updates the same registers. */
+  else if (eMB_Util_JoinPendingRead(slaveAddr, eMB_FUNC_READ_INPUT_REGISTER, inputAddr, inputNum) == true)
+  {
+    errStatus = eMB_ENOERR;
+  }
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave is offline and its next probe is not due yet. */
+  else if (eMB_Health_IsAvailable(slaveAddr) == false)
+  {
+    errStatus = eMB_EOFFLINE;
+  }
+#endif
   /* Get resource control */
-  else if (eMB_gConfigPtr->pPortResourceTake() == false)
+  else if (eMB_Util_ResourceTake() == false)
   {
     errStatus = eMB_EBUSY;
   }
@@ -91,6 +104,8 @@ eMB_ErrorCodeType eMB_Master_RequestReadInputRegister
     /* Set PDU buffer length */
     eMB_FrameSetSendPduLengthCalloutArr(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE);
 
+    eMB_Util_SetPendingRead(slaveAddr, eMB_FUNC_READ_INPUT_REGISTER, inputAddr, inputNum);
+
     (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_SENT);
   }
 
@@ -132,7 +147,8 @@ eMB_ExceptionType eMB_Master_FuncReadInputRegisterHandler(uint8_t *recvPduFrame,
 
     /* Check if the number of registers to read is valid. If not
      * return Modbus illegal data value exception. */
-    if ((inputNum > (uint16_t)0U) && ((uint8_t)(inputNum * 2U) == recvPduFrame[eMB_PDU_FUNC_READ_BYTECNT_OFF]))
+    if ((inputNum > (uint16_t)0U) && ((uint8_t)(inputNum * 2U) == recvPduFrame[eMB_PDU_FUNC_READ_BYTECNT_OFF]) &&
+        (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + inputNum * 2U)))
     {
       /* Make callback to fill the buffer. */
       eRegStatus = eMB_Util_FuncInputRegisterCallback(inputAddr, inputNum, &recvPduFrame[eMB_PDU_FUNC_READ_VALUES_OFF]);
@@ -160,6 +176,67 @@ eMB_ExceptionType eMB_Master_FuncReadInputRegisterHandler(uint8_t *recvPduFrame,
 
 #endif
 
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+#ifdef eMB_FUNC_READ_INPUT_ENABLED
+/*=============================================================================================*/
+/**
+ * This function will handle read input register request from master.
+ * The register values are written directly into the frame.
+ *
+ * @param recvPduFrame received PDU frame pointer, response is built in place
+ * @param recvPduLength received PDU length pointer, response length on return
+ *
+ * @return exception code
+ */
+eMB_ExceptionType eMB_Slave_FuncReadInputRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength)
+{
+  uint16_t inputAddr;
+  uint16_t inputNum;
+  eMB_ExceptionType exptStatus = eMB_EX_NONE;
+  eMB_ErrorCodeType errStatus;
+
+  if (*recvPduLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE))
+  {
+    inputAddr  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_ADDR_OFF] << 8U);
+    inputAddr |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_ADDR_OFF + 1]  );
+
+    inputNum  = (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_REGCNT_OFF] << 8U);
+    inputNum |= (uint16_t)(recvPduFrame[eMB_PDU_REQ_READ_REGCNT_OFF + 1]  );
+
+    /* Check if the number of registers to read is valid. If not
+     * return Modbus illegal data value exception. */
+    if ((inputNum >= (uint16_t)1U) && (inputNum <= (uint16_t)eMB_PDU_FUNC_READ_REGCNT_MAX))
+    {
+      /* Make callback to fill the buffer. */
+      errStatus = eMB_Util_SlaveFuncInputRegisterCallback(inputAddr, inputNum, &recvPduFrame[eMB_PDU_FUNC_READ_VALUES_OFF]);
+
+      if (errStatus == eMB_ENOERR)
+      {
+        recvPduFrame[eMB_PDU_FUNC_READ_BYTECNT_OFF] = (uint8_t)(inputNum * 2U);
+        *recvPduLength = (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + inputNum * 2U);
+      }
+      else
+      {
+        exptStatus = eMB_Util_ErrorToException(errStatus);
+      }
+    }
+    else
+    {
+      exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+  }
+  else
+  {
+    /* Can't be a valid request because the length is incorrect. */
+    exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+  }
+
+  return exptStatus;
+}
+#endif
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
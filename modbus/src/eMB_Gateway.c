@@ -0,0 +1,775 @@
+/*
+ * File:   eMB_Gateway.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 06:00 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "string.h"
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_GATEWAY_ENABLED
+/* No request (end of a queue, nothing on the line) */
+#define eMB_GATEWAY_REQ_NONE                      ( 0xFFFF )
+
+/* States of a request */
+#define eMB_GATEWAY_REQ_FREE                      (  0 )
+#define eMB_GATEWAY_REQ_QUEUED                    (  1 )  /* In the queue of its client */
+#define eMB_GATEWAY_REQ_CURRENT                   (  2 )  /* On the line */
+#define eMB_GATEWAY_REQ_JOINED                    (  3 )  /* Waits for the response of an identical request */
+
+#define eMB_PDU_REQ_ADDR_OFF                      ( eMB_PDU_DATA_OFFSET + 0 )
+#define eMB_PDU_REQ_CNT_OFF                       ( eMB_PDU_DATA_OFFSET + 2 )
+#define eMB_PDU_REQ_READ_SIZE                     ( 4 )
+#define eMB_PDU_REQ_READWRITE_WRITE_ADDR_OFF      ( eMB_PDU_DATA_OFFSET + 4 )
+#define eMB_PDU_REQ_READWRITE_WRITE_CNT_OFF       ( eMB_PDU_DATA_OFFSET + 6 )
+
+/* A request of a client */
+typedef struct _eMB_GatewayReqStruct
+{
+  eMB_GatewayRespondCallback  respond;            /*!< NULL if the client was cancelled. */
+  void                       *ctx;
+  uint32_t                    tag;
+  uint16_t                    next;               /*!< Next request of the same client or of the joined list. */
+  uint16_t                    joined;             /*!< First request which waits for this one. */
+  uint16_t                    clientId;
+  uint16_t                    pduLength;
+  uint8_t                     unitId;
+  uint8_t                     state;
+  uint8_t                     pduBuf[eMB_PDU_SIZE_MAX];
+} eMB_GatewayReqStruct;
+
+/* Requests of one client */
+typedef struct _eMB_GatewayQueueStruct
+{
+  uint16_t                    head;
+  uint16_t                    tail;
+  uint16_t                    num;                /*!< Queued requests, in arrival order from head. */
+  uint16_t                    joinedNum;          /*!< Requests joined to a request of any client. */
+} eMB_GatewayQueueStruct;
+
+/* Response of a read request */
+typedef struct _eMB_GatewayCacheStruct
+{
+  uint32_t                    time;               /*!< eMB_ConfigStruct::pPortTimeGet when stored. */
+  uint32_t                    ttl;                /*!< 0 if the entry is unused. */
+  uint16_t                    regAddr;
+  uint16_t                    regNum;
+  uint16_t                    pduLength;
+  uint8_t                     unitId;
+  uint8_t                     funcCode;
+  uint8_t                     pduBuf[eMB_PDU_SIZE_MAX];
+} eMB_GatewayCacheStruct;
+
+/* Time to live of a register range */
+typedef struct _eMB_GatewayTtlStruct
+{
+  uint32_t                    ttl;
+  uint16_t                    regAddr;
+  uint16_t                    regNum;
+  uint8_t                     unitId;
+  uint8_t                     funcCode;
+} eMB_GatewayTtlStruct;
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static eMB_GatewayReqStruct eMB_Gateway_Req[eMB_GATEWAY_QUEUE_SIZE];
+static eMB_GatewayQueueStruct eMB_Gateway_Queue[eMB_GATEWAY_CLIENT_MAX];
+
+/* Stack of free requests, filled by eMB_Gateway_Init() */
+static uint16_t eMB_Gateway_Free[eMB_GATEWAY_QUEUE_SIZE];
+static uint16_t eMB_Gateway_FreeNum;
+
+/* Number of queued requests of all clients */
+static uint16_t eMB_Gateway_QueuedNum;
+
+/* Client which is looked at first by the next dispatch */
+static uint16_t eMB_Gateway_NextClient;
+
+/* Request on the line */
+static uint16_t eMB_Gateway_Current = (uint16_t)eMB_GATEWAY_REQ_NONE;
+
+static eMB_GatewayCacheStruct eMB_Gateway_Cache[eMB_GATEWAY_CACHE_SIZE];
+
+static eMB_GatewayTtlStruct eMB_Gateway_Ttl[eMB_GATEWAY_CACHE_RANGES_MAX];
+static uint8_t              eMB_Gateway_TtlNum;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_Gateway_Reject(uint8_t funcCode, eMB_ExceptionType exptStatus, void *ctx, uint32_t tag,
+                               eMB_GatewayRespondCallback respond);
+static void eMB_Gateway_FreeReq(uint16_t reqIdx);
+static uint16_t eMB_Gateway_FindLeader(uint8_t unitId, const uint8_t *pduBuf, uint16_t pduLength);
+
+static bool eMB_Gateway_ParseRead(const uint8_t *pduBuf, uint16_t pduLength, uint16_t *regAddr, uint16_t *regNum);
+static const eMB_GatewayCacheStruct *eMB_Gateway_CacheFind(uint8_t unitId, uint8_t funcCode,
+                                                           uint16_t regAddr, uint16_t regNum);
+static void eMB_Gateway_CacheStore(uint8_t unitId, uint8_t funcCode, uint16_t regAddr, uint16_t regNum,
+                                   const uint8_t *pduBuf, uint16_t pduLength);
+static uint32_t eMB_Gateway_CacheTtl(uint8_t unitId, uint8_t funcCode, uint16_t regAddr, uint16_t regNum);
+static void eMB_Gateway_CacheInvalidate(uint8_t unitId, uint8_t funcCode, uint16_t regAddr, uint16_t regNum);
+static void eMB_Gateway_CacheInvalidateWrite(uint8_t unitId, const uint8_t *pduBuf);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_Gateway_Submit(uint16_t clientId, void *ctx, uint32_t tag, uint8_t unitId,
+                                     const uint8_t *pduBuf, uint16_t pduLength, eMB_GatewayRespondCallback respond)
+{
+  const eMB_GatewayCacheStruct *pCache;
+  eMB_GatewayQueueStruct *pQueue;
+  eMB_GatewayReqStruct *pReq;
+  uint16_t leaderIdx = (uint16_t)eMB_GATEWAY_REQ_NONE;
+  uint16_t reqIdx;
+  uint16_t regAddr;
+  uint16_t regNum;
+  bool isRead;
+
+  if ((clientId >= (uint16_t)eMB_GATEWAY_CLIENT_MAX) ||
+      (unitId < (uint8_t)eMB_ADDRESS_MIN) || (unitId > (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM) ||
+      (pduLength < (uint16_t)eMB_PDU_SIZE_MIN) || (pduLength > (uint16_t)eMB_PDU_SIZE_MAX))
+  {
+    eMB_Gateway_Reject(pduBuf[eMB_PDU_FUNC_OFFSET], eMB_EX_GATEWAY_PATH_FAILED, ctx, tag, respond);
+    return eMB_EINVAL;
+  }
+
+  isRead = eMB_Gateway_ParseRead(pduBuf, pduLength, &regAddr, &regNum);
+
+  if (isRead == true)
+  {
+    pCache = eMB_Gateway_CacheFind(unitId, pduBuf[eMB_PDU_FUNC_OFFSET], regAddr, regNum);
+
+    if (pCache != NULL)
+    {
+      respond(ctx, tag, pCache->pduBuf, pCache->pduLength);
+      return eMB_ENOERR;
+    }
+
+    /* An identical read which waits for the line or is on the line is not sent twice. */
+    leaderIdx = eMB_Gateway_FindLeader(unitId, pduBuf, pduLength);
+  }
+
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* An offline slave would only block the line until its respond timeout. */
+  if ((leaderIdx == (uint16_t)eMB_GATEWAY_REQ_NONE) && (eMB_Health_IsAvailable(unitId) == false))
+  {
+    eMB_Gateway_Reject(pduBuf[eMB_PDU_FUNC_OFFSET], eMB_EX_GATEWAY_TGT_FAILED, ctx, tag, respond);
+    return eMB_EOFFLINE;
+  }
+#endif
+
+  pQueue = &eMB_Gateway_Queue[clientId];
+
+  if ((eMB_Gateway_FreeNum == (uint16_t)0U) ||
+      ((uint16_t)(pQueue->num + pQueue->joinedNum) >= (uint16_t)eMB_GATEWAY_CLIENT_QUEUE_SIZE))
+  {
+    eMB_Gateway_Reject(pduBuf[eMB_PDU_FUNC_OFFSET], eMB_EX_GATEWAY_PATH_FAILED, ctx, tag, respond);
+    return eMB_ENORES;
+  }
+
+  reqIdx = eMB_Gateway_Free[--eMB_Gateway_FreeNum];
+  pReq = &eMB_Gateway_Req[reqIdx];
+
+  pReq->respond   = respond;
+  pReq->ctx       = ctx;
+  pReq->tag       = tag;
+  pReq->next      = (uint16_t)eMB_GATEWAY_REQ_NONE;
+  pReq->joined    = (uint16_t)eMB_GATEWAY_REQ_NONE;
+  pReq->clientId  = clientId;
+  pReq->pduLength = pduLength;
+  pReq->unitId    = unitId;
+  memcpy(pReq->pduBuf, pduBuf, pduLength);
+
+  if (leaderIdx != (uint16_t)eMB_GATEWAY_REQ_NONE)
+  {
+    pReq->state = (uint8_t)eMB_GATEWAY_REQ_JOINED;
+    pReq->next = eMB_Gateway_Req[leaderIdx].joined;
+    eMB_Gateway_Req[leaderIdx].joined = reqIdx;
+    pQueue->joinedNum++;
+
+    return eMB_ENOERR;
+  }
+
+  pReq->state = (uint8_t)eMB_GATEWAY_REQ_QUEUED;
+
+  if (pQueue->num == (uint16_t)0U)
+  {
+    pQueue->head = reqIdx;
+  }
+  else
+  {
+    eMB_Gateway_Req[pQueue->tail].next = reqIdx;
+  }
+
+  pQueue->tail = reqIdx;
+  pQueue->num++;
+  eMB_Gateway_QueuedNum++;
+
+  return eMB_ENOERR;
+}
+
+void eMB_Gateway_CancelClient(uint16_t clientId)
+{
+  eMB_GatewayQueueStruct *pQueue;
+  eMB_GatewayReqStruct *pReq;
+  uint16_t reqIdx;
+  uint16_t nextIdx;
+  uint16_t keptNum = (uint16_t)0U;
+
+  if (clientId >= (uint16_t)eMB_GATEWAY_CLIENT_MAX)
+  {
+    return;
+  }
+
+  pQueue = &eMB_Gateway_Queue[clientId];
+  reqIdx = pQueue->head;
+
+  /* Queued requests which other clients joined stay queued without a callback. */
+  while (pQueue->num != (uint16_t)0U)
+  {
+    pReq = &eMB_Gateway_Req[reqIdx];
+    nextIdx = pReq->next;
+    pQueue->num--;
+
+    if (pReq->joined == (uint16_t)eMB_GATEWAY_REQ_NONE)
+    {
+      eMB_Gateway_FreeReq(reqIdx);
+      eMB_Gateway_QueuedNum--;
+    }
+    else
+    {
+      pReq->respond = NULL;
+
+      if (keptNum == (uint16_t)0U)
+      {
+        pQueue->head = reqIdx;
+      }
+      else
+      {
+        eMB_Gateway_Req[pQueue->tail].next = reqIdx;
+      }
+
+      pQueue->tail = reqIdx;
+      keptNum++;
+    }
+
+    reqIdx = nextIdx;
+  }
+
+  pQueue->num = keptNum;
+  pQueue->joinedNum = (uint16_t)0U;
+
+  /* Joined requests and the request on the line complete without a callback. */
+  for (reqIdx = (uint16_t)0U; reqIdx < (uint16_t)eMB_GATEWAY_QUEUE_SIZE; reqIdx++)
+  {
+    pReq = &eMB_Gateway_Req[reqIdx];
+
+    if ((pReq->clientId == clientId) &&
+        ((pReq->state == (uint8_t)eMB_GATEWAY_REQ_JOINED) || (pReq->state == (uint8_t)eMB_GATEWAY_REQ_CURRENT)))
+    {
+      pReq->respond = NULL;
+    }
+  }
+}
+
+eMB_ErrorCodeType eMB_Gateway_SetCacheTtl(eMB_RegType regType, uint8_t unitId, uint16_t regAddr, uint16_t regNum,
+                                          uint32_t ttlMs)
+{
+  eMB_GatewayTtlStruct *pTtl;
+  uint8_t funcCode;
+  uint8_t ttlIdx;
+
+  switch (regType)
+  {
+    case eMB_REG_COILS:
+    {
+      funcCode = (uint8_t)eMB_FUNC_READ_COILS;
+      break;
+    }
+    case eMB_REG_DISCRETE_INPUTS:
+    {
+      funcCode = (uint8_t)eMB_FUNC_READ_DISCRETE_INPUTS;
+      break;
+    }
+    case eMB_REG_HOLDING:
+    {
+      funcCode = (uint8_t)eMB_FUNC_READ_HOLDING_REGISTER;
+      break;
+    }
+    default:
+    {
+      funcCode = (uint8_t)eMB_FUNC_READ_INPUT_REGISTER;
+      break;
+    }
+  }
+
+  if ((unitId < (uint8_t)eMB_ADDRESS_MIN) || (unitId > (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM) ||
+      (regNum == (uint16_t)0U) || ((uint32_t)regAddr + regNum > 0x10000UL))
+  {
+    return eMB_EINVAL;
+  }
+
+  for (ttlIdx = (uint8_t)0U; ttlIdx < eMB_Gateway_TtlNum; ttlIdx++)
+  {
+    pTtl = &eMB_Gateway_Ttl[ttlIdx];
+
+    if ((pTtl->unitId == unitId) && (pTtl->funcCode == funcCode) &&
+        (pTtl->regAddr == regAddr) && (pTtl->regNum == regNum))
+    {
+      break;
+    }
+  }
+
+  if (ttlIdx == eMB_Gateway_TtlNum)
+  {
+    if (eMB_Gateway_TtlNum >= (uint8_t)eMB_GATEWAY_CACHE_RANGES_MAX)
+    {
+      return eMB_ENORES;
+    }
+
+    eMB_Gateway_TtlNum++;
+  }
+
+  pTtl = &eMB_Gateway_Ttl[ttlIdx];
+  pTtl->ttl      = ttlMs;
+  pTtl->regAddr  = regAddr;
+  pTtl->regNum   = regNum;
+  pTtl->unitId   = unitId;
+  pTtl->funcCode = funcCode;
+
+  /* Entries stored with the old time to live. */
+  eMB_Gateway_CacheInvalidate(unitId, funcCode, regAddr, regNum);
+
+  return eMB_ENOERR;
+}
+
+void eMB_Gateway_Init(void)
+{
+  uint16_t i;
+
+  memset(eMB_Gateway_Req, 0, sizeof(eMB_Gateway_Req));
+  memset(eMB_Gateway_Queue, 0, sizeof(eMB_Gateway_Queue));
+  memset(eMB_Gateway_Cache, 0, sizeof(eMB_Gateway_Cache));
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_GATEWAY_QUEUE_SIZE; i++)
+  {
+    eMB_Gateway_Free[i] = i;
+  }
+
+  eMB_Gateway_FreeNum    = (uint16_t)eMB_GATEWAY_QUEUE_SIZE;
+  eMB_Gateway_QueuedNum  = (uint16_t)0U;
+  eMB_Gateway_NextClient = (uint16_t)0U;
+  eMB_Gateway_Current    = (uint16_t)eMB_GATEWAY_REQ_NONE;
+}
+
+void eMB_Gateway_Dispatch(void)
+{
+  eMB_GatewayQueueStruct *pQueue;
+  eMB_GatewayReqStruct *pReq;
+  uint8_t *pduFrame;
+  uint16_t clientId;
+  uint16_t regAddr;
+  uint16_t regNum;
+
+  if ((eMB_Gateway_QueuedNum == (uint16_t)0U) || (eMB_Gateway_Current != (uint16_t)eMB_GATEWAY_REQ_NONE))
+  {
+    return;
+  }
+
+  /* The line is shared with the requests of the application. */
+  if (eMB_Util_ResourceTake() == false)
+  {
+    return;
+  }
+
+  /* Round robin: the client after the one served last is looked at first. */
+  clientId = eMB_Gateway_NextClient;
+
+  while (eMB_Gateway_Queue[clientId].num == (uint16_t)0U)
+  {
+    clientId = (uint16_t)((clientId + 1U) % (uint16_t)eMB_GATEWAY_CLIENT_MAX);
+  }
+
+  eMB_Gateway_NextClient = (uint16_t)((clientId + 1U) % (uint16_t)eMB_GATEWAY_CLIENT_MAX);
+
+  pQueue = &eMB_Gateway_Queue[clientId];
+  eMB_Gateway_Current = pQueue->head;
+  pQueue->head = eMB_Gateway_Req[eMB_Gateway_Current].next;
+  pQueue->num--;
+  eMB_Gateway_QueuedNum--;
+
+  pReq = &eMB_Gateway_Req[eMB_Gateway_Current];
+  pReq->state = (uint8_t)eMB_GATEWAY_REQ_CURRENT;
+
+  eMB_FrameGetSendPduBufferCalloutArr(&pduFrame);
+  memcpy(pduFrame, pReq->pduBuf, pReq->pduLength);
+
+  eMB_FrameSetSlaveAddressCalloutArr(pReq->unitId);
+  eMB_FrameSetSendPduLengthCalloutArr(pReq->pduLength);
+
+  /* Reads of the application join the read of the client. */
+  if (eMB_Gateway_ParseRead(pReq->pduBuf, pReq->pduLength, &regAddr, &regNum) == true)
+  {
+    eMB_Util_SetPendingRead(pReq->unitId, pReq->pduBuf[eMB_PDU_FUNC_OFFSET], regAddr, regNum);
+  }
+
+  (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_SENT);
+}
+
+void eMB_Gateway_Complete(const uint8_t *pduBuf, uint16_t pduLength)
+{
+  eMB_GatewayRespondCallback respond;
+  eMB_GatewayReqStruct *pReq;
+  uint8_t *pSendPdu;
+  void *ctx;
+  uint32_t tag;
+  uint16_t reqIdx;
+  uint16_t nextIdx;
+  uint16_t regAddr;
+  uint16_t regNum;
+  uint8_t funcCode;
+
+  /* A write of a client or of the application makes cached reads stale, also
+   * if it failed: the slave may have executed it. The request is still in the
+   * send buffer. */
+  eMB_FrameGetSendPduBufferCalloutArr(&pSendPdu);
+  eMB_Gateway_CacheInvalidateWrite(eMB_FrameGetSlaveAddressCalloutArr(), pSendPdu);
+
+  if (eMB_Gateway_Current == (uint16_t)eMB_GATEWAY_REQ_NONE)
+  {
+    /* Request of the application. */
+    return;
+  }
+
+  reqIdx = eMB_Gateway_Current;
+  eMB_Gateway_Current = (uint16_t)eMB_GATEWAY_REQ_NONE;
+
+  pReq = &eMB_Gateway_Req[reqIdx];
+  funcCode = pReq->pduBuf[eMB_PDU_FUNC_OFFSET];
+
+  if ((pduBuf != NULL) && ((pduBuf[eMB_PDU_FUNC_OFFSET] & (uint8_t)eMB_FUNC_ERROR) == (uint8_t)0U) &&
+      (eMB_Gateway_ParseRead(pReq->pduBuf, pReq->pduLength, &regAddr, &regNum) == true))
+  {
+    eMB_Gateway_CacheStore(pReq->unitId, funcCode, regAddr, regNum, pduBuf, pduLength);
+  }
+
+  /* The request and the ones joined to it get the same response. Each request
+   * is freed before its callback, the callback may submit the next one. */
+  while (reqIdx != (uint16_t)eMB_GATEWAY_REQ_NONE)
+  {
+    pReq = &eMB_Gateway_Req[reqIdx];
+    nextIdx  = (pReq->state == (uint8_t)eMB_GATEWAY_REQ_JOINED) ? pReq->next : pReq->joined;
+    respond  = pReq->respond;
+    ctx      = pReq->ctx;
+    tag      = pReq->tag;
+
+    if ((pReq->state == (uint8_t)eMB_GATEWAY_REQ_JOINED) && (respond != NULL))
+    {
+      eMB_Gateway_Queue[pReq->clientId].joinedNum--;
+    }
+
+    eMB_Gateway_FreeReq(reqIdx);
+
+    if (respond != NULL)
+    {
+      if (pduBuf != NULL)
+      {
+        respond(ctx, tag, pduBuf, pduLength);
+      }
+      else
+      {
+        eMB_Gateway_Reject(funcCode, eMB_EX_GATEWAY_TGT_FAILED, ctx, tag, respond);
+      }
+    }
+
+    reqIdx = nextIdx;
+  }
+}
+
+bool eMB_Gateway_IsForwarding(void)
+{
+  return (eMB_Gateway_Current != (uint16_t)eMB_GATEWAY_REQ_NONE);
+}
+
+
+
+
+
+/* Answer a request with an exception. */
+static void eMB_Gateway_Reject(uint8_t funcCode, eMB_ExceptionType exptStatus, void *ctx, uint32_t tag,
+                               eMB_GatewayRespondCallback respond)
+{
+  uint8_t pduBuf[2];
+
+  pduBuf[eMB_PDU_FUNC_OFFSET] = (uint8_t)(funcCode | eMB_FUNC_ERROR);
+  pduBuf[eMB_PDU_DATA_OFFSET] = (uint8_t)exptStatus;
+
+  respond(ctx, tag, pduBuf, (uint16_t)2U);
+}
+
+/* Return a request to the free stack. */
+static void eMB_Gateway_FreeReq(uint16_t reqIdx)
+{
+  eMB_Gateway_Req[reqIdx].state = (uint8_t)eMB_GATEWAY_REQ_FREE;
+  eMB_Gateway_Free[eMB_Gateway_FreeNum++] = reqIdx;
+}
+
+/* Find a queued request or the request on the line with the same unit id and PDU. */
+static uint16_t eMB_Gateway_FindLeader(uint8_t unitId, const uint8_t *pduBuf, uint16_t pduLength)
+{
+  eMB_GatewayReqStruct *pReq;
+  uint16_t reqIdx;
+
+  for (reqIdx = (uint16_t)0U; reqIdx < (uint16_t)eMB_GATEWAY_QUEUE_SIZE; reqIdx++)
+  {
+    pReq = &eMB_Gateway_Req[reqIdx];
+
+    if (((pReq->state == (uint8_t)eMB_GATEWAY_REQ_QUEUED) || (pReq->state == (uint8_t)eMB_GATEWAY_REQ_CURRENT)) &&
+        (pReq->unitId == unitId) && (pReq->pduLength == pduLength) &&
+        (memcmp(pReq->pduBuf, pduBuf, pduLength) == 0))
+    {
+      return reqIdx;
+    }
+  }
+
+  return (uint16_t)eMB_GATEWAY_REQ_NONE;
+}
+
+/* Check for a read request (function code 1 - 4) and get its range. */
+static bool eMB_Gateway_ParseRead(const uint8_t *pduBuf, uint16_t pduLength, uint16_t *regAddr, uint16_t *regNum)
+{
+  if ((pduLength != (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE)) ||
+      (pduBuf[eMB_PDU_FUNC_OFFSET] < (uint8_t)eMB_FUNC_READ_COILS) ||
+      (pduBuf[eMB_PDU_FUNC_OFFSET] > (uint8_t)eMB_FUNC_READ_INPUT_REGISTER))
+  {
+    return false;
+  }
+
+  *regAddr  = (uint16_t)(pduBuf[eMB_PDU_REQ_ADDR_OFF] << 8U);
+  *regAddr |= (uint16_t)(pduBuf[eMB_PDU_REQ_ADDR_OFF + 1]  );
+  *regNum   = (uint16_t)(pduBuf[eMB_PDU_REQ_CNT_OFF] << 8U);
+  *regNum  |= (uint16_t)(pduBuf[eMB_PDU_REQ_CNT_OFF + 1]  );
+
+  return true;
+}
+
+/* Find a cached response which did not expire. */
+static const eMB_GatewayCacheStruct *eMB_Gateway_CacheFind(uint8_t unitId, uint8_t funcCode,
+                                                           uint16_t regAddr, uint16_t regNum)
+{
+  eMB_GatewayCacheStruct *pCache;
+  uint32_t time;
+  uint8_t cacheIdx;
+
+  if (eMB_gConfigPtr->pPortTimeGet == NULL)
+  {
+    return NULL;
+  }
+
+  time = eMB_gConfigPtr->pPortTimeGet();
+
+  for (cacheIdx = (uint8_t)0U; cacheIdx < (uint8_t)eMB_GATEWAY_CACHE_SIZE; cacheIdx++)
+  {
+    pCache = &eMB_Gateway_Cache[cacheIdx];
+
+    if ((pCache->ttl != 0UL) && (pCache->unitId == unitId) && (pCache->funcCode == funcCode) &&
+        (pCache->regAddr == regAddr) && (pCache->regNum == regNum))
+    {
+      if ((uint32_t)(time - pCache->time) < pCache->ttl)
+      {
+        return pCache;
+      }
+
+      pCache->ttl = 0UL;
+      break;
+    }
+  }
+
+  return NULL;
+}
+
+/* Store a response. An unused entry is taken, otherwise the oldest one. */
+static void eMB_Gateway_CacheStore(uint8_t unitId, uint8_t funcCode, uint16_t regAddr, uint16_t regNum,
+                                   const uint8_t *pduBuf, uint16_t pduLength)
+{
+  eMB_GatewayCacheStruct *pCache = NULL;
+  uint32_t ttl;
+  uint32_t time;
+  uint32_t age;
+  uint32_t ageMax = 0UL;
+  uint8_t cacheIdx;
+
+  if (eMB_gConfigPtr->pPortTimeGet == NULL)
+  {
+    return;
+  }
+
+  ttl = eMB_Gateway_CacheTtl(unitId, funcCode, regAddr, regNum);
+
+  if (ttl == 0UL)
+  {
+    return;
+  }
+
+  time = eMB_gConfigPtr->pPortTimeGet();
+
+  for (cacheIdx = (uint8_t)0U; cacheIdx < (uint8_t)eMB_GATEWAY_CACHE_SIZE; cacheIdx++)
+  {
+    if (eMB_Gateway_Cache[cacheIdx].ttl == 0UL)
+    {
+      pCache = &eMB_Gateway_Cache[cacheIdx];
+      break;
+    }
+
+    age = (uint32_t)(time - eMB_Gateway_Cache[cacheIdx].time);
+
+    if ((pCache == NULL) || (age > ageMax))
+    {
+      pCache = &eMB_Gateway_Cache[cacheIdx];
+      ageMax = age;
+    }
+  }
+
+  pCache->time      = time;
+  pCache->ttl       = ttl;
+  pCache->regAddr   = regAddr;
+  pCache->regNum    = regNum;
+  pCache->pduLength = pduLength;
+  pCache->unitId    = unitId;
+  pCache->funcCode  = funcCode;
+  memcpy(pCache->pduBuf, pduBuf, pduLength);
+}
+
+/* Time to live of a read. The shortest one of the ranges it overlaps, the default if none. */
+static uint32_t eMB_Gateway_CacheTtl(uint8_t unitId, uint8_t funcCode, uint16_t regAddr, uint16_t regNum)
+{
+  const eMB_GatewayTtlStruct *pTtl;
+  uint32_t ttl = (uint32_t)eMB_GATEWAY_CACHE_TTL_MS;
+  bool isFound = false;
+  uint8_t ttlIdx;
+
+  for (ttlIdx = (uint8_t)0U; ttlIdx < eMB_Gateway_TtlNum; ttlIdx++)
+  {
+    pTtl = &eMB_Gateway_Ttl[ttlIdx];
+
+    if ((pTtl->unitId == unitId) && (pTtl->funcCode == funcCode) &&
+        ((uint32_t)regAddr < (uint32_t)pTtl->regAddr + pTtl->regNum) &&
+        ((uint32_t)pTtl->regAddr < (uint32_t)regAddr + regNum))
+    {
+      if ((isFound == false) || (pTtl->ttl < ttl))
+      {
+        ttl = pTtl->ttl;
+        isFound = true;
+      }
+    }
+  }
+
+  return ttl;
+}
+
+/* Drop the responses of reads which overlap a range. Unit id 0 (broadcast) matches all slaves. */
+static void eMB_Gateway_CacheInvalidate(uint8_t unitId, uint8_t funcCode, uint16_t regAddr, uint16_t regNum)
+{
+  eMB_GatewayCacheStruct *pCache;
+  uint8_t cacheIdx;
+
+  for (cacheIdx = (uint8_t)0U; cacheIdx < (uint8_t)eMB_GATEWAY_CACHE_SIZE; cacheIdx++)
+  {
+    pCache = &eMB_Gateway_Cache[cacheIdx];
+
+    if ((pCache->ttl != 0UL) && (pCache->funcCode == funcCode) &&
+        ((unitId == (uint8_t)eMB_ADDRESS_BROADCAST) || (pCache->unitId == unitId)) &&
+        ((uint32_t)regAddr < (uint32_t)pCache->regAddr + pCache->regNum) &&
+        ((uint32_t)pCache->regAddr < (uint32_t)regAddr + regNum))
+    {
+      pCache->ttl = 0UL;
+    }
+  }
+}
+
+/* Drop the responses of reads which overlap the range of a write request. */
+static void eMB_Gateway_CacheInvalidateWrite(uint8_t unitId, const uint8_t *pduBuf)
+{
+  uint16_t regAddr;
+  uint16_t regNum = (uint16_t)1U;
+
+  regAddr  = (uint16_t)(pduBuf[eMB_PDU_REQ_ADDR_OFF] << 8U);
+  regAddr |= (uint16_t)(pduBuf[eMB_PDU_REQ_ADDR_OFF + 1]  );
+
+  switch (pduBuf[eMB_PDU_FUNC_OFFSET])
+  {
+    case eMB_FUNC_WRITE_MULTIPLE_COILS:
+    {
+      regNum  = (uint16_t)(pduBuf[eMB_PDU_REQ_CNT_OFF] << 8U);
+      regNum |= (uint16_t)(pduBuf[eMB_PDU_REQ_CNT_OFF + 1]  );
+    }
+    /* fall through */
+    case eMB_FUNC_WRITE_SINGLE_COIL:
+    {
+      eMB_Gateway_CacheInvalidate(unitId, (uint8_t)eMB_FUNC_READ_COILS, regAddr, regNum);
+      break;
+    }
+    case eMB_FUNC_READWRITE_MULTIPLE_REGISTERS:
+    {
+      regAddr  = (uint16_t)(pduBuf[eMB_PDU_REQ_READWRITE_WRITE_ADDR_OFF] << 8U);
+      regAddr |= (uint16_t)(pduBuf[eMB_PDU_REQ_READWRITE_WRITE_ADDR_OFF + 1]  );
+      regNum   = (uint16_t)(pduBuf[eMB_PDU_REQ_READWRITE_WRITE_CNT_OFF] << 8U);
+      regNum  |= (uint16_t)(pduBuf[eMB_PDU_REQ_READWRITE_WRITE_CNT_OFF + 1]  );
+
+      eMB_Gateway_CacheInvalidate(unitId, (uint8_t)eMB_FUNC_READ_HOLDING_REGISTER, regAddr, regNum);
+      break;
+    }
+    case eMB_FUNC_WRITE_MULTIPLE_REGISTERS:
+    {
+      regNum  = (uint16_t)(pduBuf[eMB_PDU_REQ_CNT_OFF] << 8U);
+      regNum |= (uint16_t)(pduBuf[eMB_PDU_REQ_CNT_OFF + 1]  );
+    }
+    /* fall through */
+    case eMB_FUNC_WRITE_REGISTER:
+    {
+      eMB_Gateway_CacheInvalidate(unitId, (uint8_t)eMB_FUNC_READ_HOLDING_REGISTER, regAddr, regNum);
+      break;
+    }
+    default:
+      break;
+  }
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
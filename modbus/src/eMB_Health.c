@@ -0,0 +1,159 @@
+/*
+ * File:   eMB_Health.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 09:10 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_HEALTH_ENABLED
+#define eMB_HEALTH_SLAVE_IS_VALID(addr)           ( ((addr) >= (uint8_t)eMB_ADDRESS_MIN) && \
+                                                    ((addr) <= (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM) )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* Written by eMB_MainFunction(), read by the request functions of the application. */
+static eMB_HealthStatsStruct eMB_HealthStats[eMB_MASTER_TOTAL_SLAVE_NUM];
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_Health_GetStats(uint8_t slaveAddr, eMB_HealthStatsStruct *stats)
+{
+  if ((eMB_HEALTH_SLAVE_IS_VALID(slaveAddr) == false) || (stats == NULL))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_PortEnterCriticalSection();
+
+  *stats = eMB_HealthStats[slaveAddr - 1U];
+
+  eMB_PortExitCriticalSection();
+
+  return eMB_ENOERR;
+}
+
+eMB_ErrorCodeType eMB_Health_Reset(uint8_t slaveAddr)
+{
+  if (eMB_HEALTH_SLAVE_IS_VALID(slaveAddr) == false)
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_Health_Answer(slaveAddr);
+
+  return eMB_ENOERR;
+}
+
+bool eMB_Health_IsAvailable(uint8_t slaveAddr)
+{
+  bool isAvailable = true;
+
+  /* Broadcasts are not answered, they are always sent. */
+  if (eMB_HEALTH_SLAVE_IS_VALID(slaveAddr) == true)
+  {
+    eMB_PortEnterCriticalSection();
+
+    /* Without a clock every request to an offline slave is a probe. */
+    if ((eMB_HealthStats[slaveAddr - 1U].state == eMB_HEALTH_OFFLINE) && (eMB_gConfigPtr->pPortTimeGet != NULL) &&
+        ((int32_t)(eMB_Util_GetTime() - eMB_HealthStats[slaveAddr - 1U].probeTime) < 0))
+    {
+      isAvailable = false;
+    }
+
+    eMB_PortExitCriticalSection();
+  }
+
+  return isAvailable;
+}
+
+void eMB_Health_Answer(uint8_t slaveAddr)
+{
+  if (eMB_HEALTH_SLAVE_IS_VALID(slaveAddr) == true)
+  {
+    eMB_PortEnterCriticalSection();
+
+    eMB_HealthStats[slaveAddr - 1U].state      = eMB_HEALTH_ONLINE;
+    eMB_HealthStats[slaveAddr - 1U].timeoutNum = (uint16_t)0U;
+    eMB_HealthStats[slaveAddr - 1U].probeMs    = 0UL;
+
+    eMB_PortExitCriticalSection();
+  }
+}
+
+void eMB_Health_Timeout(uint8_t slaveAddr)
+{
+  eMB_HealthStatsStruct *pStats;
+
+  if (eMB_HEALTH_SLAVE_IS_VALID(slaveAddr) == true)
+  {
+    pStats = &eMB_HealthStats[slaveAddr - 1U];
+
+    eMB_PortEnterCriticalSection();
+
+    if (pStats->timeoutNum < (uint16_t)0xFFFFU)
+    {
+      pStats->timeoutNum++;
+    }
+
+    if (pStats->state == eMB_HEALTH_OFFLINE)
+    {
+      /* The probe was not answered, back off. */
+      pStats->probeMs *= 2UL;
+
+      if (pStats->probeMs > (uint32_t)eMB_MASTER_HEALTH_PROBE_MS_MAX)
+      {
+        pStats->probeMs = (uint32_t)eMB_MASTER_HEALTH_PROBE_MS_MAX;
+      }
+    }
+    else if (pStats->timeoutNum >= (uint16_t)eMB_MASTER_HEALTH_OFFLINE_TIMEOUTS)
+    {
+      pStats->state   = eMB_HEALTH_OFFLINE;
+      pStats->probeMs = (uint32_t)eMB_MASTER_HEALTH_PROBE_MS_MIN;
+    }
+    else
+    {
+      pStats->state = eMB_HEALTH_SUSPECT;
+    }
+
+    pStats->probeTime = eMB_Util_GetTime() + pStats->probeMs;
+
+    eMB_PortExitCriticalSection();
+  }
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
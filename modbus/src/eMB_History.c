@@ -0,0 +1,509 @@
+/* 
+ * File:   eMB_History.c
+ * Author: Long
+ * 
+ * Created on October 19, 2026, 09:12 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+/* Bits of one column */
+#define eMB_HISTORY_COLUMN_BITS                   ( eMB_MASTER_HISTORY_COLUMN_SIZE * 8U )
+
+/* Worst case size of one encoded sample: '1111' + 32 bits delta-of-delta. */
+#define eMB_HISTORY_TIME_BITS_MAX                 ( 36U )
+
+/* Worst case size of one encoded sample: '11' + 4 bits leading zeros + 4 bits length + 16 bits. */
+#define eMB_HISTORY_VALUE_BITS_MAX                ( 26U )
+
+/* Leading zero count which marks that no XOR window is set. */
+#define eMB_HISTORY_WINDOW_NONE                   ( 16U )
+
+typedef struct _eMB_HistoryBlockStruct
+{
+  uint32_t                    firstTime;          /* Timestamp of the first sample, stored raw. */
+  uint16_t                    firstValue;         /* Value of the first sample, stored raw. */
+  uint16_t                    sampleNum;          /* Number of samples in the block. */
+  uint16_t                    timeBitPos;         /* Used bits of the timestamp column. */
+  uint16_t                    valueBitPos;        /* Used bits of the value column. */
+} eMB_HistoryBlockStruct;
+
+typedef struct _eMB_HistoryPointStruct
+{
+  uint32_t                    lastTime;           /* Encoder state of the head block. */
+  uint32_t                    lastDelta;
+  uint16_t                    lastValue;
+  uint8_t                     lastLead;
+  uint8_t                     lastTrail;
+  uint8_t                     headBlock;          /* Block receiving new samples. */
+  uint8_t                     blockNum;           /* Number of used blocks. */
+} eMB_HistoryPointStruct;
+
+typedef struct _eMB_HistoryRangeStruct
+{
+  eMB_RegType                 regType;
+  uint8_t                     slaveAddr;
+  uint16_t                    regAddr;
+  uint16_t                    regNum;
+  uint16_t                    firstPoint;
+} eMB_HistoryRangeStruct;
+
+/* Decoder state of one block. */
+typedef struct _eMB_HistoryCursorStruct
+{
+  uint32_t                    time;
+  uint32_t                    delta;
+  uint16_t                    value;
+  uint8_t                     lead;
+  uint8_t                     trail;
+  uint16_t                    timeBitPos;
+  uint16_t                    valueBitPos;
+} eMB_HistoryCursorStruct;
+#endif
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+static eMB_HistoryRangeStruct eMB_HistoryRange[eMB_MASTER_HISTORY_RANGES_MAX];
+static uint8_t                eMB_HistoryRangeNum;
+
+static eMB_HistoryPointStruct eMB_HistoryPoint[eMB_MASTER_HISTORY_POINTS_MAX];
+static uint16_t               eMB_HistoryPointNum;
+
+/* Block headers, timestamp columns and value columns are stored apart. */
+static eMB_HistoryBlockStruct eMB_HistoryBlock[eMB_MASTER_HISTORY_POINTS_MAX][eMB_MASTER_HISTORY_BLOCKS];
+static uint8_t                eMB_HistoryTimeCol[eMB_MASTER_HISTORY_POINTS_MAX][eMB_MASTER_HISTORY_BLOCKS][eMB_MASTER_HISTORY_COLUMN_SIZE];
+static uint8_t                eMB_HistoryValueCol[eMB_MASTER_HISTORY_POINTS_MAX][eMB_MASTER_HISTORY_BLOCKS][eMB_MASTER_HISTORY_COLUMN_SIZE];
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+static void     eMB_History_PutBits(uint8_t *column, uint16_t *bitPos, uint32_t value, uint8_t bitNum);
+static uint32_t eMB_History_GetBits(const uint8_t *column, uint16_t *bitPos, uint8_t bitNum);
+static int16_t  eMB_History_FindPoint(eMB_RegType regType, uint8_t slaveAddr, uint16_t regAddr);
+static void     eMB_History_AppendPoint(uint16_t point, uint32_t time, uint16_t value);
+static void     eMB_History_DecodeSample(uint16_t point, uint8_t block, eMB_HistoryCursorStruct *cursor);
+#endif
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+eMB_ErrorCodeType eMB_History_AddRange(eMB_RegType regType, uint8_t slaveAddr, uint16_t regAddr, uint16_t regNum)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  eMB_HistoryRangeStruct *pRange;
+
+  if (((regType != eMB_REG_INPUT) && (regType != eMB_REG_HOLDING)) ||
+      (slaveAddr < eMB_ADDRESS_MIN) || (slaveAddr > eMB_MASTER_TOTAL_SLAVE_NUM) ||
+      (regNum == (uint16_t)0U) || ((uint32_t)regAddr + regNum > (uint32_t)0x10000U))
+  {
+    errStatus = eMB_EINVAL;
+  }
+  else if ((eMB_HistoryRangeNum >= (uint8_t)eMB_MASTER_HISTORY_RANGES_MAX) ||
+           ((uint32_t)eMB_HistoryPointNum + regNum > (uint32_t)eMB_MASTER_HISTORY_POINTS_MAX))
+  {
+    errStatus = eMB_ENORES;
+  }
+  else
+  {
+    eMB_PortEnterCriticalSection();
+
+    pRange = &eMB_HistoryRange[eMB_HistoryRangeNum];
+
+    pRange->regType    = regType;
+    pRange->slaveAddr  = slaveAddr;
+    pRange->regAddr    = regAddr;
+    pRange->regNum     = regNum;
+    pRange->firstPoint = eMB_HistoryPointNum;
+
+    eMB_HistoryPointNum += regNum;
+    eMB_HistoryRangeNum++;
+
+    eMB_PortExitCriticalSection();
+  }
+
+  return errStatus;
+}
+
+uint16_t eMB_History_Read(eMB_RegType regType, uint8_t slaveAddr, uint16_t regAddr,
+                          uint32_t *timeBuf, uint16_t *valueBuf, uint16_t sampleMax)
+{
+  eMB_HistoryPointStruct *pPoint;
+  eMB_HistoryBlockStruct *pBlock;
+  eMB_HistoryCursorStruct cursor;
+  int16_t  point;
+  uint8_t  block, blockIdx;
+  uint16_t sampleIdx;
+  uint32_t sampleTotal = 0U;
+  uint32_t sampleSkip;
+  uint16_t sampleCnt = (uint16_t)0U;
+
+  point = eMB_History_FindPoint(regType, slaveAddr, regAddr);
+
+  if ((point < 0) || (sampleMax == (uint16_t)0U))
+  {
+    return (uint16_t)0U;
+  }
+
+  pPoint = &eMB_HistoryPoint[point];
+
+  for (blockIdx = (uint8_t)0U; blockIdx < pPoint->blockNum; blockIdx++)
+  {
+    sampleTotal += eMB_HistoryBlock[point][blockIdx].sampleNum;
+  }
+
+  /* Keep only the most recent samples. */
+  sampleSkip = (sampleTotal > sampleMax) ? (sampleTotal - sampleMax) : 0U;
+
+  /* Walk from the oldest block to the head block. */
+  block = (uint8_t)((pPoint->headBlock + eMB_MASTER_HISTORY_BLOCKS + 1U - pPoint->blockNum) % eMB_MASTER_HISTORY_BLOCKS);
+
+  for (blockIdx = (uint8_t)0U; blockIdx < pPoint->blockNum; blockIdx++)
+  {
+    pBlock = &eMB_HistoryBlock[point][block];
+
+    if (sampleSkip >= pBlock->sampleNum)
+    {
+      /* Whole block is skipped, no need to decode it. */
+      sampleSkip -= pBlock->sampleNum;
+    }
+    else
+    {
+      cursor.time        = pBlock->firstTime;
+      cursor.delta       = 0U;
+      cursor.value       = pBlock->firstValue;
+      cursor.lead        = (uint8_t)eMB_HISTORY_WINDOW_NONE;
+      cursor.trail       = (uint8_t)0U;
+      cursor.timeBitPos  = (uint16_t)0U;
+      cursor.valueBitPos = (uint16_t)0U;
+
+      for (sampleIdx = (uint16_t)0U; sampleIdx < pBlock->sampleNum; sampleIdx++)
+      {
+        if (sampleIdx > (uint16_t)0U)
+        {
+          eMB_History_DecodeSample((uint16_t)point, block, &cursor);
+        }
+
+        if (sampleSkip > 0U)
+        {
+          sampleSkip--;
+        }
+        else
+        {
+          timeBuf[sampleCnt]  = cursor.time;
+          valueBuf[sampleCnt] = cursor.value;
+          sampleCnt++;
+        }
+      }
+    }
+
+    block = (uint8_t)((block + 1U) % eMB_MASTER_HISTORY_BLOCKS);
+  }
+
+  return sampleCnt;
+}
+
+void eMB_History_Append(eMB_RegType regType, uint8_t slaveAddr, uint16_t regAddr, uint16_t regNum,
+                        const uint16_t *regBuf)
+{
+  eMB_HistoryRangeStruct *pRange;
+  uint8_t  rangeIdx;
+  uint32_t time;
+  uint32_t addrStart, addrEnd, addr;
+
+  if ((eMB_HistoryRangeNum == (uint8_t)0U) || (eMB_gConfigPtr->pPortTimeGet == NULL))
+  {
+    return;
+  }
+
+  time = eMB_gConfigPtr->pPortTimeGet();
+
+  for (rangeIdx = (uint8_t)0U; rangeIdx < eMB_HistoryRangeNum; rangeIdx++)
+  {
+    pRange = &eMB_HistoryRange[rangeIdx];
+
+    if ((pRange->regType != regType) || (pRange->slaveAddr != slaveAddr))
+    {
+      continue;
+    }
+
+    /* Overlap of the updated registers and the tracked range. */
+    addrStart = (pRange->regAddr > regAddr) ? pRange->regAddr : regAddr;
+    addrEnd   = (uint32_t)pRange->regAddr + pRange->regNum;
+
+    if (addrEnd > (uint32_t)regAddr + regNum)
+    {
+      addrEnd = (uint32_t)regAddr + regNum;
+    }
+
+    for (addr = addrStart; addr < addrEnd; addr++)
+    {
+      eMB_History_AppendPoint((uint16_t)(pRange->firstPoint + (addr - pRange->regAddr)), time, regBuf[addr - regAddr]);
+    }
+  }
+}
+
+
+
+
+
+/* Write bitNum bits of value, MSB first. The column must be zeroed. */
+static void eMB_History_PutBits(uint8_t *column, uint16_t *bitPos, uint32_t value, uint8_t bitNum)
+{
+  while (bitNum > (uint8_t)0U)
+  {
+    bitNum--;
+
+    if (((value >> bitNum) & 1U) != 0U)
+    {
+      column[*bitPos >> 3U] |= (uint8_t)(0x80U >> (*bitPos & 7U));
+    }
+
+    (*bitPos)++;
+  }
+}
+
+/* Read bitNum bits, MSB first. */
+static uint32_t eMB_History_GetBits(const uint8_t *column, uint16_t *bitPos, uint8_t bitNum)
+{
+  uint32_t value = 0U;
+
+  while (bitNum > (uint8_t)0U)
+  {
+    bitNum--;
+
+    value = (value << 1U) | ((uint32_t)(column[*bitPos >> 3U] >> (7U - (*bitPos & 7U))) & 1U);
+
+    (*bitPos)++;
+  }
+
+  return value;
+}
+
+static int16_t eMB_History_FindPoint(eMB_RegType regType, uint8_t slaveAddr, uint16_t regAddr)
+{
+  eMB_HistoryRangeStruct *pRange;
+  uint8_t rangeIdx;
+
+  for (rangeIdx = (uint8_t)0U; rangeIdx < eMB_HistoryRangeNum; rangeIdx++)
+  {
+    pRange = &eMB_HistoryRange[rangeIdx];
+
+    if ((pRange->regType == regType) && (pRange->slaveAddr == slaveAddr) &&
+        (regAddr >= pRange->regAddr) && ((uint32_t)regAddr < (uint32_t)pRange->regAddr + pRange->regNum))
+    {
+      return (int16_t)(pRange->firstPoint + (regAddr - pRange->regAddr));
+    }
+  }
+
+  return -1;
+}
+
+static void eMB_History_AppendPoint(uint16_t point, uint32_t time, uint16_t value)
+{
+  eMB_HistoryPointStruct *pPoint = &eMB_HistoryPoint[point];
+  eMB_HistoryBlockStruct *pBlock = &eMB_HistoryBlock[point][pPoint->headBlock];
+  uint8_t  *timeCol;
+  uint8_t  *valueCol;
+  uint32_t  delta;
+  int32_t   dod;
+  uint16_t  xorVal;
+  uint8_t   lead, trail;
+
+  /* Open a new block if there is none yet or the head block can not take a
+   * worst case sample any more. A full ring drops its oldest block. */
+  if ((pPoint->blockNum == (uint8_t)0U) ||
+      ((pBlock->timeBitPos + eMB_HISTORY_TIME_BITS_MAX) > eMB_HISTORY_COLUMN_BITS) ||
+      ((pBlock->valueBitPos + eMB_HISTORY_VALUE_BITS_MAX) > eMB_HISTORY_COLUMN_BITS) ||
+      (pBlock->sampleNum == (uint16_t)0xFFFFU))
+  {
+    if (pPoint->blockNum != (uint8_t)0U)
+    {
+      pPoint->headBlock = (uint8_t)((pPoint->headBlock + 1U) % eMB_MASTER_HISTORY_BLOCKS);
+    }
+
+    if (pPoint->blockNum < (uint8_t)eMB_MASTER_HISTORY_BLOCKS)
+    {
+      pPoint->blockNum++;
+    }
+
+    pBlock = &eMB_HistoryBlock[point][pPoint->headBlock];
+
+    pBlock->firstTime   = time;
+    pBlock->firstValue  = value;
+    pBlock->sampleNum   = (uint16_t)1U;
+    pBlock->timeBitPos  = (uint16_t)0U;
+    pBlock->valueBitPos = (uint16_t)0U;
+
+    memset(eMB_HistoryTimeCol[point][pPoint->headBlock], 0, eMB_MASTER_HISTORY_COLUMN_SIZE);
+    memset(eMB_HistoryValueCol[point][pPoint->headBlock], 0, eMB_MASTER_HISTORY_COLUMN_SIZE);
+
+    pPoint->lastTime  = time;
+    pPoint->lastDelta = 0U;
+    pPoint->lastValue = value;
+    pPoint->lastLead  = (uint8_t)eMB_HISTORY_WINDOW_NONE;
+    pPoint->lastTrail = (uint8_t)0U;
+
+    return;
+  }
+
+  timeCol  = eMB_HistoryTimeCol[point][pPoint->headBlock];
+  valueCol = eMB_HistoryValueCol[point][pPoint->headBlock];
+
+  /* Timestamp: delta-of-delta with variable length buckets. Unsigned math
+   * keeps the encoding correct when the time wraps around. */
+  delta = time - pPoint->lastTime;
+  dod   = (int32_t)(delta - pPoint->lastDelta);
+
+  if (dod == 0)
+  {
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, 0x0U, 1U);
+  }
+  else if ((dod >= -63) && (dod <= 64))
+  {
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, 0x2U, 2U);
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, (uint32_t)(dod + 63), 7U);
+  }
+  else if ((dod >= -255) && (dod <= 256))
+  {
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, 0x6U, 3U);
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, (uint32_t)(dod + 255), 9U);
+  }
+  else if ((dod >= -2047) && (dod <= 2048))
+  {
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, 0xEU, 4U);
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, (uint32_t)(dod + 2047), 12U);
+  }
+  else
+  {
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, 0xFU, 4U);
+    eMB_History_PutBits(timeCol, &pBlock->timeBitPos, (uint32_t)dod, 32U);
+  }
+
+  /* Value: XOR with the previous value. Meaningful bits are written into
+   * the previous window if they fit, otherwise a new window is stored. */
+  xorVal = (uint16_t)(value ^ pPoint->lastValue);
+
+  if (xorVal == (uint16_t)0U)
+  {
+    eMB_History_PutBits(valueCol, &pBlock->valueBitPos, 0x0U, 1U);
+  }
+  else
+  {
+    for (lead = (uint8_t)0U; (xorVal & (uint16_t)(0x8000U >> lead)) == (uint16_t)0U; lead++);
+    for (trail = (uint8_t)0U; (xorVal & (uint16_t)(0x0001U << trail)) == (uint16_t)0U; trail++);
+
+    if ((pPoint->lastLead != (uint8_t)eMB_HISTORY_WINDOW_NONE) && (lead >= pPoint->lastLead) && (trail >= pPoint->lastTrail))
+    {
+      eMB_History_PutBits(valueCol, &pBlock->valueBitPos, 0x2U, 2U);
+      eMB_History_PutBits(valueCol, &pBlock->valueBitPos, (uint32_t)(xorVal >> pPoint->lastTrail),
+                          (uint8_t)(16U - pPoint->lastLead - pPoint->lastTrail));
+    }
+    else
+    {
+      eMB_History_PutBits(valueCol, &pBlock->valueBitPos, 0x3U, 2U);
+      eMB_History_PutBits(valueCol, &pBlock->valueBitPos, lead, 4U);
+      eMB_History_PutBits(valueCol, &pBlock->valueBitPos, (uint32_t)(16U - lead - trail - 1U), 4U);
+      eMB_History_PutBits(valueCol, &pBlock->valueBitPos, (uint32_t)(xorVal >> trail), (uint8_t)(16U - lead - trail));
+
+      pPoint->lastLead  = lead;
+      pPoint->lastTrail = trail;
+    }
+  }
+
+  pPoint->lastTime  = time;
+  pPoint->lastDelta = delta;
+  pPoint->lastValue = value;
+
+  pBlock->sampleNum++;
+}
+
+/* Decode the sample following the one held by the cursor. */
+static void eMB_History_DecodeSample(uint16_t point, uint8_t block, eMB_HistoryCursorStruct *cursor)
+{
+  const uint8_t *timeCol  = eMB_HistoryTimeCol[point][block];
+  const uint8_t *valueCol = eMB_HistoryValueCol[point][block];
+  uint32_t dod;
+  uint8_t  len;
+
+  if (eMB_History_GetBits(timeCol, &cursor->timeBitPos, 1U) == 0U)
+  {
+    dod = 0U;
+  }
+  else if (eMB_History_GetBits(timeCol, &cursor->timeBitPos, 1U) == 0U)
+  {
+    dod = eMB_History_GetBits(timeCol, &cursor->timeBitPos, 7U) - 63U;
+  }
+  else if (eMB_History_GetBits(timeCol, &cursor->timeBitPos, 1U) == 0U)
+  {
+    dod = eMB_History_GetBits(timeCol, &cursor->timeBitPos, 9U) - 255U;
+  }
+  else if (eMB_History_GetBits(timeCol, &cursor->timeBitPos, 1U) == 0U)
+  {
+    dod = eMB_History_GetBits(timeCol, &cursor->timeBitPos, 12U) - 2047U;
+  }
+  else
+  {
+    dod = eMB_History_GetBits(timeCol, &cursor->timeBitPos, 32U);
+  }
+
+  cursor->delta += dod;
+  cursor->time  += cursor->delta;
+
+  if (eMB_History_GetBits(valueCol, &cursor->valueBitPos, 1U) != 0U)
+  {
+    if (eMB_History_GetBits(valueCol, &cursor->valueBitPos, 1U) != 0U)
+    {
+      cursor->lead  = (uint8_t)eMB_History_GetBits(valueCol, &cursor->valueBitPos, 4U);
+      len           = (uint8_t)(eMB_History_GetBits(valueCol, &cursor->valueBitPos, 4U) + 1U);
+      cursor->trail = (uint8_t)(16U - cursor->lead - len);
+    }
+    else
+    {
+      len = (uint8_t)(16U - cursor->lead - cursor->trail);
+    }
+
+    cursor->value ^= (uint16_t)(eMB_History_GetBits(valueCol, &cursor->valueBitPos, len) << cursor->trail);
+  }
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,162 @@
+/*
+ * File:   eMB_Phase.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 10:45 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+#ifdef eMB_MASTER_PHASE_ENABLED
+/* Transaction on the line, its points are also marked by the serial and timer interrupts */
+static volatile eMB_PhaseRecordStruct eMB_PhaseCurrent;
+static volatile bool                  eMB_PhaseActive;
+
+/* Completed transactions, oldest at eMB_PhaseTail */
+static eMB_PhaseRecordStruct eMB_PhaseRing[eMB_MASTER_PHASE_RECORD_NUM];
+static uint16_t              eMB_PhaseTail;
+static uint16_t              eMB_PhaseNum;
+
+static eMB_PhaseCallback     eMB_PhaseCbk;
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+void eMB_Phase_SetCallback(eMB_PhaseCallback callback)
+{
+  eMB_PhaseCbk = callback;
+}
+
+uint16_t eMB_Phase_Read(eMB_PhaseRecordStruct *records, uint16_t maxNum)
+{
+  uint16_t readNum = (uint16_t)0U;
+
+  if (records == NULL)
+  {
+    return readNum;
+  }
+
+  eMB_PortEnterCriticalSection();
+
+  while ((readNum < maxNum) && (eMB_PhaseNum != (uint16_t)0U))
+  {
+    records[readNum++] = eMB_PhaseRing[eMB_PhaseTail];
+
+    eMB_PhaseTail = (uint16_t)((eMB_PhaseTail + 1U) % (uint16_t)eMB_MASTER_PHASE_RECORD_NUM);
+    eMB_PhaseNum--;
+  }
+
+  eMB_PortExitCriticalSection();
+
+  return readNum;
+}
+
+/* The request took the line. */
+void eMB_Phase_Begin(void)
+{
+  uint8_t i;
+
+  eMB_PortEnterCriticalSection();
+
+  for (i = 0U; i < (uint8_t)eMB_PHASE_NUM; i++)
+  {
+    eMB_PhaseCurrent.time[i] = 0UL;
+  }
+
+  eMB_PhaseCurrent.pointMask = 0U;
+  eMB_PhaseActive = true;
+
+  eMB_PhaseCurrent.time[eMB_PHASE_TAKE] = eMB_Util_GetTimeUs();
+  eMB_PhaseCurrent.pointMask |= (uint8_t)(1U << eMB_PHASE_TAKE);
+
+  eMB_PortExitCriticalSection();
+}
+
+/* A point of the transaction on the line was reached, the first time counts. */
+void eMB_Phase_Mark(eMB_PhasePointType point)
+{
+  if ((eMB_PhaseActive == true) && ((eMB_PhaseCurrent.pointMask & (uint8_t)(1U << point)) == 0U))
+  {
+    eMB_PhaseCurrent.time[point] = eMB_Util_GetTimeUs();
+    eMB_PhaseCurrent.pointMask |= (uint8_t)(1U << point);
+  }
+}
+
+/* eMB_MainFunction() starts to send the request. */
+void eMB_Phase_Sent(uint8_t slaveAddr, uint8_t funcCode)
+{
+  eMB_PhaseCurrent.slaveAddr = slaveAddr;
+  eMB_PhaseCurrent.funcCode  = funcCode;
+
+  eMB_Phase_Mark(eMB_PHASE_SENT);
+}
+
+/* The transaction completed, keep its record. */
+void eMB_Phase_End(eMB_ErrorCodeType status, eMB_ExceptionType exception)
+{
+  eMB_PhaseRecordStruct *pRecord;
+  uint16_t headIdx;
+
+  if (eMB_PhaseActive == false)
+  {
+    return;
+  }
+
+  eMB_Phase_Mark(eMB_PHASE_DONE);
+
+  eMB_PortEnterCriticalSection();
+
+  eMB_PhaseActive = false;
+
+  eMB_PhaseCurrent.status    = status;
+  eMB_PhaseCurrent.exception = (uint8_t)exception;
+
+  /* A full ring drops its oldest record. */
+  if (eMB_PhaseNum == (uint16_t)eMB_MASTER_PHASE_RECORD_NUM)
+  {
+    eMB_PhaseTail = (uint16_t)((eMB_PhaseTail + 1U) % (uint16_t)eMB_MASTER_PHASE_RECORD_NUM);
+    eMB_PhaseNum--;
+  }
+
+  headIdx = (uint16_t)((eMB_PhaseTail + eMB_PhaseNum) % (uint16_t)eMB_MASTER_PHASE_RECORD_NUM);
+  pRecord = &eMB_PhaseRing[headIdx];
+  *pRecord = *(const eMB_PhaseRecordStruct *)&eMB_PhaseCurrent;
+  eMB_PhaseNum++;
+
+  eMB_PortExitCriticalSection();
+
+  if (eMB_PhaseCbk != NULL)
+  {
+    eMB_PhaseCbk(pRecord);
+  }
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,214 @@
+/*
+ * File:   eMB_Profile.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 01:15 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_PROFILE_ENABLED
+/* Fails to compile with a negative array size if cond is false. */
+#define eMB_PROFILE_STATIC_ASSERT(name, cond)     typedef char name[(cond) ? 1 : -1]
+
+/* Every poll entry must be one valid read request. */
+#define eMB_PROFILE_GEN_POLL_CHECK(name, slave, type, addr, num, period)                          \
+  eMB_PROFILE_STATIC_ASSERT(eMB_ProfilePollCheck_##name,                                          \
+                            ((slave) >= 1) && ((slave) <= eMB_MASTER_TOTAL_SLAVE_NUM) &&          \
+                            ((num) >= 1) && ((num) <= eMB_PROFILE_PDU_MAX(type)) &&               \
+                            ((addr) + (num) <= eMB_PROFILE_ADDR_SPACE) && ((period) > 0));
+eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_POLL_CHECK)
+
+/* Every point must lie inside its poll entry. */
+#define eMB_PROFILE_GEN_POINT_CHECK(name, poll, offset, num)                                      \
+  eMB_PROFILE_STATIC_ASSERT(eMB_ProfilePointCheck_##name,                                         \
+                            ((num) >= 1) && ((offset) + (num) <= eMB_PROFILE_POLL_NREG_##poll));
+eMB_PROFILE_POINT_TABLE(eMB_PROFILE_GEN_POINT_CHECK)
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static const eMB_ProfileEntryStruct eMB_ProfilePollPlan[eMB_PROFILE_POLL_NUM] =
+{
+#define eMB_PROFILE_GEN_POLL_ENTRY(name, slave, type, addr, num, period)                          \
+  { (period), (addr), (num), (slave), (type) },
+  eMB_PROFILE_POLL_TABLE(eMB_PROFILE_GEN_POLL_ENTRY)
+#undef eMB_PROFILE_GEN_POLL_ENTRY
+};
+
+static const eMB_ProfileEntryStruct eMB_ProfilePointTable[eMB_PROFILE_POINT_NUM] =
+{
+#define eMB_PROFILE_GEN_POINT_ENTRY(name, poll, offset, num)                                      \
+  { eMB_PROFILE_POLL_PERIOD_##poll, eMB_PROFILE_ADDR_##name, (num),                               \
+    eMB_PROFILE_SLAVE_##name, eMB_PROFILE_TYPE_##name },
+  eMB_PROFILE_POINT_TABLE(eMB_PROFILE_GEN_POINT_ENTRY)
+#undef eMB_PROFILE_GEN_POINT_ENTRY
+};
+
+/* Time at which every poll entry is due next */
+static uint32_t eMB_ProfileDueTime[eMB_PROFILE_POLL_NUM];
+
+/* Poll entry checked first by the next call */
+static uint16_t eMB_ProfileNextPoll;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static eMB_ErrorCodeType eMB_Profile_Request(const eMB_ProfileEntryStruct *entry);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_Profile_PollFunction(void)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint32_t now = eMB_Util_GetTime();
+  uint16_t pollIdx;
+  uint16_t i;
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_PROFILE_POLL_NUM; i++)
+  {
+    pollIdx = (uint16_t)((eMB_ProfileNextPoll + i) % (uint16_t)eMB_PROFILE_POLL_NUM);
+
+    if ((int32_t)(now - eMB_ProfileDueTime[pollIdx]) >= 0)
+    {
+      errStatus = eMB_Profile_Request(&eMB_ProfilePollPlan[pollIdx]);
+
+      /* Only a busy master is tried again by the next call. Other errors, like an
+       * offline slave or a table which is not compiled in, wait for the next period
+       * so a failing entry cannot starve the others. */
+      if (errStatus != eMB_EBUSY)
+      {
+        eMB_ProfileDueTime[pollIdx] = now + eMB_ProfilePollPlan[pollIdx].periodMs;
+        eMB_ProfileNextPoll = (uint16_t)((pollIdx + 1U) % (uint16_t)eMB_PROFILE_POLL_NUM);
+      }
+
+      break;
+    }
+  }
+
+  return errStatus;
+}
+
+const eMB_ProfileEntryStruct *eMB_Profile_GetPoll(eMB_ProfilePollType poll)
+{
+  if ((uint16_t)poll >= (uint16_t)eMB_PROFILE_POLL_NUM)
+  {
+    return NULL;
+  }
+
+  return &eMB_ProfilePollPlan[poll];
+}
+
+const eMB_ProfileEntryStruct *eMB_Profile_GetPoint(eMB_ProfilePointType point)
+{
+  if ((uint16_t)point >= (uint16_t)eMB_PROFILE_POINT_NUM)
+  {
+    return NULL;
+  }
+
+  return &eMB_ProfilePointTable[point];
+}
+
+eMB_ErrorCodeType eMB_Profile_ReadPoint(eMB_ProfilePointType point, void *valueBuf)
+{
+  const eMB_ProfileEntryStruct *pPoint = eMB_Profile_GetPoint(point);
+
+  if ((pPoint == NULL) || (valueBuf == NULL))
+  {
+    return eMB_EINVAL;
+  }
+
+  if ((pPoint->regType == (uint8_t)eMB_REG_INPUT) || (pPoint->regType == (uint8_t)eMB_REG_HOLDING))
+  {
+    return eMB_Shadow_ReadRegisters(eMB_gShadowPtr, (eMB_RegType)pPoint->regType, pPoint->slaveAddr,
+                                    pPoint->addr, pPoint->num, (uint16_t *)valueBuf);
+  }
+
+  return eMB_Shadow_ReadBits(eMB_gShadowPtr, (eMB_RegType)pPoint->regType, pPoint->slaveAddr,
+                             pPoint->addr, pPoint->num, (uint8_t *)valueBuf);
+}
+
+
+
+
+
+/* Issue the read request of a poll plan entry. */
+static eMB_ErrorCodeType eMB_Profile_Request(const eMB_ProfileEntryStruct *entry)
+{
+  eMB_ErrorCodeType errStatus = eMB_EINVAL;
+
+  switch (entry->regType)
+  {
+#ifdef eMB_FUNC_READ_COILS_ENABLED
+    case eMB_REG_COILS:
+    {
+      errStatus = eMB_Master_RequestReadCoils(entry->slaveAddr, entry->addr, entry->num);
+      break;
+    }
+#endif
+#ifdef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
+    case eMB_REG_DISCRETE_INPUTS:
+    {
+      errStatus = eMB_Master_RequestReadDiscreteInputs(entry->slaveAddr, entry->addr, entry->num);
+      break;
+    }
+#endif
+#ifdef eMB_FUNC_READ_INPUT_ENABLED
+    case eMB_REG_INPUT:
+    {
+      errStatus = eMB_Master_RequestReadInputRegister(entry->slaveAddr, entry->addr, entry->num);
+      break;
+    }
+#endif
+#ifdef eMB_FUNC_READ_HOLDING_ENABLED
+    case eMB_REG_HOLDING:
+    {
+      errStatus = eMB_Master_RequestReadHoldingRegister(entry->slaveAddr, entry->addr, entry->num);
+      break;
+    }
+#endif
+    default:
+    {
+      break;
+    }
+  }
+
+  return errStatus;
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
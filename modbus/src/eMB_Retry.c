@@ -0,0 +1,321 @@
+/*
+ * File:   eMB_Retry.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 09:40 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_RETRY_ENABLED
+#define eMB_RETRY_REQ_NONE                        ( 0xFFU )
+
+/* Busy delays double up to 2^eMB_RETRY_BUSY_SHIFT_MAX times busyDelayMs */
+#define eMB_RETRY_BUSY_SHIFT_MAX                  ( 16U )
+
+/* Failed request which waits for its retry */
+typedef struct _eMB_RetryReqStruct
+{
+  uint32_t                    dueTime;            /*!< Time of the retry. */
+  uint16_t                    pduLength;          /*!< Request PDU length. */
+  uint8_t                     slaveAddr;          /*!< Slave address. */
+  uint8_t                     retryNum;           /*!< Retries after timeouts so far. */
+  uint8_t                     busyRetryNum;       /*!< Retries after 0x06 so far. */
+  uint8_t                     ackPollNum;         /*!< Repetitions after 0x05 so far. */
+  bool                        inUse;              /*!< Entry holds a request. */
+  uint8_t                     pduBuf[eMB_PDU_SIZE_MAX];
+} eMB_RetryReqStruct;
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static eMB_RetryReqStruct    eMB_RetryQueue[eMB_MASTER_RETRY_QUEUE_SIZE];
+
+/* Policies, set to the defaults of eMB_Cfg.h by the first call of this unit */
+static eMB_RetryPolicyStruct eMB_RetryPolicy[eMB_MASTER_TOTAL_SLAVE_NUM];
+static bool                  eMB_RetryReady;
+
+/* Retry on the line and the entry which is looked at first by the next dispatch */
+static uint8_t               eMB_RetryCurrent = (uint8_t)eMB_RETRY_REQ_NONE;
+static uint8_t               eMB_RetryNext;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_Retry_Init(void);
+static bool eMB_Retry_IsDue(const eMB_RetryReqStruct *pReq, uint32_t now);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_Retry_SetPolicy(uint8_t slaveAddr, const eMB_RetryPolicyStruct *policy)
+{
+  uint8_t i;
+
+  if ((slaveAddr > (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM) || (policy == NULL))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_Retry_Init();
+
+  for (i = (uint8_t)eMB_ADDRESS_MIN; i <= (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM; i++)
+  {
+    if ((slaveAddr == (uint8_t)eMB_ADDRESS_BROADCAST) || (slaveAddr == i))
+    {
+      eMB_RetryPolicy[i - 1U] = *policy;
+    }
+  }
+
+  return eMB_ENOERR;
+}
+
+void eMB_Retry_Dispatch(void)
+{
+  eMB_RetryReqStruct *pReq = NULL;
+  uint8_t *pduFrame;
+  uint32_t now = eMB_Util_GetTime();
+  uint8_t reqIdx = eMB_RetryNext;
+  uint8_t i;
+
+  if (eMB_RetryCurrent != (uint8_t)eMB_RETRY_REQ_NONE)
+  {
+    return;
+  }
+
+  for (i = 0U; i < (uint8_t)eMB_MASTER_RETRY_QUEUE_SIZE; i++)
+  {
+    if (eMB_Retry_IsDue(&eMB_RetryQueue[reqIdx], now) == true)
+    {
+      pReq = &eMB_RetryQueue[reqIdx];
+      break;
+    }
+
+    reqIdx = (uint8_t)((reqIdx + 1U) % (uint8_t)eMB_MASTER_RETRY_QUEUE_SIZE);
+  }
+
+  if (pReq == NULL)
+  {
+    return;
+  }
+
+#ifdef eMB_MASTER_HEALTH_ENABLED
+  /* The slave went offline meanwhile, its probes are up to the application. */
+  if (eMB_Health_IsAvailable(pReq->slaveAddr) == false)
+  {
+    pReq->inUse = false;
+    return;
+  }
+#endif
+
+  /* The line is shared with the requests of the application. */
+  if (eMB_Util_ResourceTake() == false)
+  {
+    return;
+  }
+
+  eMB_RetryCurrent = reqIdx;
+  eMB_RetryNext = (uint8_t)((reqIdx + 1U) % (uint8_t)eMB_MASTER_RETRY_QUEUE_SIZE);
+
+  eMB_FrameGetSendPduBufferCalloutArr(&pduFrame);
+  memcpy(pduFrame, pReq->pduBuf, pReq->pduLength);
+
+  eMB_FrameSetSlaveAddressCalloutArr(pReq->slaveAddr);
+  eMB_FrameSetSendPduLengthCalloutArr(pReq->pduLength);
+
+  (void)eMB_gConfigPtr->pPortEventPost(eMB_EV_FRAME_SENT);
+}
+
+void eMB_Retry_Done(void)
+{
+  if (eMB_RetryCurrent != (uint8_t)eMB_RETRY_REQ_NONE)
+  {
+    eMB_RetryQueue[eMB_RetryCurrent].inUse = false;
+    eMB_RetryCurrent = (uint8_t)eMB_RETRY_REQ_NONE;
+  }
+}
+
+void eMB_Retry_Failed(eMB_ErrorEventType errorType, eMB_ExceptionType exptStatus)
+{
+  const eMB_RetryPolicyStruct *pPolicy;
+  eMB_RetryReqStruct *pReq;
+  uint8_t *pduFrame;
+  uint8_t slaveAddr = eMB_FrameGetSlaveAddressCalloutArr();
+  uint8_t reqIdx = eMB_RetryCurrent;
+  uint8_t retryNum = 0U;
+  uint8_t busyRetryNum = 0U;
+  uint8_t ackPollNum = 0U;
+  uint32_t delayMs = 0UL;
+  bool isRetried = false;
+  uint8_t i;
+
+  eMB_RetryCurrent = (uint8_t)eMB_RETRY_REQ_NONE;
+
+#ifdef eMB_GATEWAY_ENABLED
+  /* TCP clients retry on their own. */
+  if (eMB_Gateway_IsForwarding() == true)
+  {
+    return;
+  }
+#endif
+
+  if ((slaveAddr < (uint8_t)eMB_ADDRESS_MIN) || (slaveAddr > (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM))
+  {
+    return;
+  }
+
+  eMB_Retry_Init();
+
+  pPolicy = &eMB_RetryPolicy[slaveAddr - 1U];
+
+  if (reqIdx != (uint8_t)eMB_RETRY_REQ_NONE)
+  {
+    retryNum     = eMB_RetryQueue[reqIdx].retryNum;
+    busyRetryNum = eMB_RetryQueue[reqIdx].busyRetryNum;
+    ackPollNum   = eMB_RetryQueue[reqIdx].ackPollNum;
+  }
+
+  if ((errorType == eMB_EV_ERROR_RESPOND_TIMEOUT) || (errorType == eMB_EV_ERROR_RECEIVE_DATA))
+  {
+    if (retryNum < pPolicy->retryNum)
+    {
+      retryNum++;
+      delayMs = pPolicy->delayMs;
+      isRetried = true;
+    }
+  }
+  else if (exptStatus == eMB_EX_SLAVE_BUSY)
+  {
+    if (busyRetryNum < pPolicy->busyRetryNum)
+    {
+      delayMs = (uint32_t)pPolicy->busyDelayMs <<
+                ((busyRetryNum < eMB_RETRY_BUSY_SHIFT_MAX) ? busyRetryNum : eMB_RETRY_BUSY_SHIFT_MAX);
+      busyRetryNum++;
+      isRetried = true;
+    }
+  }
+  else if (exptStatus == eMB_EX_ACKNOWLEDGE)
+  {
+    if (ackPollNum < pPolicy->ackPollNum)
+    {
+      ackPollNum++;
+      delayMs = pPolicy->ackPollMs;
+      isRetried = true;
+    }
+  }
+  else
+  {
+    /* Other exceptions will not change by sending the request again. */
+  }
+
+  if (isRetried == false)
+  {
+    if (reqIdx != (uint8_t)eMB_RETRY_REQ_NONE)
+    {
+      eMB_RetryQueue[reqIdx].inUse = false;
+    }
+
+    return;
+  }
+
+  /* First failure of the request: it is still in the send buffer. */
+  if (reqIdx == (uint8_t)eMB_RETRY_REQ_NONE)
+  {
+    for (i = 0U; i < (uint8_t)eMB_MASTER_RETRY_QUEUE_SIZE; i++)
+    {
+      if (eMB_RetryQueue[i].inUse == false)
+      {
+        reqIdx = i;
+        break;
+      }
+    }
+
+    if (reqIdx == (uint8_t)eMB_RETRY_REQ_NONE)
+    {
+      return;
+    }
+
+    pReq = &eMB_RetryQueue[reqIdx];
+
+    eMB_FrameGetSendPduBufferCalloutArr(&pduFrame);
+    pReq->pduLength = eMB_FrameGetSendPduLengthCalloutArr();
+    pReq->slaveAddr = slaveAddr;
+    memcpy(pReq->pduBuf, pduFrame, pReq->pduLength);
+  }
+
+  pReq = &eMB_RetryQueue[reqIdx];
+
+  pReq->retryNum     = retryNum;
+  pReq->busyRetryNum = busyRetryNum;
+  pReq->ackPollNum   = ackPollNum;
+  pReq->dueTime      = eMB_Util_GetTime() + delayMs;
+  pReq->inUse        = true;
+}
+
+
+
+
+
+/* Set the policies to the defaults once. */
+static void eMB_Retry_Init(void)
+{
+  uint8_t i;
+
+  if (eMB_RetryReady == false)
+  {
+    for (i = 0U; i < (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM; i++)
+    {
+      eMB_RetryPolicy[i].retryNum     = (uint8_t)eMB_MASTER_RETRY_NUM;
+      eMB_RetryPolicy[i].busyRetryNum = (uint8_t)eMB_MASTER_RETRY_BUSY_NUM;
+      eMB_RetryPolicy[i].ackPollNum   = (uint8_t)eMB_MASTER_RETRY_ACK_POLL_NUM;
+      eMB_RetryPolicy[i].delayMs      = (uint16_t)eMB_MASTER_RETRY_DELAY_MS;
+      eMB_RetryPolicy[i].busyDelayMs  = (uint16_t)eMB_MASTER_RETRY_BUSY_DELAY_MS;
+      eMB_RetryPolicy[i].ackPollMs    = (uint16_t)eMB_MASTER_RETRY_ACK_POLL_MS;
+    }
+
+    eMB_RetryReady = true;
+  }
+}
+
+/* Check if a queued request is due. Without a clock it is due at once. */
+static bool eMB_Retry_IsDue(const eMB_RetryReqStruct *pReq, uint32_t now)
+{
+  return (pReq->inUse == true) &&
+         ((eMB_gConfigPtr->pPortTimeGet == NULL) || ((int32_t)(now - pReq->dueTime) >= 0));
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,185 @@
+/*
+ * File:   eMB_Rtt.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 07:30 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/* Respond timeout without samples, eMB_MASTER_TIMEOUT_MS_RESPOND is in 100us */
+#define eMB_RTT_TIMEOUT_DEFAULT_US                ( (uint32_t)eMB_MASTER_TIMEOUT_MS_RESPOND * 100UL )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+#ifdef eMB_MASTER_RTT_ENABLED
+/* Written in the context of eMB_MainFunction() and of the timer interrupt,
+ * read by the port when the respond timer is started. */
+static volatile eMB_RttStatsStruct eMB_RttStats[eMB_MASTER_TOTAL_SLAVE_NUM];
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static uint32_t eMB_Rtt_Limit(uint32_t rto);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+uint32_t eMB_Rtt_GetTimeout(void)
+{
+  uint32_t rto = eMB_Rtt_Limit(eMB_RTT_TIMEOUT_DEFAULT_US);
+#ifdef eMB_MASTER_RTT_ENABLED
+  uint8_t slaveAddr = eMB_FrameGetSlaveAddressCalloutArr();
+
+  if ((slaveAddr >= (uint8_t)eMB_ADDRESS_MIN) && (slaveAddr <= (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM) &&
+      (eMB_RttStats[slaveAddr - 1U].rto != 0UL))
+  {
+    rto = eMB_RttStats[slaveAddr - 1U].rto;
+  }
+#endif
+
+  return rto;
+}
+
+#ifdef eMB_MASTER_RTT_ENABLED
+eMB_ErrorCodeType eMB_Rtt_GetStats(uint8_t slaveAddr, eMB_RttStatsStruct *stats)
+{
+  if ((slaveAddr < (uint8_t)eMB_ADDRESS_MIN) || (slaveAddr > (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM) || (stats == NULL))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_PortEnterCriticalSection();
+
+  stats->srtt       = eMB_RttStats[slaveAddr - 1U].srtt;
+  stats->rttvar     = eMB_RttStats[slaveAddr - 1U].rttvar;
+  stats->rto        = eMB_RttStats[slaveAddr - 1U].rto;
+  stats->last       = eMB_RttStats[slaveAddr - 1U].last;
+  stats->sampleNum  = eMB_RttStats[slaveAddr - 1U].sampleNum;
+  stats->timeoutNum = eMB_RttStats[slaveAddr - 1U].timeoutNum;
+
+  eMB_PortExitCriticalSection();
+
+  if (stats->rto == 0UL)
+  {
+    stats->rto = eMB_Rtt_Limit(eMB_RTT_TIMEOUT_DEFAULT_US);
+  }
+
+  return eMB_ENOERR;
+}
+
+void eMB_Rtt_Sample(uint8_t slaveAddr, uint32_t sendTime, uint32_t recvTime)
+{
+  volatile eMB_RttStatsStruct *pStats;
+  uint32_t sample = (uint32_t)(recvTime - sendTime);
+  uint32_t delta;
+  uint32_t granularity;
+
+  if ((slaveAddr < (uint8_t)eMB_ADDRESS_MIN) || (slaveAddr > (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM))
+  {
+    return;
+  }
+
+  pStats = &eMB_RttStats[slaveAddr - 1U];
+
+  if (pStats->sampleNum == 0UL)
+  {
+    pStats->srtt   = sample;
+    pStats->rttvar = sample / 2UL;
+  }
+  else
+  {
+    delta = (pStats->srtt > sample) ? (pStats->srtt - sample) : (sample - pStats->srtt);
+
+    pStats->rttvar = pStats->rttvar - (pStats->rttvar / 4UL) + (delta / 4UL);
+    pStats->srtt   = pStats->srtt - (pStats->srtt / 8UL) + (sample / 8UL);
+  }
+
+  /* Without a microsecond clock the samples are multiples of 1 ms. */
+  granularity = (eMB_gConfigPtr->pPortTimeGetUs != NULL) ? 1UL : 1000UL;
+
+  pStats->rto = eMB_Rtt_Limit(pStats->srtt + ((4UL * pStats->rttvar > granularity) ? (4UL * pStats->rttvar) : granularity));
+  pStats->last = sample;
+  pStats->sampleNum++;
+}
+
+void eMB_Rtt_Timeout(uint8_t slaveAddr)
+{
+  volatile eMB_RttStatsStruct *pStats;
+
+  if ((slaveAddr < (uint8_t)eMB_ADDRESS_MIN) || (slaveAddr > (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM))
+  {
+    return;
+  }
+
+  pStats = &eMB_RttStats[slaveAddr - 1U];
+
+  /* Back off until the slave answers again (Karn). */
+  if (pStats->sampleNum != 0UL)
+  {
+    pStats->rto = eMB_Rtt_Limit(2UL * pStats->rto);
+  }
+
+  pStats->timeoutNum++;
+}
+#endif
+
+
+
+
+
+/* Limit a respond timeout to the configured range. */
+static uint32_t eMB_Rtt_Limit(uint32_t rto)
+{
+#ifdef eMB_MASTER_RTT_ENABLED
+  if (rto < (uint32_t)eMB_MASTER_RTT_TIMEOUT_MIN_US)
+  {
+    rto = (uint32_t)eMB_MASTER_RTT_TIMEOUT_MIN_US;
+  }
+  else if (rto > (uint32_t)eMB_MASTER_RTT_TIMEOUT_MAX_US)
+  {
+    rto = (uint32_t)eMB_MASTER_RTT_TIMEOUT_MAX_US;
+  }
+#endif
+
+  return rto;
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,488 @@
+/*
+ * File:   eMB_Shadow.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 10:40 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Shadow.h"
+#include "eMB_CRC.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/* Full memory barrier between sequence counter and data accesses. */
+#if defined(__GNUC__)
+#define eMB_SHADOW_BARRIER()                      __sync_synchronize()
+#else
+#define eMB_SHADOW_BARRIER()
+#endif
+#endif
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+static eMB_ShadowStruct eMB_ShadowStore;
+
+static eMB_ShadowNotifyCallback eMB_ShadowNotify;
+
+/* Blocks carry a CRC only in a store placed by eMB_Shadow_Restore(), it is read on the next restore. */
+static bool eMB_ShadowIsPersistent;
+
+/* Pointer to the shadow store used by the master */
+eMB_ShadowStruct *eMB_gShadowPtr = &eMB_ShadowStore;
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+static void     eMB_Shadow_InitHeader(eMB_ShadowHeaderStruct *header);
+static uint8_t *eMB_Shadow_GetBlock(const eMB_ShadowStruct *shadow, uint8_t regType, uint8_t slaveIdx, uint16_t *blockSize);
+#endif
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+eMB_ErrorCodeType eMB_Shadow_Attach(void *mem, uint32_t size, eMB_ShadowNotifyCallback notify)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  eMB_ShadowStruct *shadow = (mem == NULL) ? &eMB_ShadowStore : (eMB_ShadowStruct *)mem;
+
+  if ((mem != NULL) && (size < (uint32_t)sizeof(eMB_ShadowStruct)))
+  {
+    errStatus = eMB_EINVAL;
+  }
+  else
+  {
+    memset(shadow, 0, sizeof(eMB_ShadowStruct));
+    eMB_Shadow_InitHeader(&shadow->header);
+
+    shadow->header.generation = (uint16_t)1U;
+
+    eMB_gShadowPtr = shadow;
+    eMB_ShadowNotify = notify;
+    eMB_ShadowIsPersistent = false;
+  }
+
+  return errStatus;
+}
+
+eMB_ErrorCodeType eMB_Shadow_Restore(void *mem, uint32_t size, eMB_ShadowNotifyCallback notify)
+{
+  eMB_ShadowStruct *shadow = (eMB_ShadowStruct *)mem;
+  eMB_ShadowBlockInfoStruct *pInfo;
+  uint8_t *pBlock;
+  uint16_t blockSize;
+  uint8_t slaveIdx, regType;
+
+  if ((mem == NULL) || (size < (uint32_t)sizeof(eMB_ShadowStruct)))
+  {
+    return eMB_EINVAL;
+  }
+
+  if (eMB_Shadow_Validate(shadow, size) != eMB_ENOERR)
+  {
+    (void)eMB_Shadow_Attach(mem, size, notify);
+    eMB_ShadowIsPersistent = true;
+
+    return eMB_EIO;
+  }
+
+  shadow->header.generation++;
+
+  for (slaveIdx = (uint8_t)0U; slaveIdx < (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM; slaveIdx++)
+  {
+    for (regType = (uint8_t)0U; regType < (uint8_t)eMB_SHADOW_TABLE_NUM; regType++)
+    {
+      pBlock = eMB_Shadow_GetBlock(shadow, regType, slaveIdx, &blockSize);
+      pInfo  = &shadow->info[slaveIdx][regType];
+
+      /* A crash may have left a block in the middle of an update. */
+      shadow->seq[slaveIdx][regType] = 0U;
+
+      if ((pInfo->status != (uint8_t)eMB_SHADOW_BLOCK_EMPTY) && (eMB_GetCRC(pBlock, blockSize) == pInfo->crc))
+      {
+        pInfo->status = (uint8_t)eMB_SHADOW_BLOCK_STALE;
+      }
+      else
+      {
+        memset(pBlock, 0, blockSize);
+        memset(pInfo, 0, sizeof(eMB_ShadowBlockInfoStruct));
+      }
+    }
+  }
+
+  eMB_gShadowPtr = shadow;
+  eMB_ShadowNotify = notify;
+  eMB_ShadowIsPersistent = true;
+
+  return eMB_ENOERR;
+}
+
+eMB_ErrorCodeType eMB_Shadow_Validate(const eMB_ShadowStruct *shadow, uint32_t size)
+{
+  eMB_ShadowHeaderStruct expected;
+
+  if ((shadow == NULL) || (size < (uint32_t)sizeof(eMB_ShadowStruct)))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_Shadow_InitHeader(&expected);
+
+  /* Everything before the checksum describes the layout. */
+  if ((memcmp(&shadow->header, &expected, offsetof(eMB_ShadowHeaderStruct, crc)) != 0) ||
+      (shadow->header.crc != expected.crc))
+  {
+    return eMB_EINVAL;
+  }
+
+  return eMB_ENOERR;
+}
+
+eMB_ErrorCodeType eMB_Shadow_ReadRegisters(const eMB_ShadowStruct *shadow, eMB_RegType regType, uint8_t slaveAddr,
+                                           uint16_t regAddr, uint16_t regNum, uint16_t *regBuf)
+{
+  const uint16_t *pRegBuf;
+  uint16_t regStart, regTotal;
+  uint32_t seqBegin;
+  uint16_t retry;
+
+  if ((shadow == NULL) || (regBuf == NULL) || (slaveAddr < 1U) || (slaveAddr > eMB_MASTER_TOTAL_SLAVE_NUM))
+  {
+    return eMB_EINVAL;
+  }
+
+  if (regType == eMB_REG_INPUT)
+  {
+    pRegBuf  = shadow->inputBuf[slaveAddr - 1U];
+    regStart = eMB_MASTER_REG_INPUT_START;
+    regTotal = eMB_MASTER_REG_INPUT_NREGS;
+  }
+  else if (regType == eMB_REG_HOLDING)
+  {
+    pRegBuf  = shadow->holdingBuf[slaveAddr - 1U];
+    regStart = eMB_MASTER_REG_HOLDING_START;
+    regTotal = eMB_MASTER_REG_HOLDING_NREGS;
+  }
+  else
+  {
+    return eMB_EINVAL;
+  }
+
+  if ((regAddr < regStart) || ((uint32_t)regAddr + regNum > (uint32_t)regStart + regTotal))
+  {
+    return eMB_ENOREG;
+  }
+
+  for (retry = (uint16_t)0U; retry < (uint16_t)eMB_SHADOW_READ_RETRY_MAX; retry++)
+  {
+    seqBegin = shadow->seq[slaveAddr - 1U][regType];
+    eMB_SHADOW_BARRIER();
+
+    if ((seqBegin & 1U) == 0U)
+    {
+      memcpy(regBuf, &pRegBuf[regAddr - regStart], (size_t)regNum * sizeof(uint16_t));
+      eMB_SHADOW_BARRIER();
+
+      if (shadow->seq[slaveAddr - 1U][regType] == seqBegin)
+      {
+        return eMB_ENOERR;
+      }
+    }
+  }
+
+  return eMB_EBUSY;
+}
+
+eMB_ErrorCodeType eMB_Shadow_ReadRegistersPdu(const eMB_ShadowStruct *shadow, eMB_RegType regType, uint8_t slaveAddr,
+                                              uint16_t regAddr, uint16_t regNum, uint8_t *pduBuf)
+{
+  const uint16_t *pRegBuf;
+  uint16_t regStart, regTotal;
+  uint16_t regIdx;
+  uint32_t seqBegin;
+  uint16_t retry;
+
+  if ((shadow == NULL) || (pduBuf == NULL) || (slaveAddr < 1U) || (slaveAddr > eMB_MASTER_TOTAL_SLAVE_NUM))
+  {
+    return eMB_EINVAL;
+  }
+
+  if (regType == eMB_REG_INPUT)
+  {
+    pRegBuf  = shadow->inputBuf[slaveAddr - 1U];
+    regStart = eMB_MASTER_REG_INPUT_START;
+    regTotal = eMB_MASTER_REG_INPUT_NREGS;
+  }
+  else if (regType == eMB_REG_HOLDING)
+  {
+    pRegBuf  = shadow->holdingBuf[slaveAddr - 1U];
+    regStart = eMB_MASTER_REG_HOLDING_START;
+    regTotal = eMB_MASTER_REG_HOLDING_NREGS;
+  }
+  else
+  {
+    return eMB_EINVAL;
+  }
+
+  if ((regAddr < regStart) || ((uint32_t)regAddr + regNum > (uint32_t)regStart + regTotal))
+  {
+    return eMB_ENOREG;
+  }
+
+  pRegBuf = &pRegBuf[regAddr - regStart];
+
+  for (retry = (uint16_t)0U; retry < (uint16_t)eMB_SHADOW_READ_RETRY_MAX; retry++)
+  {
+    seqBegin = shadow->seq[slaveAddr - 1U][regType];
+    eMB_SHADOW_BARRIER();
+
+    if ((seqBegin & 1U) == 0U)
+    {
+      for (regIdx = (uint16_t)0U; regIdx < regNum; regIdx++)
+      {
+        pduBuf[2U * regIdx]      = (uint8_t)(pRegBuf[regIdx] >> 8U);
+        pduBuf[2U * regIdx + 1U] = (uint8_t)(pRegBuf[regIdx] & (uint16_t)0x00FFU);
+      }
+
+      eMB_SHADOW_BARRIER();
+
+      if (shadow->seq[slaveAddr - 1U][regType] == seqBegin)
+      {
+        return eMB_ENOERR;
+      }
+    }
+  }
+
+  return eMB_EBUSY;
+}
+
+eMB_ErrorCodeType eMB_Shadow_ReadBits(const eMB_ShadowStruct *shadow, eMB_RegType regType, uint8_t slaveAddr,
+                                      uint16_t bitAddr, uint16_t bitNum, uint8_t *bitBuf)
+{
+  const uint8_t *pBitBuf;
+  uint16_t bitStart, bitTotal;
+  uint16_t bitIdx, bitPos;
+  uint32_t seqBegin;
+  uint16_t retry;
+
+  if ((shadow == NULL) || (bitBuf == NULL) || (slaveAddr < 1U) || (slaveAddr > eMB_MASTER_TOTAL_SLAVE_NUM))
+  {
+    return eMB_EINVAL;
+  }
+
+  if (regType == eMB_REG_COILS)
+  {
+    pBitBuf  = shadow->coilBuf[slaveAddr - 1U];
+    bitStart = eMB_MASTER_COIL_START;
+    bitTotal = eMB_MASTER_COIL_NCOILS;
+  }
+  else if (regType == eMB_REG_DISCRETE_INPUTS)
+  {
+    pBitBuf  = shadow->discreteBuf[slaveAddr - 1U];
+    bitStart = eMB_MASTER_DISCRETE_INPUT_START;
+    bitTotal = eMB_MASTER_DISCRETE_INPUT_NDISCRETES;
+  }
+  else
+  {
+    return eMB_EINVAL;
+  }
+
+  if ((bitAddr < bitStart) || ((uint32_t)bitAddr + bitNum > (uint32_t)bitStart + bitTotal))
+  {
+    return eMB_ENOREG;
+  }
+
+  for (retry = (uint16_t)0U; retry < (uint16_t)eMB_SHADOW_READ_RETRY_MAX; retry++)
+  {
+    seqBegin = shadow->seq[slaveAddr - 1U][regType];
+    eMB_SHADOW_BARRIER();
+
+    if ((seqBegin & 1U) == 0U)
+    {
+      memset(bitBuf, 0, (size_t)((bitNum + 7U) / 8U));
+
+      for (bitIdx = (uint16_t)0U; bitIdx < bitNum; bitIdx++)
+      {
+        bitPos = (uint16_t)(bitAddr - bitStart + bitIdx);
+
+        if ((pBitBuf[bitPos / 8U] & (uint8_t)(1U << (bitPos % 8U))) != (uint8_t)0U)
+        {
+          bitBuf[bitIdx / 8U] |= (uint8_t)(1U << (bitIdx % 8U));
+        }
+      }
+
+      eMB_SHADOW_BARRIER();
+
+      if (shadow->seq[slaveAddr - 1U][regType] == seqBegin)
+      {
+        return eMB_ENOERR;
+      }
+    }
+  }
+
+  return eMB_EBUSY;
+}
+
+eMB_ErrorCodeType eMB_Shadow_ReadBlockInfo(const eMB_ShadowStruct *shadow, eMB_RegType regType, uint8_t slaveAddr,
+                                           eMB_ShadowBlockInfoStruct *info)
+{
+  uint32_t seqBegin;
+  uint16_t retry;
+
+  if ((shadow == NULL) || (info == NULL) || ((uint8_t)regType >= (uint8_t)eMB_SHADOW_TABLE_NUM) ||
+      (slaveAddr < 1U) || (slaveAddr > eMB_MASTER_TOTAL_SLAVE_NUM))
+  {
+    return eMB_EINVAL;
+  }
+
+  for (retry = (uint16_t)0U; retry < (uint16_t)eMB_SHADOW_READ_RETRY_MAX; retry++)
+  {
+    seqBegin = shadow->seq[slaveAddr - 1U][regType];
+    eMB_SHADOW_BARRIER();
+
+    if ((seqBegin & 1U) == 0U)
+    {
+      memcpy(info, &shadow->info[slaveAddr - 1U][regType], sizeof(eMB_ShadowBlockInfoStruct));
+      eMB_SHADOW_BARRIER();
+
+      if (shadow->seq[slaveAddr - 1U][regType] == seqBegin)
+      {
+        return eMB_ENOERR;
+      }
+    }
+  }
+
+  return eMB_EBUSY;
+}
+
+void eMB_Shadow_WriteBegin(eMB_RegType regType, uint8_t slaveAddr)
+{
+  /* Odd sequence: block is being updated. */
+  eMB_gShadowPtr->seq[slaveAddr - 1U][regType]++;
+  eMB_SHADOW_BARRIER();
+}
+
+void eMB_Shadow_WriteEnd(eMB_RegType regType, uint8_t slaveAddr, uint32_t time)
+{
+  eMB_ShadowBlockInfoStruct *pInfo = &eMB_gShadowPtr->info[slaveAddr - 1U][regType];
+  uint8_t *pBlock;
+  uint16_t blockSize;
+
+  pInfo->time       = time;
+  pInfo->generation = eMB_gShadowPtr->header.generation;
+  pInfo->status     = (uint8_t)eMB_SHADOW_BLOCK_VALID;
+
+  if (eMB_ShadowIsPersistent == true)
+  {
+    pBlock = eMB_Shadow_GetBlock(eMB_gShadowPtr, (uint8_t)regType, (uint8_t)(slaveAddr - 1U), &blockSize);
+    pInfo->crc = eMB_GetCRC(pBlock, blockSize);
+  }
+
+  eMB_SHADOW_BARRIER();
+  eMB_gShadowPtr->seq[slaveAddr - 1U][regType]++;
+
+  eMB_gShadowPtr->header.changeCount++;
+
+  if (eMB_ShadowNotify != NULL)
+  {
+    eMB_ShadowNotify();
+  }
+}
+
+
+
+
+
+static void eMB_Shadow_InitHeader(eMB_ShadowHeaderStruct *header)
+{
+  memset(header, 0, sizeof(eMB_ShadowHeaderStruct));
+
+  header->magic         = eMB_SHADOW_MAGIC;
+  header->version       = (uint16_t)eMB_SHADOW_VERSION;
+  header->headerSize    = (uint16_t)sizeof(eMB_ShadowHeaderStruct);
+  header->totalSize     = (uint32_t)sizeof(eMB_ShadowStruct);
+  header->slaveNum      = (uint16_t)eMB_MASTER_TOTAL_SLAVE_NUM;
+  header->coilStart     = (uint16_t)eMB_MASTER_COIL_START;
+  header->coilNum       = (uint16_t)eMB_MASTER_COIL_NCOILS;
+  header->discreteStart = (uint16_t)eMB_MASTER_DISCRETE_INPUT_START;
+  header->discreteNum   = (uint16_t)eMB_MASTER_DISCRETE_INPUT_NDISCRETES;
+  header->inputStart    = (uint16_t)eMB_MASTER_REG_INPUT_START;
+  header->inputNum      = (uint16_t)eMB_MASTER_REG_INPUT_NREGS;
+  header->holdingStart  = (uint16_t)eMB_MASTER_REG_HOLDING_START;
+  header->holdingNum    = (uint16_t)eMB_MASTER_REG_HOLDING_NREGS;
+
+  header->crc = eMB_GetCRC((uint8_t *)header, (uint16_t)offsetof(eMB_ShadowHeaderStruct, crc));
+}
+
+static uint8_t *eMB_Shadow_GetBlock(const eMB_ShadowStruct *shadow, uint8_t regType, uint8_t slaveIdx, uint16_t *blockSize)
+{
+  uint8_t *pBlock;
+
+  switch (regType)
+  {
+    case eMB_REG_COILS:
+    {
+      pBlock = (uint8_t *)shadow->coilBuf[slaveIdx];
+      *blockSize = (uint16_t)sizeof(shadow->coilBuf[slaveIdx]);
+      break;
+    }
+    case eMB_REG_DISCRETE_INPUTS:
+    {
+      pBlock = (uint8_t *)shadow->discreteBuf[slaveIdx];
+      *blockSize = (uint16_t)sizeof(shadow->discreteBuf[slaveIdx]);
+      break;
+    }
+    case eMB_REG_INPUT:
+    {
+      pBlock = (uint8_t *)shadow->inputBuf[slaveIdx];
+      *blockSize = (uint16_t)sizeof(shadow->inputBuf[slaveIdx]);
+      break;
+    }
+    default:
+    {
+      pBlock = (uint8_t *)shadow->holdingBuf[slaveIdx];
+      *blockSize = (uint16_t)sizeof(shadow->holdingBuf[slaveIdx]);
+      break;
+    }
+  }
+
+  return pBlock;
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
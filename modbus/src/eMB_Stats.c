@@ -0,0 +1,284 @@
+/*
+ * File:   eMB_Stats.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 10:15 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_STATS_ENABLED
+#define eMB_STATS_SLAVE_IS_VALID(addr)            ( ((addr) >= (uint8_t)eMB_ADDRESS_MIN) && \
+                                                    ((addr) <= (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM) )
+
+#define eMB_STATS_SUB_BITS                        ( (uint32_t)eMB_MASTER_STATS_HIST_SUB_BITS )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static eMB_StatsSlaveStruct eMB_StatsSlave[eMB_MASTER_TOTAL_SLAVE_NUM];
+
+/* Counters of the request on the line, NULL for broadcasts */
+static eMB_StatsCountStruct *eMB_StatsCurrent;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static eMB_StatsFuncType eMB_Stats_FuncIndex(uint8_t funcCode);
+static uint16_t eMB_Stats_HistIndex(uint32_t value);
+static uint32_t eMB_Stats_HistUpper(uint16_t histIdx);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_Stats_GetSlave(uint8_t slaveAddr, eMB_StatsSlaveStruct *stats)
+{
+  if ((eMB_STATS_SLAVE_IS_VALID(slaveAddr) == false) || (stats == NULL))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_PortEnterCriticalSection();
+
+  *stats = eMB_StatsSlave[slaveAddr - 1U];
+
+  eMB_PortExitCriticalSection();
+
+  return eMB_ENOERR;
+}
+
+eMB_ErrorCodeType eMB_Stats_Reset(uint8_t slaveAddr)
+{
+  if ((slaveAddr != (uint8_t)eMB_ADDRESS_BROADCAST) && (eMB_STATS_SLAVE_IS_VALID(slaveAddr) == false))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_PortEnterCriticalSection();
+
+  if (slaveAddr == (uint8_t)eMB_ADDRESS_BROADCAST)
+  {
+    memset(eMB_StatsSlave, 0, sizeof(eMB_StatsSlave));
+  }
+  else
+  {
+    memset(&eMB_StatsSlave[slaveAddr - 1U], 0, sizeof(eMB_StatsSlaveStruct));
+  }
+
+  eMB_PortExitCriticalSection();
+
+  return eMB_ENOERR;
+}
+
+uint32_t eMB_Stats_GetLatency(const eMB_StatsSlaveStruct *stats, uint16_t permille)
+{
+  uint32_t rank;
+  uint32_t sum = 0UL;
+  uint16_t i;
+
+  if ((stats == NULL) || (stats->latencyNum == 0UL))
+  {
+    return 0UL;
+  }
+
+  if (permille > (uint16_t)1000U)
+  {
+    permille = (uint16_t)1000U;
+  }
+
+  /* Rank of the percentile sample, 1 based and rounded up. */
+  rank = (uint32_t)(((uint64_t)stats->latencyNum * permille + 999U) / 1000U);
+
+  if (rank == 0UL)
+  {
+    rank = 1UL;
+  }
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_STATS_HIST_SIZE; i++)
+  {
+    sum += stats->hist[i];
+
+    if (sum >= rank)
+    {
+      break;
+    }
+  }
+
+  if (i >= (uint16_t)eMB_STATS_HIST_SIZE)
+  {
+    i = (uint16_t)(eMB_STATS_HIST_SIZE - 1U);
+  }
+
+  /* The bucket may be wider than the largest sample. */
+  return (eMB_Stats_HistUpper(i) < stats->latencyMax) ? eMB_Stats_HistUpper(i) : stats->latencyMax;
+}
+
+void eMB_Stats_Request(uint8_t slaveAddr, uint8_t funcCode)
+{
+  eMB_StatsCurrent = NULL;
+
+  if (eMB_STATS_SLAVE_IS_VALID(slaveAddr) == true)
+  {
+    eMB_StatsCurrent = &eMB_StatsSlave[slaveAddr - 1U].count[eMB_Stats_FuncIndex(funcCode)];
+    eMB_StatsCurrent->requestNum++;
+  }
+}
+
+void eMB_Stats_Response(bool isException)
+{
+  if (eMB_StatsCurrent != NULL)
+  {
+    if (isException == true)
+    {
+      eMB_StatsCurrent->exceptionNum++;
+    }
+    else
+    {
+      eMB_StatsCurrent->responseNum++;
+    }
+
+    eMB_StatsCurrent = NULL;
+  }
+}
+
+void eMB_Stats_Error(eMB_ErrorEventType errorType)
+{
+  if (eMB_StatsCurrent != NULL)
+  {
+    if (errorType == eMB_EV_ERROR_RESPOND_TIMEOUT)
+    {
+      eMB_StatsCurrent->timeoutNum++;
+    }
+    else if (errorType == eMB_EV_ERROR_RECEIVE_DATA)
+    {
+      eMB_StatsCurrent->crcErrorNum++;
+    }
+    else
+    {
+      /* Exceptions were counted with the response. */
+    }
+
+    eMB_StatsCurrent = NULL;
+  }
+}
+
+void eMB_Stats_Latency(uint8_t slaveAddr, uint32_t latencyUs)
+{
+  eMB_StatsSlaveStruct *pStats;
+
+  if (eMB_STATS_SLAVE_IS_VALID(slaveAddr) == true)
+  {
+    pStats = &eMB_StatsSlave[slaveAddr - 1U];
+
+    pStats->hist[eMB_Stats_HistIndex(latencyUs)]++;
+    pStats->latencyNum++;
+
+    if (latencyUs > pStats->latencyMax)
+    {
+      pStats->latencyMax = latencyUs;
+    }
+  }
+}
+
+
+
+
+
+/* Counter slot of a function code. */
+static eMB_StatsFuncType eMB_Stats_FuncIndex(uint8_t funcCode)
+{
+  eMB_StatsFuncType funcIdx;
+
+  switch (funcCode)
+  {
+    case eMB_FUNC_READ_COILS:                   funcIdx = eMB_STATS_FUNC_READ_COILS;                  break;
+    case eMB_FUNC_READ_DISCRETE_INPUTS:         funcIdx = eMB_STATS_FUNC_READ_DISCRETE_INPUTS;        break;
+    case eMB_FUNC_READ_HOLDING_REGISTER:        funcIdx = eMB_STATS_FUNC_READ_HOLDING_REGISTER;       break;
+    case eMB_FUNC_READ_INPUT_REGISTER:          funcIdx = eMB_STATS_FUNC_READ_INPUT_REGISTER;         break;
+    case eMB_FUNC_WRITE_SINGLE_COIL:            funcIdx = eMB_STATS_FUNC_WRITE_SINGLE_COIL;           break;
+    case eMB_FUNC_WRITE_REGISTER:               funcIdx = eMB_STATS_FUNC_WRITE_REGISTER;              break;
+    case eMB_FUNC_WRITE_MULTIPLE_COILS:         funcIdx = eMB_STATS_FUNC_WRITE_MULTIPLE_COILS;        break;
+    case eMB_FUNC_WRITE_MULTIPLE_REGISTERS:     funcIdx = eMB_STATS_FUNC_WRITE_MULTIPLE_REGISTERS;    break;
+    case eMB_FUNC_READWRITE_MULTIPLE_REGISTERS: funcIdx = eMB_STATS_FUNC_READWRITE_MULTIPLE_REGISTERS; break;
+    default:                                    funcIdx = eMB_STATS_FUNC_OTHER;                       break;
+  }
+
+  return funcIdx;
+}
+
+/* Histogram bucket of a latency: linear below 2^SUB_BITS, above the power of two
+ * selects the group and the next SUB_BITS bits the bucket in the group. */
+static uint16_t eMB_Stats_HistIndex(uint32_t value)
+{
+  uint32_t msb = eMB_STATS_SUB_BITS;
+
+  if (value < (uint32_t)eMB_STATS_HIST_SUB_NUM)
+  {
+    return (uint16_t)value;
+  }
+
+  if (value >= (1UL << eMB_STATS_HIST_MAX_BITS))
+  {
+    return (uint16_t)(eMB_STATS_HIST_SIZE - 1U);
+  }
+
+  while ((value >> (msb + 1UL)) != 0UL)
+  {
+    msb++;
+  }
+
+  return (uint16_t)(((msb - eMB_STATS_SUB_BITS + 1UL) << eMB_STATS_SUB_BITS) +
+                    ((value >> (msb - eMB_STATS_SUB_BITS)) & ((uint32_t)eMB_STATS_HIST_SUB_NUM - 1UL)));
+}
+
+/* Largest latency of a histogram bucket. */
+static uint32_t eMB_Stats_HistUpper(uint16_t histIdx)
+{
+  uint32_t shift;
+
+  if (histIdx < (uint16_t)eMB_STATS_HIST_SUB_NUM)
+  {
+    return (uint32_t)histIdx;
+  }
+
+  shift = ((uint32_t)histIdx >> eMB_STATS_SUB_BITS) - 1UL;
+
+  return ((((uint32_t)eMB_STATS_HIST_SUB_NUM + ((uint32_t)histIdx & ((uint32_t)eMB_STATS_HIST_SUB_NUM - 1UL))) << shift) +
+          (1UL << shift) - 1UL);
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
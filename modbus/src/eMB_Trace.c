@@ -0,0 +1,537 @@
+/*
+ * File:   eMB_Trace.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 11:55 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_TRACE_ENABLED
+#define eMB_TRACE_RING_SIZE                       ( eMB_MASTER_TRACE_RECORD_NUM + 1 )
+
+#define eMB_TRACE_STATE_NONE                      ( 0xFFU )
+
+/* Rows of the timeline */
+#define eMB_TRACE_TID_TASK                        ( 1U )
+#define eMB_TRACE_TID_ISR                         ( 2U )
+#define eMB_TRACE_TID_SEND                        ( 3U )
+#define eMB_TRACE_TID_RECV                        ( 4U )
+#define eMB_TRACE_TID_TIMER                       ( 5U )
+
+/* Ring with one free entry, written at head and read at tail */
+typedef struct _eMB_TraceRingStruct
+{
+  volatile eMB_TraceRecordStruct record[eMB_TRACE_RING_SIZE];
+  volatile uint16_t           head;
+  volatile uint16_t           tail;
+} eMB_TraceRingStruct;
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static eMB_TraceRingStruct eMB_TraceTaskRing;
+static eMB_TraceRingStruct eMB_TraceIsrRing;
+static volatile uint32_t   eMB_TraceLostNum;
+
+/* Set while an interrupt callout runs, the callouts do not preempt each other */
+static volatile bool       eMB_TraceInIsr;
+
+/* Port hooks and callouts behind the shims */
+static const eMB_ConfigStruct          *eMB_TracePortPtr;
+static eMB_ConfigStruct                 eMB_TraceConfig;
+static eMB_FrameByteReceivedCallout     eMB_TraceByteReceived;
+static eMB_FrameTransmitterEmptyCallout eMB_TraceTransmitterEmpty;
+static eMB_FrameTimerExpiredCallout     eMB_TraceTimerExpired;
+
+/* Last recorded timer mode and states */
+static volatile uint8_t    eMB_TraceTimerMode = (uint8_t)eMB_TRACE_STATE_NONE;
+static volatile uint8_t    eMB_TraceSendState = (uint8_t)eMB_TRACE_STATE_NONE;
+static volatile uint8_t    eMB_TraceRecvState = (uint8_t)eMB_TRACE_STATE_NONE;
+
+/* Upper 32 bits of the exported timestamps */
+static uint32_t            eMB_TraceTimeHigh;
+static uint32_t            eMB_TraceTimeLast;
+
+/* Names in the order of eMB_RTU_SendStateType and eMB_RTU_RecvStateType */
+static const char * const  eMB_TraceSendStateName[] = { "IDLE", "XMIT", "DONE" };
+static const char * const  eMB_TraceRecvStateName[] = { "INIT", "IDLE", "RCV", "ERROR", "DONE" };
+static const char * const  eMB_TraceTimerName[]     = { "T35", "RESPOND_TIMEOUT", "CONVERT_DELAY" };
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static bool eMB_Trace_EventPost(eMB_EventType eEvent);
+static bool eMB_Trace_EventGet(eMB_EventType *eEvent);
+static void eMB_Trace_TimersEnable(eMB_PortTimerModeType timerMode);
+static void eMB_Trace_TimersDisable(void);
+static bool eMB_Trace_ByteReceivedCallout(void);
+static bool eMB_Trace_TransmitterEmptyCallout(void);
+static bool eMB_Trace_TimerExpiredCallout(void);
+static void eMB_Trace_States(void);
+static void eMB_Trace_RingPut(eMB_TraceRingStruct *ring, eMB_TraceEventType event, uint8_t arg);
+static const char *eMB_Trace_EventName(uint8_t event);
+static uint16_t eMB_Trace_Format(char *buf, const eMB_TraceRecordStruct *record, uint8_t tid, uint64_t timeUs);
+static uint16_t eMB_Trace_FormatEvent(char *buf, const char *prefix, const char *name, char phase, uint64_t timeUs, uint8_t tid);
+static uint16_t eMB_Trace_Append(char *buf, uint16_t pos, const char *str);
+static uint16_t eMB_Trace_AppendNum(char *buf, uint16_t pos, uint64_t value);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+uint32_t eMB_Trace_GetLostNum(void)
+{
+  return eMB_TraceLostNum;
+}
+
+uint16_t eMB_Trace_ExportHeader(char *buf, uint16_t size)
+{
+  static const char * const rowName[] = { "tasks", "line interrupts", "send state", "receive state", "timer" };
+  char text[eMB_TRACE_JSON_SIZE_MAX];
+  uint16_t pos = (uint16_t)0U;
+  uint16_t len;
+  uint8_t i;
+
+  if ((buf == NULL) || (size < (uint16_t)1U))
+  {
+    return (uint16_t)0U;
+  }
+
+  buf[pos++] = '[';
+
+  for (i = 0U; i < (uint8_t)(sizeof(rowName) / sizeof(rowName[0])); i++)
+  {
+    len = eMB_Trace_Append(text, (uint16_t)0U, "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+    len = eMB_Trace_AppendNum(text, len, (uint64_t)(i + 1U));
+    len = eMB_Trace_Append(text, len, ",\"args\":{\"name\":\"");
+    len = eMB_Trace_Append(text, len, rowName[i]);
+    len = eMB_Trace_Append(text, len, "\"}},");
+
+    if ((uint32_t)pos + len > size)
+    {
+      return (uint16_t)0U;
+    }
+
+    memcpy(&buf[pos], text, len);
+    pos += len;
+  }
+
+  eMB_TraceTimeHigh = 0UL;
+  eMB_TraceTimeLast = 0UL;
+
+  return pos;
+}
+
+uint16_t eMB_Trace_ExportRecords(char *buf, uint16_t size)
+{
+  eMB_TraceRingStruct *ring;
+  eMB_TraceRecordStruct record;
+  char text[eMB_TRACE_JSON_SIZE_MAX];
+  uint16_t pos = (uint16_t)0U;
+  uint16_t len;
+  uint32_t timeHigh;
+  bool hasTask;
+  bool hasIsr;
+
+  if (buf == NULL)
+  {
+    return pos;
+  }
+
+  for (;;)
+  {
+    hasTask = (eMB_TraceTaskRing.tail != eMB_TraceTaskRing.head) ? true : false;
+    hasIsr  = (eMB_TraceIsrRing.tail != eMB_TraceIsrRing.head) ? true : false;
+
+    /* Merge the rings, the older event first. */
+    if ((hasTask == true) &&
+        ((hasIsr == false) ||
+         ((int32_t)(eMB_TraceTaskRing.record[eMB_TraceTaskRing.tail].timeUs -
+                    eMB_TraceIsrRing.record[eMB_TraceIsrRing.tail].timeUs) <= 0)))
+    {
+      ring = &eMB_TraceTaskRing;
+    }
+    else if (hasIsr == true)
+    {
+      ring = &eMB_TraceIsrRing;
+    }
+    else
+    {
+      break;
+    }
+
+    record.timeUs = ring->record[ring->tail].timeUs;
+    record.event  = ring->record[ring->tail].event;
+    record.arg    = ring->record[ring->tail].arg;
+
+    timeHigh = (record.timeUs < eMB_TraceTimeLast) ? (eMB_TraceTimeHigh + 1UL) : eMB_TraceTimeHigh;
+
+    len = eMB_Trace_Format(text, &record, (ring == &eMB_TraceIsrRing) ? (uint8_t)eMB_TRACE_TID_ISR : (uint8_t)eMB_TRACE_TID_TASK,
+                           ((uint64_t)timeHigh << 32U) | record.timeUs);
+
+    if ((uint32_t)pos + len > size)
+    {
+      break;
+    }
+
+    memcpy(&buf[pos], text, len);
+    pos += len;
+
+    eMB_TraceTimeHigh = timeHigh;
+    eMB_TraceTimeLast = record.timeUs;
+
+    /* Free the entry after it is copied. */
+    ring->tail = (uint16_t)((ring->tail + 1U) % (uint16_t)eMB_TRACE_RING_SIZE);
+  }
+
+  return pos;
+}
+
+/* Put the shims in front of the port hooks and the interrupt callouts. */
+void eMB_Trace_Install(void)
+{
+  eMB_TracePortPtr = eMB_gConfigPtr;
+  eMB_TraceConfig  = *eMB_gConfigPtr;
+
+  eMB_TraceConfig.pPortEventPost      = eMB_Trace_EventPost;
+  eMB_TraceConfig.pPortEventGet       = eMB_Trace_EventGet;
+  eMB_TraceConfig.pPortTimersEnable   = eMB_Trace_TimersEnable;
+  eMB_TraceConfig.pPortTimersDisable  = eMB_Trace_TimersDisable;
+
+  eMB_gConfigPtr = &eMB_TraceConfig;
+
+  eMB_TraceByteReceived     = eMB_FrameByteReceivedCalloutArr;
+  eMB_TraceTransmitterEmpty = eMB_FrameTransmitterEmptyCalloutArr;
+  eMB_TraceTimerExpired     = eMB_FrameTimerExpiredCalloutArr;
+
+  eMB_FrameByteReceivedCalloutArr     = eMB_Trace_ByteReceivedCallout;
+  eMB_FrameTransmitterEmptyCalloutArr = eMB_Trace_TransmitterEmptyCallout;
+  eMB_FrameTimerExpiredCalloutArr     = eMB_Trace_TimerExpiredCallout;
+}
+
+/* Record an event in the ring of the calling context. */
+void eMB_Trace_Put(eMB_TraceEventType event, uint8_t arg)
+{
+  if (eMB_TraceInIsr == true)
+  {
+    eMB_Trace_RingPut(&eMB_TraceIsrRing, event, arg);
+  }
+  else
+  {
+    eMB_PortEnterCriticalSection();
+
+    eMB_Trace_RingPut(&eMB_TraceTaskRing, event, arg);
+
+    eMB_PortExitCriticalSection();
+  }
+}
+
+
+
+
+
+/* Shims of the port hooks. */
+static bool eMB_Trace_EventPost(eMB_EventType eEvent)
+{
+  eMB_Trace_Put(eMB_TRACE_EVENT_POST, (uint8_t)eEvent);
+
+  return eMB_TracePortPtr->pPortEventPost(eEvent);
+}
+
+static bool eMB_Trace_EventGet(eMB_EventType *eEvent)
+{
+  bool isEvent = eMB_TracePortPtr->pPortEventGet(eEvent);
+
+  if (isEvent == true)
+  {
+    eMB_Trace_Put(eMB_TRACE_EVENT_GET, (uint8_t)*eEvent);
+  }
+
+  return isEvent;
+}
+
+static void eMB_Trace_TimersEnable(eMB_PortTimerModeType timerMode)
+{
+  if (eMB_TraceTimerMode != (uint8_t)timerMode)
+  {
+    eMB_TraceTimerMode = (uint8_t)timerMode;
+    eMB_Trace_Put(eMB_TRACE_TIMER_ENABLE, (uint8_t)timerMode);
+  }
+
+  eMB_TracePortPtr->pPortTimersEnable(timerMode);
+}
+
+static void eMB_Trace_TimersDisable(void)
+{
+  if (eMB_TraceTimerMode != (uint8_t)eMB_TRACE_STATE_NONE)
+  {
+    eMB_TraceTimerMode = (uint8_t)eMB_TRACE_STATE_NONE;
+    eMB_Trace_Put(eMB_TRACE_TIMER_DISABLE, 0U);
+  }
+
+  eMB_TracePortPtr->pPortTimersDisable();
+}
+
+/* Shims of the interrupt callouts. */
+static bool eMB_Trace_ByteReceivedCallout(void)
+{
+  bool isDone;
+
+  eMB_TraceInIsr = true;
+
+  isDone = eMB_TraceByteReceived();
+  eMB_Trace_States();
+
+  eMB_TraceInIsr = false;
+
+  return isDone;
+}
+
+static bool eMB_Trace_TransmitterEmptyCallout(void)
+{
+  bool isDone;
+
+  eMB_TraceInIsr = true;
+
+  isDone = eMB_TraceTransmitterEmpty();
+  eMB_Trace_States();
+
+  eMB_TraceInIsr = false;
+
+  return isDone;
+}
+
+static bool eMB_Trace_TimerExpiredCallout(void)
+{
+  bool isDone;
+
+  eMB_TraceInIsr = true;
+
+  eMB_Trace_Put(eMB_TRACE_TIMER_EXPIRE, eMB_TraceTimerMode);
+
+  isDone = eMB_TraceTimerExpired();
+  eMB_Trace_States();
+
+  eMB_TraceInIsr = false;
+
+  return isDone;
+}
+
+/* Record new states of the RTU master, sampled after every interrupt callout. */
+static void eMB_Trace_States(void)
+{
+#ifdef eMB_MASTER_RTU_ENABLED
+  uint8_t sendState;
+  uint8_t recvState;
+
+  if ((eMB_gConfigPtr->role == eMB_ROLE_MASTER) && (eMB_gConfigPtr->comm == eMB_COMM_RTU))
+  {
+    eMB_Master_RTUGetState(&sendState, &recvState);
+
+    if (sendState != eMB_TraceSendState)
+    {
+      eMB_TraceSendState = sendState;
+      eMB_Trace_Put(eMB_TRACE_SEND_STATE, sendState);
+    }
+
+    if (recvState != eMB_TraceRecvState)
+    {
+      eMB_TraceRecvState = recvState;
+      eMB_Trace_Put(eMB_TRACE_RECV_STATE, recvState);
+    }
+  }
+#endif
+}
+
+/* Put an event into a ring with a single writer, a full ring drops it. */
+static void eMB_Trace_RingPut(eMB_TraceRingStruct *ring, eMB_TraceEventType event, uint8_t arg)
+{
+  uint16_t nextHead = (uint16_t)((ring->head + 1U) % (uint16_t)eMB_TRACE_RING_SIZE);
+
+  if (nextHead == ring->tail)
+  {
+    eMB_TraceLostNum++;
+    return;
+  }
+
+  ring->record[ring->head].timeUs = eMB_Util_GetTimeUs();
+  ring->record[ring->head].event  = (uint8_t)event;
+  ring->record[ring->head].arg    = arg;
+
+  /* Publish the event after it is complete. */
+  ring->head = nextHead;
+}
+
+static const char *eMB_Trace_EventName(uint8_t event)
+{
+  const char *name;
+
+  switch (event)
+  {
+    case eMB_EV_READY:          name = "READY";          break;
+    case eMB_EV_FRAME_RECEIVED: name = "FRAME_RECEIVED"; break;
+    case eMB_EV_EXECUTE:        name = "EXECUTE";        break;
+    case eMB_EV_FRAME_SENT:     name = "FRAME_SENT";     break;
+    case eMB_EV_ERROR:          name = "ERROR";          break;
+    default:                    name = "UNKNOWN";        break;
+  }
+
+  return name;
+}
+
+/* JSON text of an event: slices for handlers, timers and states, instants for the rest. */
+static uint16_t eMB_Trace_Format(char *buf, const eMB_TraceRecordStruct *record, uint8_t tid, uint64_t timeUs)
+{
+  static const char hexDigit[] = "0123456789ABCDEF";
+  char funcName[5];
+  uint16_t len = (uint16_t)0U;
+
+  switch (record->event)
+  {
+    case eMB_TRACE_EVENT_POST:
+    {
+      len = eMB_Trace_FormatEvent(buf, "post ", eMB_Trace_EventName(record->arg), 'i', timeUs, tid);
+      break;
+    }
+    case eMB_TRACE_EVENT_GET:
+    {
+      len = eMB_Trace_FormatEvent(buf, "get ", eMB_Trace_EventName(record->arg), 'i', timeUs, tid);
+      break;
+    }
+    case eMB_TRACE_TIMER_ENABLE:
+    {
+      len = eMB_Trace_FormatEvent(buf, "", (record->arg <= (uint8_t)eMB_PORT_TIMER_CONVERT_DELAY) ?
+                                  eMB_TraceTimerName[record->arg] : "UNKNOWN", 'B', timeUs, (uint8_t)eMB_TRACE_TID_TIMER);
+      break;
+    }
+    case eMB_TRACE_TIMER_DISABLE:
+    {
+      len = eMB_Trace_FormatEvent(buf, "", "", 'E', timeUs, (uint8_t)eMB_TRACE_TID_TIMER);
+      break;
+    }
+    case eMB_TRACE_TIMER_EXPIRE:
+    {
+      len = eMB_Trace_FormatEvent(buf, "", "expired", 'i', timeUs, (uint8_t)eMB_TRACE_TID_TIMER);
+      break;
+    }
+    case eMB_TRACE_SEND_STATE:
+    {
+      len = eMB_Trace_FormatEvent(buf, "", "", 'E', timeUs, (uint8_t)eMB_TRACE_TID_SEND);
+      len += eMB_Trace_FormatEvent(&buf[len], "", (record->arg < (uint8_t)3U) ?
+                                   eMB_TraceSendStateName[record->arg] : "UNKNOWN", 'B', timeUs, (uint8_t)eMB_TRACE_TID_SEND);
+      break;
+    }
+    case eMB_TRACE_RECV_STATE:
+    {
+      len = eMB_Trace_FormatEvent(buf, "", "", 'E', timeUs, (uint8_t)eMB_TRACE_TID_RECV);
+      len += eMB_Trace_FormatEvent(&buf[len], "", (record->arg < (uint8_t)5U) ?
+                                   eMB_TraceRecvStateName[record->arg] : "UNKNOWN", 'B', timeUs, (uint8_t)eMB_TRACE_TID_RECV);
+      break;
+    }
+    case eMB_TRACE_HANDLER_BEGIN:
+    case eMB_TRACE_HANDLER_END:
+    {
+      funcName[0] = '0';
+      funcName[1] = 'x';
+      funcName[2] = hexDigit[record->arg >> 4U];
+      funcName[3] = hexDigit[record->arg & 0x0FU];
+      funcName[4] = '\0';
+
+      len = eMB_Trace_FormatEvent(buf, "handler ", funcName,
+                                  (record->event == (uint8_t)eMB_TRACE_HANDLER_BEGIN) ? 'B' : 'E', timeUs, tid);
+      break;
+    }
+    default:
+      break;
+  }
+
+  return len;
+}
+
+/* {"name":"<prefix><name>","ph":"<phase>","ts":<timeUs>,"pid":1,"tid":<tid>}, */
+static uint16_t eMB_Trace_FormatEvent(char *buf, const char *prefix, const char *name, char phase, uint64_t timeUs, uint8_t tid)
+{
+  char phaseText[2];
+  uint16_t len;
+
+  phaseText[0] = phase;
+  phaseText[1] = '\0';
+
+  len = eMB_Trace_Append(buf, (uint16_t)0U, "\n{\"name\":\"");
+  len = eMB_Trace_Append(buf, len, prefix);
+  len = eMB_Trace_Append(buf, len, name);
+  len = eMB_Trace_Append(buf, len, "\",\"ph\":\"");
+  len = eMB_Trace_Append(buf, len, phaseText);
+  len = eMB_Trace_Append(buf, len, (phase == 'i') ? "\",\"s\":\"t\",\"ts\":" : "\",\"ts\":");
+  len = eMB_Trace_AppendNum(buf, len, timeUs);
+  len = eMB_Trace_Append(buf, len, ",\"pid\":1,\"tid\":");
+  len = eMB_Trace_AppendNum(buf, len, (uint64_t)tid);
+  len = eMB_Trace_Append(buf, len, "},");
+
+  return len;
+}
+
+static uint16_t eMB_Trace_Append(char *buf, uint16_t pos, const char *str)
+{
+  while (*str != '\0')
+  {
+    buf[pos++] = *str++;
+  }
+
+  return pos;
+}
+
+static uint16_t eMB_Trace_AppendNum(char *buf, uint16_t pos, uint64_t value)
+{
+  char digit[20];
+  uint8_t digitNum = 0U;
+
+  do
+  {
+    digit[digitNum++] = (char)('0' + (char)(value % 10U));
+    value /= 10U;
+  } while (value != 0U);
+
+  while (digitNum != 0U)
+  {
+    buf[pos++] = digit[--digitNum];
+  }
+
+  return pos;
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -29,24 +29,6 @@ extern "C" {
 
 #define BITS_UCHAR                                8U
 
-#define M_DISCRETE_INPUT_START                    0
-#define M_DISCRETE_INPUT_NDISCRETES               16
-#define M_COIL_START                              0
-#define M_COIL_NCOILS                             64
-#define M_REG_INPUT_START                         0
-#define M_REG_INPUT_NREGS                         100
-#define M_REG_HOLDING_START                       0
-#define M_REG_HOLDING_NREGS                       100
-
-/* master mode: holding register's all address */
-#define M_HD_RESERVE                              0
-/* master mode: input register's all address */
-#define M_IN_RESERVE                              0
-/* master mode: coil's all address */
-#define M_CO_RESERVE                              0
-/* master mode: discrete's all address */
-#define M_DI_RESERVE                              0
-
 
 
 /*===============================================================================================
@@ -55,93 +37,23 @@ extern "C" {
 
 static eMB_ErrorEventType eMB_ErrorEvent;
 
-/* Discrete inputs variables */
-uint16_t usMDiscInStart = M_DISCRETE_INPUT_START;
-
-#if (M_DISCRETE_INPUT_NDISCRETES % 8)
-uint8_t ucMDiscInBuf[eMB_MASTER_TOTAL_SLAVE_NUM][M_DISCRETE_INPUT_NDISCRETES/8+1];
-#else
-uint8_t ucMDiscInBuf[eMB_MASTER_TOTAL_SLAVE_NUM][M_DISCRETE_INPUT_NDISCRETES/8];
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/* Read request on the line. Identical requests of other tasks join it. */
+static volatile bool eMB_PendingRead;
+static uint8_t       eMB_PendingReadSlaveAddr;
+static uint8_t       eMB_PendingReadFuncCode;
+static uint16_t      eMB_PendingReadAddr;
+static uint16_t      eMB_PendingReadNum;
 #endif
 
-/* Coils variables */
-uint16_t usMCoilStart = M_COIL_START;
-#if (M_COIL_NCOILS % 8)
-uint8_t ucMCoilBuf[eMB_MASTER_TOTAL_SLAVE_NUM][M_COIL_NCOILS/8+1];
-#else
-uint8_t ucMCoilBuf[eMB_MASTER_TOTAL_SLAVE_NUM][M_COIL_NCOILS/8];
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+/* Register store of the slave */
+uint8_t  eMB_Slave_CoilBuf[eMB_SLAVE_COIL_BYTES];
+uint8_t  eMB_Slave_DiscreteBuf[eMB_SLAVE_DISCRETE_BYTES];
+uint16_t eMB_Slave_RegInputBuf[eMB_SLAVE_REG_INPUT_NREGS];
+uint16_t eMB_Slave_RegHoldingBuf[eMB_SLAVE_REG_HOLDING_NREGS];
 #endif
 
-/* Input Register variables */
-uint16_t usMRegInStart = M_REG_INPUT_START;
-uint16_t usMRegInBuf[eMB_MASTER_TOTAL_SLAVE_NUM][M_REG_INPUT_NREGS];
-
-/* Holding Register variables */
-uint16_t usMRegHoldStart = M_REG_HOLDING_START;
-uint16_t usMRegHoldBuf[eMB_MASTER_TOTAL_SLAVE_NUM][M_REG_HOLDING_NREGS];
-
-
-
-/*===============================================================================================
-*                                   FUNCTIONS PROTOTYPES
-===============================================================================================*/
-
-/*! \brief Function to set bits in a byte buffer.
- *
- * This function allows the efficient use of an array to implement bitfields.
- * The array used for storing the bits must always be a multiple of two
- * bytes. Up to eight bits can be set or cleared in one operation.
- *
- * \param byteArr A buffer where the bit values are stored. Must be a
- *   multiple of 2 bytes. No length checking is performed and if
- *   offset / 8 is greater than the size of the buffer memory contents
- *   is overwritten.
- * \param offset The starting address of the bits to set. The first
- *   bit has the offset 0.
- * \param bitNum Number of bits to modify. The value must always be smaller
- *   than 8.
- * \param value Thew new values for the bits. The value for the first bit
- *   starting at <code>offset</code> is the LSB of the value
- *   <code>value</code>
- *
- * \code
- * ucBits[2] = {0, 0};
- *
- * // Set bit 4 to 1 (read: set 1 bit starting at bit offset 4 to value 1)
- * eMB_Util_SetBits( ucBits, 4, 1, 1 );
- *
- * // Set bit 7 to 1 and bit 8 to 0.
- * eMB_Util_SetBits( ucBits, 7, 2, 0x01 );
- *
- * // Set bits 8 - 11 to 0x05 and bits 12 - 15 to 0x0A;
- * eMB_Util_SetBits( ucBits, 8, 8, 0x5A);
- * \endcode
- */
-void eMB_Util_SetBits(uint8_t * byteArr, uint16_t offset, uint8_t bitNum, uint8_t value);
-
-
-
-/*! \brief Function to read bits in a byte buffer.
- *
- * This function is used to extract up bit values from an array. Up to eight
- * bit values can be extracted in one step.
- *
- * \param byteArr A buffer where the bit values are stored.
- * \param offset The starting address of the bits to set. The first
- *   bit has the offset 0.
- * \param bitNum Number of bits to modify. The value must always be smaller
- *   than 8.
- *
- * \code
- * uint8_t ucBits[2] = {0, 0};
- * uint8_t ucResult;
- *
- * // Extract the bits 3 - 10.
- * ucResult = eMB_Util_GetBits( ucBits, 3, 8 );
- * \endcode
- */
-uint8_t eMB_Util_GetBits(uint8_t * byteArr, uint16_t offset, uint8_t bitNum);
-
 
 
 /*===============================================================================================
@@ -240,6 +152,7 @@ eMB_ExceptionType eMB_Util_ErrorToException(eMB_ErrorCodeType errorCode)
 
 
 
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
 /**
  * Modbus read coils callback function.
  *
@@ -263,18 +176,20 @@ eMB_ErrorCodeType eMB_Util_FuncCoilsCallback
 
   iNReg =  usNCoils / 8 + 1;
 
-  pucCoilBuf = ucMCoilBuf[eMB_FrameGetSlaveAddressCalloutArr() - 1];
-  usCoilStart = usMCoilStart;
+  pucCoilBuf = eMB_gShadowPtr->coilBuf[eMB_FrameGetSlaveAddressCalloutArr() - 1];
+  usCoilStart = eMB_MASTER_COIL_START;
 
   /* it already plus one in modbus function method. */
   usAddress--;
 
-  if ((usAddress >= M_COIL_START) &&
-      (usAddress + usNCoils <= M_COIL_START + M_COIL_NCOILS))
+  if ((usAddress >= eMB_MASTER_COIL_START) &&
+      (usAddress + usNCoils <= eMB_MASTER_COIL_START + eMB_MASTER_COIL_NCOILS))
   {
     iRegIndex = (uint16_t)(usAddress - usCoilStart) / 8U;
     iRegBitIndex = (uint16_t)(usAddress - usCoilStart) % 8U;
 
+    eMB_Shadow_WriteBegin(eMB_REG_COILS, eMB_FrameGetSlaveAddressCalloutArr());
+
     while (iNReg > 1)
     {
       eMB_Util_SetBits(&pucCoilBuf[iRegIndex++], iRegBitIndex, 8, *pucRegBuffer++);
@@ -289,6 +204,8 @@ eMB_ErrorCodeType eMB_Util_FuncCoilsCallback
     {
       eMB_Util_SetBits(&pucCoilBuf[iRegIndex++], iRegBitIndex, usNCoils, *pucRegBuffer++);
     }
+
+    eMB_Shadow_WriteEnd(eMB_REG_COILS, eMB_FrameGetSlaveAddressCalloutArr(), eMB_Util_GetTime());
   }
   else
   {
@@ -321,18 +238,20 @@ eMB_ErrorCodeType eMB_Util_FuncDiscreteInputsCallback
 
   iNReg = usNDiscrete / 8 + 1;
 
-  pucDiscreteInputBuf = ucMDiscInBuf[eMB_FrameGetSlaveAddressCalloutArr() - 1];
-  usDiscreteInputStart = usMDiscInStart;
+  pucDiscreteInputBuf = eMB_gShadowPtr->discreteBuf[eMB_FrameGetSlaveAddressCalloutArr() - 1];
+  usDiscreteInputStart = eMB_MASTER_DISCRETE_INPUT_START;
 
   /* it already plus one in modbus function method. */
   usAddress--;
 
-  if ((usAddress >= M_DISCRETE_INPUT_START) &&
-      (usAddress + usNDiscrete <= M_DISCRETE_INPUT_START + M_DISCRETE_INPUT_NDISCRETES))
+  if ((usAddress >= eMB_MASTER_DISCRETE_INPUT_START) &&
+      (usAddress + usNDiscrete <= eMB_MASTER_DISCRETE_INPUT_START + eMB_MASTER_DISCRETE_INPUT_NDISCRETES))
   {
     iRegIndex = (uint16_t)(usAddress - usDiscreteInputStart) / 8;
     iRegBitIndex = (uint16_t)(usAddress - usDiscreteInputStart) % 8;
 
+    eMB_Shadow_WriteBegin(eMB_REG_DISCRETE_INPUTS, eMB_FrameGetSlaveAddressCalloutArr());
+
     /* write current discrete values with new values from the protocol stack. */
     while (iNReg > 1)
     {
@@ -348,6 +267,8 @@ eMB_ErrorCodeType eMB_Util_FuncDiscreteInputsCallback
     {
       eMB_Util_SetBits(&pucDiscreteInputBuf[iRegIndex++], iRegBitIndex, usNDiscrete, *pucRegBuffer++);
     }
+
+    eMB_Shadow_WriteEnd(eMB_REG_DISCRETE_INPUTS, eMB_FrameGetSlaveAddressCalloutArr(), eMB_Util_GetTime());
   }
   else
   {
@@ -378,17 +299,19 @@ eMB_ErrorCodeType eMB_Util_FuncHoldingRegisterCallback
   uint16_t *pusRegHoldingBuf;
   uint16_t usRegHoldStart;
 
-  pusRegHoldingBuf = usMRegHoldBuf[eMB_FrameGetSlaveAddressCalloutArr() - 1];
-  usRegHoldStart = usMRegHoldStart;
+  pusRegHoldingBuf = eMB_gShadowPtr->holdingBuf[eMB_FrameGetSlaveAddressCalloutArr() - 1];
+  usRegHoldStart = eMB_MASTER_REG_HOLDING_START;
   
   /* it already plus one in modbus function method. */
   usAddress--;
 
-  if ((usAddress >= M_REG_HOLDING_START) &&
-      (usAddress + usNRegs <= M_REG_HOLDING_START + M_REG_HOLDING_NREGS))
+  if ((usAddress >= eMB_MASTER_REG_HOLDING_START) &&
+      (usAddress + usNRegs <= eMB_MASTER_REG_HOLDING_START + eMB_MASTER_REG_HOLDING_NREGS))
   {
     iRegIndex = usAddress - usRegHoldStart;
 
+    eMB_Shadow_WriteBegin(eMB_REG_HOLDING, eMB_FrameGetSlaveAddressCalloutArr());
+
     while (usNRegs > 0)
     {
       pusRegHoldingBuf[iRegIndex] = *pucRegBuffer++ << 8;
@@ -396,6 +319,13 @@ eMB_ErrorCodeType eMB_Util_FuncHoldingRegisterCallback
       iRegIndex++;
       usNRegs--;
     }
+
+    eMB_Shadow_WriteEnd(eMB_REG_HOLDING, eMB_FrameGetSlaveAddressCalloutArr(), eMB_Util_GetTime());
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+    eMB_History_Append(eMB_REG_HOLDING, eMB_FrameGetSlaveAddressCalloutArr(), usAddress,
+                       (uint16_t)(iRegIndex - (usAddress - usRegHoldStart)), &pusRegHoldingBuf[usAddress - usRegHoldStart]);
+#endif
   }
   else
   {
@@ -426,17 +356,19 @@ eMB_ErrorCodeType eMB_Util_FuncInputRegisterCallback
   uint16_t *pusRegInputBuf;
   uint16_t usRegInStart;
 
-  pusRegInputBuf = usMRegInBuf[eMB_FrameGetSlaveAddressCalloutArr() - 1];
-  usRegInStart = usMRegInStart;
+  pusRegInputBuf = eMB_gShadowPtr->inputBuf[eMB_FrameGetSlaveAddressCalloutArr() - 1];
+  usRegInStart = eMB_MASTER_REG_INPUT_START;
 
   /* it already plus one in modbus function method. */
   usAddress--;
 
-  if ((usAddress >= M_REG_INPUT_START) &&
-      (usAddress + usNRegs <= M_REG_INPUT_START + M_REG_INPUT_NREGS))
+  if ((usAddress >= eMB_MASTER_REG_INPUT_START) &&
+      (usAddress + usNRegs <= eMB_MASTER_REG_INPUT_START + eMB_MASTER_REG_INPUT_NREGS))
   {
     iRegIndex = usAddress - usRegInStart;
 
+    eMB_Shadow_WriteBegin(eMB_REG_INPUT, eMB_FrameGetSlaveAddressCalloutArr());
+
     while (usNRegs > 0)
     {
       pusRegInputBuf[iRegIndex] = *pucRegBuffer++ << 8;
@@ -444,6 +376,13 @@ eMB_ErrorCodeType eMB_Util_FuncInputRegisterCallback
       iRegIndex++;
       usNRegs--;
     }
+
+    eMB_Shadow_WriteEnd(eMB_REG_INPUT, eMB_FrameGetSlaveAddressCalloutArr(), eMB_Util_GetTime());
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+    eMB_History_Append(eMB_REG_INPUT, eMB_FrameGetSlaveAddressCalloutArr(), usAddress,
+                       (uint16_t)(iRegIndex - (usAddress - usRegInStart)), &pusRegInputBuf[usAddress - usRegInStart]);
+#endif
   }
   else
   {
@@ -453,7 +392,280 @@ eMB_ErrorCodeType eMB_Util_FuncInputRegisterCallback
   return errStatus;
 }
 
+/* Take the line for a request of the master. */
+bool eMB_Util_ResourceTake(void)
+{
+  bool isTaken = eMB_gConfigPtr->pPortResourceTake();
 
+#ifdef eMB_MASTER_PHASE_ENABLED
+  if (isTaken == true)
+  {
+    eMB_Phase_Begin();
+  }
+#endif
+
+  return isTaken;
+}
+
+/* Record the read request which is sent now. Called with the resource taken. */
+void eMB_Util_SetPendingRead(uint8_t slaveAddr, uint8_t funcCode, uint16_t regAddr, uint16_t regNum)
+{
+  eMB_PortEnterCriticalSection();
+
+  eMB_PendingReadSlaveAddr = slaveAddr;
+  eMB_PendingReadFuncCode  = funcCode;
+  eMB_PendingReadAddr      = regAddr;
+  eMB_PendingReadNum       = regNum;
+  eMB_PendingRead          = true;
+
+  eMB_PortExitCriticalSection();
+}
+
+/* The response of the pending read was handled or it failed. */
+void eMB_Util_ClearPendingRead(void)
+{
+  eMB_PendingRead = false;
+}
+
+/* Check if an identical read is on the line. Its response updates the same
+ * registers, so the caller does not need to send its own request. */
+bool eMB_Util_JoinPendingRead(uint8_t slaveAddr, uint8_t funcCode, uint16_t regAddr, uint16_t regNum)
+{
+  bool isJoined;
+
+  eMB_PortEnterCriticalSection();
+
+  isJoined = (eMB_PendingRead == true) && (eMB_PendingReadSlaveAddr == slaveAddr) &&
+             (eMB_PendingReadFuncCode == funcCode) && (eMB_PendingReadAddr == regAddr) &&
+             (eMB_PendingReadNum == regNum);
+
+  eMB_PortExitCriticalSection();
+
+  return isJoined;
+}
+#endif
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+/**
+ * Modbus slave coils callback function. Values are copied directly between
+ * the store and the frame.
+ *
+ * @param usAddress coils address as in the PDU
+ * @param usNCoils coils number
+ * @param pucRegBuffer coils in the frame, packed LSB first
+ * @param eMode read or write
+ *
+ * @return result
+ */
+eMB_ErrorCodeType eMB_Util_SlaveFuncCoilsCallback
+(
+  uint16_t usAddress,
+  uint16_t usNCoils,
+  uint8_t *pucRegBuffer,
+  eMB_RegModeType eMode
+)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint16_t usBitOffset;
+  uint8_t ucNBits;
+
+  /* An address below the start wraps around to beyond the table. */
+  usBitOffset = (uint16_t)(usAddress - eMB_SLAVE_COIL_START);
+
+  if ((uint32_t)usBitOffset + usNCoils <= (uint32_t)eMB_SLAVE_COIL_NCOILS)
+  {
+    while (usNCoils > 0)
+    {
+      ucNBits = (uint8_t)((usNCoils > 8U) ? 8U : usNCoils);
+
+      if (eMode == eMB_REG_READ)
+      {
+        *pucRegBuffer++ = eMB_Util_GetBits(eMB_Slave_CoilBuf, usBitOffset, ucNBits);
+      }
+      else
+      {
+        eMB_Util_SetBits(eMB_Slave_CoilBuf, usBitOffset, ucNBits, *pucRegBuffer++);
+      }
+
+      usBitOffset += ucNBits;
+      usNCoils -= ucNBits;
+    }
+  }
+  else
+  {
+    errStatus = eMB_ENOREG;
+  }
+
+  return errStatus;
+}
+
+/**
+ * Modbus slave discrete callback function.
+ *
+ * @param usAddress discrete address as in the PDU
+ * @param usNDiscrete discrete number
+ * @param pucRegBuffer discrete in the frame, packed LSB first
+ *
+ * @return result
+ */
+eMB_ErrorCodeType eMB_Util_SlaveFuncDiscreteInputsCallback
+(
+  uint16_t usAddress,
+  uint16_t usNDiscrete,
+  uint8_t *pucRegBuffer
+)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint16_t usBitOffset;
+  uint8_t ucNBits;
+
+  /* An address below the start wraps around to beyond the table. */
+  usBitOffset = (uint16_t)(usAddress - eMB_SLAVE_DISCRETE_INPUT_START);
+
+  if ((uint32_t)usBitOffset + usNDiscrete <= (uint32_t)eMB_SLAVE_DISCRETE_INPUT_NDISCRETES)
+  {
+    while (usNDiscrete > 0)
+    {
+      ucNBits = (uint8_t)((usNDiscrete > 8U) ? 8U : usNDiscrete);
+
+      *pucRegBuffer++ = eMB_Util_GetBits(eMB_Slave_DiscreteBuf, usBitOffset, ucNBits);
+
+      usBitOffset += ucNBits;
+      usNDiscrete -= ucNBits;
+    }
+  }
+  else
+  {
+    errStatus = eMB_ENOREG;
+  }
+
+  return errStatus;
+}
+
+/**
+ * Modbus slave holding register callback function.
+ *
+ * @param usAddress holding register address as in the PDU
+ * @param usNRegs holding register number
+ * @param pucRegBuffer holding registers in the frame, big endian
+ * @param eMode read or write
+ *
+ * @return result
+ */
+eMB_ErrorCodeType eMB_Util_SlaveFuncHoldingRegisterCallback
+(
+  uint16_t usAddress,
+  uint16_t usNRegs,
+  uint8_t *pucRegBuffer,
+  eMB_RegModeType eMode
+)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint16_t iRegIndex;
+
+  /* An address below the start wraps around to beyond the table. */
+  iRegIndex = (uint16_t)(usAddress - eMB_SLAVE_REG_HOLDING_START);
+
+  if ((uint32_t)iRegIndex + usNRegs <= (uint32_t)eMB_SLAVE_REG_HOLDING_NREGS)
+  {
+    while (usNRegs > 0)
+    {
+      if (eMode == eMB_REG_READ)
+      {
+        *pucRegBuffer++ = (uint8_t)(eMB_Slave_RegHoldingBuf[iRegIndex] >> 8);
+        *pucRegBuffer++ = (uint8_t)(eMB_Slave_RegHoldingBuf[iRegIndex] & 0xFF);
+      }
+      else
+      {
+        eMB_Slave_RegHoldingBuf[iRegIndex] = (uint16_t)(*pucRegBuffer++ << 8);
+        eMB_Slave_RegHoldingBuf[iRegIndex] |= *pucRegBuffer++;
+      }
+
+      iRegIndex++;
+      usNRegs--;
+    }
+  }
+  else
+  {
+    errStatus = eMB_ENOREG;
+  }
+
+  return errStatus;
+}
+
+/**
+ * Modbus slave input register callback function.
+ *
+ * @param usAddress input register address as in the PDU
+ * @param usNRegs input register number
+ * @param pucRegBuffer input registers in the frame, big endian
+ *
+ * @return result
+ */
+eMB_ErrorCodeType eMB_Util_SlaveFuncInputRegisterCallback
+(
+  uint16_t usAddress,
+  uint16_t usNRegs,
+  uint8_t *pucRegBuffer
+)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint16_t iRegIndex;
+
+  /* An address below the start wraps around to beyond the table. */
+  iRegIndex = (uint16_t)(usAddress - eMB_SLAVE_REG_INPUT_START);
+
+  if ((uint32_t)iRegIndex + usNRegs <= (uint32_t)eMB_SLAVE_REG_INPUT_NREGS)
+  {
+    while (usNRegs > 0)
+    {
+      *pucRegBuffer++ = (uint8_t)(eMB_Slave_RegInputBuf[iRegIndex] >> 8);
+      *pucRegBuffer++ = (uint8_t)(eMB_Slave_RegInputBuf[iRegIndex] & 0xFF);
+
+      iRegIndex++;
+      usNRegs--;
+    }
+  }
+  else
+  {
+    errStatus = eMB_ENOREG;
+  }
+
+  return errStatus;
+}
+#endif
+
+
+
+/* Get current time of the port in milliseconds, 0 if the port has no time. */
+uint32_t eMB_Util_GetTime(void)
+{
+  uint32_t time = 0U;
+
+  if (eMB_gConfigPtr->pPortTimeGet != NULL)
+  {
+    time = eMB_gConfigPtr->pPortTimeGet();
+  }
+
+  return time;
+}
+
+/* Get current time of the port in microseconds. Falls back to the millisecond clock. */
+uint32_t eMB_Util_GetTimeUs(void)
+{
+  uint32_t time;
+
+  if (eMB_gConfigPtr->pPortTimeGetUs != NULL)
+  {
+    time = eMB_gConfigPtr->pPortTimeGetUs();
+  }
+  else
+  {
+    time = eMB_Util_GetTime() * 1000UL;
+  }
+
+  return time;
+}
 
 /* Get Modbus Master current error event type. */
 eMB_ErrorEventType eMB_Util_GetErrorEvent(void)
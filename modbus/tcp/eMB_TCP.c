@@ -0,0 +1,384 @@
+/*
+ * File:   eMB_TCP.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 04:20 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "string.h"
+
+#include "eMB.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_SLAVE_TCP_ENABLED
+#define eMB_PDU_REQ_READ_ADDR_OFF                 ( eMB_PDU_DATA_OFFSET + 0 )
+#define eMB_PDU_REQ_READ_CNT_OFF                  ( eMB_PDU_DATA_OFFSET + 2 )
+#define eMB_PDU_REQ_READ_SIZE                     ( 4 )
+#define eMB_PDU_FUNC_READ_BYTECNT_OFF             ( eMB_PDU_DATA_OFFSET + 0 )
+#define eMB_PDU_FUNC_READ_VALUES_OFF              ( eMB_PDU_DATA_OFFSET + 1 )
+#define eMB_PDU_FUNC_READ_SIZE_MIN                ( 1 )
+#define eMB_PDU_FUNC_READ_REGCNT_MAX              ( 0x007D )
+#define eMB_PDU_FUNC_READ_BITCNT_MAX              ( 0x07D0 )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* Store which is served, NULL serves eMB_gShadowPtr */
+static const eMB_ShadowStruct *eMB_TCP_ShadowPtr;
+
+#ifdef eMB_GATEWAY_ENABLED
+static eMB_TCPNotifyCallback eMB_TCP_Notify;
+
+/* Connection in eMB_Slave_TCPProcess(), its responses are sent by the port anyway */
+static eMB_TCPConnStruct *eMB_TCP_ProcessConn;
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_Slave_TCPWriteHeader(uint8_t *rspAdu, uint16_t transId, uint8_t unitId, uint16_t pduLength);
+
+#ifdef eMB_GATEWAY_ENABLED
+static void eMB_Slave_TCPRespond(void *ctx, uint32_t tag, const uint8_t *pduBuf, uint16_t pduLength);
+#else
+static uint16_t eMB_Slave_TCPExecute(uint8_t unitId, const uint8_t *reqPdu, uint16_t reqLength, uint8_t *rspPdu);
+static eMB_ExceptionType eMB_Slave_TCPRead(uint8_t unitId, const uint8_t *reqPdu, uint8_t *rspPdu, uint16_t *rspLength);
+#endif
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+void eMB_Slave_TCPInit(const eMB_ShadowStruct *shadow)
+{
+  eMB_TCP_ShadowPtr = shadow;
+}
+
+#ifdef eMB_GATEWAY_ENABLED
+void eMB_Slave_TCPSetNotify(eMB_TCPNotifyCallback notify)
+{
+  eMB_TCP_Notify = notify;
+}
+#endif
+
+void eMB_Slave_TCPConnReset(eMB_TCPConnStruct *conn, uint16_t clientId)
+{
+  conn->clientId = clientId;
+  conn->rxLen = (uint16_t)0U;
+  conn->txPos = (uint16_t)0U;
+  conn->txLen = (uint16_t)0U;
+#ifdef eMB_GATEWAY_ENABLED
+  conn->txReserved = (uint16_t)0U;
+#endif
+}
+
+eMB_ErrorCodeType eMB_Slave_TCPProcess(eMB_TCPConnStruct *conn)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint16_t rxPos = (uint16_t)0U;
+  uint16_t txFree;
+  uint16_t transId;
+  uint16_t mbapLength;
+  uint8_t *pReq;
+#ifdef eMB_GATEWAY_ENABLED
+  eMB_TCPConnStruct *pPrevConn = eMB_TCP_ProcessConn;
+#else
+  uint16_t pduLength;
+  uint8_t *pRsp;
+#endif
+
+  /* Move responses which are not sent yet to the front. */
+  if (conn->txPos != (uint16_t)0U)
+  {
+    conn->txLen = (uint16_t)(conn->txLen - conn->txPos);
+    memmove(conn->txBuf, &conn->txBuf[conn->txPos], conn->txLen);
+    conn->txPos = (uint16_t)0U;
+  }
+
+#ifdef eMB_GATEWAY_ENABLED
+  eMB_TCP_ProcessConn = conn;
+#endif
+
+  while ((uint16_t)(conn->rxLen - rxPos) >= (uint16_t)eMB_TCP_MBAP_SIZE)
+  {
+    pReq = &conn->rxBuf[rxPos];
+
+    mbapLength  = (uint16_t)(pReq[eMB_TCP_MBAP_LEN_OFFSET] << 8U);
+    mbapLength |= (uint16_t)(pReq[eMB_TCP_MBAP_LEN_OFFSET + 1]  );
+
+    /* The length counts the unit id and the PDU. A wrong protocol id or length
+     * means the stream is out of sync, it can't be recovered. */
+    if ((pReq[eMB_TCP_MBAP_PID_OFFSET] != (uint8_t)0U) || (pReq[eMB_TCP_MBAP_PID_OFFSET + 1] != (uint8_t)0U) ||
+        (mbapLength < (uint16_t)(1U + eMB_PDU_SIZE_MIN)) || (mbapLength > (uint16_t)(1U + eMB_PDU_SIZE_MAX)))
+    {
+      errStatus = eMB_EIO;
+      break;
+    }
+
+    /* Wait for the rest of the frame. */
+    if ((uint16_t)(conn->rxLen - rxPos) < (uint16_t)(eMB_TCP_MBAP_UID_OFFSET + mbapLength))
+    {
+      break;
+    }
+
+    /* Wait until the pending responses are sent. */
+    txFree = (uint16_t)(eMB_SLAVE_TCP_BUF_SIZE - conn->txLen);
+#ifdef eMB_GATEWAY_ENABLED
+    txFree = (uint16_t)(txFree - conn->txReserved);
+#endif
+
+    if (txFree < (uint16_t)eMB_TCP_ADU_SIZE_MAX)
+    {
+      break;
+    }
+
+    transId  = (uint16_t)(pReq[eMB_TCP_MBAP_TID_OFFSET] << 8U);
+    transId |= (uint16_t)(pReq[eMB_TCP_MBAP_TID_OFFSET + 1]  );
+
+#ifdef eMB_GATEWAY_ENABLED
+    /* Keep room for the response, it may be appended at any later time. The
+     * tag carries what is needed to build its header. */
+    conn->txReserved = (uint16_t)(conn->txReserved + eMB_TCP_ADU_SIZE_MAX);
+
+    (void)eMB_Gateway_Submit(conn->clientId, conn,
+                             ((uint32_t)transId << 8U) | (uint32_t)pReq[eMB_TCP_MBAP_UID_OFFSET],
+                             pReq[eMB_TCP_MBAP_UID_OFFSET], &pReq[eMB_TCP_MBAP_SIZE],
+                             (uint16_t)(mbapLength - 1U), eMB_Slave_TCPRespond);
+#else
+    /* The response is built directly in the transmit buffer. */
+    pRsp = &conn->txBuf[conn->txLen];
+
+    pduLength = eMB_Slave_TCPExecute(pReq[eMB_TCP_MBAP_UID_OFFSET], &pReq[eMB_TCP_MBAP_SIZE],
+                                     (uint16_t)(mbapLength - 1U), &pRsp[eMB_TCP_MBAP_SIZE]);
+
+    eMB_Slave_TCPWriteHeader(pRsp, transId, pReq[eMB_TCP_MBAP_UID_OFFSET], pduLength);
+
+    conn->txLen = (uint16_t)(conn->txLen + eMB_TCP_MBAP_SIZE + pduLength);
+#endif
+    rxPos = (uint16_t)(rxPos + eMB_TCP_MBAP_UID_OFFSET + mbapLength);
+  }
+
+#ifdef eMB_GATEWAY_ENABLED
+  eMB_TCP_ProcessConn = pPrevConn;
+#endif
+
+  /* Keep the partial frame for the next call. */
+  if (rxPos != (uint16_t)0U)
+  {
+    conn->rxLen = (uint16_t)(conn->rxLen - rxPos);
+    memmove(conn->rxBuf, &conn->rxBuf[rxPos], conn->rxLen);
+  }
+
+  return errStatus;
+}
+
+
+
+
+
+/* Write the MBAP header of a response. */
+static void eMB_Slave_TCPWriteHeader(uint8_t *rspAdu, uint16_t transId, uint8_t unitId, uint16_t pduLength)
+{
+  rspAdu[eMB_TCP_MBAP_TID_OFFSET]     = (uint8_t)(transId >> 8U);
+  rspAdu[eMB_TCP_MBAP_TID_OFFSET + 1] = (uint8_t)(transId & 0x00FFU);
+  rspAdu[eMB_TCP_MBAP_PID_OFFSET]     = (uint8_t)0U;
+  rspAdu[eMB_TCP_MBAP_PID_OFFSET + 1] = (uint8_t)0U;
+  rspAdu[eMB_TCP_MBAP_LEN_OFFSET]     = (uint8_t)((pduLength + 1U) >> 8U);
+  rspAdu[eMB_TCP_MBAP_LEN_OFFSET + 1] = (uint8_t)((pduLength + 1U) & 0x00FFU);
+  rspAdu[eMB_TCP_MBAP_UID_OFFSET]     = unitId;
+}
+
+#ifdef eMB_GATEWAY_ENABLED
+/* Append the response of a forwarded request to the transmit buffer of its connection. */
+static void eMB_Slave_TCPRespond(void *ctx, uint32_t tag, const uint8_t *pduBuf, uint16_t pduLength)
+{
+  eMB_TCPConnStruct *conn = (eMB_TCPConnStruct *)ctx;
+  uint8_t *pRsp = &conn->txBuf[conn->txLen];
+
+  eMB_Slave_TCPWriteHeader(pRsp, (uint16_t)(tag >> 8U), (uint8_t)(tag & 0x00FFU), pduLength);
+  memcpy(&pRsp[eMB_TCP_MBAP_SIZE], pduBuf, pduLength);
+
+  conn->txLen = (uint16_t)(conn->txLen + eMB_TCP_MBAP_SIZE + pduLength);
+  conn->txReserved = (uint16_t)(conn->txReserved - eMB_TCP_ADU_SIZE_MAX);
+
+  if ((conn != eMB_TCP_ProcessConn) && (eMB_TCP_Notify != NULL))
+  {
+    eMB_TCP_Notify(conn);
+  }
+}
+#else
+/* Execute one request and build the response PDU. Returns the response PDU length. */
+static uint16_t eMB_Slave_TCPExecute(uint8_t unitId, const uint8_t *reqPdu, uint16_t reqLength, uint8_t *rspPdu)
+{
+  uint8_t funcCode = reqPdu[eMB_PDU_FUNC_OFFSET];
+  uint16_t rspLength = (uint16_t)0U;
+  eMB_ExceptionType exptStatus;
+
+  switch (funcCode)
+  {
+    case eMB_FUNC_READ_COILS:
+    case eMB_FUNC_READ_DISCRETE_INPUTS:
+    case eMB_FUNC_READ_HOLDING_REGISTER:
+    case eMB_FUNC_READ_INPUT_REGISTER:
+    {
+      if (reqLength == (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_REQ_READ_SIZE))
+      {
+        exptStatus = eMB_Slave_TCPRead(unitId, reqPdu, rspPdu, &rspLength);
+      }
+      else
+      {
+        exptStatus = eMB_EX_ILLEGAL_DATA_VALUE;
+      }
+      break;
+    }
+    default:
+    {
+      exptStatus = eMB_EX_ILLEGAL_FUNCTION;
+      break;
+    }
+  }
+
+  if (exptStatus != eMB_EX_NONE)
+  {
+    rspPdu[eMB_PDU_FUNC_OFFSET] = (uint8_t)(funcCode | eMB_FUNC_ERROR);
+    rspPdu[eMB_PDU_DATA_OFFSET] = (uint8_t)exptStatus;
+    rspLength = (uint16_t)2U;
+  }
+
+  return rspLength;
+}
+
+/* Answer a read request from the shadow store. */
+static eMB_ExceptionType eMB_Slave_TCPRead(uint8_t unitId, const uint8_t *reqPdu, uint8_t *rspPdu, uint16_t *rspLength)
+{
+  const eMB_ShadowStruct *pShadow = (eMB_TCP_ShadowPtr != NULL) ? eMB_TCP_ShadowPtr : eMB_gShadowPtr;
+  eMB_ShadowBlockInfoStruct blockInfo;
+  eMB_ErrorCodeType errStatus;
+  eMB_RegType regType;
+  uint16_t regAddr;
+  uint16_t regNum;
+  uint8_t  byteCount;
+
+  regAddr  = (uint16_t)(reqPdu[eMB_PDU_REQ_READ_ADDR_OFF] << 8U);
+  regAddr |= (uint16_t)(reqPdu[eMB_PDU_REQ_READ_ADDR_OFF + 1]  );
+
+  regNum  = (uint16_t)(reqPdu[eMB_PDU_REQ_READ_CNT_OFF] << 8U);
+  regNum |= (uint16_t)(reqPdu[eMB_PDU_REQ_READ_CNT_OFF + 1]  );
+
+  switch (reqPdu[eMB_PDU_FUNC_OFFSET])
+  {
+    case eMB_FUNC_READ_COILS:
+    {
+      regType = eMB_REG_COILS;
+      break;
+    }
+    case eMB_FUNC_READ_DISCRETE_INPUTS:
+    {
+      regType = eMB_REG_DISCRETE_INPUTS;
+      break;
+    }
+    case eMB_FUNC_READ_HOLDING_REGISTER:
+    {
+      regType = eMB_REG_HOLDING;
+      break;
+    }
+    default:
+    {
+      regType = eMB_REG_INPUT;
+      break;
+    }
+  }
+
+  if ((regType == eMB_REG_COILS) || (regType == eMB_REG_DISCRETE_INPUTS))
+  {
+    if ((regNum < (uint16_t)1U) || (regNum > (uint16_t)eMB_PDU_FUNC_READ_BITCNT_MAX))
+    {
+      return eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+
+    byteCount = (uint8_t)((regNum + 7U) / 8U);
+  }
+  else
+  {
+    if ((regNum < (uint16_t)1U) || (regNum > (uint16_t)eMB_PDU_FUNC_READ_REGCNT_MAX))
+    {
+      return eMB_EX_ILLEGAL_DATA_VALUE;
+    }
+
+    byteCount = (uint8_t)(regNum * 2U);
+  }
+
+  /* The unit id is the address of the slave on the serial line. */
+  if ((unitId < 1U) || (unitId > eMB_MASTER_TOTAL_SLAVE_NUM))
+  {
+    return eMB_EX_GATEWAY_PATH_FAILED;
+  }
+
+  /* A block which was never read from the slave has no data to serve. */
+  if ((eMB_Shadow_ReadBlockInfo(pShadow, regType, unitId, &blockInfo) == eMB_ENOERR) &&
+      (blockInfo.status == (uint8_t)eMB_SHADOW_BLOCK_EMPTY))
+  {
+    return eMB_EX_GATEWAY_TGT_FAILED;
+  }
+
+  if ((regType == eMB_REG_INPUT) || (regType == eMB_REG_HOLDING))
+  {
+    errStatus = eMB_Shadow_ReadRegistersPdu(pShadow, regType, unitId, regAddr, regNum,
+                                            &rspPdu[eMB_PDU_FUNC_READ_VALUES_OFF]);
+  }
+  else
+  {
+    errStatus = eMB_Shadow_ReadBits(pShadow, regType, unitId, regAddr, regNum,
+                                    &rspPdu[eMB_PDU_FUNC_READ_VALUES_OFF]);
+  }
+
+  if (errStatus == eMB_EBUSY)
+  {
+    return eMB_EX_SLAVE_BUSY;
+  }
+  else if (errStatus != eMB_ENOERR)
+  {
+    return eMB_Util_ErrorToException(errStatus);
+  }
+
+  rspPdu[eMB_PDU_FUNC_OFFSET]           = reqPdu[eMB_PDU_FUNC_OFFSET];
+  rspPdu[eMB_PDU_FUNC_READ_BYTECNT_OFF] = byteCount;
+  *rspLength = (uint16_t)(eMB_PDU_SIZE_MIN + eMB_PDU_FUNC_READ_SIZE_MIN + byteCount);
+
+  return eMB_EX_NONE;
+}
+#endif
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
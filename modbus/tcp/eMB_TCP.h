@@ -0,0 +1,146 @@
+/*
+ * File:   eMB_TCP.h
+ * Author: Long
+ *
+ * Modbus TCP (MBAP) slave server core. It serves the shadow store of the
+ * master to TCP clients, the unit identifier selects the slave. The core does
+ * no I/O: the port reads into eMB_TCPConnStruct::rxBuf, calls
+ * eMB_Slave_TCPProcess() and writes eMB_TCPConnStruct::txBuf. All complete
+ * requests in the receive buffer are answered in one call, so pipelined
+ * requests of a client are sent back in one write.
+ *
+ * With eMB_GATEWAY_ENABLED the requests are forwarded to the serial line
+ * instead (see eMB_Gateway.h). Their responses are appended to txBuf later and
+ * the port is told to send them by the notify callback.
+ *
+ * Created on October 19, 2026, 04:20 PM
+ */
+
+#ifndef EMB_TCP_H
+#define EMB_TCP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+#include "eMB_Shadow.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_SLAVE_TCP_ENABLED
+#if !(defined eMB_MASTER_RTU_ENABLED) && !(defined eMB_MASTER_ASCII_ENABLED)
+#error "eMB_SLAVE_TCP_ENABLED serves the shadow store of the master, enable a master role"
+#endif
+
+/*! \brief Size of the MBAP header (transaction id, protocol id, length, unit id). */
+#define eMB_TCP_MBAP_SIZE                         (  7 )
+
+/*! \brief Offsets in the MBAP header. */
+#define eMB_TCP_MBAP_TID_OFFSET                   (  0 )
+#define eMB_TCP_MBAP_PID_OFFSET                   (  2 )
+#define eMB_TCP_MBAP_LEN_OFFSET                   (  4 )
+#define eMB_TCP_MBAP_UID_OFFSET                   (  6 )
+
+/*! \brief Maximum size of a Modbus TCP frame. */
+#define eMB_TCP_ADU_SIZE_MAX                      ( eMB_TCP_MBAP_SIZE + eMB_PDU_SIZE_MAX )
+
+#ifdef eMB_GATEWAY_ENABLED
+/* Every forwarded request keeps room for its response. One more frame must fit,
+ * else a connection with a full queue can't take or reject further requests. */
+#if ((eMB_GATEWAY_CLIENT_QUEUE_SIZE * eMB_TCP_ADU_SIZE_MAX) + eMB_TCP_ADU_SIZE_MAX) > eMB_SLAVE_TCP_BUF_SIZE
+#error "eMB_SLAVE_TCP_BUF_SIZE must hold eMB_GATEWAY_CLIENT_QUEUE_SIZE + 1 frames of eMB_TCP_ADU_SIZE_MAX bytes"
+#endif
+#endif
+
+/*! \ingroup modbus
+ * \brief Buffers of one client connection.
+ *
+ * rxBuf[0 .. rxLen) holds received data which is not processed yet. The port
+ * appends to it and sets rxLen. txBuf[txPos .. txLen) holds responses which are
+ * not sent yet. The port sends from txPos and advances it.
+ */
+typedef struct _eMB_TCPConnStruct
+{
+  uint16_t                    clientId;           /*!< Number of the connection, set by the port. */
+  uint16_t                    rxLen;
+  uint16_t                    txPos;
+  uint16_t                    txLen;
+#ifdef eMB_GATEWAY_ENABLED
+  uint16_t                    txReserved;         /*!< Room kept in txBuf for forwarded requests. */
+#endif
+  uint8_t                     rxBuf[eMB_SLAVE_TCP_BUF_SIZE];
+  uint8_t                     txBuf[eMB_SLAVE_TCP_BUF_SIZE];
+} eMB_TCPConnStruct;
+
+#ifdef eMB_GATEWAY_ENABLED
+/*! \brief Called when a response of a forwarded request was appended to the
+ *    transmit buffer of a connection outside of eMB_Slave_TCPProcess(). */
+typedef void (*eMB_TCPNotifyCallback)(eMB_TCPConnStruct *conn);
+#endif
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#ifdef eMB_SLAVE_TCP_ENABLED
+/*! \ingroup modbus
+ * \brief Select the store which is served. NULL serves the store of the master.
+ *
+ * A process other than the master can serve a read only mapping of the store
+ * (see eMB_POSIX_PortShmOpen()).
+ */
+void eMB_Slave_TCPInit(const eMB_ShadowStruct *shadow);
+
+#ifdef eMB_GATEWAY_ENABLED
+/*! \ingroup modbus
+ * \brief Set the callback which sends late responses of forwarded requests.
+ */
+void eMB_Slave_TCPSetNotify(eMB_TCPNotifyCallback notify);
+#endif
+
+/*! \ingroup modbus
+ * \brief Clear the buffers of a connection. Called for every new connection.
+ *
+ * \param conn     connection
+ * \param clientId number of the connection, 0 - eMB_SLAVE_TCP_CONN_MAX - 1
+ */
+void eMB_Slave_TCPConnReset(eMB_TCPConnStruct *conn, uint16_t clientId);
+
+/*! \ingroup modbus
+ * \brief Execute the complete requests in the receive buffer of a connection.
+ *
+ * Requests are executed (or forwarded) while the transmit buffer has room
+ * for one more response. The rest stays in the receive buffer until the port has sent
+ * the pending responses.
+ *
+ * \return eMB_ENOERR, or eMB_EIO if the client sent an invalid MBAP header
+ *   and the connection must be closed.
+ */
+eMB_ErrorCodeType eMB_Slave_TCPProcess(eMB_TCPConnStruct *conn);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_TCP_H */
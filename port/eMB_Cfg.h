@@ -92,17 +92,6 @@ extern "C" {
 
 
 
-/*! \brief Maximum number of Modbus functions codes the protocol stack
- *    should support.
- *
- * The maximum number of supported Modbus functions must be greater than
- * the sum of all enabled functions in this file and custom function
- * handlers. If set too small adding more functions will fail.
- */
-#define eMB_FUNC_HANDLERS_MAX                                         ( 16 )
-
-
-
 /*! \brief Number of bytes which should be allocated for the <em>Report Slave ID
  *    </em>command.
  *
@@ -115,11 +104,41 @@ extern "C" {
 
 
 
-#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
-/*! \brief If master receives a frame, the master will wait time of T35 to determine if the
- * last character received, then master can execute received frame */
-#define eMB_MASTER_DELAY_MS_T35                                       ( 50 )      /* 50 x 100us = 5ms */
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_SLAVE_RTU_ENABLED)
+/*! \brief Baud rate and bits per character (start, data, parity and stop bits) of the
+ * serial line, must match the UART configuration. A frame ends after a silence of
+ * T3.5, which is derived from them (see eMB_RTU_SetBaudrate()). The default of
+ * 9600 baud gives a T3.5 of 4 ms, a faster line only waits longer between frames,
+ * a slower one splits them. */
+#define eMB_RTU_BAUDRATE                                              (  9600UL)
+#define eMB_RTU_CHAR_BITS                                             ( 11 )      /* 8E1, 8O1 or 8N2 */
+
+/*! \brief If a frame with a silence of more than T1.5 between two characters is dropped.
+ * Requires eMB_ConfigStruct::pPortTimeGetUs. */
+// #define eMB_RTU_T15_CHECK_ENABLED
+
+/*! \brief If the busy time of the line is accounted, see eMB_Bus_GetStats(). */
+// #define eMB_RTU_BUS_ENABLED
+#endif
 
+#ifdef eMB_MASTER_RTU_ENABLED
+/*! \brief If the master detects the end of a response from its length, which follows
+ * from the function code and byte count, and a valid CRC. The response is processed
+ * when its last byte arrives and T3.5 only ends responses of other function codes
+ * and damaged ones. Helps with adapters which deliver the bytes in bursts (USB). */
+// #define eMB_MASTER_RTU_LENGTH_FRAMING_ENABLED
+
+/*! \brief If the master captures the frames on the line for eMB_Capture_Read() and
+ * the pcapng export, see eMB_Capture.h. A record takes about 264 bytes of RAM. */
+// #define eMB_MASTER_RTU_CAPTURE_ENABLED
+
+/*! \brief Frames kept in the capture ring. */
+#define eMB_MASTER_RTU_CAPTURE_RECORD_NUM                             (  8 )
+#endif
+
+
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
 /*! \brief If master send a broadcast frame, the master will wait time of convert to delay,
  * then master can send other frame */
 #define eMB_MASTER_DELAY_MS_CONVERT                                   (200 )
@@ -129,9 +148,146 @@ extern "C" {
  * Then master can send other frame */
 #define eMB_MASTER_TIMEOUT_MS_RESPOND                                 (1000)      /* 1000 x 100us = 100ms */
 
+/*! \brief If the respond timeout is derived per slave from the measured round trip
+ * times (see eMB_Rtt.h). eMB_MASTER_TIMEOUT_MS_RESPOND is then the timeout of a
+ * slave which has not answered yet. */
+// #define eMB_MASTER_RTT_ENABLED
+
+#ifdef eMB_MASTER_RTT_ENABLED
+/*! \brief Lower and upper limit of the respond timeout in microseconds. */
+#define eMB_MASTER_RTT_TIMEOUT_MIN_US                                 ( 5000UL )
+#define eMB_MASTER_RTT_TIMEOUT_MAX_US                                 (1000000UL )
+#endif
+
+/*! \brief If the master tracks the health of the slaves (see eMB_Health.h). Requests
+ * to an offline slave are refused, so it does not block the line with timeouts. */
+// #define eMB_MASTER_HEALTH_ENABLED
+
+#ifdef eMB_MASTER_HEALTH_ENABLED
+/*! \brief Number of respond timeouts in a row after which a slave is offline. */
+#define eMB_MASTER_HEALTH_OFFLINE_TIMEOUTS                            (  3 )
+
+/*! \brief First and longest probe interval of an offline slave in milliseconds. The
+ * interval doubles with every unanswered probe. Requires pPortTimeGet, without it
+ * every request to an offline slave is a probe. */
+#define eMB_MASTER_HEALTH_PROBE_MS_MIN                                ( 1000UL )
+#define eMB_MASTER_HEALTH_PROBE_MS_MAX                                (60000UL )
+#endif
+
+/*! \brief If failed requests of the application are retried by the stack (see eMB_Retry.h). */
+// #define eMB_MASTER_RETRY_ENABLED
+
+#ifdef eMB_MASTER_RETRY_ENABLED
+/*! \brief Number of failed requests which can wait for their retry. */
+#define eMB_MASTER_RETRY_QUEUE_SIZE                                   (  4 )
+
+/*! \brief Default retry policy of the slaves, see eMB_Retry_SetPolicy(). Delays are in
+ * milliseconds and require pPortTimeGet, without it retries are sent at once. */
+#define eMB_MASTER_RETRY_NUM                                          (  2 )
+#define eMB_MASTER_RETRY_DELAY_MS                                     (  0 )
+#define eMB_MASTER_RETRY_BUSY_NUM                                     (  4 )
+#define eMB_MASTER_RETRY_BUSY_DELAY_MS                                ( 50 )
+#define eMB_MASTER_RETRY_ACK_POLL_NUM                                 ( 10 )
+#define eMB_MASTER_RETRY_ACK_POLL_MS                                  (100 )
+#endif
+
+/*! \brief If the master keeps counters and latency histograms per slave (see eMB_Stats.h). */
+// #define eMB_MASTER_STATS_ENABLED
+
+#ifdef eMB_MASTER_STATS_ENABLED
+/*! \brief Buckets per power of two of the latency histogram as a power of two. 3 gives
+ * 8 buckets (12.5 % resolution) and 640 bytes of histogram per slave. */
+#define eMB_MASTER_STATS_HIST_SUB_BITS                                (  3 )
+#endif
+
+/*! \brief If the master records the phases of every transaction (see eMB_Phase.h). */
+// #define eMB_MASTER_PHASE_ENABLED
+
+#ifdef eMB_MASTER_PHASE_ENABLED
+/*! \brief Number of completed transactions kept for eMB_Phase_Read(). */
+#define eMB_MASTER_PHASE_RECORD_NUM                                   ( 16 )
+#endif
+
+/*! \brief If the master traces its internal events for a timeline viewer (see eMB_Trace.h). */
+// #define eMB_MASTER_TRACE_ENABLED
+
+#ifdef eMB_MASTER_TRACE_ENABLED
+/*! \brief Events kept per ring, the tasks and the line interrupts have one ring each.
+ * An event takes 8 bytes. */
+#define eMB_MASTER_TRACE_RECORD_NUM                                   (128 )
+#endif
+
 /*! \brief The total slaves in Modbus Master system. Default 16.
  * \note : The slave ID must be continuous from 1.*/
 #define eMB_MASTER_TOTAL_SLAVE_NUM                                    ( 16 )
+
+/*! \brief If the register map and the poll plan of the master are generated from the
+ * device profile in eMB_ProfileCfg.h. The register map below is then not used. */
+// #define eMB_MASTER_PROFILE_ENABLED
+
+#ifdef eMB_MASTER_PROFILE_ENABLED
+#include "eMB_Profile.h"
+
+#define eMB_MASTER_DISCRETE_INPUT_START                               eMB_PROFILE_DISCRETE_START
+#define eMB_MASTER_DISCRETE_INPUT_NDISCRETES                          eMB_PROFILE_DISCRETE_NUM
+#define eMB_MASTER_COIL_START                                         eMB_PROFILE_COIL_START
+#define eMB_MASTER_COIL_NCOILS                                        eMB_PROFILE_COIL_NUM
+#define eMB_MASTER_REG_INPUT_START                                    eMB_PROFILE_INPUT_START
+#define eMB_MASTER_REG_INPUT_NREGS                                    eMB_PROFILE_INPUT_NUM
+#define eMB_MASTER_REG_HOLDING_START                                  eMB_PROFILE_HOLDING_START
+#define eMB_MASTER_REG_HOLDING_NREGS                                  eMB_PROFILE_HOLDING_NUM
+#else
+/*! \brief Register map of every slave kept by the master (shadow store). */
+#define eMB_MASTER_DISCRETE_INPUT_START                               (  0 )
+#define eMB_MASTER_DISCRETE_INPUT_NDISCRETES                          ( 16 )
+#define eMB_MASTER_COIL_START                                         (  0 )
+#define eMB_MASTER_COIL_NCOILS                                        ( 64 )
+#define eMB_MASTER_REG_INPUT_START                                    (  0 )
+#define eMB_MASTER_REG_INPUT_NREGS                                    (100 )
+#define eMB_MASTER_REG_HOLDING_START                                  (  0 )
+#define eMB_MASTER_REG_HOLDING_NREGS                                  (100 )
+#endif
+#endif
+
+
+
+#if (defined eMB_SLAVE_RTU_ENABLED) || (defined eMB_SLAVE_ASCII_ENABLED)
+/*! \brief Register store of the slave. The application accesses it through
+ * eMB_Slave_CoilBuf, eMB_Slave_DiscreteBuf, eMB_Slave_RegInputBuf and eMB_Slave_RegHoldingBuf. */
+#define eMB_SLAVE_DISCRETE_INPUT_START                                (  0 )
+#define eMB_SLAVE_DISCRETE_INPUT_NDISCRETES                           ( 16 )
+#define eMB_SLAVE_COIL_START                                          (  0 )
+#define eMB_SLAVE_COIL_NCOILS                                         ( 64 )
+#define eMB_SLAVE_REG_INPUT_START                                     (  0 )
+#define eMB_SLAVE_REG_INPUT_NREGS                                     (100 )
+#define eMB_SLAVE_REG_HOLDING_START                                   (  0 )
+#define eMB_SLAVE_REG_HOLDING_NREGS                                   (100 )
+#endif
+
+
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/*! \brief If the master keeps a compressed sample history of selected input and
+ * holding registers. The history requires eMB_ConfigStruct::pPortTimeGet. */
+// #define eMB_MASTER_HISTORY_ENABLED
+#endif
+
+
+
+#ifdef eMB_MASTER_HISTORY_ENABLED
+/*! \brief Maximum number of registers (points) which can have a history. */
+#define eMB_MASTER_HISTORY_POINTS_MAX                                 ( 16 )
+
+/*! \brief Maximum number of register ranges registered by eMB_History_AddRange(). */
+#define eMB_MASTER_HISTORY_RANGES_MAX                                 (  8 )
+
+/*! \brief Number of blocks in the ring of each point. When all blocks are full
+ * the oldest block is dropped as a whole. */
+#define eMB_MASTER_HISTORY_BLOCKS                                     (  4 )
+
+/*! \brief Size in bytes of the timestamp column and of the value column of a block.
+ * A constant poll period costs 1 bit per timestamp and an unchanged value 1 bit. */
+#define eMB_MASTER_HISTORY_COLUMN_SIZE                                ( 64 )
 #endif
 
 
@@ -143,6 +299,53 @@ extern "C" {
 
 
 
+#if (defined eMB_SLAVE_TCP_ENABLED)
+/*! \brief Default port of the Modbus slave TCP server. */
+#define eMB_SLAVE_TCP_PORT                                            (502 )
+
+/*! \brief Maximum number of simultaneous client connections. */
+#define eMB_SLAVE_TCP_CONN_MAX                                        (256 )
+
+/*! \brief Size of the receive and of the transmit buffer of a connection. Pipelined
+ * requests are executed as long as the responses fit into the transmit buffer.
+ * Must hold at least two frames (2 * 260 bytes). */
+#define eMB_SLAVE_TCP_BUF_SIZE                                        (2048 )
+
+#if (defined eMB_MASTER_RTU_ENABLED) || (defined eMB_MASTER_ASCII_ENABLED)
+/*! \brief If requests of TCP clients are forwarded to the serial line (gateway)
+ * instead of being answered from the shadow store. */
+// #define eMB_GATEWAY_ENABLED
+#endif
+#endif
+
+
+
+#if (defined eMB_GATEWAY_ENABLED)
+/*! \brief Number of clients of the gateway, one per TCP connection. */
+#define eMB_GATEWAY_CLIENT_MAX                                        ( eMB_SLAVE_TCP_CONN_MAX )
+
+/*! \brief Number of requests which wait for the serial line, of all clients. */
+#define eMB_GATEWAY_QUEUE_SIZE                                        ( 64 )
+
+/*! \brief Number of requests of one client which wait for the serial line. Further
+ * requests are rejected, so one client can't fill the whole queue. The transmit
+ * buffer keeps room for their responses, eMB_SLAVE_TCP_BUF_SIZE must hold one
+ * frame more (260 bytes each). */
+#define eMB_GATEWAY_CLIENT_QUEUE_SIZE                                 (  4 )
+
+/*! \brief Number of cached read responses (about 270 bytes each). */
+#define eMB_GATEWAY_CACHE_SIZE                                        ( 32 )
+
+/*! \brief Default time to live of a cached read in milliseconds, 0 disables the
+ * cache for registers without a range of eMB_Gateway_SetCacheTtl(). */
+#define eMB_GATEWAY_CACHE_TTL_MS                                      (500 )
+
+/*! \brief Number of ranges with their own time to live. */
+#define eMB_GATEWAY_CACHE_RANGES_MAX                                  (  8 )
+#endif
+
+
+
 /*===============================================================================================
 *                                           VARIABLES
 ===============================================================================================*/
@@ -43,6 +43,8 @@ extern bool eMB_WEH_PortTimersInit(void);
 extern void eMB_WEH_PortTimersEnable(eMB_PortTimerModeType timerMode);
 extern void eMB_WEH_PortTimersDisable(void);
 
+extern uint32_t eMB_WEH_PortTimeGet(void);
+
 
 
 /*===============================================================================================
@@ -69,7 +71,13 @@ const eMB_ConfigStruct eMB_WehConfig =
   /* Port timer function pointer */
   .pPortTimersInit            = eMB_WEH_PortTimersInit,
   .pPortTimersEnable          = eMB_WEH_PortTimersEnable,
-  .pPortTimersDisable         = eMB_WEH_PortTimersDisable
+  .pPortTimersDisable         = eMB_WEH_PortTimersDisable,
+  /* Port time function pointer */
+  .pPortTimeGet               = eMB_WEH_PortTimeGet,
+  /* No microsecond clock, round trip times are measured in milliseconds */
+  .pPortTimeGetUs             = NULL,
+  /* Own address if role is eMB_ROLE_SLAVE */
+  .slaveAddr                  = 1U
 };
 
 
@@ -161,7 +161,7 @@ static void eMB_WEH_PortSerialTxTask(void* parameter)
     osEventFlagsWait(eMB_WEH_PortSerialTxEvent, eMB_WEH_PORT_SERIAL_TXEVENT_START, osFlagsWaitAny | osFlagsNoClear, osWaitForever);
 
     /* execute modbus callback */
-    eMB_Master_RTUFrameTransmitterEmptyCallback();
+    (void)eMB_FrameTransmitterEmptyCalloutArr();
   }
 }
 
@@ -180,7 +180,7 @@ void eMB_WEH_PortSerialRxCpltCallback(UART_HandleTypeDef *huart)
     eMB_recvData = eMB_WEH_pUartIns->Instance->DR & (uint8_t)0xFFU;
 
     /* execute modbus callback */
-    eMB_Master_RTUFrameByteReceivedCallback();
+    (void)eMB_FrameByteReceivedCalloutArr();
   }
 }
 
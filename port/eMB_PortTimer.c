@@ -54,7 +54,7 @@ static void eMB_WEH_PortTimerElapsedCallback(TIM_HandleTypeDef *xTimer);
 /* By default we acknowledged that timer frequency is 10kHz (period is 100us) */
 bool eMB_WEH_PortTimersInit(void)
 {
-  __HAL_TIM_SetAutoreload(eMB_WEH_PORT_TIMER_INSTANCE, (eMB_MASTER_DELAY_MS_T35 - 1));
+  __HAL_TIM_SetAutoreload(eMB_WEH_PORT_TIMER_INSTANCE, ((eMB_RTU_GetT35() + 99UL) / 100UL - 1UL));
   HAL_TIM_RegisterCallback(eMB_WEH_PORT_TIMER_INSTANCE, HAL_TIM_PERIOD_ELAPSED_CB_ID, eMB_WEH_PortTimerElapsedCallback);
   
   return true;
@@ -62,25 +62,32 @@ bool eMB_WEH_PortTimersInit(void)
 
 void eMB_WEH_PortTimersEnable(eMB_PortTimerModeType timerMode)
 {
-  uint16_t delay = (uint16_t)0U;
+  uint32_t delay = 0UL;
 
   switch (timerMode)
   {
     case eMB_PORT_TIMER_T35:
     {
-      delay = (uint16_t)eMB_MASTER_DELAY_MS_T35 - 1U;
+      /* T3.5 of the serial line, in 100us ticks. */
+      delay = (eMB_RTU_GetT35() + 99UL) / 100UL - 1UL;
 
       break;
     }
     case eMB_PORT_TIMER_RESPOND_TIMEOUT:
     {
-      delay = (uint16_t)eMB_MASTER_DELAY_MS_CONVERT - 1U;
+      /* Respond timeout of the addressed slave, in 100us ticks. */
+      delay = (eMB_Rtt_GetTimeout() + 99UL) / 100UL - 1UL;
+
+      if (delay > 0xFFFFUL)
+      {
+        delay = 0xFFFFUL;
+      }
 
       break;
     }
     case eMB_PORT_TIMER_CONVERT_DELAY:
     {
-      delay = (uint16_t)eMB_MASTER_TIMEOUT_MS_RESPOND - 1U;
+      delay = (uint32_t)eMB_MASTER_DELAY_MS_CONVERT - 1UL;
 
       break;
     }
@@ -107,7 +114,7 @@ static void eMB_WEH_PortTimerElapsedCallback(TIM_HandleTypeDef *xTimer)
 {
   HAL_TIM_Base_Stop_IT(eMB_WEH_PORT_TIMER_INSTANCE);
 
-  (void)eMB_Master_RTUTimerExpiredCallback();
+  (void)eMB_FrameTimerExpiredCalloutArr();
 }
 
 
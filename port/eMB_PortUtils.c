@@ -59,6 +59,17 @@ void eMB_PortExitCriticalSection(void)
   taskEXIT_CRITICAL();
 }
 
+/**
+ * This function returns a monotonic time in milliseconds.
+ * Note: The time is derived from OS kernel tick. It wraps around like the tick counter.
+ *
+ * @return current time in milliseconds
+ */
+uint32_t eMB_WEH_PortTimeGet(void)
+{
+  return (uint32_t)(((uint64_t)osKernelGetTickCount() * 1000U) / osKernelGetTickFreq());
+}
+
 
 
 #ifdef __cplusplus
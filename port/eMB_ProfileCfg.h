@@ -0,0 +1,69 @@
+/*
+ * File:   eMB_ProfileCfg.h
+ * Author: Long
+ *
+ * Device profile of the Modbus master network. Only used if
+ * eMB_MASTER_PROFILE_ENABLED is defined in eMB_Cfg.h.
+ *
+ * Created on October 19, 2026, 01:15 PM
+ */
+
+#ifndef EMB_PROFILECFG_H
+#define EMB_PROFILECFG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \brief Poll table. Every entry is read with one request every periodMs
+ * milliseconds, so registers which are read together must be one entry.
+ *
+ * X(name, slaveAddr, regType, address, number, periodMs)
+ */
+#define eMB_PROFILE_POLL_TABLE(X)                                                                 \
+  X(METER_VOLTAGE,    1, eMB_REG_INPUT,             0, 12,  1000)                                 \
+  X(METER_ENERGY,     1, eMB_REG_INPUT,            40,  4, 10000)                                 \
+  X(DRIVE_CONTROL,    2, eMB_REG_HOLDING,           0,  8,   500)                                 \
+  X(DRIVE_STATUS,     2, eMB_REG_DISCRETE_INPUTS,   0, 16,   200)                                 \
+  X(RELAYS,           3, eMB_REG_COILS,             0,  8,  1000)
+
+/*! \brief Point table. A point is a named value inside one entry of the poll table.
+ *
+ * X(name, pollName, offset, number)
+ */
+#define eMB_PROFILE_POINT_TABLE(X)                                                                \
+  X(VOLTAGE_L1,       METER_VOLTAGE,  0, 2)                                                       \
+  X(VOLTAGE_L2,       METER_VOLTAGE,  2, 2)                                                       \
+  X(VOLTAGE_L3,       METER_VOLTAGE,  4, 2)                                                       \
+  X(ENERGY_TOTAL,     METER_ENERGY,   0, 4)                                                       \
+  X(DRIVE_SPEED_SET,  DRIVE_CONTROL,  0, 1)                                                       \
+  X(DRIVE_RAMP_TIME,  DRIVE_CONTROL,  1, 1)                                                       \
+  X(DRIVE_RUNNING,    DRIVE_STATUS,   0, 1)                                                       \
+  X(DRIVE_FAULT,      DRIVE_STATUS,   1, 1)                                                       \
+  X(RELAY_PUMP,       RELAYS,         0, 1)                                                       \
+  X(RELAY_FAN,        RELAYS,         1, 1)
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PROFILECFG_H */
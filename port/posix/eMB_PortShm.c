@@ -0,0 +1,381 @@
+/*
+ * File:   eMB_PortShm.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 10:40 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#define _GNU_SOURCE                                             /* syscall() */
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "eMB.h"
+#include "eMB_PortShm.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Suffix of the name of the waiter segment or file */
+#define eMB_POSIX_SHM_WAIT_SUFFIX                 ".wait"
+
+/* Mode of the store: consumers only read it */
+#define eMB_POSIX_SHM_MODE                        ( 0644 )
+
+/* Mode of the waiter page: every consumer counts itself in it */
+#define eMB_POSIX_SHM_WAIT_MODE                   ( 0666 )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static eMB_ShadowStruct *eMB_POSIX_ShmPtr;
+
+/* Consumers waiting for changeCount, in the waiter page of the master */
+static volatile uint32_t *eMB_POSIX_ShmWaiterPtr;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static eMB_ErrorCodeType       eMB_POSIX_PortShmMapWrite(int fd, int waitFd, bool restore);
+static const eMB_ShadowStruct *eMB_POSIX_PortShmMapRead(int fd, int waitFd);
+static void                    eMB_POSIX_PortShmNotify(void);
+static bool                    eMB_POSIX_PortShmWaitName(char *waitName, const char *name);
+static size_t                  eMB_POSIX_PortShmStoreSize(void);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_POSIX_PortShmCreate(const char *name)
+{
+  char waitName[PATH_MAX];
+  int fd, waitFd;
+
+  if (eMB_POSIX_PortShmWaitName(waitName, name) == false)
+  {
+    return eMB_EINVAL;
+  }
+
+  fd     = shm_open(name, O_CREAT | O_RDWR, eMB_POSIX_SHM_MODE);
+  waitFd = shm_open(waitName, O_CREAT | O_RDWR, eMB_POSIX_SHM_WAIT_MODE);
+
+  return eMB_POSIX_PortShmMapWrite(fd, waitFd, false);
+}
+
+eMB_ErrorCodeType eMB_POSIX_PortShmCreateFile(const char *path)
+{
+  char waitName[PATH_MAX];
+  int fd, waitFd;
+
+  if (eMB_POSIX_PortShmWaitName(waitName, path) == false)
+  {
+    return eMB_EINVAL;
+  }
+
+  fd     = open(path, O_CREAT | O_RDWR, eMB_POSIX_SHM_MODE);
+  waitFd = open(waitName, O_CREAT | O_RDWR, eMB_POSIX_SHM_WAIT_MODE);
+
+  return eMB_POSIX_PortShmMapWrite(fd, waitFd, true);
+}
+
+void eMB_POSIX_PortShmDestroy(const char *name)
+{
+  char waitName[PATH_MAX];
+
+  eMB_POSIX_PortShmRelease();
+
+  (void)shm_unlink(name);
+
+  if (eMB_POSIX_PortShmWaitName(waitName, name) == true)
+  {
+    (void)shm_unlink(waitName);
+  }
+}
+
+void eMB_POSIX_PortShmRelease(void)
+{
+  if (eMB_POSIX_ShmPtr != NULL)
+  {
+    (void)eMB_Shadow_Attach(NULL, 0U, NULL);
+    (void)msync(eMB_POSIX_ShmPtr, sizeof(eMB_ShadowStruct), MS_SYNC);
+    (void)munmap(eMB_POSIX_ShmPtr, sizeof(eMB_ShadowStruct));
+    (void)munmap((void *)eMB_POSIX_ShmWaiterPtr, (size_t)sysconf(_SC_PAGESIZE));
+
+    eMB_POSIX_ShmPtr = NULL;
+    eMB_POSIX_ShmWaiterPtr = NULL;
+  }
+}
+
+eMB_ErrorCodeType eMB_POSIX_PortShmSync(void)
+{
+  if (eMB_POSIX_ShmPtr == NULL)
+  {
+    return eMB_EILLSTATE;
+  }
+
+  /* Readers of the mapping see every update at once, this only schedules the
+   * write back of dirty pages so a power loss costs at most one period. */
+  if (msync(eMB_POSIX_ShmPtr, sizeof(eMB_ShadowStruct), MS_ASYNC) != 0)
+  {
+    return eMB_EIO;
+  }
+
+  return eMB_ENOERR;
+}
+
+const eMB_ShadowStruct *eMB_POSIX_PortShmOpen(const char *name)
+{
+  char waitName[PATH_MAX];
+
+  if (eMB_POSIX_PortShmWaitName(waitName, name) == false)
+  {
+    return NULL;
+  }
+
+  return eMB_POSIX_PortShmMapRead(shm_open(name, O_RDONLY, 0), shm_open(waitName, O_RDWR, 0));
+}
+
+const eMB_ShadowStruct *eMB_POSIX_PortShmOpenFile(const char *path)
+{
+  char waitName[PATH_MAX];
+
+  if (eMB_POSIX_PortShmWaitName(waitName, path) == false)
+  {
+    return NULL;
+  }
+
+  return eMB_POSIX_PortShmMapRead(open(path, O_RDONLY), open(waitName, O_RDWR));
+}
+
+void eMB_POSIX_PortShmClose(const eMB_ShadowStruct *shadow)
+{
+  if (shadow != NULL)
+  {
+    (void)munmap((void *)shadow, eMB_POSIX_PortShmStoreSize() + (size_t)sysconf(_SC_PAGESIZE));
+  }
+}
+
+bool eMB_POSIX_PortShmWait(const eMB_ShadowStruct *shadow, uint32_t changeCount, int32_t timeoutMs)
+{
+  /* The waiter page is mapped right behind the read only store. */
+  volatile uint32_t *pWaiterNum = (volatile uint32_t *)((const uint8_t *)shadow + eMB_POSIX_PortShmStoreSize());
+  struct timespec timeout;
+
+  if (shadow->header.changeCount != changeCount)
+  {
+    return true;
+  }
+
+  timeout.tv_sec  = timeoutMs / 1000;
+  timeout.tv_nsec = (long)(timeoutMs % 1000) * 1000000L;
+
+  /* Registered before the kernel compares the counter: a master which missed
+   * the waiter has already changed the counter, the wait returns at once with
+   * EAGAIN. */
+  (void)__atomic_fetch_add(pWaiterNum, 1UL, __ATOMIC_SEQ_CST);
+
+  (void)syscall(SYS_futex, &shadow->header.changeCount, FUTEX_WAIT, changeCount,
+                (timeoutMs < 0) ? NULL : &timeout, NULL, 0);
+
+  (void)__atomic_fetch_sub(pWaiterNum, 1UL, __ATOMIC_SEQ_CST);
+
+  return (shadow->header.changeCount != changeCount);
+}
+
+
+
+
+
+/* Map the descriptors read write and place the master shadow store in the
+ * first, the second holds the waiter count. The descriptors are closed, the
+ * mappings stay valid. */
+static eMB_ErrorCodeType eMB_POSIX_PortShmMapWrite(int fd, int waitFd, bool restore)
+{
+  eMB_ErrorCodeType errStatus = eMB_EPORTERR;
+  size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  void *waitMem = MAP_FAILED;
+  void *mem;
+
+  if ((fd < 0) || (waitFd < 0))
+  {
+    errStatus = eMB_EPORTERR;
+  }
+  else if (eMB_POSIX_ShmPtr != NULL)
+  {
+    errStatus = eMB_EILLSTATE;
+  }
+  else if ((ftruncate(fd, (off_t)sizeof(eMB_ShadowStruct)) == 0) && (ftruncate(waitFd, (off_t)pageSize) == 0))
+  {
+    /* The umask must not keep consumers from counting themselves. */
+    (void)fchmod(waitFd, eMB_POSIX_SHM_WAIT_MODE);
+
+    waitMem = mmap(NULL, pageSize, PROT_READ | PROT_WRITE, MAP_SHARED, waitFd, 0);
+    mem = mmap(NULL, sizeof(eMB_ShadowStruct), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if ((mem != MAP_FAILED) && (waitMem != MAP_FAILED))
+    {
+      /* Set before attaching, the notify callback uses them. */
+      eMB_POSIX_ShmPtr = (eMB_ShadowStruct *)mem;
+      eMB_POSIX_ShmWaiterPtr = (volatile uint32_t *)waitMem;
+
+      if (restore == true)
+      {
+        /* eMB_EIO only tells that no previous image was found. */
+        errStatus = eMB_Shadow_Restore(mem, (uint32_t)sizeof(eMB_ShadowStruct), eMB_POSIX_PortShmNotify);
+
+        if (errStatus == eMB_EIO)
+        {
+          errStatus = eMB_ENOERR;
+        }
+      }
+      else
+      {
+        errStatus = eMB_Shadow_Attach(mem, (uint32_t)sizeof(eMB_ShadowStruct), eMB_POSIX_PortShmNotify);
+      }
+    }
+
+    if (errStatus != eMB_ENOERR)
+    {
+      if (mem != MAP_FAILED)
+      {
+        (void)munmap(mem, sizeof(eMB_ShadowStruct));
+      }
+
+      if (waitMem != MAP_FAILED)
+      {
+        (void)munmap(waitMem, pageSize);
+      }
+
+      eMB_POSIX_ShmPtr = NULL;
+      eMB_POSIX_ShmWaiterPtr = NULL;
+    }
+  }
+  else
+  {
+    /* Size of a descriptor could not be set. */
+  }
+
+  if (fd >= 0)
+  {
+    (void)close(fd);
+  }
+
+  if (waitFd >= 0)
+  {
+    (void)close(waitFd);
+  }
+
+  return errStatus;
+}
+
+/* Map the store read only for a consumer and check its layout. The waiter
+ * page follows the store in the same address range, so eMB_POSIX_PortShmWait()
+ * finds it from the store. */
+static const eMB_ShadowStruct *eMB_POSIX_PortShmMapRead(int fd, int waitFd)
+{
+  const eMB_ShadowStruct *shadow = NULL;
+  size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  size_t storeSize = eMB_POSIX_PortShmStoreSize();
+  struct stat st;
+  uint8_t *mem;
+
+  if ((fd >= 0) && (waitFd >= 0) && (fstat(fd, &st) == 0) && ((size_t)st.st_size >= sizeof(eMB_ShadowStruct)))
+  {
+    /* Reserve the range, then map both into it. */
+    mem = (uint8_t *)mmap(NULL, storeSize + pageSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if ((void *)mem != MAP_FAILED)
+    {
+      if ((mmap(mem, sizeof(eMB_ShadowStruct), PROT_READ, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED) &&
+          (mmap(mem + storeSize, pageSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, waitFd, 0) != MAP_FAILED) &&
+          (eMB_Shadow_Validate((const eMB_ShadowStruct *)mem, (uint32_t)st.st_size) == eMB_ENOERR))
+      {
+        shadow = (const eMB_ShadowStruct *)mem;
+      }
+      else
+      {
+        (void)munmap(mem, storeSize + pageSize);
+      }
+    }
+  }
+
+  if (fd >= 0)
+  {
+    (void)close(fd);
+  }
+
+  if (waitFd >= 0)
+  {
+    (void)close(waitFd);
+  }
+
+  return shadow;
+}
+
+/* Wake all consumers waiting on the change counter. Most updates have no
+ * waiter, they cost no system call. */
+static void eMB_POSIX_PortShmNotify(void)
+{
+  /* Orders the counter update before the read of the waiters, the pair of the
+   * increment in eMB_POSIX_PortShmWait(). */
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+  if (__atomic_load_n(eMB_POSIX_ShmWaiterPtr, __ATOMIC_SEQ_CST) != 0UL)
+  {
+    (void)syscall(SYS_futex, &eMB_POSIX_ShmPtr->header.changeCount, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+  }
+}
+
+/* Name of the waiter segment or file of a store. */
+static bool eMB_POSIX_PortShmWaitName(char *waitName, const char *name)
+{
+  int length = snprintf(waitName, PATH_MAX, "%s" eMB_POSIX_SHM_WAIT_SUFFIX, name);
+
+  return ((length > 0) && (length < PATH_MAX));
+}
+
+/* Size of the store rounded up to whole pages, the offset of the waiter page
+ * in the mapping of a consumer. */
+static size_t eMB_POSIX_PortShmStoreSize(void)
+{
+  size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+
+  return ((sizeof(eMB_ShadowStruct) + pageSize - 1U) / pageSize) * pageSize;
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
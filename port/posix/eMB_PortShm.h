@@ -0,0 +1,82 @@
+/*
+ * File:   eMB_PortShm.h
+ * Author: Long
+ *
+ * POSIX shared memory export of the master shadow store. The master process
+ * creates the segment, other processes map it read only and read values with
+ * eMB_Shadow_ReadRegisters()/eMB_Shadow_ReadBits() without any system call.
+ * Updates are signalled with a futex on eMB_ShadowHeaderStruct::changeCount.
+ * A waiting consumer counts itself in a separate page, the segment or file
+ * with the suffix ".wait" (mode 0666), and the master only wakes while the
+ * count is not 0. A consumer can only disturb the wake-ups through it, never
+ * the store (mode 0644).
+ * A regular file can be used instead of a segment to keep the values over a
+ * restart of the master.
+ *
+ * Created on October 19, 2026, 10:40 AM
+ */
+
+#ifndef EMB_PORTSHM_H
+#define EMB_PORTSHM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+#include "eMB_Shadow.h"
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \brief Create (or reuse) the segment and place the master shadow store in it.
+ *    Must be called before eMB_Enable(). */
+eMB_ErrorCodeType eMB_POSIX_PortShmCreate(const char *name);
+
+/*! \brief Like eMB_POSIX_PortShmCreate(), but the store is kept in a file. The values
+ *    of a previous run are restored as stale blocks (see eMB_Shadow_Restore()). */
+eMB_ErrorCodeType eMB_POSIX_PortShmCreateFile(const char *path);
+
+/*! \brief Return the master to its internal store and remove the segment and its waiter page. */
+void eMB_POSIX_PortShmDestroy(const char *name);
+
+/*! \brief Return the master to its internal store and keep the segment or file. */
+void eMB_POSIX_PortShmRelease(void);
+
+/*! \brief Start writing the file mapping back to disk. Call periodically. */
+eMB_ErrorCodeType eMB_POSIX_PortShmSync(void);
+
+/*! \brief Map an existing segment read only. Returns NULL if it or its waiter
+ *    page does not exist or it was created with another layout. */
+const eMB_ShadowStruct *eMB_POSIX_PortShmOpen(const char *name);
+
+/*! \brief Map an existing file created by eMB_POSIX_PortShmCreateFile() read only. */
+const eMB_ShadowStruct *eMB_POSIX_PortShmOpenFile(const char *path);
+
+/*! \brief Unmap a segment mapped by eMB_POSIX_PortShmOpen(). */
+void eMB_POSIX_PortShmClose(const eMB_ShadowStruct *shadow);
+
+/*! \brief Wait until the change counter differs from changeCount.
+ *    A negative timeout waits forever. Returns true if the store changed. */
+bool eMB_POSIX_PortShmWait(const eMB_ShadowStruct *shadow, uint32_t changeCount, int32_t timeoutMs);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PORTSHM_H */
@@ -0,0 +1,379 @@
+/*
+ * File:   eMB_PortTcp.c
+ * Author: Long
+ *
+ * Created on October 19, 2026, 04:20 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE                               /* accept4() */
+#endif
+
+#include <errno.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include "eMB.h"
+#include "eMB_PortTcp.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_SLAVE_TCP_ENABLED
+/* Maximum number of events taken from the kernel per epoll_wait() */
+#define eMB_POSIX_PORT_TCP_EVENTS_MAX             ( 64 )
+
+/* One client connection */
+typedef struct _eMB_POSIX_TcpConnStruct
+{
+  int                         fd;                 /*!< -1 if the slot is free. */
+  eMB_TCPConnStruct           conn;
+} eMB_POSIX_TcpConnStruct;
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static int eMB_POSIX_TcpEpollFd = -1;
+static int eMB_POSIX_TcpListenFd = -1;
+
+static eMB_POSIX_TcpConnStruct eMB_POSIX_TcpConn[eMB_SLAVE_TCP_CONN_MAX];
+
+/* Stack of free connection slots */
+static uint16_t eMB_POSIX_TcpFree[eMB_SLAVE_TCP_CONN_MAX];
+static uint16_t eMB_POSIX_TcpFreeNum;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_POSIX_PortTcpAccept(void);
+static void eMB_POSIX_PortTcpService(eMB_POSIX_TcpConnStruct *pConn);
+static void eMB_POSIX_PortTcpDrop(eMB_POSIX_TcpConnStruct *pConn);
+
+#ifdef eMB_GATEWAY_ENABLED
+static void eMB_POSIX_PortTcpNotify(eMB_TCPConnStruct *conn);
+#endif
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_POSIX_PortTcpOpen(uint16_t port)
+{
+  struct sockaddr_in addr;
+  struct epoll_event event;
+  int optVal = 1;
+  uint16_t i;
+
+  if (eMB_POSIX_TcpEpollFd >= 0)
+  {
+    return eMB_EILLSTATE;
+  }
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_SLAVE_TCP_CONN_MAX; i++)
+  {
+    eMB_POSIX_TcpConn[i].fd = -1;
+    eMB_POSIX_TcpFree[i] = (uint16_t)(eMB_SLAVE_TCP_CONN_MAX - 1U - i);
+  }
+  eMB_POSIX_TcpFreeNum = (uint16_t)eMB_SLAVE_TCP_CONN_MAX;
+
+#ifdef eMB_GATEWAY_ENABLED
+  eMB_Slave_TCPSetNotify(eMB_POSIX_PortTcpNotify);
+#endif
+
+  eMB_POSIX_TcpListenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  eMB_POSIX_TcpEpollFd = epoll_create1(EPOLL_CLOEXEC);
+
+  if ((eMB_POSIX_TcpListenFd < 0) || (eMB_POSIX_TcpEpollFd < 0))
+  {
+    eMB_POSIX_PortTcpClose();
+    return eMB_EPORTERR;
+  }
+
+  (void)setsockopt(eMB_POSIX_TcpListenFd, SOL_SOCKET, SO_REUSEADDR, &optVal, sizeof(optVal));
+
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons((port != 0U) ? port : (uint16_t)eMB_SLAVE_TCP_PORT);
+
+  /* The listening socket is the only one with a NULL pointer. */
+  event.events = EPOLLIN | EPOLLET;
+  event.data.ptr = NULL;
+
+  if ((bind(eMB_POSIX_TcpListenFd, (struct sockaddr *)&addr, sizeof(addr)) != 0) ||
+      (listen(eMB_POSIX_TcpListenFd, SOMAXCONN) != 0) ||
+      (epoll_ctl(eMB_POSIX_TcpEpollFd, EPOLL_CTL_ADD, eMB_POSIX_TcpListenFd, &event) != 0))
+  {
+    eMB_POSIX_PortTcpClose();
+    return eMB_EPORTERR;
+  }
+
+  return eMB_ENOERR;
+}
+
+eMB_ErrorCodeType eMB_POSIX_PortTcpPoll(int32_t timeoutMs)
+{
+  struct epoll_event events[eMB_POSIX_PORT_TCP_EVENTS_MAX];
+  eMB_POSIX_TcpConnStruct *pConn;
+  int eventNum;
+  int i;
+
+  if (eMB_POSIX_TcpEpollFd < 0)
+  {
+    return eMB_EILLSTATE;
+  }
+
+  eventNum = epoll_wait(eMB_POSIX_TcpEpollFd, events, eMB_POSIX_PORT_TCP_EVENTS_MAX, (int)timeoutMs);
+
+  if (eventNum < 0)
+  {
+    return (errno == EINTR) ? eMB_ENOERR : eMB_EPORTERR;
+  }
+
+  for (i = 0; i < eventNum; i++)
+  {
+    pConn = (eMB_POSIX_TcpConnStruct *)events[i].data.ptr;
+
+    if (pConn == NULL)
+    {
+      eMB_POSIX_PortTcpAccept();
+    }
+    else if (pConn->fd < 0)
+    {
+      /* Dropped by an earlier event of this batch. */
+    }
+    else if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0U)
+    {
+      eMB_POSIX_PortTcpDrop(pConn);
+    }
+    else
+    {
+      eMB_POSIX_PortTcpService(pConn);
+    }
+  }
+
+  return eMB_ENOERR;
+}
+
+void eMB_POSIX_PortTcpClose(void)
+{
+  uint16_t i;
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_SLAVE_TCP_CONN_MAX; i++)
+  {
+    if (eMB_POSIX_TcpConn[i].fd >= 0)
+    {
+      eMB_POSIX_PortTcpDrop(&eMB_POSIX_TcpConn[i]);
+    }
+  }
+
+  if (eMB_POSIX_TcpListenFd >= 0)
+  {
+    (void)close(eMB_POSIX_TcpListenFd);
+    eMB_POSIX_TcpListenFd = -1;
+  }
+
+  if (eMB_POSIX_TcpEpollFd >= 0)
+  {
+    (void)close(eMB_POSIX_TcpEpollFd);
+    eMB_POSIX_TcpEpollFd = -1;
+  }
+}
+
+uint16_t eMB_POSIX_PortTcpConnCount(void)
+{
+  return (uint16_t)(eMB_SLAVE_TCP_CONN_MAX - eMB_POSIX_TcpFreeNum);
+}
+
+
+
+
+
+/* Accept all pending connections. Connections above eMB_SLAVE_TCP_CONN_MAX are closed at once. */
+static void eMB_POSIX_PortTcpAccept(void)
+{
+  eMB_POSIX_TcpConnStruct *pConn;
+  struct epoll_event event;
+  int optVal = 1;
+  int fd;
+
+  for (;;)
+  {
+    fd = accept4(eMB_POSIX_TcpListenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (fd < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      /* EAGAIN: nothing left. Other errors (e.g. EMFILE) are retried on the next edge. */
+      break;
+    }
+
+    if (eMB_POSIX_TcpFreeNum == (uint16_t)0U)
+    {
+      (void)close(fd);
+      continue;
+    }
+
+    /* Responses are written in one piece, don't wait for more data. */
+    (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &optVal, sizeof(optVal));
+
+    pConn = &eMB_POSIX_TcpConn[eMB_POSIX_TcpFree[--eMB_POSIX_TcpFreeNum]];
+    pConn->fd = fd;
+    eMB_Slave_TCPConnReset(&pConn->conn, (uint16_t)(pConn - eMB_POSIX_TcpConn));
+
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = pConn;
+
+    if (epoll_ctl(eMB_POSIX_TcpEpollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+      eMB_POSIX_PortTcpDrop(pConn);
+    }
+  }
+}
+
+/* Execute received requests, send responses and read until the socket is drained.
+ * With edge triggered events the loop only stops when the kernel returns EAGAIN,
+ * otherwise no further event would be reported for this connection. */
+static void eMB_POSIX_PortTcpService(eMB_POSIX_TcpConnStruct *pConn)
+{
+  eMB_TCPConnStruct *pTcp = &pConn->conn;
+  ssize_t count;
+  uint16_t rxLen;
+  bool isStalled;
+
+  for (;;)
+  {
+    rxLen = pTcp->rxLen;
+
+    if (eMB_Slave_TCPProcess(pTcp) != eMB_ENOERR)
+    {
+      eMB_POSIX_PortTcpDrop(pConn);
+      return;
+    }
+
+    /* Nothing taken and nothing to send: the room is held by forwarded requests. */
+    isStalled = ((pTcp->rxLen == rxLen) && (pTcp->txLen == (uint16_t)0U)) ? true : false;
+
+    while (pTcp->txPos < pTcp->txLen)
+    {
+      count = send(pConn->fd, &pTcp->txBuf[pTcp->txPos], (size_t)(pTcp->txLen - pTcp->txPos), MSG_NOSIGNAL);
+
+      if (count > 0)
+      {
+        pTcp->txPos = (uint16_t)(pTcp->txPos + count);
+      }
+      else if ((count < 0) && (errno == EINTR))
+      {
+        continue;
+      }
+      else if ((count < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+      {
+        /* Client does not read. Stop reading requests until EPOLLOUT. */
+        return;
+      }
+      else
+      {
+        eMB_POSIX_PortTcpDrop(pConn);
+        return;
+      }
+    }
+
+    /* Receive buffer full of pipelined requests, execute them first. If they
+     * wait for room, eMB_POSIX_PortTcpNotify() resumes with the next response. */
+    if (pTcp->rxLen == (uint16_t)eMB_SLAVE_TCP_BUF_SIZE)
+    {
+      if (isStalled == true)
+      {
+        return;
+      }
+
+      continue;
+    }
+
+    count = recv(pConn->fd, &pTcp->rxBuf[pTcp->rxLen], (size_t)(eMB_SLAVE_TCP_BUF_SIZE - pTcp->rxLen), 0);
+
+    if (count > 0)
+    {
+      pTcp->rxLen = (uint16_t)(pTcp->rxLen + count);
+    }
+    else if ((count < 0) && (errno == EINTR))
+    {
+      continue;
+    }
+    else if ((count < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+    {
+      return;
+    }
+    else
+    {
+      /* Closed by the client or failed. */
+      eMB_POSIX_PortTcpDrop(pConn);
+      return;
+    }
+  }
+}
+
+/* Close a connection and return its slot. */
+static void eMB_POSIX_PortTcpDrop(eMB_POSIX_TcpConnStruct *pConn)
+{
+  (void)epoll_ctl(eMB_POSIX_TcpEpollFd, EPOLL_CTL_DEL, pConn->fd, NULL);
+  (void)close(pConn->fd);
+
+#ifdef eMB_GATEWAY_ENABLED
+  /* Requests still waiting for the serial line are not answered. */
+  eMB_Gateway_CancelClient(pConn->conn.clientId);
+#endif
+
+  pConn->fd = -1;
+  eMB_POSIX_TcpFree[eMB_POSIX_TcpFreeNum++] = (uint16_t)(pConn - eMB_POSIX_TcpConn);
+}
+
+#ifdef eMB_GATEWAY_ENABLED
+/* A response of the serial line arrived, send it. Gateway and server run in the same task. */
+static void eMB_POSIX_PortTcpNotify(eMB_TCPConnStruct *conn)
+{
+  eMB_POSIX_TcpConnStruct *pConn = &eMB_POSIX_TcpConn[conn->clientId];
+
+  if (pConn->fd >= 0)
+  {
+    eMB_POSIX_PortTcpService(pConn);
+  }
+}
+#endif
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,62 @@
+/*
+ * File:   eMB_PortTcp.h
+ * Author: Long
+ *
+ * POSIX port of the Modbus slave TCP server (see eMB_TCP.h). All client
+ * connections are served by one thread with an edge triggered epoll set:
+ * the application calls eMB_POSIX_PortTcpPoll() in a loop. With
+ * eMB_GATEWAY_ENABLED the same loop calls eMB_MainFunction().
+ *
+ * port/posix/main/eMB_PosixTcpLoadMain.c measures the responses per second
+ * of the server with pipelining clients.
+ *
+ * Created on October 19, 2026, 04:20 PM
+ */
+
+#ifndef EMB_PORTTCP_H
+#define EMB_PORTTCP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_Types.h"
+#include "eMB_Cfg.h"
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+#ifdef eMB_SLAVE_TCP_ENABLED
+/*! \brief Listen on the given TCP port, 0 uses eMB_SLAVE_TCP_PORT. */
+eMB_ErrorCodeType eMB_POSIX_PortTcpOpen(uint16_t port);
+
+/*! \brief Wait up to timeoutMs for socket events and serve them. A negative
+ *    timeout waits forever. */
+eMB_ErrorCodeType eMB_POSIX_PortTcpPoll(int32_t timeoutMs);
+
+/*! \brief Close all connections and the listening socket. */
+void eMB_POSIX_PortTcpClose(void);
+
+/*! \brief Number of open client connections. */
+uint16_t eMB_POSIX_PortTcpConnCount(void);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PORTTCP_H */
@@ -0,0 +1,479 @@
+/*
+ * File:   eMB_PosixTcpLoadMain.c
+ * Author: Long
+ *
+ * Load generator of the Modbus slave TCP server (eMB_PortTcp.h). It forks the
+ * server, which serves a shadow store with ten holding registers of slave 1,
+ * and drives it from the parent over loopback:
+ *
+ *   gcc -std=c99 -O2 -D_DEFAULT_SOURCE -DeMB_SLAVE_TCP_ENABLED -Imodbus/include -Imodbus/rtu \
+ *       -Imodbus/tcp -Iport -Iport/posix -Iport/sim port/posix/main/eMB_PosixTcpLoadMain.c \
+ *       port/posix/eMB_PortTcp.c port/sim/eMB_PortSim.c modbus/tcp/eMB_TCP.c \
+ *       modbus/src/\*.c modbus/rtu/\*.c -lm -o tcpload
+ *   ./tcpload [connNum [depth [durationMs [port]]]]
+ *
+ * Every connection keeps depth read holding register requests (FC 3, ten
+ * registers) in flight and sends a new one for every response. The defaults
+ * are 250 connections, a depth of 16, 5000 ms and port 15020. The client runs
+ * on one thread of the same machine, so it competes with the server for the
+ * CPU. It prints one JSON line:
+ *
+ *   {"connNum":250,"depth":16,"durationMs":5000,"respNum":...,"respPerSec":...,
+ *    "errorNum":0,"serverCpuNsPerResp":...}
+ *
+ * serverCpuNsPerResp is the user and system time of the server process
+ * divided by the responses, it does not depend on the speed of the client.
+ *
+ * Created on October 20, 2026, 10:30 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "eMB.h"
+#include "eMB_PortTcp.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#define eMB_POSIX_TCP_LOAD_CONN_NUM               ( 250UL )
+#define eMB_POSIX_TCP_LOAD_DEPTH                  ( 16UL )
+#define eMB_POSIX_TCP_LOAD_DURATION_MS            ( 5000UL )
+#define eMB_POSIX_TCP_LOAD_PORT                   ( 15020UL )
+
+/* Slave and registers which are read */
+#define eMB_POSIX_TCP_LOAD_SLAVE                  ( 1U )
+#define eMB_POSIX_TCP_LOAD_REG_NUM                ( 10U )
+
+/* Read holding registers request: MBAP header, function code, address and quantity */
+#define eMB_POSIX_TCP_LOAD_REQ_SIZE               ( eMB_TCP_MBAP_SIZE + 5 )
+
+/* Deepest pipeline of a connection, bounded by the receive buffer of the server */
+#define eMB_POSIX_TCP_LOAD_DEPTH_MAX              ( eMB_SLAVE_TCP_BUF_SIZE / eMB_POSIX_TCP_LOAD_REQ_SIZE )
+
+#define eMB_POSIX_TCP_LOAD_EVENTS_MAX             ( 64 )
+
+/* One client connection */
+typedef struct _eMB_POSIX_TcpLoadConnStruct
+{
+  int                         fd;
+  uint16_t                    tid;                /*!< Transaction id of the next request. */
+  uint16_t                    rxLen;
+  uint16_t                    txPos;
+  uint16_t                    txLen;
+  uint8_t                     rxBuf[eMB_SLAVE_TCP_BUF_SIZE];
+  uint8_t                     txBuf[2 * eMB_SLAVE_TCP_BUF_SIZE]; /*!< Sent bytes are moved out past the half. */
+} eMB_POSIX_TcpLoadConnStruct;
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static eMB_POSIX_TcpLoadConnStruct *eMB_POSIX_TcpLoadConn;
+
+static uint64_t eMB_POSIX_TcpLoadRespNum;
+static uint64_t eMB_POSIX_TcpLoadErrorNum;
+
+static volatile sig_atomic_t eMB_POSIX_TcpLoadStop;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_POSIX_TcpLoadServe(uint16_t port);
+static void eMB_POSIX_TcpLoadOnSignal(int sigNum);
+static int  eMB_POSIX_TcpLoadConnect(uint16_t port);
+static void eMB_POSIX_TcpLoadPutRequest(eMB_POSIX_TcpLoadConnStruct *pConn);
+static bool eMB_POSIX_TcpLoadSend(eMB_POSIX_TcpLoadConnStruct *pConn);
+static bool eMB_POSIX_TcpLoadReceive(eMB_POSIX_TcpLoadConnStruct *pConn);
+static uint64_t eMB_POSIX_TcpLoadNowNs(void);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+int main(int argc, char *argv[])
+{
+  struct epoll_event events[eMB_POSIX_TCP_LOAD_EVENTS_MAX];
+  struct epoll_event event;
+  struct rusage usage;
+  eMB_POSIX_TcpLoadConnStruct *pConn;
+  uint32_t connNum    = eMB_POSIX_TCP_LOAD_CONN_NUM;
+  uint32_t depth      = eMB_POSIX_TCP_LOAD_DEPTH;
+  uint32_t durationMs = eMB_POSIX_TCP_LOAD_DURATION_MS;
+  uint16_t port       = (uint16_t)eMB_POSIX_TCP_LOAD_PORT;
+  uint64_t startNs;
+  uint64_t endNs;
+  uint64_t serverNs;
+  uint32_t i, j;
+  int epollFd;
+  int eventNum;
+  int status;
+  pid_t server;
+
+  if (argc > 1)
+  {
+    connNum = (uint32_t)strtoul(argv[1], NULL, 0);
+  }
+
+  if (argc > 2)
+  {
+    depth = (uint32_t)strtoul(argv[2], NULL, 0);
+  }
+
+  if (argc > 3)
+  {
+    durationMs = (uint32_t)strtoul(argv[3], NULL, 0);
+  }
+
+  if (argc > 4)
+  {
+    port = (uint16_t)strtoul(argv[4], NULL, 0);
+  }
+
+  if ((connNum == 0UL) || (connNum > (uint32_t)eMB_SLAVE_TCP_CONN_MAX) ||
+      (depth == 0UL) || (depth > (uint32_t)eMB_POSIX_TCP_LOAD_DEPTH_MAX))
+  {
+    (void)fprintf(stderr, "1 to %u connections with a depth of 1 to %u\n",
+                  (unsigned)eMB_SLAVE_TCP_CONN_MAX, (unsigned)eMB_POSIX_TCP_LOAD_DEPTH_MAX);
+    return 1;
+  }
+
+  server = fork();
+
+  if (server < 0)
+  {
+    return 1;
+  }
+
+  if (server == 0)
+  {
+    eMB_POSIX_TcpLoadServe(port);
+  }
+
+  eMB_POSIX_TcpLoadConn = (eMB_POSIX_TcpLoadConnStruct *)calloc(connNum, sizeof(eMB_POSIX_TcpLoadConnStruct));
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+  if ((eMB_POSIX_TcpLoadConn == NULL) || (epollFd < 0))
+  {
+    (void)kill(server, SIGTERM);
+    return 1;
+  }
+
+  for (i = 0UL; i < connNum; i++)
+  {
+    pConn = &eMB_POSIX_TcpLoadConn[i];
+    pConn->fd = eMB_POSIX_TcpLoadConnect(port);
+
+    event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+    event.data.ptr = pConn;
+
+    if ((pConn->fd < 0) || (epoll_ctl(epollFd, EPOLL_CTL_ADD, pConn->fd, &event) != 0))
+    {
+      (void)fprintf(stderr, "connection %lu failed\n", (unsigned long)i);
+      (void)kill(server, SIGTERM);
+      return 1;
+    }
+
+    for (j = 0UL; j < depth; j++)
+    {
+      eMB_POSIX_TcpLoadPutRequest(pConn);
+    }
+  }
+
+  startNs = eMB_POSIX_TcpLoadNowNs();
+  endNs   = startNs + (uint64_t)durationMs * 1000000ULL;
+
+  while (eMB_POSIX_TcpLoadNowNs() < endNs)
+  {
+    eventNum = epoll_wait(epollFd, events, eMB_POSIX_TCP_LOAD_EVENTS_MAX, 100);
+
+    for (i = 0UL; i < (uint32_t)((eventNum > 0) ? eventNum : 0); i++)
+    {
+      pConn = (eMB_POSIX_TcpLoadConnStruct *)events[i].data.ptr;
+
+      if ((eMB_POSIX_TcpLoadReceive(pConn) == false) || (eMB_POSIX_TcpLoadSend(pConn) == false))
+      {
+        (void)fprintf(stderr, "connection closed by the server\n");
+        (void)kill(server, SIGTERM);
+        return 1;
+      }
+    }
+  }
+
+  endNs = eMB_POSIX_TcpLoadNowNs();
+
+  (void)kill(server, SIGTERM);
+  (void)waitpid(server, &status, 0);
+  (void)getrusage(RUSAGE_CHILDREN, &usage);
+
+  serverNs = ((uint64_t)usage.ru_utime.tv_sec + (uint64_t)usage.ru_stime.tv_sec) * 1000000000ULL +
+             ((uint64_t)usage.ru_utime.tv_usec + (uint64_t)usage.ru_stime.tv_usec) * 1000ULL;
+
+  (void)printf("{\"connNum\":%lu,\"depth\":%lu,\"durationMs\":%lu,\"respNum\":%llu,\"respPerSec\":%.0f,"
+               "\"errorNum\":%llu,\"serverCpuNsPerResp\":%.0f}\n",
+               (unsigned long)connNum, (unsigned long)depth, (unsigned long)durationMs,
+               (unsigned long long)eMB_POSIX_TcpLoadRespNum,
+               (double)eMB_POSIX_TcpLoadRespNum * 1e9 / (double)(endNs - startNs),
+               (unsigned long long)eMB_POSIX_TcpLoadErrorNum,
+               (eMB_POSIX_TcpLoadRespNum != 0ULL) ? ((double)serverNs / (double)eMB_POSIX_TcpLoadRespNum) : 0.0);
+
+  return (eMB_POSIX_TcpLoadErrorNum == 0ULL) ? 0 : 1;
+}
+
+
+
+
+
+/* Server process: fill the holding registers of the slave and serve until SIGTERM. */
+static void eMB_POSIX_TcpLoadServe(uint16_t port)
+{
+  uint16_t i;
+
+  (void)signal(SIGTERM, eMB_POSIX_TcpLoadOnSignal);
+
+  (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+
+  eMB_Shadow_WriteBegin(eMB_REG_HOLDING, eMB_POSIX_TCP_LOAD_SLAVE);
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_POSIX_TCP_LOAD_REG_NUM; i++)
+  {
+    eMB_gShadowPtr->holdingBuf[eMB_POSIX_TCP_LOAD_SLAVE - 1U][i] = (uint16_t)(0x1000U + i);
+  }
+
+  eMB_Shadow_WriteEnd(eMB_REG_HOLDING, eMB_POSIX_TCP_LOAD_SLAVE, 0UL);
+
+  if (eMB_POSIX_PortTcpOpen(port) != eMB_ENOERR)
+  {
+    (void)fprintf(stderr, "server cannot listen on port %u\n", (unsigned)port);
+    _exit(1);
+  }
+
+  while (eMB_POSIX_TcpLoadStop == 0)
+  {
+    (void)eMB_POSIX_PortTcpPoll(100);
+  }
+
+  eMB_POSIX_PortTcpClose();
+  _exit(0);
+}
+
+static void eMB_POSIX_TcpLoadOnSignal(int sigNum)
+{
+  (void)sigNum;
+
+  eMB_POSIX_TcpLoadStop = 1;
+}
+
+/* Connect to the server, retried while it is starting. */
+static int eMB_POSIX_TcpLoadConnect(uint16_t port)
+{
+  struct sockaddr_in addr;
+  struct timespec delay = { 0, 10000000L };
+  int optVal = 1;
+  int retry;
+  int fd;
+
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+
+  for (retry = 0; retry < 100; retry++)
+  {
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (fd < 0)
+    {
+      return -1;
+    }
+
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+    {
+      (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &optVal, sizeof(optVal));
+      (void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+      return fd;
+    }
+
+    (void)close(fd);
+    (void)nanosleep(&delay, NULL);
+  }
+
+  return -1;
+}
+
+/* Append a request to the transmit buffer, sent by eMB_POSIX_TcpLoadSend(). */
+static void eMB_POSIX_TcpLoadPutRequest(eMB_POSIX_TcpLoadConnStruct *pConn)
+{
+  uint8_t *pReq;
+
+  if (pConn->txPos == pConn->txLen)
+  {
+    pConn->txPos = (uint16_t)0U;
+    pConn->txLen = (uint16_t)0U;
+  }
+
+  pReq = &pConn->txBuf[pConn->txLen];
+
+  pReq[eMB_TCP_MBAP_TID_OFFSET]      = (uint8_t)(pConn->tid >> 8U);
+  pReq[eMB_TCP_MBAP_TID_OFFSET + 1]  = (uint8_t)(pConn->tid & 0xFFU);
+  pReq[eMB_TCP_MBAP_PID_OFFSET]      = 0U;
+  pReq[eMB_TCP_MBAP_PID_OFFSET + 1]  = 0U;
+  pReq[eMB_TCP_MBAP_LEN_OFFSET]      = 0U;
+  pReq[eMB_TCP_MBAP_LEN_OFFSET + 1]  = 6U;
+  pReq[eMB_TCP_MBAP_UID_OFFSET]      = (uint8_t)eMB_POSIX_TCP_LOAD_SLAVE;
+  pReq[eMB_TCP_MBAP_SIZE]            = (uint8_t)eMB_FUNC_READ_HOLDING_REGISTER;
+  pReq[eMB_TCP_MBAP_SIZE + 1]        = 0U;
+  pReq[eMB_TCP_MBAP_SIZE + 2]        = 0U;
+  pReq[eMB_TCP_MBAP_SIZE + 3]        = 0U;
+  pReq[eMB_TCP_MBAP_SIZE + 4]        = (uint8_t)eMB_POSIX_TCP_LOAD_REG_NUM;
+
+  pConn->txLen = (uint16_t)(pConn->txLen + eMB_POSIX_TCP_LOAD_REQ_SIZE);
+  pConn->tid++;
+}
+
+/* Write the pending requests until the socket is full. */
+static bool eMB_POSIX_TcpLoadSend(eMB_POSIX_TcpLoadConnStruct *pConn)
+{
+  ssize_t count;
+
+  while (pConn->txPos < pConn->txLen)
+  {
+    count = send(pConn->fd, &pConn->txBuf[pConn->txPos], (size_t)(pConn->txLen - pConn->txPos), MSG_NOSIGNAL);
+
+    if (count > 0)
+    {
+      pConn->txPos = (uint16_t)(pConn->txPos + count);
+    }
+    else if ((count < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+    {
+      break;
+    }
+    else if ((count < 0) && (errno == EINTR))
+    {
+      continue;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  /* Move the unsent requests to the start once the buffer is sent or half used. */
+  if ((pConn->txPos == pConn->txLen) || (pConn->txPos > (uint16_t)(eMB_SLAVE_TCP_BUF_SIZE / 2)))
+  {
+    memmove(pConn->txBuf, &pConn->txBuf[pConn->txPos], (size_t)(pConn->txLen - pConn->txPos));
+    pConn->txLen = (uint16_t)(pConn->txLen - pConn->txPos);
+    pConn->txPos = (uint16_t)0U;
+  }
+
+  return true;
+}
+
+/* Read until the socket is drained and put one request for every response. */
+static bool eMB_POSIX_TcpLoadReceive(eMB_POSIX_TcpLoadConnStruct *pConn)
+{
+  uint16_t frameLen;
+  uint16_t pos;
+  ssize_t count;
+
+  for (;;)
+  {
+    count = recv(pConn->fd, &pConn->rxBuf[pConn->rxLen], (size_t)(eMB_SLAVE_TCP_BUF_SIZE - pConn->rxLen), 0);
+
+    if (count == 0)
+    {
+      return false;
+    }
+
+    if (count < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? true : false;
+    }
+
+    pConn->rxLen = (uint16_t)(pConn->rxLen + count);
+    pos = (uint16_t)0U;
+
+    while ((uint16_t)(pConn->rxLen - pos) >= (uint16_t)eMB_TCP_MBAP_SIZE)
+    {
+      /* The length field counts the unit id and the PDU. */
+      frameLen = (uint16_t)(((uint16_t)pConn->rxBuf[pos + eMB_TCP_MBAP_LEN_OFFSET] << 8U) |
+                            pConn->rxBuf[pos + eMB_TCP_MBAP_LEN_OFFSET + 1U]);
+      frameLen = (uint16_t)(frameLen + eMB_TCP_MBAP_UID_OFFSET);
+
+      if ((uint16_t)(pConn->rxLen - pos) < frameLen)
+      {
+        break;
+      }
+
+      if ((frameLen != (uint16_t)(eMB_TCP_MBAP_SIZE + 2U + 2U * eMB_POSIX_TCP_LOAD_REG_NUM)) ||
+          (pConn->rxBuf[pos + eMB_TCP_MBAP_SIZE] != (uint8_t)eMB_FUNC_READ_HOLDING_REGISTER))
+      {
+        eMB_POSIX_TcpLoadErrorNum++;
+      }
+
+      eMB_POSIX_TcpLoadRespNum++;
+      eMB_POSIX_TcpLoadPutRequest(pConn);
+
+      pos = (uint16_t)(pos + frameLen);
+    }
+
+    memmove(pConn->rxBuf, &pConn->rxBuf[pos], (size_t)(pConn->rxLen - pos));
+    pConn->rxLen = (uint16_t)(pConn->rxLen - pos);
+  }
+}
+
+static uint64_t eMB_POSIX_TcpLoadNowNs(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,971 @@
+/*
+ * File:   eMB_PortSim.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 12:20 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_PortSim.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_RTU_ENABLED
+#define eMB_SIM_EVENT_QUEUE_SIZE                  ( 8U )
+#define eMB_SIM_INDEX_NONE                        ( 0xFFFFU )
+
+#define eMB_SIM_READ_REG_NUM_MAX                  ( 125U )
+#define eMB_SIM_WRITE_REG_NUM_MAX                 ( 123U )
+#define eMB_SIM_READ_BIT_NUM_MAX                  ( 2000U )
+#define eMB_SIM_WRITE_BIT_NUM_MAX                 ( 1968U )
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static bool eMB_SIM_PortEventInit(void);
+static bool eMB_SIM_PortEventPost(eMB_EventType eEvent);
+static bool eMB_SIM_PortEventGet(eMB_EventType *eEvent);
+static void eMB_SIM_PortResourceInit(void);
+static bool eMB_SIM_PortResourceTake(void);
+static void eMB_SIM_PortResourceRelease(void);
+static bool eMB_SIM_PortSerialInit(void);
+static void eMB_SIM_PortSerialSetMode(eMB_PortSerialModeType serialMode);
+static bool eMB_SIM_PortSerialGetByte(uint8_t *data);
+static bool eMB_SIM_PortSerialPutByte(uint8_t data);
+static bool eMB_SIM_PortTimersInit(void);
+static void eMB_SIM_PortTimersEnable(eMB_PortTimerModeType timerMode);
+static void eMB_SIM_PortTimersDisable(void);
+static uint32_t eMB_SIM_PortTimeGet(void);
+static uint32_t eMB_SIM_PortTimeGetUs(void);
+
+static bool eMB_SIM_PortFireNext(uint64_t deadlineNs);
+static void eMB_SIM_PortRunTo(uint64_t deadlineNs);
+static void eMB_SIM_PortRequest(void);
+static uint16_t eMB_SIM_PortExecute(eMB_SIM_SlaveStruct *slave, const uint8_t *pdu, uint16_t pduLen, uint8_t *ans);
+static uint16_t eMB_SIM_PortException(const uint8_t *pdu, eMB_ExceptionType exception, uint8_t *ans);
+static bool eMB_SIM_PortIsInMap(const void *buf, uint16_t start, uint16_t num, uint16_t addr, uint16_t count);
+static bool eMB_SIM_PortGetBit(const uint8_t *buf, uint16_t bitIdx);
+static void eMB_SIM_PortSetBit(uint8_t *buf, uint16_t bitIdx, bool value);
+static uint16_t eMB_SIM_PortGet16(const uint8_t *buf);
+static bool eMB_SIM_PortRoll(uint16_t permille);
+static uint32_t eMB_SIM_PortRandom(void);
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+const eMB_ConfigStruct eMB_SIM_Config =
+{
+  .role                       = eMB_ROLE_MASTER,
+  .comm                       = eMB_COMM_RTU,
+  /* Port event function pointer */
+  .pPortEventInit             = eMB_SIM_PortEventInit,
+  .pPortEventPost             = eMB_SIM_PortEventPost,
+  .pPortEventGet              = eMB_SIM_PortEventGet,
+  /* Port resource function pointer */
+  .pPortResourceInit          = eMB_SIM_PortResourceInit,
+  .pPortResourceTake          = eMB_SIM_PortResourceTake,
+  .pPortResourceRelease       = eMB_SIM_PortResourceRelease,
+  /* Port serial function pointer */
+  .pPortSerialInit            = eMB_SIM_PortSerialInit,
+  .pPortSerialSetMode         = eMB_SIM_PortSerialSetMode,
+  .pPortSerialGetByte         = eMB_SIM_PortSerialGetByte,
+  .pPortSerialPutByte         = eMB_SIM_PortSerialPutByte,
+  /* Port timer function pointer */
+  .pPortTimersInit            = eMB_SIM_PortTimersInit,
+  .pPortTimersEnable          = eMB_SIM_PortTimersEnable,
+  .pPortTimersDisable         = eMB_SIM_PortTimersDisable,
+  /* Port time function pointer */
+  .pPortTimeGet               = eMB_SIM_PortTimeGet,
+  .pPortTimeGetUs             = eMB_SIM_PortTimeGetUs,
+  /* Own address if role is eMB_ROLE_SLAVE */
+  .slaveAddr                  = 1U
+};
+
+/* Virtual clock and random generator */
+static uint64_t               eMB_SIM_NowNs;
+static uint32_t               eMB_SIM_CharNs;
+static uint32_t               eMB_SIM_RandState;
+
+/* Events of the stack and the line resource */
+static eMB_EventType          eMB_SIM_EventQueue[eMB_SIM_EVENT_QUEUE_SIZE];
+static uint8_t                eMB_SIM_EventHead;
+static uint8_t                eMB_SIM_EventNum;
+static bool                   eMB_SIM_ResourceIsTaken;
+static eMB_SIM_EventHook      eMB_SIM_EventHookFn;
+
+/* Serial port and timer of the master, a pending interrupt fires at its time */
+static eMB_PortSerialModeType eMB_SIM_SerialMode = eMB_PORT_SERIAL_RX;
+static uint8_t                eMB_SIM_RxByte;
+static bool                   eMB_SIM_TxIsPending;
+static uint64_t               eMB_SIM_TxNs;
+static bool                   eMB_SIM_TimerIsPending;
+static uint64_t               eMB_SIM_TimerNs;
+
+/* Request as the slaves receive it, processed at eMB_SIM_ReqEndNs */
+static uint8_t                eMB_SIM_ReqBuf[eMB_SDU_SIZE_MAX];
+static uint16_t               eMB_SIM_ReqLength;
+static bool                   eMB_SIM_ReqIsDamaged;
+static bool                   eMB_SIM_ReqIsPending;
+static uint64_t               eMB_SIM_ReqEndNs;
+
+/* Answer on the line, byte eMB_SIM_AnsIdx arrives at eMB_SIM_AnsNs */
+static uint8_t                eMB_SIM_AnsBuf[eMB_SDU_SIZE_MAX];
+static uint16_t               eMB_SIM_AnsLength;
+static uint16_t               eMB_SIM_AnsIdx;
+static uint16_t               eMB_SIM_AnsGapIdx = (uint16_t)eMB_SIM_INDEX_NONE;
+static uint64_t               eMB_SIM_AnsNs;
+
+static eMB_SIM_SlaveStruct    eMB_SIM_Slave[eMB_SIM_SLAVE_NUM];
+static bool                   eMB_SIM_SlaveIsUsed[eMB_SIM_SLAVE_NUM];
+static eMB_SIM_StatsStruct    eMB_SIM_Stats;
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_SIM_PortSetup(uint32_t baudrate, uint8_t charBits, uint32_t seed)
+{
+  eMB_ErrorCodeType errStatus = eMB_RTU_SetBaudrate(baudrate, charBits);
+
+  if (errStatus != eMB_ENOERR)
+  {
+    return errStatus;
+  }
+
+  eMB_SIM_NowNs     = 0ULL;
+  eMB_SIM_CharNs    = (uint32_t)(((uint64_t)charBits * 1000000000ULL + baudrate - 1UL) / baudrate);
+  eMB_SIM_RandState = (seed != 0UL) ? seed : 1UL;
+
+  eMB_SIM_EventHead       = 0U;
+  eMB_SIM_EventNum        = 0U;
+  eMB_SIM_ResourceIsTaken = false;
+
+  eMB_SIM_SerialMode     = eMB_PORT_SERIAL_RX;
+  eMB_SIM_TxIsPending    = false;
+  eMB_SIM_TimerIsPending = false;
+  eMB_SIM_ReqIsPending   = false;
+  eMB_SIM_ReqLength      = (uint16_t)0U;
+  eMB_SIM_AnsLength      = (uint16_t)0U;
+  eMB_SIM_AnsIdx         = (uint16_t)0U;
+
+  memset(eMB_SIM_SlaveIsUsed, 0, sizeof(eMB_SIM_SlaveIsUsed));
+  memset(&eMB_SIM_Stats, 0, sizeof(eMB_SIM_Stats));
+
+  return eMB_ENOERR;
+}
+
+eMB_ErrorCodeType eMB_SIM_PortSetSlave(uint8_t slaveAddr, const eMB_SIM_SlaveStruct *slave)
+{
+  if ((slaveAddr < (uint8_t)eMB_ADDRESS_MIN) || (slaveAddr > (uint8_t)eMB_SIM_SLAVE_NUM))
+  {
+    return eMB_EINVAL;
+  }
+
+  eMB_SIM_SlaveIsUsed[slaveAddr - 1U] = (slave != NULL) ? true : false;
+
+  if (slave != NULL)
+  {
+    eMB_SIM_Slave[slaveAddr - 1U] = *slave;
+  }
+
+  return eMB_ENOERR;
+}
+
+bool eMB_SIM_PortStep(void)
+{
+  /* Takes one event and dispatches queued requests. */
+  eMB_MainFunction();
+
+  if (eMB_SIM_EventNum != 0U)
+  {
+    return true;
+  }
+
+  return eMB_SIM_PortFireNext(UINT64_MAX);
+}
+
+void eMB_SIM_PortRunUntilIdle(void)
+{
+  while (eMB_SIM_PortStep() == true)
+  {
+  }
+}
+
+void eMB_SIM_PortRunFor(uint32_t durationUs)
+{
+  eMB_SIM_PortRunTo(eMB_SIM_NowNs + (uint64_t)durationUs * 1000ULL);
+}
+
+void eMB_SIM_PortRunUntilSent(void)
+{
+  for (;;)
+  {
+    eMB_MainFunction();
+
+    if (eMB_SIM_EventNum != 0U)
+    {
+      continue;
+    }
+
+    if (((eMB_SIM_SerialMode == eMB_PORT_SERIAL_RX) && (eMB_SIM_TxIsPending == false)) ||
+        (eMB_SIM_PortFireNext(UINT64_MAX) == false))
+    {
+      break;
+    }
+  }
+}
+
+void eMB_SIM_PortReceiveByte(uint8_t data)
+{
+  eMB_SIM_PortRunTo(eMB_SIM_NowNs + eMB_SIM_CharNs);
+
+  if (eMB_SIM_SerialMode == eMB_PORT_SERIAL_RX)
+  {
+    eMB_SIM_RxByte = data;
+    (void)eMB_FrameByteReceivedCalloutArr();
+  }
+
+  while (eMB_SIM_EventNum != 0U)
+  {
+    eMB_MainFunction();
+  }
+}
+
+bool eMB_SIM_PortExpireTimer(void)
+{
+  if (eMB_SIM_TimerIsPending == false)
+  {
+    return false;
+  }
+
+  eMB_SIM_PortRunTo(eMB_SIM_TimerNs);
+
+  return true;
+}
+
+void eMB_SIM_PortRepeatRequest(uint32_t repeatNum)
+{
+  eMB_SIM_StatsStruct stats     = eMB_SIM_Stats;
+  uint32_t            randState = eMB_SIM_RandState;
+  uint16_t            ansLength = eMB_SIM_AnsLength;
+  uint16_t            ansIdx    = eMB_SIM_AnsIdx;
+  uint16_t            ansGapIdx = eMB_SIM_AnsGapIdx;
+  uint64_t            ansNs     = eMB_SIM_AnsNs;
+  uint32_t            i;
+
+  for (i = 0UL; i < repeatNum; i++)
+  {
+    eMB_SIM_PortRequest();
+  }
+
+  /* The answers are not put on the line. */
+  eMB_SIM_Stats     = stats;
+  eMB_SIM_RandState = randState;
+  eMB_SIM_AnsLength = ansLength;
+  eMB_SIM_AnsIdx    = ansIdx;
+  eMB_SIM_AnsGapIdx = ansGapIdx;
+  eMB_SIM_AnsNs     = ansNs;
+}
+
+uint64_t eMB_SIM_PortGetTimeUs(void)
+{
+  return eMB_SIM_NowNs / 1000ULL;
+}
+
+void eMB_SIM_PortGetStats(eMB_SIM_StatsStruct *stats)
+{
+  if (stats != NULL)
+  {
+    *stats = eMB_SIM_Stats;
+  }
+}
+
+void eMB_SIM_PortSetEventHook(eMB_SIM_EventHook hook)
+{
+  eMB_SIM_EventHookFn = hook;
+}
+
+void eMB_PortEnterCriticalSection(void)
+{
+  /* Single threaded, the callouts run between the steps. */
+}
+
+void eMB_PortExitCriticalSection(void)
+{
+}
+
+
+
+
+
+static bool eMB_SIM_PortEventInit(void)
+{
+  eMB_SIM_EventHead = 0U;
+  eMB_SIM_EventNum  = 0U;
+
+  return true;
+}
+
+static bool eMB_SIM_PortEventPost(eMB_EventType eEvent)
+{
+  if (eMB_SIM_EventNum >= (uint8_t)eMB_SIM_EVENT_QUEUE_SIZE)
+  {
+    return false;
+  }
+
+  eMB_SIM_EventQueue[(eMB_SIM_EventHead + eMB_SIM_EventNum) % eMB_SIM_EVENT_QUEUE_SIZE] = eEvent;
+  eMB_SIM_EventNum++;
+
+  return true;
+}
+
+static bool eMB_SIM_PortEventGet(eMB_EventType *eEvent)
+{
+  if (eMB_SIM_EventNum == 0U)
+  {
+    return false;
+  }
+
+  *eEvent = eMB_SIM_EventQueue[eMB_SIM_EventHead];
+
+  eMB_SIM_EventHead = (uint8_t)((eMB_SIM_EventHead + 1U) % eMB_SIM_EVENT_QUEUE_SIZE);
+  eMB_SIM_EventNum--;
+
+  if (eMB_SIM_EventHookFn != NULL)
+  {
+    eMB_SIM_EventHookFn(*eEvent);
+  }
+
+  return true;
+}
+
+static void eMB_SIM_PortResourceInit(void)
+{
+  eMB_SIM_ResourceIsTaken = false;
+}
+
+static bool eMB_SIM_PortResourceTake(void)
+{
+  if (eMB_SIM_ResourceIsTaken == true)
+  {
+    return false;
+  }
+
+  eMB_SIM_ResourceIsTaken = true;
+
+  return true;
+}
+
+static void eMB_SIM_PortResourceRelease(void)
+{
+  eMB_SIM_ResourceIsTaken = false;
+}
+
+static bool eMB_SIM_PortSerialInit(void)
+{
+  return true;
+}
+
+/* The transmitter interrupt fires at once, the receiver takes the answer bytes. */
+static void eMB_SIM_PortSerialSetMode(eMB_PortSerialModeType serialMode)
+{
+  eMB_SIM_SerialMode = serialMode;
+
+  if (serialMode == eMB_PORT_SERIAL_TX)
+  {
+    /* A slave still answers: the rest of its answer and the request collide. */
+    eMB_SIM_ReqIsDamaged = false;
+
+    if (eMB_SIM_AnsIdx < eMB_SIM_AnsLength)
+    {
+      eMB_SIM_AnsLength = eMB_SIM_AnsIdx;
+      eMB_SIM_ReqIsDamaged = true;
+      eMB_SIM_Stats.collisionNum++;
+    }
+
+    eMB_SIM_ReqLength    = (uint16_t)0U;
+    eMB_SIM_ReqIsPending = false;
+
+    eMB_SIM_TxIsPending = true;
+    eMB_SIM_TxNs        = eMB_SIM_NowNs;
+  }
+  else
+  {
+    eMB_SIM_TxIsPending = false;
+  }
+}
+
+static bool eMB_SIM_PortSerialGetByte(uint8_t *data)
+{
+  *data = eMB_SIM_RxByte;
+
+  return true;
+}
+
+/* The byte is on the line for one character time, the slaves see the end
+ * of the request T3.5 after its last byte. */
+static bool eMB_SIM_PortSerialPutByte(uint8_t data)
+{
+  if (eMB_SIM_ReqLength < (uint16_t)eMB_SDU_SIZE_MAX)
+  {
+    eMB_SIM_ReqBuf[eMB_SIM_ReqLength++] = data;
+  }
+
+  eMB_SIM_TxIsPending = true;
+  eMB_SIM_TxNs        = eMB_SIM_NowNs + eMB_SIM_CharNs;
+
+  eMB_SIM_ReqIsPending = true;
+  eMB_SIM_ReqEndNs     = eMB_SIM_TxNs + (uint64_t)eMB_RTU_GetT35() * 1000ULL;
+
+  return true;
+}
+
+static bool eMB_SIM_PortTimersInit(void)
+{
+  eMB_SIM_TimerIsPending = false;
+
+  return true;
+}
+
+/* Same timeouts as the hardware port, without its 100us ticks. */
+static void eMB_SIM_PortTimersEnable(eMB_PortTimerModeType timerMode)
+{
+  uint32_t delayUs = 0UL;
+
+  switch (timerMode)
+  {
+    case eMB_PORT_TIMER_T35:
+    {
+      delayUs = eMB_RTU_GetT35();
+      break;
+    }
+    case eMB_PORT_TIMER_RESPOND_TIMEOUT:
+    {
+      delayUs = eMB_Rtt_GetTimeout();
+      break;
+    }
+    case eMB_PORT_TIMER_CONVERT_DELAY:
+    {
+      delayUs = (uint32_t)eMB_MASTER_DELAY_MS_CONVERT * 100UL;
+      break;
+    }
+    default:
+      break;
+  }
+
+  eMB_SIM_TimerIsPending = true;
+  eMB_SIM_TimerNs        = eMB_SIM_NowNs + (uint64_t)delayUs * 1000ULL;
+}
+
+static void eMB_SIM_PortTimersDisable(void)
+{
+  eMB_SIM_TimerIsPending = false;
+}
+
+static uint32_t eMB_SIM_PortTimeGet(void)
+{
+  return (uint32_t)(eMB_SIM_NowNs / 1000000ULL);
+}
+
+static uint32_t eMB_SIM_PortTimeGetUs(void)
+{
+  return (uint32_t)(eMB_SIM_NowNs / 1000ULL);
+}
+
+/* Handle the events and interrupts up to deadlineNs and advance the clock to it. */
+static void eMB_SIM_PortRunTo(uint64_t deadlineNs)
+{
+  for (;;)
+  {
+    eMB_MainFunction();
+
+    if ((eMB_SIM_EventNum == 0U) && (eMB_SIM_PortFireNext(deadlineNs) == false))
+    {
+      break;
+    }
+  }
+
+  eMB_SIM_NowNs = deadlineNs;
+
+  /* Requests which became due at the deadline. */
+  eMB_MainFunction();
+}
+
+/* Advance the clock to the next interrupt or request end up to deadlineNs and
+ * handle it. Returns false if there is none. */
+static bool eMB_SIM_PortFireNext(uint64_t deadlineNs)
+{
+  uint64_t nextNs = UINT64_MAX;
+  uint8_t  source = 0U;
+  uint32_t gapNs;
+
+  /* On a tie a byte comes before the end of a request and the timer. */
+  if (eMB_SIM_TxIsPending == true)
+  {
+    nextNs = eMB_SIM_TxNs;
+    source = 1U;
+  }
+
+  if ((eMB_SIM_AnsIdx < eMB_SIM_AnsLength) && (eMB_SIM_AnsNs < nextNs))
+  {
+    nextNs = eMB_SIM_AnsNs;
+    source = 2U;
+  }
+
+  if ((eMB_SIM_ReqIsPending == true) && (eMB_SIM_ReqEndNs < nextNs))
+  {
+    nextNs = eMB_SIM_ReqEndNs;
+    source = 3U;
+  }
+
+  if ((eMB_SIM_TimerIsPending == true) && (eMB_SIM_TimerNs < nextNs))
+  {
+    nextNs = eMB_SIM_TimerNs;
+    source = 4U;
+  }
+
+  if ((source == 0U) || (nextNs > deadlineNs))
+  {
+    return false;
+  }
+
+  eMB_SIM_NowNs = nextNs;
+
+  switch (source)
+  {
+    case 1U:
+    {
+      eMB_SIM_TxIsPending = false;
+      (void)eMB_FrameTransmitterEmptyCalloutArr();
+      break;
+    }
+    case 2U:
+    {
+      eMB_SIM_RxByte = eMB_SIM_AnsBuf[eMB_SIM_AnsIdx++];
+      eMB_SIM_AnsNs += eMB_SIM_CharNs;
+
+      /* Silence half way between T1.5 and T3.5. */
+      if (eMB_SIM_AnsIdx == eMB_SIM_AnsGapIdx)
+      {
+        gapNs = (eMB_RTU_GetT15() + eMB_RTU_GetT35()) * 500UL;
+        eMB_SIM_AnsNs += gapNs;
+      }
+
+      /* The receiver is off while the master sends. */
+      if (eMB_SIM_SerialMode == eMB_PORT_SERIAL_RX)
+      {
+        (void)eMB_FrameByteReceivedCalloutArr();
+      }
+      break;
+    }
+    case 3U:
+    {
+      eMB_SIM_ReqIsPending = false;
+      eMB_SIM_PortRequest();
+      break;
+    }
+    default:
+    {
+      eMB_SIM_TimerIsPending = false;
+      (void)eMB_FrameTimerExpiredCalloutArr();
+      break;
+    }
+  }
+
+  return true;
+}
+
+/* The slaves received a request: the addressed one answers after its turnaround. */
+static void eMB_SIM_PortRequest(void)
+{
+  eMB_SIM_SlaveStruct *slave;
+  uint8_t  slaveAddr = eMB_SIM_ReqBuf[eMB_SDU_ADDR_OFFSET];
+  uint16_t pduLen;
+  uint16_t crcVal;
+  uint32_t turnaroundUs;
+  uint8_t  i;
+
+  eMB_SIM_Stats.requestNum++;
+
+  if ((eMB_SIM_ReqIsDamaged == true) || (eMB_SIM_ReqLength < (uint16_t)eMB_SDU_SIZE_MIN) ||
+      (eMB_GetCRC(eMB_SIM_ReqBuf, eMB_SIM_ReqLength) != (uint16_t)0U))
+  {
+    eMB_SIM_Stats.damagedNum++;
+    return;
+  }
+
+  pduLen = (uint16_t)(eMB_SIM_ReqLength - eMB_SDU_FUNC_OFFSET - eMB_SDU_CRC_SIZE);
+
+  /* Every slave executes a broadcast, none answers. */
+  if (slaveAddr == (uint8_t)eMB_ADDRESS_BROADCAST)
+  {
+    for (i = 0U; i < (uint8_t)eMB_SIM_SLAVE_NUM; i++)
+    {
+      if (eMB_SIM_SlaveIsUsed[i] == true)
+      {
+        (void)eMB_SIM_PortExecute(&eMB_SIM_Slave[i], &eMB_SIM_ReqBuf[eMB_SDU_FUNC_OFFSET], pduLen,
+                                  &eMB_SIM_AnsBuf[eMB_SDU_FUNC_OFFSET]);
+      }
+    }
+
+    return;
+  }
+
+  if ((slaveAddr > (uint8_t)eMB_SIM_SLAVE_NUM) || (eMB_SIM_SlaveIsUsed[slaveAddr - 1U] == false))
+  {
+    return;
+  }
+
+  slave = &eMB_SIM_Slave[slaveAddr - 1U];
+
+  if (eMB_SIM_PortRoll(slave->noAnswerPermille) == true)
+  {
+    eMB_SIM_Stats.noAnswerNum++;
+    return;
+  }
+
+  pduLen = eMB_SIM_PortExecute(slave, &eMB_SIM_ReqBuf[eMB_SDU_FUNC_OFFSET], pduLen, &eMB_SIM_AnsBuf[eMB_SDU_FUNC_OFFSET]);
+
+  if (eMB_SIM_PortRoll(slave->busyPermille) == true)
+  {
+    pduLen = eMB_SIM_PortException(&eMB_SIM_ReqBuf[eMB_SDU_FUNC_OFFSET], eMB_EX_SLAVE_BUSY, &eMB_SIM_AnsBuf[eMB_SDU_FUNC_OFFSET]);
+    eMB_SIM_Stats.busyNum++;
+  }
+
+  eMB_SIM_AnsBuf[eMB_SDU_ADDR_OFFSET] = slaveAddr;
+  eMB_SIM_AnsLength = (uint16_t)(pduLen + eMB_SDU_FUNC_OFFSET);
+
+  crcVal = eMB_GetCRC(eMB_SIM_AnsBuf, eMB_SIM_AnsLength);
+  eMB_SIM_AnsBuf[eMB_SIM_AnsLength++] = (uint8_t)(crcVal & 0xFFU);
+  eMB_SIM_AnsBuf[eMB_SIM_AnsLength++] = (uint8_t)(crcVal >> 8U);
+
+  if (eMB_SIM_PortRoll(slave->crcPermille) == true)
+  {
+    eMB_SIM_AnsBuf[eMB_SIM_PortRandom() % eMB_SIM_AnsLength] ^= (uint8_t)(1U << (eMB_SIM_PortRandom() % 8U));
+    eMB_SIM_Stats.crcNum++;
+  }
+
+  eMB_SIM_AnsGapIdx = (uint16_t)eMB_SIM_INDEX_NONE;
+
+  if (eMB_SIM_PortRoll(slave->gapPermille) == true)
+  {
+    eMB_SIM_AnsGapIdx = (uint16_t)(1U + eMB_SIM_PortRandom() % (eMB_SIM_AnsLength - 1U));
+    eMB_SIM_Stats.gapNum++;
+  }
+
+  turnaroundUs = slave->turnaroundUs;
+
+  if (slave->jitterUs != 0UL)
+  {
+    turnaroundUs += eMB_SIM_PortRandom() % (slave->jitterUs + 1UL);
+  }
+
+  if (eMB_SIM_PortRoll(slave->tailPermille) == true)
+  {
+    turnaroundUs += slave->tailUs;
+  }
+
+  /* The first byte arrives one character time after the slave starts to send. */
+  eMB_SIM_AnsIdx = (uint16_t)0U;
+  eMB_SIM_AnsNs  = eMB_SIM_NowNs + (uint64_t)turnaroundUs * 1000ULL + eMB_SIM_CharNs;
+
+  eMB_SIM_Stats.answerNum++;
+}
+
+/* Execute a request PDU on the register maps of a slave, returns the length of the answer PDU. */
+static uint16_t eMB_SIM_PortExecute(eMB_SIM_SlaveStruct *slave, const uint8_t *pdu, uint16_t pduLen, uint8_t *ans)
+{
+  uint16_t addr = (pduLen >= 3U) ? eMB_SIM_PortGet16(&pdu[1]) : (uint16_t)0U;
+  uint16_t num  = (pduLen >= 5U) ? eMB_SIM_PortGet16(&pdu[3]) : (uint16_t)0U;
+  uint16_t readAddr;
+  uint16_t readNum;
+  uint16_t *regBuf = NULL;
+  uint16_t regStart = (uint16_t)0U;
+  uint16_t regNum = (uint16_t)0U;
+  uint8_t *bitBuf = NULL;
+  uint16_t bitStart = (uint16_t)0U;
+  uint16_t bitNum = (uint16_t)0U;
+  uint16_t i;
+
+  ans[0] = pdu[0];
+
+  switch (pdu[0])
+  {
+    case eMB_FUNC_READ_COILS:
+    case eMB_FUNC_READ_DISCRETE_INPUTS:
+    {
+      if (pdu[0] == (uint8_t)eMB_FUNC_READ_COILS)
+      {
+        bitBuf = slave->coilBuf;
+        bitStart = slave->coilStart;
+        bitNum = slave->coilNum;
+      }
+      else
+      {
+        bitBuf = slave->discreteBuf;
+        bitStart = slave->discreteStart;
+        bitNum = slave->discreteNum;
+      }
+
+      if ((pduLen != 5U) || (num == 0U) || (num > (uint16_t)eMB_SIM_READ_BIT_NUM_MAX))
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_VALUE, ans);
+      }
+
+      if (eMB_SIM_PortIsInMap(bitBuf, bitStart, bitNum, addr, num) == false)
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_ADDRESS, ans);
+      }
+
+      ans[1] = (uint8_t)((num + 7U) / 8U);
+      memset(&ans[2], 0, ans[1]);
+
+      for (i = (uint16_t)0U; i < num; i++)
+      {
+        eMB_SIM_PortSetBit(&ans[2], i, eMB_SIM_PortGetBit(bitBuf, (uint16_t)(addr - bitStart + i)));
+      }
+
+      return (uint16_t)(2U + ans[1]);
+    }
+    case eMB_FUNC_READ_HOLDING_REGISTER:
+    case eMB_FUNC_READ_INPUT_REGISTER:
+    {
+      if (pdu[0] == (uint8_t)eMB_FUNC_READ_HOLDING_REGISTER)
+      {
+        regBuf = slave->holdingBuf;
+        regStart = slave->holdingStart;
+        regNum = slave->holdingNum;
+      }
+      else
+      {
+        regBuf = slave->inputBuf;
+        regStart = slave->inputStart;
+        regNum = slave->inputNum;
+      }
+
+      if ((pduLen != 5U) || (num == 0U) || (num > (uint16_t)eMB_SIM_READ_REG_NUM_MAX))
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_VALUE, ans);
+      }
+
+      if (eMB_SIM_PortIsInMap(regBuf, regStart, regNum, addr, num) == false)
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_ADDRESS, ans);
+      }
+
+      ans[1] = (uint8_t)(num * 2U);
+
+      for (i = (uint16_t)0U; i < num; i++)
+      {
+        ans[2U + i * 2U]      = (uint8_t)(regBuf[addr - regStart + i] >> 8U);
+        ans[2U + i * 2U + 1U] = (uint8_t)(regBuf[addr - regStart + i] & 0xFFU);
+      }
+
+      return (uint16_t)(2U + ans[1]);
+    }
+    case eMB_FUNC_WRITE_SINGLE_COIL:
+    {
+      if ((pduLen != 5U) || ((num != 0xFF00U) && (num != 0x0000U)))
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_VALUE, ans);
+      }
+
+      if (eMB_SIM_PortIsInMap(slave->coilBuf, slave->coilStart, slave->coilNum, addr, 1U) == false)
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_ADDRESS, ans);
+      }
+
+      eMB_SIM_PortSetBit(slave->coilBuf, (uint16_t)(addr - slave->coilStart), (num == 0xFF00U) ? true : false);
+
+      memcpy(ans, pdu, 5U);
+
+      return (uint16_t)5U;
+    }
+    case eMB_FUNC_WRITE_REGISTER:
+    {
+      if (pduLen != 5U)
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_VALUE, ans);
+      }
+
+      if (eMB_SIM_PortIsInMap(slave->holdingBuf, slave->holdingStart, slave->holdingNum, addr, 1U) == false)
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_ADDRESS, ans);
+      }
+
+      slave->holdingBuf[addr - slave->holdingStart] = num;
+
+      memcpy(ans, pdu, 5U);
+
+      return (uint16_t)5U;
+    }
+    case eMB_FUNC_WRITE_MULTIPLE_COILS:
+    {
+      if ((pduLen < 6U) || (num == 0U) || (num > (uint16_t)eMB_SIM_WRITE_BIT_NUM_MAX) ||
+          (pdu[5] != (uint8_t)((num + 7U) / 8U)) || (pduLen != (uint16_t)(6U + pdu[5])))
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_VALUE, ans);
+      }
+
+      if (eMB_SIM_PortIsInMap(slave->coilBuf, slave->coilStart, slave->coilNum, addr, num) == false)
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_ADDRESS, ans);
+      }
+
+      for (i = (uint16_t)0U; i < num; i++)
+      {
+        eMB_SIM_PortSetBit(slave->coilBuf, (uint16_t)(addr - slave->coilStart + i), eMB_SIM_PortGetBit(&pdu[6], i));
+      }
+
+      memcpy(ans, pdu, 5U);
+
+      return (uint16_t)5U;
+    }
+    case eMB_FUNC_WRITE_MULTIPLE_REGISTERS:
+    {
+      if ((pduLen < 6U) || (num == 0U) || (num > (uint16_t)eMB_SIM_WRITE_REG_NUM_MAX) ||
+          (pdu[5] != (uint8_t)(num * 2U)) || (pduLen != (uint16_t)(6U + pdu[5])))
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_VALUE, ans);
+      }
+
+      if (eMB_SIM_PortIsInMap(slave->holdingBuf, slave->holdingStart, slave->holdingNum, addr, num) == false)
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_ADDRESS, ans);
+      }
+
+      for (i = (uint16_t)0U; i < num; i++)
+      {
+        slave->holdingBuf[addr - slave->holdingStart + i] = eMB_SIM_PortGet16(&pdu[6U + i * 2U]);
+      }
+
+      memcpy(ans, pdu, 5U);
+
+      return (uint16_t)5U;
+    }
+    case eMB_FUNC_READWRITE_MULTIPLE_REGISTERS:
+    {
+      readAddr = addr;
+      readNum  = num;
+      addr = (pduLen >= 7U) ? eMB_SIM_PortGet16(&pdu[5]) : (uint16_t)0U;
+      num  = (pduLen >= 9U) ? eMB_SIM_PortGet16(&pdu[7]) : (uint16_t)0U;
+
+      if ((pduLen < 10U) || (readNum == 0U) || (readNum > (uint16_t)eMB_SIM_READ_REG_NUM_MAX) ||
+          (num == 0U) || (num > (uint16_t)eMB_SIM_WRITE_REG_NUM_MAX) ||
+          (pdu[9] != (uint8_t)(num * 2U)) || (pduLen != (uint16_t)(10U + pdu[9])))
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_VALUE, ans);
+      }
+
+      if ((eMB_SIM_PortIsInMap(slave->holdingBuf, slave->holdingStart, slave->holdingNum, addr, num) == false) ||
+          (eMB_SIM_PortIsInMap(slave->holdingBuf, slave->holdingStart, slave->holdingNum, readAddr, readNum) == false))
+      {
+        return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_DATA_ADDRESS, ans);
+      }
+
+      /* The write comes before the read. */
+      for (i = (uint16_t)0U; i < num; i++)
+      {
+        slave->holdingBuf[addr - slave->holdingStart + i] = eMB_SIM_PortGet16(&pdu[10U + i * 2U]);
+      }
+
+      ans[1] = (uint8_t)(readNum * 2U);
+
+      for (i = (uint16_t)0U; i < readNum; i++)
+      {
+        ans[2U + i * 2U]      = (uint8_t)(slave->holdingBuf[readAddr - slave->holdingStart + i] >> 8U);
+        ans[2U + i * 2U + 1U] = (uint8_t)(slave->holdingBuf[readAddr - slave->holdingStart + i] & 0xFFU);
+      }
+
+      return (uint16_t)(2U + ans[1]);
+    }
+    default:
+      break;
+  }
+
+  return eMB_SIM_PortException(pdu, eMB_EX_ILLEGAL_FUNCTION, ans);
+}
+
+static uint16_t eMB_SIM_PortException(const uint8_t *pdu, eMB_ExceptionType exception, uint8_t *ans)
+{
+  ans[0] = (uint8_t)(pdu[0] | (uint8_t)eMB_FUNC_ERROR);
+  ans[1] = (uint8_t)exception;
+
+  return (uint16_t)2U;
+}
+
+/* Check if count items from addr are in a map of num items from start. */
+static bool eMB_SIM_PortIsInMap(const void *buf, uint16_t start, uint16_t num, uint16_t addr, uint16_t count)
+{
+  return (buf != NULL) && (addr >= start) &&
+         ((uint32_t)addr + count <= (uint32_t)start + num);
+}
+
+static bool eMB_SIM_PortGetBit(const uint8_t *buf, uint16_t bitIdx)
+{
+  return ((buf[bitIdx / 8U] >> (bitIdx % 8U)) & 0x01U) != 0U;
+}
+
+static void eMB_SIM_PortSetBit(uint8_t *buf, uint16_t bitIdx, bool value)
+{
+  if (value == true)
+  {
+    buf[bitIdx / 8U] |= (uint8_t)(1U << (bitIdx % 8U));
+  }
+  else
+  {
+    buf[bitIdx / 8U] &= (uint8_t)~(1U << (bitIdx % 8U));
+  }
+}
+
+static uint16_t eMB_SIM_PortGet16(const uint8_t *buf)
+{
+  return (uint16_t)(((uint16_t)buf[0] << 8U) | buf[1]);
+}
+
+/* True with a probability of permille / 1000. */
+static bool eMB_SIM_PortRoll(uint16_t permille)
+{
+  return (permille != 0U) && ((eMB_SIM_PortRandom() % 1000UL) < permille);
+}
+
+/* xorshift32, repeatable for a seed. */
+static uint32_t eMB_SIM_PortRandom(void)
+{
+  eMB_SIM_RandState ^= eMB_SIM_RandState << 13U;
+  eMB_SIM_RandState ^= eMB_SIM_RandState >> 17U;
+  eMB_SIM_RandState ^= eMB_SIM_RandState << 5U;
+
+  return eMB_SIM_RandState;
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
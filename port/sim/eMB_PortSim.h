@@ -0,0 +1,177 @@
+/*
+ * File:   eMB_PortSim.h
+ * Author: Long
+ *
+ * Host port of the RTU master against a simulated RS-485 line. It implements
+ * the hooks of eMB_ConfigStruct (eMB_SIM_Config) on a virtual clock and runs
+ * up to 247 virtual slaves with register maps, turnaround times and error
+ * injection. Nothing waits for real time: a poll takes a few microseconds of
+ * host time, so thousands of transactions run in milliseconds.
+ *
+ * The line is half duplex. The bytes of the master reach the slaves one
+ * character time apart, a slave processes a request T3.5 after its last byte
+ * and answers after its turnaround. If the master starts to send while a
+ * slave still answers (a late answer after a timeout), the rest of the answer
+ * is lost and the request is damaged.
+ *
+ * The interrupt callouts are called from eMB_SIM_PortStep() in the order of
+ * the virtual clock, eMB_MainFunction() between them:
+ *
+ *   eMB_SIM_PortSetup(115200UL, 11U, 1UL);
+ *   eMB_SIM_PortSetSlave(1U, &slave);
+ *   eMB_Init(&eMB_SIM_Config);
+ *   eMB_Enable();
+ *   eMB_SIM_PortRunUntilIdle();
+ *
+ *   for (i = 0; i < 10000; i++)
+ *   {
+ *     (void)eMB_Master_RequestReadHoldingRegister(1U, 0U, 10U);
+ *     eMB_SIM_PortRunUntilIdle();
+ *   }
+ *
+ * Link it instead of the hardware port (eMB_PortEvent.c, eMB_PortSerial.c,
+ * eMB_PortTimer.c, eMB_PortUtils.c and eMB_LCfg.c). Single threaded only.
+ *
+ * Created on October 20, 2026, 12:20 AM
+ */
+
+#ifndef EMB_PORTSIM_H
+#define EMB_PORTSIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#define eMB_SIM_SLAVE_NUM                         ( 247U )
+
+/*! \brief Virtual slave. Turnaround is turnaroundUs plus a uniform random part of up to
+ *    jitterUs, with a probability of tailPermille another tailUs (long tail). Errors are
+ *    injected per answer with the given probabilities in 1/1000. The register maps
+ *    belong to the application, coils and discrete inputs are bits, LSB first. */
+typedef struct _eMB_SIM_SlaveStruct
+{
+  uint32_t                    turnaroundUs;       /*!< Fixed part of the turnaround. */
+  uint32_t                    jitterUs;           /*!< Uniform random part of the turnaround. */
+  uint32_t                    tailUs;             /*!< Extra turnaround of the tail. */
+  uint16_t                    tailPermille;       /*!< Probability of the tail. */
+  uint16_t                    noAnswerPermille;   /*!< Request is ignored. */
+  uint16_t                    crcPermille;        /*!< A bit of the answer is flipped. */
+  uint16_t                    busyPermille;       /*!< Answer is exception 0x06. */
+  uint16_t                    gapPermille;        /*!< Silence between T1.5 and T3.5 inside the answer. */
+
+  uint16_t                   *holdingBuf;         /*!< Holding registers, NULL if none. */
+  uint16_t                    holdingStart;
+  uint16_t                    holdingNum;
+  uint16_t                   *inputBuf;           /*!< Input registers, NULL if none. */
+  uint16_t                    inputStart;
+  uint16_t                    inputNum;
+  uint8_t                    *coilBuf;            /*!< Coils, NULL if none. */
+  uint16_t                    coilStart;
+  uint16_t                    coilNum;
+  uint8_t                    *discreteBuf;        /*!< Discrete inputs, NULL if none. */
+  uint16_t                    discreteStart;
+  uint16_t                    discreteNum;
+} eMB_SIM_SlaveStruct;
+
+/*! \brief Counters of the simulated line. */
+typedef struct _eMB_SIM_StatsStruct
+{
+  uint32_t                    requestNum;         /*!< Frames sent by the master. */
+  uint32_t                    answerNum;          /*!< Answers sent by the slaves. */
+  uint32_t                    noAnswerNum;        /*!< Injected missing answers. */
+  uint32_t                    crcNum;             /*!< Injected CRC errors. */
+  uint32_t                    busyNum;            /*!< Injected busy exceptions. */
+  uint32_t                    gapNum;             /*!< Injected gaps. */
+  uint32_t                    collisionNum;       /*!< Answers cut by the master. */
+  uint32_t                    damagedNum;         /*!< Requests dropped by the slaves (CRC or collision). */
+} eMB_SIM_StatsStruct;
+
+/*! \brief Called for every event which eMB_MainFunction() takes, before it handles it. */
+typedef void (*eMB_SIM_EventHook)(eMB_EventType eEvent);
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/*! \brief Configuration of a master RTU on the simulated line. */
+extern const eMB_ConfigStruct eMB_SIM_Config;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \brief Reset the clock, the line and all slaves and set the baud rate of the line and
+ *    the stack (see eMB_RTU_SetBaudrate()). Call before eMB_Init(). The seed makes
+ *    the turnaround times and injected errors repeatable. */
+eMB_ErrorCodeType eMB_SIM_PortSetup(uint32_t baudrate, uint8_t charBits, uint32_t seed);
+
+/*! \brief Configure a virtual slave (1 - 247), NULL removes it. */
+eMB_ErrorCodeType eMB_SIM_PortSetSlave(uint8_t slaveAddr, const eMB_SIM_SlaveStruct *slave);
+
+/*! \brief Run eMB_MainFunction() once and, if it has no event left, advance the clock
+ *    to the next event of the line or timer and call its callout.
+ *    Returns false if nothing is pending. */
+bool eMB_SIM_PortStep(void);
+
+/*! \brief Step until nothing is pending: the request on the line has completed. */
+void eMB_SIM_PortRunUntilIdle(void);
+
+/*! \brief Step for durationUs of virtual time, e.g. to let retries become due. */
+void eMB_SIM_PortRunFor(uint32_t durationUs);
+
+/*! \brief Step until the request of the master is on the line and it waits for
+ *    the response (or the request was not sent). */
+void eMB_SIM_PortRunUntilSent(void);
+
+/*! \brief Inject a byte from the line into the master, one character time from now,
+ *    and run eMB_MainFunction() on the events of the stack. The slaves do not see it. */
+void eMB_SIM_PortReceiveByte(uint8_t data);
+
+/*! \brief Advance the clock to the timer of the master and let it expire.
+ *    Returns false if no timer is armed. */
+bool eMB_SIM_PortExpireTimer(void);
+
+/*! \brief Let the slaves take the last request of the master again, repeatNum times,
+ *    without the line: check of the request, execution on the register maps and
+ *    answer with its CRC. The line, its counters and the random generator are not
+ *    changed. Times the simulator alone, e.g. to subtract it from a benchmark. */
+void eMB_SIM_PortRepeatRequest(uint32_t repeatNum);
+
+/*! \brief Virtual time since eMB_SIM_PortSetup() in microseconds. */
+uint64_t eMB_SIM_PortGetTimeUs(void);
+
+/*! \brief Copy the counters of the line. */
+void eMB_SIM_PortGetStats(eMB_SIM_StatsStruct *stats);
+
+/*! \brief Set the hook which sees the events of the stack, NULL removes it.
+ *    eMB_SIM_PortSetup() keeps it. */
+void eMB_SIM_PortSetEventHook(eMB_SIM_EventHook hook);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PORTSIM_H */
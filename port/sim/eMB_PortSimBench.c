@@ -0,0 +1,627 @@
+/*
+ * File:   eMB_PortSimBench.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 01:10 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE                           ( 199309L )   /* clock_gettime() */
+#endif
+
+#include <time.h>
+#if (defined __x86_64__) || (defined __i386__)
+#include <x86intrin.h>
+#endif
+
+#include "eMB_PortSimBench.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_RTU_ENABLED
+#define eMB_SIM_BENCH_SLAVE_ADDR                  ( 1U )
+#define eMB_SIM_BENCH_WARMUP_NUM                  ( 100UL )
+
+#define eMB_SIM_BENCH_REG_NUM                     ( 125U )
+#define eMB_SIM_BENCH_BIT_NUM                     ( 2000U )
+
+/* Registers of one slave in the store of the master */
+#define eMB_SIM_BENCH_UNPACK_NUM                  ( (eMB_MASTER_REG_HOLDING_NREGS < eMB_SIM_BENCH_REG_NUM) ? \
+                                                    (uint16_t)eMB_MASTER_REG_HOLDING_NREGS : (uint16_t)eMB_SIM_BENCH_REG_NUM )
+
+#if (defined __x86_64__) || (defined __i386__)
+#define eMB_SIM_BENCH_CYCLE_UNIT                  "tsc"
+#else
+#define eMB_SIM_BENCH_CYCLE_UNIT                  "ns"
+#endif
+
+/* One function code with one quantity */
+typedef struct _eMB_SIM_BenchCaseStruct
+{
+  uint8_t                     funcCode;
+  uint16_t                    num;
+} eMB_SIM_BenchCaseStruct;
+
+/* Kernel of the micro benchmark, request builders are selected by their function code */
+typedef enum _eMB_SIM_BenchKernelType
+{
+  eMB_SIM_BENCH_KERNEL_CRC,
+  eMB_SIM_BENCH_KERNEL_SET_BITS,
+  eMB_SIM_BENCH_KERNEL_GET_BITS,
+  eMB_SIM_BENCH_KERNEL_HOLDING_UNPACK,
+  eMB_SIM_BENCH_KERNEL_REQUEST
+} eMB_SIM_BenchKernelType;
+
+typedef struct _eMB_SIM_BenchKernelStruct
+{
+  const char                 *name;
+  eMB_SIM_BenchKernelType     kernel;
+  uint8_t                     funcCode;
+  uint16_t                    sizeMax;            /*!< Bytes, bits or registers. */
+} eMB_SIM_BenchKernelStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static eMB_ErrorCodeType eMB_SIM_BenchSetup(uint32_t baudrate);
+static eMB_ErrorCodeType eMB_SIM_BenchRequest(uint8_t funcCode, uint16_t num);
+static void eMB_SIM_BenchFrameSize(uint8_t funcCode, uint16_t num, eMB_SIM_BenchResultStruct *result);
+static uint64_t eMB_SIM_BenchClock(clockid_t clockId);
+static uint64_t eMB_SIM_BenchKernel(const eMB_SIM_BenchKernelStruct *kernel, uint16_t size, uint32_t repeatNum,
+                                    eMB_ErrorCodeType *errStatus);
+static uint16_t eMB_SIM_BenchKernelBytes(const eMB_SIM_BenchKernelStruct *kernel, uint16_t size);
+static uint64_t eMB_SIM_BenchCycles(void);
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* The largest quantities are the limits of the request functions of the master */
+static const eMB_SIM_BenchCaseStruct eMB_SIM_BenchCaseCfg[] =
+{
+  { eMB_FUNC_READ_COILS,                   1U   }, { eMB_FUNC_READ_COILS,                   128U }, { eMB_FUNC_READ_COILS,                   2000U },
+  { eMB_FUNC_READ_DISCRETE_INPUTS,         1U   }, { eMB_FUNC_READ_DISCRETE_INPUTS,         128U }, { eMB_FUNC_READ_DISCRETE_INPUTS,         2000U },
+  { eMB_FUNC_READ_HOLDING_REGISTER,        1U   }, { eMB_FUNC_READ_HOLDING_REGISTER,        16U  }, { eMB_FUNC_READ_HOLDING_REGISTER,        125U  },
+  { eMB_FUNC_READ_INPUT_REGISTER,          1U   }, { eMB_FUNC_READ_INPUT_REGISTER,          16U  }, { eMB_FUNC_READ_INPUT_REGISTER,          125U  },
+  { eMB_FUNC_WRITE_SINGLE_COIL,            1U   },
+  { eMB_FUNC_WRITE_REGISTER,               1U   },
+  { eMB_FUNC_WRITE_MULTIPLE_COILS,         1U   }, { eMB_FUNC_WRITE_MULTIPLE_COILS,         128U }, { eMB_FUNC_WRITE_MULTIPLE_COILS,         1968U },
+  { eMB_FUNC_WRITE_MULTIPLE_REGISTERS,     1U   }, { eMB_FUNC_WRITE_MULTIPLE_REGISTERS,     16U  }, { eMB_FUNC_WRITE_MULTIPLE_REGISTERS,     120U  },
+  { eMB_FUNC_READWRITE_MULTIPLE_REGISTERS, 1U   }, { eMB_FUNC_READWRITE_MULTIPLE_REGISTERS, 16U  }, { eMB_FUNC_READWRITE_MULTIPLE_REGISTERS, 121U  }
+};
+
+static const eMB_SIM_BenchKernelStruct eMB_SIM_BenchKernelCfg[] =
+{
+  { "crc",                     eMB_SIM_BENCH_KERNEL_CRC,            0U,                                    eMB_SDU_SIZE_MAX },
+  { "setBits",                 eMB_SIM_BENCH_KERNEL_SET_BITS,       0U,                                    eMB_SIM_BENCH_BIT_NUM },
+  { "getBits",                 eMB_SIM_BENCH_KERNEL_GET_BITS,       0U,                                    eMB_SIM_BENCH_BIT_NUM },
+  { "holdingUnpack",           eMB_SIM_BENCH_KERNEL_HOLDING_UNPACK, 0U,                                    eMB_SIM_BENCH_UNPACK_NUM },
+  { "reqReadHolding",          eMB_SIM_BENCH_KERNEL_REQUEST,        eMB_FUNC_READ_HOLDING_REGISTER,        1U },
+  { "reqWriteHolding",         eMB_SIM_BENCH_KERNEL_REQUEST,        eMB_FUNC_WRITE_REGISTER,               1U },
+  { "reqWriteMultipleHolding", eMB_SIM_BENCH_KERNEL_REQUEST,        eMB_FUNC_WRITE_MULTIPLE_REGISTERS,     120U },
+  { "reqReadWriteHolding",     eMB_SIM_BENCH_KERNEL_REQUEST,        eMB_FUNC_READWRITE_MULTIPLE_REGISTERS, 121U },
+  { "reqReadCoils",            eMB_SIM_BENCH_KERNEL_REQUEST,        eMB_FUNC_READ_COILS,                   1U },
+  { "reqWriteCoil",            eMB_SIM_BENCH_KERNEL_REQUEST,        eMB_FUNC_WRITE_SINGLE_COIL,            1U },
+  { "reqWriteMultipleCoils",   eMB_SIM_BENCH_KERNEL_REQUEST,        eMB_FUNC_WRITE_MULTIPLE_COILS,         1968U }
+};
+
+/* Register maps of the slave and the data of the write requests */
+static uint16_t eMB_SIM_BenchHolding[eMB_SIM_BENCH_REG_NUM];
+static uint16_t eMB_SIM_BenchInput[eMB_SIM_BENCH_REG_NUM];
+static uint8_t  eMB_SIM_BenchCoil[eMB_SIM_BENCH_BIT_NUM / 8U];
+static uint8_t  eMB_SIM_BenchDiscrete[eMB_SIM_BENCH_BIT_NUM / 8U];
+
+static uint16_t eMB_SIM_BenchRegData[eMB_SIM_BENCH_REG_NUM];
+static uint8_t  eMB_SIM_BenchBitData[eMB_SIM_BENCH_BIT_NUM / 8U];
+
+/* Inputs and outputs of the kernels, bit buffers are accessed two bytes at a time */
+static uint8_t  eMB_SIM_BenchFrame[eMB_SDU_SIZE_MAX];
+static uint8_t  eMB_SIM_BenchBitBuf[eMB_SIM_BENCH_BIT_NUM / 8U + 1U];
+static volatile uint32_t eMB_SIM_BenchSink;
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_SIM_BenchRun(uint32_t baudrate, uint32_t transNum, uint32_t budgetNs, FILE *out)
+{
+  eMB_ErrorCodeType errStatus = eMB_SIM_BenchSetup(baudrate);
+  eMB_ErrorCodeType caseStatus;
+  eMB_SIM_BenchResultStruct result;
+  uint64_t cpuNsPerTrans;
+  uint64_t wallNsPerTrans;
+  bool isOverBudget;
+  uint8_t i;
+
+  if (errStatus != eMB_ENOERR)
+  {
+    return errStatus;
+  }
+
+  if (out != NULL)
+  {
+    (void)fprintf(out, "{\"baudrate\":%lu,\"transNum\":%lu,\"budgetNs\":%lu,\"cases\":[",
+                  (unsigned long)baudrate, (unsigned long)transNum, (unsigned long)budgetNs);
+  }
+
+  for (i = 0U; i < (uint8_t)(sizeof(eMB_SIM_BenchCaseCfg) / sizeof(eMB_SIM_BenchCaseCfg[0])); i++)
+  {
+    caseStatus = eMB_SIM_BenchCase(eMB_SIM_BenchCaseCfg[i].funcCode, eMB_SIM_BenchCaseCfg[i].num, transNum, &result);
+
+    cpuNsPerTrans  = (result.transNum != 0UL) ? (result.cpuNs / result.transNum) : 0ULL;
+    wallNsPerTrans = (result.transNum != 0UL) ? (result.wallNs / result.transNum) : 0ULL;
+    isOverBudget   = (budgetNs != 0UL) && (cpuNsPerTrans > budgetNs);
+
+    if ((caseStatus != eMB_ENOERR) && (errStatus == eMB_ENOERR))
+    {
+      errStatus = caseStatus;
+    }
+
+    if ((isOverBudget == true) && (errStatus == eMB_ENOERR))
+    {
+      errStatus = eMB_ETIMEDOUT;
+    }
+
+    if (out != NULL)
+    {
+      (void)fprintf(out,
+                    "%s\n{\"funcCode\":%u,\"num\":%u,\"reqBytes\":%u,\"ansBytes\":%u,"
+                    "\"transPerSec\":%llu,\"cpuNsPerTrans\":%llu,\"wallNsPerTrans\":%llu,"
+                    "\"simNsPerTrans\":%llu,\"lineUsPerTrans\":%llu,\"failNum\":%lu,\"overBudget\":%s}",
+                    (i == 0U) ? "" : ",",
+                    (unsigned)result.funcCode, (unsigned)result.num,
+                    (unsigned)result.reqBytes, (unsigned)result.ansBytes,
+                    (unsigned long long)((result.wallNs != 0ULL) ?
+                                         ((uint64_t)result.transNum * 1000000000ULL / result.wallNs) : 0ULL),
+                    (unsigned long long)cpuNsPerTrans, (unsigned long long)wallNsPerTrans,
+                    (unsigned long long)((result.transNum != 0UL) ? (result.simNs / result.transNum) : 0ULL),
+                    (unsigned long long)((result.transNum != 0UL) ? (result.lineUs / result.transNum) : 0ULL),
+                    (unsigned long)result.failNum, (isOverBudget == true) ? "true" : "false");
+    }
+  }
+
+  if (out != NULL)
+  {
+    (void)fprintf(out, "\n]}\n");
+  }
+
+  return errStatus;
+}
+
+eMB_ErrorCodeType eMB_SIM_BenchMicroRun(uint32_t repeatNum, FILE *out)
+{
+  eMB_ErrorCodeType errStatus = eMB_SIM_BenchSetup(115200UL);
+  const eMB_SIM_BenchKernelStruct *pKernel;
+  uint64_t cycles;
+  uint16_t bytes;
+  uint16_t size;
+  bool isFirst = true;
+  uint16_t i;
+  uint8_t k;
+
+  if ((errStatus != eMB_ENOERR) || (repeatNum == 0UL))
+  {
+    return (errStatus != eMB_ENOERR) ? errStatus : eMB_EINVAL;
+  }
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_SDU_SIZE_MAX; i++)
+  {
+    eMB_SIM_BenchFrame[i] = (uint8_t)(i * 7U + 1U);
+  }
+
+  if (out != NULL)
+  {
+    (void)fprintf(out, "{\"unit\":\"%s\",\"repeatNum\":%lu,\"kernels\":[",
+                  eMB_SIM_BENCH_CYCLE_UNIT, (unsigned long)repeatNum);
+  }
+
+  for (k = 0U; k < (uint8_t)(sizeof(eMB_SIM_BenchKernelCfg) / sizeof(eMB_SIM_BenchKernelCfg[0])); k++)
+  {
+    pKernel = &eMB_SIM_BenchKernelCfg[k];
+
+    /* Powers of two up to the maximum, which is always the last size. */
+    for (size = (uint16_t)1U; size != (uint16_t)0U;
+         size = (size == pKernel->sizeMax) ? (uint16_t)0U :
+                (((uint32_t)size * 2UL < pKernel->sizeMax) ? (uint16_t)(size * 2U) : pKernel->sizeMax))
+    {
+      /* Warm up. */
+      (void)eMB_SIM_BenchKernel(pKernel, size, (repeatNum < 100UL) ? repeatNum : 100UL, &errStatus);
+
+      cycles = eMB_SIM_BenchKernel(pKernel, size, repeatNum, &errStatus);
+      bytes  = eMB_SIM_BenchKernelBytes(pKernel, size);
+
+      if (out != NULL)
+      {
+        (void)fprintf(out, "%s\n{\"name\":\"%s\",\"size\":%u,\"bytes\":%u,\"perCall\":%.2f,\"perByte\":%.2f}",
+                      (isFirst == true) ? "" : ",", pKernel->name, (unsigned)size, (unsigned)bytes,
+                      (double)cycles / (double)repeatNum,
+                      (double)cycles / (double)repeatNum / (double)bytes);
+      }
+
+      isFirst = false;
+    }
+  }
+
+  if (out != NULL)
+  {
+    (void)fprintf(out, "\n]}\n");
+  }
+
+  return errStatus;
+}
+
+eMB_ErrorCodeType eMB_SIM_BenchCase(uint8_t funcCode, uint16_t num, uint32_t transNum,
+                                    eMB_SIM_BenchResultStruct *result)
+{
+  eMB_SIM_StatsStruct statsBefore;
+  eMB_SIM_StatsStruct statsAfter;
+  uint64_t cpuNs;
+  uint64_t wallNs;
+  uint64_t lineUs;
+  uint64_t simCpuNs;
+  uint64_t simWallNs;
+  uint32_t i;
+
+  if (result == NULL)
+  {
+    return eMB_EINVAL;
+  }
+
+  memset(result, 0, sizeof(eMB_SIM_BenchResultStruct));
+
+  result->funcCode = funcCode;
+  result->num      = num;
+  eMB_SIM_BenchFrameSize(funcCode, num, result);
+
+  /* Caches and branch predictors settle, an unsupported case fails here. */
+  for (i = 0UL; i < eMB_SIM_BENCH_WARMUP_NUM; i++)
+  {
+    if (eMB_SIM_BenchRequest(funcCode, num) != eMB_ENOERR)
+    {
+      return eMB_EINVAL;
+    }
+
+    eMB_SIM_PortRunUntilIdle();
+  }
+
+  eMB_SIM_PortGetStats(&statsBefore);
+
+  lineUs = eMB_SIM_PortGetTimeUs();
+  wallNs = eMB_SIM_BenchClock(CLOCK_MONOTONIC);
+  cpuNs  = eMB_SIM_BenchClock(CLOCK_PROCESS_CPUTIME_ID);
+
+  for (i = 0UL; i < transNum; i++)
+  {
+    if (eMB_SIM_BenchRequest(funcCode, num) != eMB_ENOERR)
+    {
+      result->failNum++;
+    }
+
+    eMB_SIM_PortRunUntilIdle();
+  }
+
+  result->cpuNs  = eMB_SIM_BenchClock(CLOCK_PROCESS_CPUTIME_ID) - cpuNs;
+  result->wallNs = eMB_SIM_BenchClock(CLOCK_MONOTONIC) - wallNs;
+  result->lineUs = eMB_SIM_PortGetTimeUs() - lineUs;
+
+  /* The slave alone, on the request of the case which is still in its buffer. */
+  eMB_SIM_PortRepeatRequest(eMB_SIM_BENCH_WARMUP_NUM);
+
+  simWallNs = eMB_SIM_BenchClock(CLOCK_MONOTONIC);
+  simCpuNs  = eMB_SIM_BenchClock(CLOCK_PROCESS_CPUTIME_ID);
+
+  eMB_SIM_PortRepeatRequest(transNum);
+
+  simCpuNs  = eMB_SIM_BenchClock(CLOCK_PROCESS_CPUTIME_ID) - simCpuNs;
+  simWallNs = eMB_SIM_BenchClock(CLOCK_MONOTONIC) - simWallNs;
+
+  result->simNs  = simCpuNs;
+  result->cpuNs  = (result->cpuNs > simCpuNs) ? (result->cpuNs - simCpuNs) : 0ULL;
+  result->wallNs = (result->wallNs > simWallNs) ? (result->wallNs - simWallNs) : 0ULL;
+
+  eMB_SIM_PortGetStats(&statsAfter);
+
+  /* Requests which were sent but not answered. */
+  result->failNum += (statsAfter.requestNum - statsBefore.requestNum) - (statsAfter.answerNum - statsBefore.answerNum);
+  result->transNum = transNum - result->failNum;
+
+  return (result->failNum == 0UL) ? eMB_ENOERR : eMB_EIO;
+}
+
+
+
+
+
+/* Set up the line with one ideal slave and the master. */
+static eMB_ErrorCodeType eMB_SIM_BenchSetup(uint32_t baudrate)
+{
+  eMB_SIM_SlaveStruct slave;
+  eMB_ErrorCodeType errStatus = eMB_SIM_PortSetup(baudrate, 11U, 1UL);
+
+  if (errStatus != eMB_ENOERR)
+  {
+    return errStatus;
+  }
+
+  memset(&slave, 0, sizeof(slave));
+
+  slave.holdingBuf  = eMB_SIM_BenchHolding;
+  slave.holdingNum  = (uint16_t)eMB_SIM_BENCH_REG_NUM;
+  slave.inputBuf    = eMB_SIM_BenchInput;
+  slave.inputNum    = (uint16_t)eMB_SIM_BENCH_REG_NUM;
+  slave.coilBuf     = eMB_SIM_BenchCoil;
+  slave.coilNum     = (uint16_t)eMB_SIM_BENCH_BIT_NUM;
+  slave.discreteBuf = eMB_SIM_BenchDiscrete;
+  slave.discreteNum = (uint16_t)eMB_SIM_BENCH_BIT_NUM;
+
+  (void)eMB_SIM_PortSetSlave((uint8_t)eMB_SIM_BENCH_SLAVE_ADDR, &slave);
+
+  errStatus = eMB_Init(&eMB_SIM_Config);
+
+  if (errStatus == eMB_ENOERR)
+  {
+    errStatus = eMB_Enable();
+  }
+
+  eMB_SIM_PortRunUntilIdle();
+
+  return errStatus;
+}
+
+static eMB_ErrorCodeType eMB_SIM_BenchRequest(uint8_t funcCode, uint16_t num)
+{
+  const uint8_t slaveAddr = (uint8_t)eMB_SIM_BENCH_SLAVE_ADDR;
+  eMB_ErrorCodeType errStatus = eMB_EINVAL;
+
+  switch (funcCode)
+  {
+#ifdef eMB_FUNC_READ_COILS_ENABLED
+    case eMB_FUNC_READ_COILS:
+      errStatus = eMB_Master_RequestReadCoils(slaveAddr, 0U, num);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_COIL_ENABLED
+    case eMB_FUNC_WRITE_SINGLE_COIL:
+      errStatus = eMB_Master_RequestWriteSingleCoil(slaveAddr, 0U, 0xFF00U);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_COILS_ENABLED
+    case eMB_FUNC_WRITE_MULTIPLE_COILS:
+      errStatus = eMB_Master_RequestWriteMultipleCoils(slaveAddr, 0U, num, eMB_SIM_BenchBitData);
+      break;
+#endif
+#ifdef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
+    case eMB_FUNC_READ_DISCRETE_INPUTS:
+      errStatus = eMB_Master_RequestReadDiscreteInputs(slaveAddr, 0U, num);
+      break;
+#endif
+#ifdef eMB_FUNC_READ_HOLDING_ENABLED
+    case eMB_FUNC_READ_HOLDING_REGISTER:
+      errStatus = eMB_Master_RequestReadHoldingRegister(slaveAddr, 0U, num);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_HOLDING_ENABLED
+    case eMB_FUNC_WRITE_REGISTER:
+      errStatus = eMB_Master_RequestWriteHoldingRegister(slaveAddr, 0U, 0x1234U);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_HOLDING_ENABLED
+    case eMB_FUNC_WRITE_MULTIPLE_REGISTERS:
+      errStatus = eMB_Master_RequestWriteMultipleHoldingRegister(slaveAddr, 0U, num, eMB_SIM_BenchRegData);
+      break;
+#endif
+#ifdef eMB_FUNC_READWRITE_HOLDING_ENABLED
+    case eMB_FUNC_READWRITE_MULTIPLE_REGISTERS:
+      errStatus = eMB_Master_RequestReadWriteMultipleHoldingRegister(slaveAddr, 0U, num, eMB_SIM_BenchRegData, 0U, num);
+      break;
+#endif
+#ifdef eMB_FUNC_READ_INPUT_ENABLED
+    case eMB_FUNC_READ_INPUT_REGISTER:
+      errStatus = eMB_Master_RequestReadInputRegister(slaveAddr, 0U, num);
+      break;
+#endif
+    default:
+      break;
+  }
+
+  return errStatus;
+}
+
+/* RTU frame sizes of a request and its normal response. */
+static void eMB_SIM_BenchFrameSize(uint8_t funcCode, uint16_t num, eMB_SIM_BenchResultStruct *result)
+{
+  uint16_t bitBytes = (uint16_t)((num + 7U) / 8U);
+
+  result->reqBytes = (uint16_t)8U;
+  result->ansBytes = (uint16_t)8U;
+
+  switch (funcCode)
+  {
+    case eMB_FUNC_READ_COILS:
+    case eMB_FUNC_READ_DISCRETE_INPUTS:
+      result->ansBytes = (uint16_t)(5U + bitBytes);
+      break;
+    case eMB_FUNC_READ_HOLDING_REGISTER:
+    case eMB_FUNC_READ_INPUT_REGISTER:
+      result->ansBytes = (uint16_t)(5U + num * 2U);
+      break;
+    case eMB_FUNC_WRITE_MULTIPLE_COILS:
+      result->reqBytes = (uint16_t)(9U + bitBytes);
+      break;
+    case eMB_FUNC_WRITE_MULTIPLE_REGISTERS:
+      result->reqBytes = (uint16_t)(9U + num * 2U);
+      break;
+    case eMB_FUNC_READWRITE_MULTIPLE_REGISTERS:
+      result->reqBytes = (uint16_t)(13U + num * 2U);
+      result->ansBytes = (uint16_t)(5U + num * 2U);
+      break;
+    default:
+      break;
+  }
+}
+
+static uint64_t eMB_SIM_BenchClock(clockid_t clockId)
+{
+  struct timespec ts;
+
+  (void)clock_gettime(clockId, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+/* Cycles of repeatNum calls of a kernel. The transactions of the request
+ * builders complete outside of the measurement. */
+static uint64_t eMB_SIM_BenchKernel(const eMB_SIM_BenchKernelStruct *kernel, uint16_t size, uint32_t repeatNum,
+                                    eMB_ErrorCodeType *errStatus)
+{
+  uint64_t cycles = 0ULL;
+  uint64_t startCycles;
+  uint32_t sink = 0UL;
+  uint16_t byteNum = (uint16_t)(size / 8U);
+  uint16_t j;
+  uint32_t i;
+
+  if (kernel->kernel == eMB_SIM_BENCH_KERNEL_REQUEST)
+  {
+    for (i = 0UL; i < repeatNum; i++)
+    {
+      startCycles = eMB_SIM_BenchCycles();
+
+      if (eMB_SIM_BenchRequest(kernel->funcCode, size) != eMB_ENOERR)
+      {
+        *errStatus = eMB_EIO;
+      }
+
+      cycles += eMB_SIM_BenchCycles() - startCycles;
+
+      eMB_SIM_PortRunUntilIdle();
+    }
+
+    return cycles;
+  }
+
+  /* The register callback stores into the slave of the last frame. */
+  eMB_FrameSetSlaveAddressCalloutArr((uint8_t)eMB_SIM_BENCH_SLAVE_ADDR);
+
+  startCycles = eMB_SIM_BenchCycles();
+
+  for (i = 0UL; i < repeatNum; i++)
+  {
+    switch (kernel->kernel)
+    {
+      case eMB_SIM_BENCH_KERNEL_CRC:
+      {
+        sink += eMB_GetCRC(eMB_SIM_BenchFrame, size);
+        break;
+      }
+      case eMB_SIM_BENCH_KERNEL_SET_BITS:
+      {
+        /* As the coil callbacks: whole bytes, then the last bits. */
+        for (j = (uint16_t)0U; j < byteNum; j++)
+        {
+          eMB_Util_SetBits(&eMB_SIM_BenchBitBuf[j], 0U, 8U, eMB_SIM_BenchFrame[j]);
+        }
+
+        if ((size % 8U) != 0U)
+        {
+          eMB_Util_SetBits(&eMB_SIM_BenchBitBuf[byteNum], 0U, (uint8_t)(size % 8U), eMB_SIM_BenchFrame[byteNum]);
+        }
+        break;
+      }
+      case eMB_SIM_BENCH_KERNEL_GET_BITS:
+      {
+        for (j = (uint16_t)0U; j < byteNum; j++)
+        {
+          eMB_SIM_BenchBitData[j] = eMB_Util_GetBits(eMB_SIM_BenchBitBuf, (uint16_t)(j * 8U), 8U);
+        }
+
+        if ((size % 8U) != 0U)
+        {
+          eMB_SIM_BenchBitData[byteNum] = eMB_Util_GetBits(eMB_SIM_BenchBitBuf, (uint16_t)(byteNum * 8U),
+                                                           (uint8_t)(size % 8U));
+        }
+        break;
+      }
+      default:
+      {
+        if (eMB_Util_FuncHoldingRegisterCallback((uint16_t)(eMB_MASTER_REG_HOLDING_START + 1U), size,
+                                                 eMB_SIM_BenchFrame) != eMB_ENOERR)
+        {
+          *errStatus = eMB_EIO;
+        }
+        break;
+      }
+    }
+  }
+
+  cycles = eMB_SIM_BenchCycles() - startCycles;
+
+  eMB_SIM_BenchSink = sink;
+
+  return cycles;
+}
+
+/* Bytes which a kernel processes for a size. */
+static uint16_t eMB_SIM_BenchKernelBytes(const eMB_SIM_BenchKernelStruct *kernel, uint16_t size)
+{
+  eMB_SIM_BenchResultStruct result;
+
+  switch (kernel->kernel)
+  {
+    case eMB_SIM_BENCH_KERNEL_CRC:
+      return size;
+    case eMB_SIM_BENCH_KERNEL_SET_BITS:
+    case eMB_SIM_BENCH_KERNEL_GET_BITS:
+      return (uint16_t)((size + 7U) / 8U);
+    case eMB_SIM_BENCH_KERNEL_HOLDING_UNPACK:
+      return (uint16_t)(size * 2U);
+    default:
+      break;
+  }
+
+  /* PDU of the request without address and CRC. */
+  eMB_SIM_BenchFrameSize(kernel->funcCode, size, &result);
+
+  return (uint16_t)(result.reqBytes - eMB_SDU_FUNC_OFFSET - eMB_SDU_CRC_SIZE);
+}
+
+/* TSC on x86, the monotonic clock in ns elsewhere. */
+static uint64_t eMB_SIM_BenchCycles(void)
+{
+#if (defined __x86_64__) || (defined __i386__)
+  return (uint64_t)__rdtsc();
+#else
+  return eMB_SIM_BenchClock(CLOCK_MONOTONIC);
+#endif
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,138 @@
+/*
+ * File:   eMB_PortSimBench.h
+ * Author: Long
+ *
+ * Benchmark of the software overhead of the master. Every eMB_Master_Request*
+ * function is driven through eMB_MainFunction() against one virtual slave of
+ * the simulated line (eMB_PortSim.h) with zero turnaround and no errors. The
+ * line costs no real time. The slave of the simulator, which executes the
+ * request and computes the CRC of the answer, is timed alone with
+ * eMB_SIM_PortRepeatRequest() after the case and subtracted, so the CPU and
+ * wall time are the ones of the stack. What remains of the simulator is the
+ * dispatch of the bytes and timers, a few calls per byte like the interrupts
+ * of a target.
+ *
+ * Each case is one function code with one quantity (1, a typical and the
+ * largest one). A case runs a warm up and then transNum transactions and
+ * reports transactions per second, CPU and wall time per transaction, the
+ * subtracted time of the slave and the bytes on the line. The results are
+ * written as one JSON object:
+ *
+ *   { "baudrate": 115200, "transNum": 10000, "budgetNs": 20000,
+ *     "cases": [ { "funcCode": 3, "num": 125, "reqBytes": 8, "ansBytes": 255,
+ *                  "transPerSec": 512345, "cpuNsPerTrans": 1951,
+ *                  "wallNsPerTrans": 1952, "simNsPerTrans": 610,
+ *                  "lineUsPerTrans": 23437,
+ *                  "failNum": 0, "overBudget": false }, ... ] }
+ *
+ * The stack allocates no memory, so there are no allocations to count.
+ * port/sim/main/eMB_SimBenchMain.c runs the cases from the command line.
+ *
+ * eMB_SIM_BenchMicroRun() times the kernels below the transaction: eMB_GetCRC(),
+ * the bit packing of eMB_Util_SetBits() / eMB_Util_GetBits() as the coil
+ * callbacks use it, the register unpacking of eMB_Util_FuncHoldingRegisterCallback()
+ * and the request builders of eMB_FuncHolding.c and eMB_FuncCoils.c. The sizes
+ * go in powers of two from 1 to the protocol maximum, the result is the time per
+ * call and per byte in TSC cycles on x86, else in ns:
+ *
+ *   { "unit": "tsc", "repeatNum": 1000,
+ *     "kernels": [ { "name": "crc", "size": 256, "bytes": 256,
+ *                    "perCall": 1310.52, "perByte": 5.12 }, ... ] }
+ *
+ * port/sim/main/eMB_SimBenchMicroMain.c runs the kernel sweeps from the command line.
+ * Link it with the simulated port, eMB_SIM_BenchRun() sets up the line and
+ * calls eMB_Init() itself.
+ *
+ * Created on October 20, 2026, 01:10 AM
+ */
+
+#ifndef EMB_PORTSIMBENCH_H
+#define EMB_PORTSIMBENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <stdio.h>
+
+#include "eMB_PortSim.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \brief Result of one case. */
+typedef struct _eMB_SIM_BenchResultStruct
+{
+  uint8_t                     funcCode;           /*!< Function code. */
+  uint16_t                    num;                /*!< Registers or bits per request. */
+  uint16_t                    reqBytes;           /*!< Request frame on the line. */
+  uint16_t                    ansBytes;           /*!< Response frame on the line. */
+  uint32_t                    transNum;           /*!< Measured transactions. */
+  uint32_t                    failNum;            /*!< Requests which were refused or not answered. */
+  uint64_t                    cpuNs;              /*!< CPU time of the stack. */
+  uint64_t                    wallNs;             /*!< Monotonic time of the stack. */
+  uint64_t                    simNs;              /*!< CPU time of the slave, subtracted from cpuNs. */
+  uint64_t                    lineUs;             /*!< Virtual time of the line. */
+} eMB_SIM_BenchResultStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \brief Run all cases and write the results as JSON.
+ *
+ * \param baudrate  baud rate of the simulated line, it only changes lineUsPerTrans
+ * \param transNum  measured transactions per case
+ * \param budgetNs  CPU time budget per transaction, 0 for none
+ * \param out       stream for the JSON, NULL for none
+ *
+ * \return eMB_ENOERR if all cases completed within the budget, eMB_ETIMEDOUT if a
+ *    case is over the budget, eMB_EIO if a transaction failed, else the error of
+ *    the setup.
+ */
+eMB_ErrorCodeType eMB_SIM_BenchRun(uint32_t baudrate, uint32_t transNum, uint32_t budgetNs, FILE *out);
+
+/*! \brief Run the kernel sweeps and write the results as JSON.
+ *
+ * \param repeatNum calls per kernel and size
+ * \param out       stream for the JSON, NULL for none
+ *
+ * \return eMB_ENOERR on success, eMB_EIO if a request builder failed, else the
+ *    error of the setup.
+ */
+eMB_ErrorCodeType eMB_SIM_BenchMicroRun(uint32_t repeatNum, FILE *out);
+
+/*! \brief Run one case, the stack must be set up by eMB_SIM_BenchRun() or the application.
+ *
+ * \param funcCode  function code
+ * \param num       registers or bits per request, the write number of 0x17
+ * \param transNum  measured transactions
+ * \param result    result of the case
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL for an unsupported case, eMB_EIO if a
+ *    transaction failed.
+ */
+eMB_ErrorCodeType eMB_SIM_BenchCase(uint8_t funcCode, uint16_t num, uint32_t transNum,
+                                    eMB_SIM_BenchResultStruct *result);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PORTSIMBENCH_H */
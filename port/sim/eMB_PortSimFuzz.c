@@ -0,0 +1,306 @@
+/*
+ * File:   eMB_PortSimFuzz.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 02:05 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_PortSimFuzz.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_RTU_ENABLED
+#define eMB_SIM_FUZZ_OP_BYTE                      ( 0xF0U )
+#define eMB_SIM_FUZZ_OP_TIMER                     ( 0xF1U )
+#define eMB_SIM_FUZZ_OP_SILENCE                   ( 0xF2U )
+#define eMB_SIM_FUZZ_OP_REQUEST                   ( 0xF3U )
+
+#define eMB_SIM_FUZZ_REQUEST_KIND_NUM             ( 9U )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+extern eMB_ExceptionType eMB_FuncReportSlaveIDHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+
+extern eMB_ExceptionType eMB_Master_FuncReadInputRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Master_FuncReadHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Master_FuncWriteMultipleHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Master_FuncWriteHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Master_FuncReadWriteMultipleHoldingRegisterHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Master_FuncReadCoilsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Master_FuncWriteSingleCoilHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Master_FuncWriteMultipleCoilsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+extern eMB_ExceptionType eMB_Master_FuncReadDiscreteInputsHandler(uint8_t *recvPduFrame, uint16_t *recvPduLength);
+
+/* Handlers of the master, as eMB_FuncHandlerCfg of eMB.c */
+static const eMB_FuncCallback eMB_SIM_FuzzHandlerCfg[] =
+{
+#ifdef eMB_FUNC_OTHER_REP_SLAVEID_ENABLED
+  eMB_FuncReportSlaveIDHandler,
+#endif
+#ifdef eMB_FUNC_READ_INPUT_ENABLED
+  eMB_Master_FuncReadInputRegisterHandler,
+#endif
+#ifdef eMB_FUNC_READ_HOLDING_ENABLED
+  eMB_Master_FuncReadHoldingRegisterHandler,
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_HOLDING_ENABLED
+  eMB_Master_FuncWriteMultipleHoldingRegisterHandler,
+#endif
+#ifdef eMB_FUNC_WRITE_HOLDING_ENABLED
+  eMB_Master_FuncWriteHoldingRegisterHandler,
+#endif
+#ifdef eMB_FUNC_READWRITE_HOLDING_ENABLED
+  eMB_Master_FuncReadWriteMultipleHoldingRegisterHandler,
+#endif
+#ifdef eMB_FUNC_READ_COILS_ENABLED
+  eMB_Master_FuncReadCoilsHandler,
+#endif
+#ifdef eMB_FUNC_WRITE_COIL_ENABLED
+  eMB_Master_FuncWriteSingleCoilHandler,
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_COILS_ENABLED
+  eMB_Master_FuncWriteMultipleCoilsHandler,
+#endif
+#ifdef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
+  eMB_Master_FuncReadDiscreteInputsHandler,
+#endif
+  NULL
+};
+
+/* Data of the write requests */
+static uint16_t eMB_SIM_FuzzRegData[eMB_PDU_SIZE_MAX / 2U];
+static uint8_t  eMB_SIM_FuzzBitData[eMB_PDU_SIZE_MAX];
+
+/* Response PDU, placed at the end */
+static uint8_t  eMB_SIM_FuzzRecvBuf[eMB_PDU_SIZE_MAX];
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_FuzzSetup(void);
+static void eMB_SIM_FuzzRequest(uint8_t kind, uint8_t slaveAddr, uint8_t num);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+int eMB_SIM_FuzzRTU(const uint8_t *data, size_t size)
+{
+  size_t i;
+
+  if (size < 3U)
+  {
+    return 0;
+  }
+
+  eMB_SIM_FuzzSetup();
+
+  eMB_SIM_FuzzRequest(data[0], data[1], data[2]);
+
+  for (i = 3U; i < size; i++)
+  {
+    switch (data[i])
+    {
+      case eMB_SIM_FUZZ_OP_BYTE:
+      {
+        if (++i < size)
+        {
+          eMB_SIM_PortReceiveByte(data[i]);
+        }
+        break;
+      }
+      case eMB_SIM_FUZZ_OP_TIMER:
+      {
+        (void)eMB_SIM_PortExpireTimer();
+        break;
+      }
+      case eMB_SIM_FUZZ_OP_SILENCE:
+      {
+        if (++i < size)
+        {
+          eMB_SIM_PortRunFor((uint32_t)data[i] * 100UL);
+        }
+        break;
+      }
+      case eMB_SIM_FUZZ_OP_REQUEST:
+      {
+        if (i + 3U < size)
+        {
+          eMB_SIM_FuzzRequest(data[i + 1U], data[i + 2U], data[i + 3U]);
+        }
+
+        i += 3U;
+        break;
+      }
+      default:
+      {
+        eMB_SIM_PortReceiveByte(data[i]);
+        break;
+      }
+    }
+  }
+
+  /* Let the last transaction complete or time out. */
+  eMB_SIM_PortRunUntilIdle();
+
+  return 0;
+}
+
+int eMB_SIM_FuzzHandler(const uint8_t *data, size_t size)
+{
+  const uint8_t handlerNum = (uint8_t)(sizeof(eMB_SIM_FuzzHandlerCfg) / sizeof(eMB_SIM_FuzzHandlerCfg[0]) - 1U);
+  uint8_t *pduFrame;
+  uint16_t sendLength;
+  uint16_t recvLength;
+  size_t offset = 3U;
+
+  if ((size < offset) || (handlerNum == 0U))
+  {
+    return 0;
+  }
+
+  eMB_SIM_FuzzSetup();
+
+  /* The handlers read the request of the transaction from the send buffer. */
+  sendLength = (uint16_t)(data[2] % (eMB_PDU_SIZE_MAX + 1U));
+
+  if (sendLength > size - offset)
+  {
+    sendLength = (uint16_t)(size - offset);
+  }
+
+  eMB_FrameGetSendPduBufferCalloutArr(&pduFrame);
+  memset(pduFrame, 0, eMB_PDU_SIZE_MAX);
+  memcpy(pduFrame, &data[offset], sendLength);
+
+  /* Broadcasts are flagged when they are sent, eMB_SIM_FuzzRTU() covers them. */
+  eMB_FrameSetSlaveAddressCalloutArr((uint8_t)(data[1] % eMB_MASTER_TOTAL_SLAVE_NUM + 1U));
+  eMB_FrameSetSendPduLengthCalloutArr(sendLength);
+
+  offset += sendLength;
+
+  recvLength = (uint16_t)(size - offset);
+
+  if (recvLength > (uint16_t)eMB_PDU_SIZE_MAX)
+  {
+    recvLength = (uint16_t)eMB_PDU_SIZE_MAX;
+  }
+
+  pduFrame = &eMB_SIM_FuzzRecvBuf[eMB_PDU_SIZE_MAX - recvLength];
+  memcpy(pduFrame, &data[offset], recvLength);
+
+  (void)eMB_SIM_FuzzHandlerCfg[data[0] % handlerNum](pduFrame, &recvLength);
+
+  return 0;
+}
+
+
+
+
+
+/* Start every input on an idle line without slaves. */
+static void eMB_SIM_FuzzSetup(void)
+{
+  (void)eMB_SIM_PortSetup(19200UL, 11U, 1UL);
+  (void)eMB_Init(&eMB_SIM_Config);
+  (void)eMB_Enable();
+
+  eMB_SIM_PortRunUntilIdle();
+}
+
+/* Send a request of one of the kinds of the master, refused ones are part of the input. */
+static void eMB_SIM_FuzzRequest(uint8_t kind, uint8_t slaveAddr, uint8_t num)
+{
+  /* Bits up to beyond the largest number, registers up to 256. */
+  const uint16_t bitNum = (uint16_t)((uint16_t)num * 8U + 1U);
+  const uint16_t regNum = (uint16_t)((uint16_t)num + 1U);
+
+  slaveAddr = (uint8_t)(slaveAddr % (eMB_MASTER_TOTAL_SLAVE_NUM + 1U));
+
+  switch (kind % eMB_SIM_FUZZ_REQUEST_KIND_NUM)
+  {
+#ifdef eMB_FUNC_READ_COILS_ENABLED
+    case 0U:
+      (void)eMB_Master_RequestReadCoils(slaveAddr, 0U, bitNum);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_COIL_ENABLED
+    case 1U:
+      (void)eMB_Master_RequestWriteSingleCoil(slaveAddr, 0U, 0xFF00U);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_COILS_ENABLED
+    case 2U:
+      (void)eMB_Master_RequestWriteMultipleCoils(slaveAddr, 0U, bitNum, eMB_SIM_FuzzBitData);
+      break;
+#endif
+#ifdef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
+    case 3U:
+      (void)eMB_Master_RequestReadDiscreteInputs(slaveAddr, 0U, bitNum);
+      break;
+#endif
+#ifdef eMB_FUNC_READ_HOLDING_ENABLED
+    case 4U:
+      (void)eMB_Master_RequestReadHoldingRegister(slaveAddr, 0U, regNum);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_HOLDING_ENABLED
+    case 5U:
+      (void)eMB_Master_RequestWriteHoldingRegister(slaveAddr, 0U, 0x1234U);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_HOLDING_ENABLED
+    case 6U:
+      (void)eMB_Master_RequestWriteMultipleHoldingRegister(slaveAddr, 0U, regNum, eMB_SIM_FuzzRegData);
+      break;
+#endif
+#ifdef eMB_FUNC_READWRITE_HOLDING_ENABLED
+    case 7U:
+      (void)eMB_Master_RequestReadWriteMultipleHoldingRegister(slaveAddr, 0U, regNum, eMB_SIM_FuzzRegData, 0U, regNum);
+      break;
+#endif
+#ifdef eMB_FUNC_READ_INPUT_ENABLED
+    case 8U:
+      (void)eMB_Master_RequestReadInputRegister(slaveAddr, 0U, regNum);
+      break;
+#endif
+    default:
+      break;
+  }
+
+  eMB_SIM_PortRunUntilSent();
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,73 @@
+/*
+ * File:   eMB_PortSimFuzz.h
+ * Author: Long
+ *
+ * Fuzz targets of the master on the simulated line (eMB_PortSim.h). Both take
+ * an arbitrary input and return 0, so they are called directly from the entry
+ * point of libFuzzer (port/sim/main/eMB_SimFuzzLibFuzzer.c) or of AFL, which
+ * reads the input from stdin (port/sim/main/eMB_SimFuzzAfl.c).
+ *
+ * eMB_SIM_FuzzRTU() sends a request and feeds the input as a script of line
+ * bytes and timer events into eMB_Master_RTUFrameByteReceivedCallback() and
+ * eMB_Master_RTUTimerExpiredCallback():
+ *
+ *   byte 0 - 3   first request: kind, slave address (0 is broadcast) and number
+ *   0xF0 b       byte b is received (escape for 0xF0 - 0xF3)
+ *   0xF1         the armed timer expires
+ *   0xF2 n       n * 100us of silence on the line
+ *   0xF3 k a n   next request like the first one, when the master is idle
+ *   other b      byte b is received
+ *
+ * eMB_SIM_FuzzHandler() calls one eMB_Master_Func*Handler with an arbitrary
+ * request in the send buffer and an arbitrary response PDU:
+ *
+ *   byte 0       handler
+ *   byte 1       slave address of the request
+ *   byte 2       length of the request PDU, followed by the request PDU
+ *   rest         response PDU, up to eMB_PDU_SIZE_MAX bytes
+ *
+ * The response PDU ends at the end of its buffer, so a handler which reads
+ * beyond the received length is caught by AddressSanitizer.
+ *
+ * Created on October 20, 2026, 02:05 AM
+ */
+
+#ifndef EMB_PORTSIMFUZZ_H
+#define EMB_PORTSIMFUZZ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <stddef.h>
+
+#include "eMB_PortSim.h"
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \brief Feed a script of line bytes and timer events into the RTU master. */
+int eMB_SIM_FuzzRTU(const uint8_t *data, size_t size);
+
+/*! \brief Feed a request and a response PDU into a handler of the master. */
+int eMB_SIM_FuzzHandler(const uint8_t *data, size_t size);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PORTSIMFUZZ_H */
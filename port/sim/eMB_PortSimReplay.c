@@ -0,0 +1,1151 @@
+/*
+ * File:   eMB_PortSimReplay.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 02:40 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE                           ( 199309L )   /* clock_gettime() */
+#endif
+
+#include <time.h>
+
+#include "eMB_PortSimReplay.h"
+#include "eMB_Utils.h"
+#include "eMB_CRC.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifdef eMB_MASTER_RTU_ENABLED
+#define eMB_SIM_REPLAY_INDEX_NONE                 ( 0xFFFFFFFFUL )
+
+/* Events of one request and their text */
+#define eMB_SIM_REPLAY_EVENT_MAX                  ( 31U )
+
+/* Length of an output line and differing lines in the report */
+#define eMB_SIM_REPLAY_LINE_SIZE                  ( 128U )
+#define eMB_SIM_REPLAY_DIFF_MAX                   ( 16UL )
+
+/* pcap files and the link types of serial captures */
+#define eMB_SIM_REPLAY_PCAP_MAGIC_US              ( 0xA1B2C3D4UL )
+#define eMB_SIM_REPLAY_PCAP_MAGIC_NS              ( 0xA1B23C4DUL )
+#define eMB_SIM_REPLAY_PCAP_HEADER_SIZE           ( 24UL )
+#define eMB_SIM_REPLAY_PCAP_RECORD_SIZE           ( 16UL )
+#define eMB_SIM_REPLAY_LINKTYPE_USER15            ( 162U )
+#define eMB_SIM_REPLAY_PCAPNG_OPT_TSRESOL         ( 9U )
+#define eMB_SIM_REPLAY_IF_MAX                     ( 8U )
+
+#define eMB_SIM_REPLAY_IS_RTU_LINK(linkType)      ( ((linkType) >= (uint32_t)eMB_PCAPNG_LINKTYPE_USER0) && \
+                                                    ((linkType) <= (uint32_t)eMB_SIM_REPLAY_LINKTYPE_USER15) )
+
+/* Interface of a pcapng file */
+typedef struct _eMB_SIM_ReplayIfStruct
+{
+  bool                        isRtu;              /*!< Link type of a serial line. */
+  uint8_t                     tsResol;            /*!< Timestamps in 10^-tsResol s. */
+} eMB_SIM_ReplayIfStruct;
+
+/* Reader of a capture file in its byte order */
+typedef struct _eMB_SIM_ReplayFileStruct
+{
+  const uint8_t              *buf;
+  uint32_t                    size;
+  bool                        isSwapped;          /*!< Big endian file. */
+  eMB_CaptureRecordStruct    *records;
+  uint32_t                    maxNum;
+  uint32_t                    recordNum;
+  uint32_t                    requestIdx;         /*!< Last request or eMB_SIM_REPLAY_INDEX_NONE. */
+  bool                        isAnswered;         /*!< Last request has a valid answer. */
+} eMB_SIM_ReplayFileStruct;
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* Events of the request on the line and the time it completed */
+static char     eMB_SIM_ReplayEvents[eMB_SIM_REPLAY_EVENT_MAX + 1U];
+static uint8_t  eMB_SIM_ReplayEventNum;
+static uint64_t eMB_SIM_ReplayDoneUs;
+
+/* Data of the write requests */
+static uint16_t eMB_SIM_ReplayRegData[eMB_PDU_SIZE_MAX / 2U];
+static uint8_t  eMB_SIM_ReplayBitData[eMB_PDU_SIZE_MAX];
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_ReplayEventHook(eMB_EventType eEvent);
+static void eMB_SIM_ReplayEventPut(char event);
+static eMB_ErrorCodeType eMB_SIM_ReplayRequest(const eMB_CaptureRecordStruct *record);
+static eMB_ErrorCodeType eMB_SIM_ReplayRequestRaw(uint8_t slaveAddr, const uint8_t *pdu, uint16_t pduLength);
+static void eMB_SIM_ReplayAnswer(const eMB_CaptureRecordStruct *record);
+static void eMB_SIM_ReplayWriteShadow(FILE *out);
+static uint16_t eMB_SIM_ReplayGet16(const uint8_t *buf);
+static uint64_t eMB_SIM_ReplayClock(clockid_t clockId);
+static eMB_ErrorCodeType eMB_SIM_ReplayLoadPcapng(eMB_SIM_ReplayFileStruct *file);
+static eMB_ErrorCodeType eMB_SIM_ReplayLoadPcap(eMB_SIM_ReplayFileStruct *file, bool isNs);
+static eMB_ErrorCodeType eMB_SIM_ReplayAddRecord(eMB_SIM_ReplayFileStruct *file, const uint8_t *data, uint32_t length,
+                                                 uint64_t timeUs, uint32_t epbFlags);
+static bool eMB_SIM_ReplayIsAnswer(const eMB_CaptureRecordStruct *request, const uint8_t *data, uint32_t length);
+static uint32_t eMB_SIM_ReplayRead32(const eMB_SIM_ReplayFileStruct *file, uint32_t pos);
+static uint16_t eMB_SIM_ReplayRead16(const eMB_SIM_ReplayFileStruct *file, uint32_t pos);
+static uint64_t eMB_SIM_ReplayToUs(uint64_t ts, uint8_t tsResol);
+static bool eMB_SIM_ReplayReadLine(FILE *in, char *line);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+eMB_ErrorCodeType eMB_SIM_ReplayLoad(const uint8_t *buf, uint32_t size, eMB_CaptureRecordStruct *records,
+                                     uint32_t maxNum, uint32_t *recordNum)
+{
+  eMB_SIM_ReplayFileStruct file;
+  eMB_ErrorCodeType errStatus;
+  uint32_t magic;
+
+  if ((buf == NULL) || (records == NULL) || (recordNum == NULL) || (size < 12UL))
+  {
+    return eMB_EINVAL;
+  }
+
+  file.buf        = buf;
+  file.size       = size;
+  file.isSwapped  = false;
+  file.records    = records;
+  file.maxNum     = maxNum;
+  file.recordNum  = 0UL;
+  file.requestIdx = (uint32_t)eMB_SIM_REPLAY_INDEX_NONE;
+  file.isAnswered = false;
+
+  magic = eMB_SIM_ReplayRead32(&file, 0UL);
+
+  if (magic == (uint32_t)eMB_PCAPNG_BLOCK_SHB)
+  {
+    errStatus = eMB_SIM_ReplayLoadPcapng(&file);
+  }
+  else if ((magic == (uint32_t)eMB_SIM_REPLAY_PCAP_MAGIC_US) || (magic == (uint32_t)eMB_SIM_REPLAY_PCAP_MAGIC_NS))
+  {
+    errStatus = eMB_SIM_ReplayLoadPcap(&file, (magic == (uint32_t)eMB_SIM_REPLAY_PCAP_MAGIC_NS) ? true : false);
+  }
+  else
+  {
+    file.isSwapped = true;
+    magic = eMB_SIM_ReplayRead32(&file, 0UL);
+
+    if ((magic == (uint32_t)eMB_SIM_REPLAY_PCAP_MAGIC_US) || (magic == (uint32_t)eMB_SIM_REPLAY_PCAP_MAGIC_NS))
+    {
+      errStatus = eMB_SIM_ReplayLoadPcap(&file, (magic == (uint32_t)eMB_SIM_REPLAY_PCAP_MAGIC_NS) ? true : false);
+    }
+    else
+    {
+      errStatus = eMB_EINVAL;
+    }
+  }
+
+  *recordNum = file.recordNum;
+
+  return errStatus;
+}
+
+eMB_ErrorCodeType eMB_SIM_ReplayRun(const eMB_CaptureRecordStruct *records, uint32_t recordNum, uint32_t baudrate,
+                                    eMB_SIM_ReplayModeType mode, FILE *out, eMB_SIM_ReplayResultStruct *result)
+{
+  eMB_SIM_ReplayResultStruct localResult;
+  eMB_ErrorCodeType errStatus;
+  const eMB_CaptureRecordStruct *pRequest;
+  uint32_t prevIdx = (uint32_t)eMB_SIM_REPLAY_INDEX_NONE;
+  uint64_t offsetUs = 0ULL;
+  uint64_t startUs;
+  uint64_t issueUs;
+  uint64_t reqEndUs;
+  uint64_t answerUs;
+  uint64_t durationUs;
+  uint64_t cpuNs;
+  uint64_t wallNs;
+  uint32_t latencyUs;
+  uint32_t i;
+  uint32_t k;
+
+  if (result == NULL)
+  {
+    result = &localResult;
+  }
+
+  memset(result, 0, sizeof(eMB_SIM_ReplayResultStruct));
+
+  if ((records == NULL) && (recordNum != 0UL))
+  {
+    return eMB_EINVAL;
+  }
+
+  errStatus = eMB_SIM_PortSetup(baudrate, 11U, 1UL);
+
+  if (errStatus == eMB_ENOERR)
+  {
+    errStatus = eMB_Init(&eMB_SIM_Config);
+  }
+
+  if (errStatus == eMB_ENOERR)
+  {
+    /* The shadow of a previous replay must not count. */
+    (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+
+    errStatus = eMB_Enable();
+  }
+
+  if (errStatus != eMB_ENOERR)
+  {
+    return errStatus;
+  }
+
+  eMB_SIM_PortRunUntilIdle();
+  eMB_SIM_PortSetEventHook(eMB_SIM_ReplayEventHook);
+
+  startUs = eMB_SIM_PortGetTimeUs();
+  wallNs  = eMB_SIM_ReplayClock(CLOCK_MONOTONIC);
+  cpuNs   = eMB_SIM_ReplayClock(CLOCK_PROCESS_CPUTIME_ID);
+
+  for (i = 0UL; i < recordNum; i++)
+  {
+    /* Frames of the slaves before the first request have no request to answer. */
+    if ((records[i].flags & (uint8_t)eMB_CAPTURE_FLAG_SENT) == 0U)
+    {
+      continue;
+    }
+
+    pRequest = &records[i];
+
+    if (mode == eMB_SIM_REPLAY_ORIGINAL)
+    {
+      if (prevIdx != (uint32_t)eMB_SIM_REPLAY_INDEX_NONE)
+      {
+        offsetUs += (uint64_t)(uint32_t)(pRequest->timeUs - records[prevIdx].timeUs);
+      }
+
+      /* The capture has the end of the frame, the request started one frame time earlier. */
+      durationUs = (uint64_t)pRequest->length * eMB_RTU_GetCharTime();
+      issueUs    = startUs + ((offsetUs > durationUs) ? (offsetUs - durationUs) : 0ULL);
+
+      if (issueUs > eMB_SIM_PortGetTimeUs())
+      {
+        eMB_SIM_PortRunFor((uint32_t)(issueUs - eMB_SIM_PortGetTimeUs()));
+      }
+    }
+
+    prevIdx = i;
+    result->transNum++;
+
+    eMB_SIM_ReplayEventNum  = 0U;
+    eMB_SIM_ReplayEvents[0] = '\0';
+
+    issueUs = eMB_SIM_PortGetTimeUs();
+    eMB_SIM_ReplayDoneUs = issueUs;
+
+    errStatus = eMB_SIM_ReplayRequest(pRequest);
+
+    if (errStatus != eMB_ENOERR)
+    {
+      /* Its answers are skipped, the master would not expect them. */
+      result->refusedNum++;
+
+      if (out != NULL)
+      {
+        (void)fprintf(out, "trans %lu %u %u !%u 0\n", (unsigned long)(result->transNum - 1UL),
+                      (unsigned)pRequest->data[0], (unsigned)((pRequest->length > 1U) ? pRequest->data[1] : 0U),
+                      (unsigned)errStatus);
+      }
+
+      continue;
+    }
+
+    if (eMB_SIM_ReplayEvents[0] == '~')
+    {
+      result->differNum++;
+    }
+
+    eMB_SIM_PortRunUntilSent();
+    reqEndUs = eMB_SIM_PortGetTimeUs();
+
+    for (k = i + 1UL; (k < recordNum) && ((records[k].flags & (uint8_t)eMB_CAPTURE_FLAG_SENT) == 0U); k++)
+    {
+      if (mode == eMB_SIM_REPLAY_ORIGINAL)
+      {
+        /* Turnaround of the capture. A frame ended by T3.5 was captured T3.5 after its last byte. */
+        durationUs = (uint64_t)records[k].length * eMB_RTU_GetCharTime();
+#ifndef eMB_MASTER_RTU_LENGTH_FRAMING_ENABLED
+        durationUs += eMB_RTU_GetT35();
+#endif
+        answerUs = reqEndUs + (uint64_t)(uint32_t)(records[k].timeUs - pRequest->timeUs);
+        answerUs = (answerUs > durationUs) ? (answerUs - durationUs) : 0ULL;
+
+        if (answerUs > eMB_SIM_PortGetTimeUs())
+        {
+          eMB_SIM_PortRunFor((uint32_t)(answerUs - eMB_SIM_PortGetTimeUs()));
+        }
+      }
+      else if (k != (i + 1UL))
+      {
+        /* Frames of the same answer stay apart. */
+        eMB_SIM_PortRunFor(eMB_RTU_GetT35());
+      }
+      else
+      {
+        /* First frame follows the request at once. */
+      }
+
+      eMB_SIM_ReplayAnswer(&records[k]);
+    }
+
+    eMB_SIM_PortRunUntilIdle();
+
+    latencyUs = (uint32_t)(eMB_SIM_ReplayDoneUs - issueUs);
+
+    result->latencySumUs += latencyUs;
+
+    if (latencyUs > result->latencyMaxUs)
+    {
+      result->latencyMaxUs = latencyUs;
+    }
+
+    if (strpbrk(eMB_SIM_ReplayEvents, "TDF") != NULL)
+    {
+      result->errorNum++;
+    }
+
+    if (out != NULL)
+    {
+      (void)fprintf(out, "trans %lu %u %u %s %lu\n", (unsigned long)(result->transNum - 1UL),
+                    (unsigned)pRequest->data[0], (unsigned)pRequest->data[1],
+                    (eMB_SIM_ReplayEventNum != 0U) ? eMB_SIM_ReplayEvents : "-", (unsigned long)latencyUs);
+    }
+  }
+
+  result->cpuNs  = eMB_SIM_ReplayClock(CLOCK_PROCESS_CPUTIME_ID) - cpuNs;
+  result->wallNs = eMB_SIM_ReplayClock(CLOCK_MONOTONIC) - wallNs;
+  result->lineUs = eMB_SIM_PortGetTimeUs() - startUs;
+
+  eMB_SIM_PortSetEventHook(NULL);
+
+  if (out != NULL)
+  {
+    eMB_SIM_ReplayWriteShadow(out);
+
+    (void)fprintf(out, "summary %lu %lu %lu %llu %llu %llu %llu %lu\n",
+                  (unsigned long)result->transNum, (unsigned long)result->refusedNum,
+                  (unsigned long)result->errorNum, (unsigned long long)result->cpuNs,
+                  (unsigned long long)result->wallNs, (unsigned long long)result->lineUs,
+                  (unsigned long long)result->latencySumUs, (unsigned long)result->latencyMaxUs);
+  }
+
+  return eMB_ENOERR;
+}
+
+eMB_ErrorCodeType eMB_SIM_ReplayCompare(FILE *baseline, FILE *current, FILE *report)
+{
+  char baseLine[eMB_SIM_REPLAY_LINE_SIZE];
+  char curLine[eMB_SIM_REPLAY_LINE_SIZE];
+  char baseEvents[eMB_SIM_REPLAY_EVENT_MAX + 1U];
+  char curEvents[eMB_SIM_REPLAY_EVENT_MAX + 1U];
+  unsigned long baseTrans[4];
+  unsigned long curTrans[4];
+  unsigned long baseSum[3] = { 0UL, 0UL, 0UL };
+  unsigned long curSum[3] = { 0UL, 0UL, 0UL };
+  unsigned long long baseTime[4] = { 0ULL, 0ULL, 0ULL, 0ULL };
+  unsigned long long curTime[4] = { 0ULL, 0ULL, 0ULL, 0ULL };
+  unsigned long baseMax = 0UL;
+  unsigned long curMax = 0UL;
+  bool hasBase;
+  bool hasCur;
+  bool isEqual;
+  int baseFields = 0;
+  int curFields = 0;
+  uint32_t diffNum = 0UL;
+  unsigned long baseDone;
+  unsigned long curDone;
+
+  if ((baseline == NULL) || (current == NULL))
+  {
+    return eMB_EINVAL;
+  }
+
+  if (report != NULL)
+  {
+    (void)fprintf(report, "{\"diffs\":[");
+  }
+
+  for (;;)
+  {
+    hasBase = eMB_SIM_ReplayReadLine(baseline, baseLine);
+    hasCur  = eMB_SIM_ReplayReadLine(current, curLine);
+
+    if ((hasBase == false) && (hasCur == false))
+    {
+      break;
+    }
+
+    if (hasBase == false)
+    {
+      baseLine[0] = '\0';
+    }
+
+    if (hasCur == false)
+    {
+      curLine[0] = '\0';
+    }
+
+    if (strncmp(baseLine, "summary ", 8U) == 0)
+    {
+      baseFields = sscanf(baseLine, "summary %lu %lu %lu %llu %llu %llu %llu %lu", &baseSum[0], &baseSum[1],
+                          &baseSum[2], &baseTime[0], &baseTime[1], &baseTime[2], &baseTime[3], &baseMax);
+    }
+
+    if (strncmp(curLine, "summary ", 8U) == 0)
+    {
+      curFields = sscanf(curLine, "summary %lu %lu %lu %llu %llu %llu %llu %lu", &curSum[0], &curSum[1],
+                         &curSum[2], &curTime[0], &curTime[1], &curTime[2], &curTime[3], &curMax);
+    }
+
+    /* Latencies and times are measurements, not behavior. */
+    if ((sscanf(baseLine, "trans %lu %lu %lu %31s %lu", &baseTrans[0], &baseTrans[1], &baseTrans[2],
+                baseEvents, &baseTrans[3]) == 5) &&
+        (sscanf(curLine, "trans %lu %lu %lu %31s %lu", &curTrans[0], &curTrans[1], &curTrans[2],
+                curEvents, &curTrans[3]) == 5))
+    {
+      isEqual = (baseTrans[0] == curTrans[0]) && (baseTrans[1] == curTrans[1]) &&
+                (baseTrans[2] == curTrans[2]) && (strcmp(baseEvents, curEvents) == 0);
+    }
+    else if ((strncmp(baseLine, "summary ", 8U) == 0) && (strncmp(curLine, "summary ", 8U) == 0))
+    {
+      isEqual = (baseSum[0] == curSum[0]) && (baseSum[1] == curSum[1]) && (baseSum[2] == curSum[2]);
+    }
+    else
+    {
+      isEqual = (strcmp(baseLine, curLine) == 0) ? true : false;
+    }
+
+    if (isEqual == false)
+    {
+      if ((report != NULL) && (diffNum < (uint32_t)eMB_SIM_REPLAY_DIFF_MAX))
+      {
+        (void)fprintf(report, "%s\n{\"baseline\":\"%s\",\"current\":\"%s\"}",
+                      (diffNum == 0UL) ? "" : ",", baseLine, curLine);
+      }
+
+      diffNum++;
+    }
+  }
+
+  if ((baseFields != 8) || (curFields != 8))
+  {
+    if (report != NULL)
+    {
+      (void)fprintf(report, "\n]}\n");
+    }
+
+    return eMB_EINVAL;
+  }
+
+  /* Refused requests have no latency. */
+  baseDone = (baseSum[0] > baseSum[1]) ? (baseSum[0] - baseSum[1]) : 1UL;
+  curDone  = (curSum[0] > curSum[1]) ? (curSum[0] - curSum[1]) : 1UL;
+
+  if (report != NULL)
+  {
+    (void)fprintf(report,
+                  "\n],\"transNum\":[%lu,%lu],\"diffNum\":%lu,"
+                  "\"cpuNsPerTrans\":[%llu,%llu],\"wallNsPerTrans\":[%llu,%llu],"
+                  "\"latencyUsMean\":[%llu,%llu],\"latencyUsMax\":[%lu,%lu]}\n",
+                  baseSum[0], curSum[0], (unsigned long)diffNum,
+                  baseTime[0] / ((baseSum[0] != 0UL) ? baseSum[0] : 1UL),
+                  curTime[0] / ((curSum[0] != 0UL) ? curSum[0] : 1UL),
+                  baseTime[1] / ((baseSum[0] != 0UL) ? baseSum[0] : 1UL),
+                  curTime[1] / ((curSum[0] != 0UL) ? curSum[0] : 1UL),
+                  baseTime[3] / baseDone, curTime[3] / curDone, baseMax, curMax);
+  }
+
+  return (diffNum == 0UL) ? eMB_ENOERR : eMB_EIO;
+}
+
+
+
+
+
+/* Record the events of the request on the line. */
+static void eMB_SIM_ReplayEventHook(eMB_EventType eEvent)
+{
+  switch (eEvent)
+  {
+    case eMB_EV_FRAME_SENT:
+      eMB_SIM_ReplayEventPut('S');
+      break;
+    case eMB_EV_FRAME_RECEIVED:
+      eMB_SIM_ReplayEventPut('R');
+      break;
+    case eMB_EV_EXECUTE:
+      eMB_SIM_ReplayEventPut('X');
+      eMB_SIM_ReplayDoneUs = eMB_SIM_PortGetTimeUs();
+      break;
+    case eMB_EV_ERROR:
+    {
+      switch (eMB_Util_GetErrorEvent())
+      {
+        case eMB_EV_ERROR_RESPOND_TIMEOUT:  eMB_SIM_ReplayEventPut('T'); break;
+        case eMB_EV_ERROR_RECEIVE_DATA:     eMB_SIM_ReplayEventPut('D'); break;
+        default:                            eMB_SIM_ReplayEventPut('F'); break;
+      }
+
+      eMB_SIM_ReplayDoneUs = eMB_SIM_PortGetTimeUs();
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+static void eMB_SIM_ReplayEventPut(char event)
+{
+  if (eMB_SIM_ReplayEventNum < (uint8_t)eMB_SIM_REPLAY_EVENT_MAX)
+  {
+    eMB_SIM_ReplayEvents[eMB_SIM_ReplayEventNum++] = event;
+    eMB_SIM_ReplayEvents[eMB_SIM_ReplayEventNum]   = '\0';
+  }
+}
+
+/* Issue a captured request with the request function of its function code.
+ * Marks the events with ~ if the built request differs from the capture. */
+static eMB_ErrorCodeType eMB_SIM_ReplayRequest(const eMB_CaptureRecordStruct *record)
+{
+  const uint8_t *pdu = &record->data[1];
+  uint8_t *pSendPdu;
+  uint8_t slaveAddr = record->data[0];
+  uint16_t pduLength;
+  uint16_t addr;
+  uint16_t num;
+  uint16_t i;
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  bool isRaw = false;
+
+  if (record->length < (uint16_t)eMB_SDU_SIZE_MIN)
+  {
+    return eMB_EINVAL;
+  }
+
+  pduLength = (uint16_t)(record->length - 3U);
+  addr      = (pduLength >= 5U) ? eMB_SIM_ReplayGet16(&pdu[1]) : (uint16_t)0U;
+  num       = (pduLength >= 5U) ? eMB_SIM_ReplayGet16(&pdu[3]) : (uint16_t)0U;
+
+  switch (pdu[eMB_PDU_FUNC_OFFSET])
+  {
+#ifdef eMB_FUNC_READ_COILS_ENABLED
+    case eMB_FUNC_READ_COILS:
+      isRaw = (pduLength != 5U);
+      errStatus = (isRaw == true) ? eMB_ENOERR : eMB_Master_RequestReadCoils(slaveAddr, addr, num);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_COIL_ENABLED
+    case eMB_FUNC_WRITE_SINGLE_COIL:
+      isRaw = (pduLength != 5U);
+      errStatus = (isRaw == true) ? eMB_ENOERR : eMB_Master_RequestWriteSingleCoil(slaveAddr, addr, num);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_COILS_ENABLED
+    case eMB_FUNC_WRITE_MULTIPLE_COILS:
+    {
+      isRaw = (pduLength < 6U) || (pduLength != (uint16_t)(6U + pdu[5]));
+
+      if (isRaw == false)
+      {
+        memcpy(eMB_SIM_ReplayBitData, &pdu[6], pdu[5]);
+        errStatus = eMB_Master_RequestWriteMultipleCoils(slaveAddr, addr, num, eMB_SIM_ReplayBitData);
+      }
+      break;
+    }
+#endif
+#ifdef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
+    case eMB_FUNC_READ_DISCRETE_INPUTS:
+      isRaw = (pduLength != 5U);
+      errStatus = (isRaw == true) ? eMB_ENOERR : eMB_Master_RequestReadDiscreteInputs(slaveAddr, addr, num);
+      break;
+#endif
+#ifdef eMB_FUNC_READ_HOLDING_ENABLED
+    case eMB_FUNC_READ_HOLDING_REGISTER:
+      isRaw = (pduLength != 5U);
+      errStatus = (isRaw == true) ? eMB_ENOERR : eMB_Master_RequestReadHoldingRegister(slaveAddr, addr, num);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_HOLDING_ENABLED
+    case eMB_FUNC_WRITE_REGISTER:
+      isRaw = (pduLength != 5U);
+      errStatus = (isRaw == true) ? eMB_ENOERR : eMB_Master_RequestWriteHoldingRegister(slaveAddr, addr, num);
+      break;
+#endif
+#ifdef eMB_FUNC_WRITE_MULTIPLE_HOLDING_ENABLED
+    case eMB_FUNC_WRITE_MULTIPLE_REGISTERS:
+    {
+      isRaw = (pduLength < 6U) || (pduLength != (uint16_t)(6U + pdu[5])) || (pdu[5] != (uint8_t)(num * 2U));
+
+      if (isRaw == false)
+      {
+        for (i = (uint16_t)0U; i < num; i++)
+        {
+          eMB_SIM_ReplayRegData[i] = eMB_SIM_ReplayGet16(&pdu[6U + i * 2U]);
+        }
+
+        errStatus = eMB_Master_RequestWriteMultipleHoldingRegister(slaveAddr, addr, num, eMB_SIM_ReplayRegData);
+      }
+      break;
+    }
+#endif
+#ifdef eMB_FUNC_READWRITE_HOLDING_ENABLED
+    case eMB_FUNC_READWRITE_MULTIPLE_REGISTERS:
+    {
+      isRaw = (pduLength < 10U) || (pduLength != (uint16_t)(10U + pdu[9])) ||
+              (pdu[9] != (uint8_t)(eMB_SIM_ReplayGet16(&pdu[7]) * 2U));
+
+      if (isRaw == false)
+      {
+        for (i = (uint16_t)0U; i < eMB_SIM_ReplayGet16(&pdu[7]); i++)
+        {
+          eMB_SIM_ReplayRegData[i] = eMB_SIM_ReplayGet16(&pdu[10U + i * 2U]);
+        }
+
+        errStatus = eMB_Master_RequestReadWriteMultipleHoldingRegister(slaveAddr, addr, num, eMB_SIM_ReplayRegData,
+                                                                       eMB_SIM_ReplayGet16(&pdu[5]),
+                                                                       eMB_SIM_ReplayGet16(&pdu[7]));
+      }
+      break;
+    }
+#endif
+#ifdef eMB_FUNC_READ_INPUT_ENABLED
+    case eMB_FUNC_READ_INPUT_REGISTER:
+      isRaw = (pduLength != 5U);
+      errStatus = (isRaw == true) ? eMB_ENOERR : eMB_Master_RequestReadInputRegister(slaveAddr, addr, num);
+      break;
+#endif
+    default:
+      isRaw = true;
+      break;
+  }
+
+  /* Other function codes and malformed requests are sent as they were captured. */
+  if (isRaw == true)
+  {
+    return eMB_SIM_ReplayRequestRaw(slaveAddr, pdu, pduLength);
+  }
+
+  if (errStatus == eMB_ENOERR)
+  {
+    eMB_FrameGetSendPduBufferCalloutArr(&pSendPdu);
+
+    if ((eMB_FrameGetSendPduLengthCalloutArr() != pduLength) || (memcmp(pSendPdu, pdu, pduLength) != 0))
+    {
+      eMB_SIM_ReplayEventPut('~');
+    }
+  }
+
+  return errStatus;
+}
+
+/* Put a request into the send buffer like eMB_Retry_Dispatch() does. */
+static eMB_ErrorCodeType eMB_SIM_ReplayRequestRaw(uint8_t slaveAddr, const uint8_t *pdu, uint16_t pduLength)
+{
+  uint8_t *pSendPdu;
+
+  if (pduLength > (uint16_t)eMB_PDU_SIZE_MAX)
+  {
+    return eMB_EINVAL;
+  }
+
+  if (eMB_Util_ResourceTake() == false)
+  {
+    return eMB_EBUSY;
+  }
+
+  eMB_FrameGetSendPduBufferCalloutArr(&pSendPdu);
+  memcpy(pSendPdu, pdu, pduLength);
+
+  eMB_FrameSetSlaveAddressCalloutArr(slaveAddr);
+  eMB_FrameSetSendPduLengthCalloutArr(pduLength);
+
+  (void)eMB_SIM_Config.pPortEventPost(eMB_EV_FRAME_SENT);
+
+  return eMB_ENOERR;
+}
+
+/* Feed a captured frame into the receiver of the master, a gap half way
+ * between T1.5 and T3.5 in the middle if the capture saw one. */
+static void eMB_SIM_ReplayAnswer(const eMB_CaptureRecordStruct *record)
+{
+  uint16_t i;
+
+  for (i = (uint16_t)0U; i < record->length; i++)
+  {
+    if (((record->flags & (uint8_t)eMB_CAPTURE_FLAG_GAP) != 0U) && (i == (uint16_t)(record->length / 2U)))
+    {
+      eMB_SIM_PortRunFor((eMB_RTU_GetT15() + eMB_RTU_GetT35()) / 2UL);
+    }
+
+    eMB_SIM_PortReceiveByte(record->data[i]);
+  }
+}
+
+/* Blocks of the shadow which were updated. */
+static void eMB_SIM_ReplayWriteShadow(FILE *out)
+{
+  const eMB_ShadowBlockInfoStruct *pInfo;
+  const uint8_t *pBlock;
+  uint16_t blockSize;
+  uint8_t slaveIdx;
+  uint8_t regType;
+
+  for (slaveIdx = (uint8_t)0U; slaveIdx < (uint8_t)eMB_MASTER_TOTAL_SLAVE_NUM; slaveIdx++)
+  {
+    for (regType = (uint8_t)0U; regType < (uint8_t)eMB_SHADOW_TABLE_NUM; regType++)
+    {
+      pInfo = &eMB_gShadowPtr->info[slaveIdx][regType];
+
+      if (pInfo->status == (uint8_t)eMB_SHADOW_BLOCK_EMPTY)
+      {
+        continue;
+      }
+
+      /* The master keeps the CRC of a block only in a restored store. */
+      switch (regType)
+      {
+        case eMB_REG_COILS:
+        {
+          pBlock    = eMB_gShadowPtr->coilBuf[slaveIdx];
+          blockSize = (uint16_t)sizeof(eMB_gShadowPtr->coilBuf[slaveIdx]);
+          break;
+        }
+        case eMB_REG_DISCRETE_INPUTS:
+        {
+          pBlock    = eMB_gShadowPtr->discreteBuf[slaveIdx];
+          blockSize = (uint16_t)sizeof(eMB_gShadowPtr->discreteBuf[slaveIdx]);
+          break;
+        }
+        case eMB_REG_INPUT:
+        {
+          pBlock    = (const uint8_t *)eMB_gShadowPtr->inputBuf[slaveIdx];
+          blockSize = (uint16_t)sizeof(eMB_gShadowPtr->inputBuf[slaveIdx]);
+          break;
+        }
+        default:
+        {
+          pBlock    = (const uint8_t *)eMB_gShadowPtr->holdingBuf[slaveIdx];
+          blockSize = (uint16_t)sizeof(eMB_gShadowPtr->holdingBuf[slaveIdx]);
+          break;
+        }
+      }
+
+      (void)fprintf(out, "shadow %u %u %u %04x\n", (unsigned)(slaveIdx + 1U), (unsigned)regType,
+                    (unsigned)pInfo->status, (unsigned)eMB_GetCRC((uint8_t *)pBlock, blockSize));
+    }
+  }
+}
+
+static uint16_t eMB_SIM_ReplayGet16(const uint8_t *buf)
+{
+  return (uint16_t)(((uint16_t)buf[0] << 8U) | (uint16_t)buf[1]);
+}
+
+static uint64_t eMB_SIM_ReplayClock(clockid_t clockId)
+{
+  struct timespec ts;
+
+  (void)clock_gettime(clockId, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Section header, interface description and enhanced packet blocks, others are skipped. */
+static eMB_ErrorCodeType eMB_SIM_ReplayLoadPcapng(eMB_SIM_ReplayFileStruct *file)
+{
+  eMB_SIM_ReplayIfStruct ifArr[eMB_SIM_REPLAY_IF_MAX];
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint32_t ifNum = 0UL;
+  uint32_t pos = 0UL;
+  uint32_t blockType;
+  uint32_t blockSize;
+  uint32_t optPos;
+  uint32_t optEnd;
+  uint32_t capLen;
+  uint32_t ifId;
+  uint32_t epbFlags;
+  uint16_t optCode;
+  uint16_t optLen;
+  uint64_t ts;
+
+  while ((errStatus == eMB_ENOERR) && ((pos + 12UL) <= file->size))
+  {
+    blockType = eMB_SIM_ReplayRead32(file, pos);
+
+    /* Every section sets its own byte order. */
+    if (blockType == (uint32_t)eMB_PCAPNG_BLOCK_SHB)
+    {
+      file->isSwapped = false;
+
+      if (eMB_SIM_ReplayRead32(file, pos + 8UL) != (uint32_t)eMB_PCAPNG_BYTE_ORDER_MAGIC)
+      {
+        file->isSwapped = true;
+
+        if (eMB_SIM_ReplayRead32(file, pos + 8UL) != (uint32_t)eMB_PCAPNG_BYTE_ORDER_MAGIC)
+        {
+          return eMB_EINVAL;
+        }
+      }
+
+      ifNum = 0UL;
+    }
+
+    blockSize = eMB_SIM_ReplayRead32(file, pos + 4UL);
+
+    if ((blockSize < 12UL) || ((blockSize & 3UL) != 0UL) || (blockSize > (file->size - pos)))
+    {
+      return eMB_EIO;
+    }
+
+    if ((blockType == (uint32_t)eMB_PCAPNG_BLOCK_IDB) && (blockSize >= 20UL))
+    {
+      if (ifNum < (uint32_t)eMB_SIM_REPLAY_IF_MAX)
+      {
+        ifArr[ifNum].isRtu   = eMB_SIM_REPLAY_IS_RTU_LINK((uint32_t)eMB_SIM_ReplayRead16(file, pos + 8UL));
+        ifArr[ifNum].tsResol = 6U;
+
+        for (optPos = pos + 16UL, optEnd = pos + blockSize - 4UL; (optPos + 4UL) <= optEnd; )
+        {
+          optCode = eMB_SIM_ReplayRead16(file, optPos);
+          optLen  = eMB_SIM_ReplayRead16(file, optPos + 2UL);
+
+          if ((optCode == (uint16_t)eMB_SIM_REPLAY_PCAPNG_OPT_TSRESOL) && (optLen == (uint16_t)1U))
+          {
+            /* Powers of two are not supported. */
+            ifArr[ifNum].tsResol = file->buf[optPos + 4UL];
+            ifArr[ifNum].isRtu   = ifArr[ifNum].isRtu && (ifArr[ifNum].tsResol <= 9U);
+          }
+
+          optPos += 4UL + (((uint32_t)optLen + 3UL) & ~3UL);
+        }
+      }
+
+      ifNum++;
+    }
+    else if ((blockType == (uint32_t)eMB_PCAPNG_BLOCK_EPB) && (blockSize >= 32UL))
+    {
+      ifId   = eMB_SIM_ReplayRead32(file, pos + 8UL);
+      capLen = eMB_SIM_ReplayRead32(file, pos + 20UL);
+
+      if (capLen > (blockSize - 32UL))
+      {
+        return eMB_EIO;
+      }
+
+      if ((ifId < ifNum) && (ifId < (uint32_t)eMB_SIM_REPLAY_IF_MAX) && (ifArr[ifId].isRtu == true))
+      {
+        ts = ((uint64_t)eMB_SIM_ReplayRead32(file, pos + 12UL) << 32U) | eMB_SIM_ReplayRead32(file, pos + 16UL);
+        epbFlags = 0UL;
+
+        for (optPos = pos + 28UL + ((capLen + 3UL) & ~3UL), optEnd = pos + blockSize - 4UL; (optPos + 4UL) <= optEnd; )
+        {
+          optCode = eMB_SIM_ReplayRead16(file, optPos);
+          optLen  = eMB_SIM_ReplayRead16(file, optPos + 2UL);
+
+          if ((optCode == (uint16_t)eMB_PCAPNG_OPT_EPB_FLAGS) && (optLen == (uint16_t)4U) && ((optPos + 8UL) <= optEnd))
+          {
+            epbFlags = eMB_SIM_ReplayRead32(file, optPos + 4UL);
+          }
+
+          optPos += 4UL + (((uint32_t)optLen + 3UL) & ~3UL);
+        }
+
+        errStatus = eMB_SIM_ReplayAddRecord(file, &file->buf[pos + 28UL], capLen,
+                                            eMB_SIM_ReplayToUs(ts, ifArr[ifId].tsResol), epbFlags);
+      }
+    }
+    else
+    {
+      /* Not a block of frames. */
+    }
+
+    pos += blockSize;
+  }
+
+  if ((errStatus == eMB_ENOERR) && (pos != file->size))
+  {
+    errStatus = eMB_EIO;
+  }
+
+  return errStatus;
+}
+
+/* Global header and records without direction. */
+static eMB_ErrorCodeType eMB_SIM_ReplayLoadPcap(eMB_SIM_ReplayFileStruct *file, bool isNs)
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  uint32_t pos = (uint32_t)eMB_SIM_REPLAY_PCAP_HEADER_SIZE;
+  uint32_t capLen;
+  uint64_t ts;
+
+  if ((file->size < (uint32_t)eMB_SIM_REPLAY_PCAP_HEADER_SIZE) ||
+      (eMB_SIM_REPLAY_IS_RTU_LINK(eMB_SIM_ReplayRead32(file, 20UL) & 0xFFFFUL) == false))
+  {
+    return eMB_EINVAL;
+  }
+
+  while ((errStatus == eMB_ENOERR) && (pos < file->size))
+  {
+    if ((file->size - pos) < (uint32_t)eMB_SIM_REPLAY_PCAP_RECORD_SIZE)
+    {
+      return eMB_EIO;
+    }
+
+    capLen = eMB_SIM_ReplayRead32(file, pos + 8UL);
+
+    if (capLen > (file->size - pos - (uint32_t)eMB_SIM_REPLAY_PCAP_RECORD_SIZE))
+    {
+      return eMB_EIO;
+    }
+
+    ts = (uint64_t)eMB_SIM_ReplayRead32(file, pos) * 1000000ULL;
+    ts += (isNs == true) ? ((uint64_t)eMB_SIM_ReplayRead32(file, pos + 4UL) / 1000ULL) :
+                           (uint64_t)eMB_SIM_ReplayRead32(file, pos + 4UL);
+
+    errStatus = eMB_SIM_ReplayAddRecord(file, &file->buf[pos + (uint32_t)eMB_SIM_REPLAY_PCAP_RECORD_SIZE], capLen,
+                                        ts, 0UL);
+
+    pos += (uint32_t)eMB_SIM_REPLAY_PCAP_RECORD_SIZE + capLen;
+  }
+
+  return errStatus;
+}
+
+/* Append a frame. Without a direction a frame is an answer if it is damaged, the
+ * master only sends valid frames, or if it is the first valid frame after a
+ * request which is laid out like its answer. Others are requests. */
+static eMB_ErrorCodeType eMB_SIM_ReplayAddRecord(eMB_SIM_ReplayFileStruct *file, const uint8_t *data, uint32_t length,
+                                                 uint64_t timeUs, uint32_t epbFlags)
+{
+  eMB_CaptureRecordStruct *pRecord;
+  const eMB_CaptureRecordStruct *pRequest;
+  bool isValid;
+  bool isSent;
+
+  if (file->recordNum >= file->maxNum)
+  {
+    return eMB_ENORES;
+  }
+
+  pRecord  = &file->records[file->recordNum];
+  pRequest = (file->requestIdx != (uint32_t)eMB_SIM_REPLAY_INDEX_NONE) ? &file->records[file->requestIdx] : NULL;
+  isValid  = (length >= (uint32_t)eMB_SDU_SIZE_MIN) && (length <= (uint32_t)eMB_SDU_SIZE_MAX) &&
+             (eMB_GetCRC((uint8_t *)data, (uint16_t)length) == (uint16_t)0U);
+
+  if ((epbFlags & 3UL) == (uint32_t)eMB_PCAPNG_FLAG_OUTBOUND)
+  {
+    isSent = true;
+  }
+  else if ((epbFlags & 3UL) == (uint32_t)eMB_PCAPNG_FLAG_INBOUND)
+  {
+    isSent = false;
+  }
+  else if ((pRequest == NULL) || (pRequest->data[0] == (uint8_t)eMB_ADDRESS_BROADCAST))
+  {
+    isSent = true;
+  }
+  else if (isValid == false)
+  {
+    isSent = false;
+  }
+  else
+  {
+    isSent = (file->isAnswered == true) || (eMB_SIM_ReplayIsAnswer(pRequest, data, length) == false);
+  }
+
+  if (isSent == true)
+  {
+    file->requestIdx = file->recordNum;
+    file->isAnswered = false;
+  }
+  else if (isValid == true)
+  {
+    file->isAnswered = true;
+  }
+  else
+  {
+    /* Damaged frames do not end the wait for an answer. */
+  }
+
+  pRecord->timeUs = (uint32_t)timeUs;
+  pRecord->flags  = (isSent == true) ? (uint8_t)eMB_CAPTURE_FLAG_SENT : 0U;
+
+  if (length > (uint32_t)eMB_SDU_SIZE_MAX)
+  {
+    length = (uint32_t)eMB_SDU_SIZE_MAX;
+    epbFlags |= (uint32_t)eMB_PCAPNG_FLAG_TOO_LONG;
+  }
+
+  pRecord->length = (uint16_t)length;
+  memcpy(pRecord->data, data, length);
+
+  pRecord->flags |= ((epbFlags & (uint32_t)eMB_PCAPNG_FLAG_WRONG_GAP) != 0UL) ? (uint8_t)eMB_CAPTURE_FLAG_GAP : 0U;
+  pRecord->flags |= ((epbFlags & (uint32_t)eMB_PCAPNG_FLAG_TOO_LONG) != 0UL) ? (uint8_t)eMB_CAPTURE_FLAG_TOO_LONG : 0U;
+
+  /* Like eMB_Capture_Read(). */
+  if (pRecord->length < (uint16_t)eMB_SDU_SIZE_MIN)
+  {
+    pRecord->flags |= (uint8_t)eMB_CAPTURE_FLAG_TOO_SHORT;
+  }
+  else if (eMB_GetCRC(pRecord->data, pRecord->length) != (uint16_t)0U)
+  {
+    pRecord->flags |= (uint8_t)eMB_CAPTURE_FLAG_CRC;
+  }
+  else
+  {
+    /* Valid frame. */
+  }
+
+  file->recordNum++;
+
+  return eMB_ENOERR;
+}
+
+/* Check slave address, function code and length of a valid frame against the
+ * answer of a request. Write single coil and register answers echo the request. */
+static bool eMB_SIM_ReplayIsAnswer(const eMB_CaptureRecordStruct *request, const uint8_t *data, uint32_t length)
+{
+  bool isAnswer;
+
+  if ((request->data[0] != data[0]) || ((request->data[1] & 0x7FU) != (data[1] & 0x7FU)))
+  {
+    return false;
+  }
+
+  if ((data[1] & 0x80U) != 0U)
+  {
+    return (length == 5UL);
+  }
+
+  switch (data[1])
+  {
+    case eMB_FUNC_READ_COILS:
+    case eMB_FUNC_READ_DISCRETE_INPUTS:
+    case eMB_FUNC_READ_HOLDING_REGISTER:
+    case eMB_FUNC_READ_INPUT_REGISTER:
+    case eMB_FUNC_READWRITE_MULTIPLE_REGISTERS:
+      isAnswer = (length == (5UL + data[2]));
+      break;
+    case eMB_FUNC_WRITE_SINGLE_COIL:
+    case eMB_FUNC_WRITE_REGISTER:
+    case eMB_FUNC_WRITE_MULTIPLE_COILS:
+    case eMB_FUNC_WRITE_MULTIPLE_REGISTERS:
+      isAnswer = (length == 8UL);
+      break;
+    default:
+      isAnswer = true;
+      break;
+  }
+
+  return isAnswer;
+}
+
+/* Read in the byte order of the file, positions are checked by the caller. */
+static uint32_t eMB_SIM_ReplayRead32(const eMB_SIM_ReplayFileStruct *file, uint32_t pos)
+{
+  const uint8_t *p = &file->buf[pos];
+
+  if (file->isSwapped == true)
+  {
+    return ((uint32_t)p[0] << 24U) | ((uint32_t)p[1] << 16U) | ((uint32_t)p[2] << 8U) | (uint32_t)p[3];
+  }
+
+  return ((uint32_t)p[3] << 24U) | ((uint32_t)p[2] << 16U) | ((uint32_t)p[1] << 8U) | (uint32_t)p[0];
+}
+
+static uint16_t eMB_SIM_ReplayRead16(const eMB_SIM_ReplayFileStruct *file, uint32_t pos)
+{
+  const uint8_t *p = &file->buf[pos];
+
+  if (file->isSwapped == true)
+  {
+    return (uint16_t)(((uint16_t)p[0] << 8U) | (uint16_t)p[1]);
+  }
+
+  return (uint16_t)(((uint16_t)p[1] << 8U) | (uint16_t)p[0]);
+}
+
+/* Timestamp in 10^-tsResol s to us. */
+static uint64_t eMB_SIM_ReplayToUs(uint64_t ts, uint8_t tsResol)
+{
+  for (; tsResol > 6U; tsResol--)
+  {
+    ts /= 10ULL;
+  }
+
+  for (; tsResol < 6U; tsResol++)
+  {
+    ts *= 10ULL;
+  }
+
+  return ts;
+}
+
+/* Read a line without its line end, longer lines are cut. */
+static bool eMB_SIM_ReplayReadLine(FILE *in, char *line)
+{
+  size_t length;
+  int c;
+
+  if (fgets(line, (int)eMB_SIM_REPLAY_LINE_SIZE, in) == NULL)
+  {
+    return false;
+  }
+
+  length = strlen(line);
+
+  if ((length != 0U) && (line[length - 1U] != '\n'))
+  {
+    do
+    {
+      c = fgetc(in);
+    } while ((c != '\n') && (c != EOF));
+  }
+
+  while ((length != 0U) && ((line[length - 1U] == '\n') || (line[length - 1U] == '\r')))
+  {
+    line[--length] = '\0';
+  }
+
+  return true;
+}
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
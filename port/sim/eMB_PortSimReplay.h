@@ -0,0 +1,153 @@
+/*
+ * File:   eMB_PortSimReplay.h
+ * Author: Long
+ *
+ * Replay of captured traffic through the master on the simulated line
+ * (eMB_PortSim.h). The input is a list of frames, taken from the capture ring
+ * with eMB_Capture_Read() or loaded with eMB_SIM_ReplayLoad() from a pcapng
+ * file of eMB_Capture_Export*() or a pcap file. Every request of the master
+ * is issued again with the eMB_Master_Request* function of its function code
+ * (other function codes are put into the send buffer as they were captured)
+ * and the frames which followed it on the line are fed into the receiver.
+ * No virtual slaves answer.
+ *
+ * eMB_SIM_REPLAY_ORIGINAL keeps the time between the requests and the
+ * turnaround of the answers of the capture, so timeouts and late answers
+ * happen as they did. eMB_SIM_REPLAY_FAST issues a request as soon as the
+ * previous one completed and lets the answer follow it at once. Both run on
+ * the virtual clock and never wait for real time.
+ *
+ * A run writes one line per request, the shadow blocks and a summary:
+ *
+ *   trans 12 3 3 SRX 9378        index, slave, function code, events, latency in us
+ *   trans 13 9 16 !2 0           refused by the master with eMB_EINVAL
+ *   shadow 3 3 1 4f2a            slave, table (eMB_RegType), status, CRC of the block
+ *   summary 5000 1 12 81234567 81900000 46000000 46878000 9800
+ *
+ * The events are the ones eMB_MainFunction() took: S frame sent, R frame
+ * received, X executed, T respond timeout, D receive data error, F execute
+ * function error, with ~ in front if the request frame differs from the
+ * captured one. The latency is the virtual time from issuing the request to
+ * its completion. The summary holds requests, refused requests, failed
+ * requests, CPU and wall time of the replay in ns, virtual time in us and
+ * the sum and maximum of the latencies in us.
+ *
+ * Keep the output of the baseline build and check a changed build against it
+ * with eMB_SIM_ReplayCompare(): events and shadow must be equal, CPU time and
+ * latency are reported as a change. port/sim/main/eMB_SimReplayMain.c does
+ * both from the command line.
+ *
+ * Created on October 20, 2026, 02:40 AM
+ */
+
+#ifndef EMB_PORTSIMREPLAY_H
+#define EMB_PORTSIMREPLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <stdio.h>
+
+#include "eMB_PortSim.h"
+#include "eMB_Capture.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \brief Timing of a replay. */
+typedef enum _eMB_SIM_ReplayModeType
+{
+  eMB_SIM_REPLAY_ORIGINAL,                        /*!< Gaps and turnarounds of the capture. */
+  eMB_SIM_REPLAY_FAST                             /*!< No idle time between and inside the transactions. */
+} eMB_SIM_ReplayModeType;
+
+/*! \brief Result of a replay. */
+typedef struct _eMB_SIM_ReplayResultStruct
+{
+  uint32_t                    transNum;           /*!< Requests of the capture. */
+  uint32_t                    refusedNum;         /*!< Requests refused by the master. */
+  uint32_t                    errorNum;           /*!< Requests which ended with an error event. */
+  uint32_t                    differNum;          /*!< Request frames which differ from the capture. */
+  uint64_t                    cpuNs;              /*!< CPU time of the process. */
+  uint64_t                    wallNs;             /*!< Monotonic time. */
+  uint64_t                    lineUs;             /*!< Virtual time of the line. */
+  uint64_t                    latencySumUs;       /*!< Sum of the latencies. */
+  uint32_t                    latencyMaxUs;       /*!< Largest latency. */
+} eMB_SIM_ReplayResultStruct;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \brief Load the frames of a pcapng or pcap file.
+ *
+ * Interfaces with another link type than USER0 - USER15 are skipped. Without
+ * the direction of epb_flags (pcap files, sniffers) a frame is taken as the
+ * answer of the request before it if it is damaged or laid out like that answer.
+ * Length and CRC are checked like eMB_Capture_Read() does.
+ *
+ * \param buf       content of the file
+ * \param size      size of the file
+ * \param records   buffer for the frames
+ * \param maxNum    size of the buffer in frames
+ * \param recordNum frames loaded
+ *
+ * \return eMB_ENOERR on success, eMB_EINVAL if the file is no pcapng or pcap
+ *    file, eMB_EIO if it is truncated, eMB_ENORES if it has more than maxNum frames.
+ */
+eMB_ErrorCodeType eMB_SIM_ReplayLoad(const uint8_t *buf, uint32_t size, eMB_CaptureRecordStruct *records,
+                                     uint32_t maxNum, uint32_t *recordNum);
+
+/*! \brief Replay the frames, sets up the line and calls eMB_Init() itself.
+ *
+ * \param records   frames in the order of the capture
+ * \param recordNum number of frames
+ * \param baudrate  baud rate of the captured line
+ * \param mode      timing of the replay
+ * \param out       stream for the output, NULL for none
+ * \param result    result of the replay, NULL for none
+ *
+ * \return eMB_ENOERR on success, else the error of the setup.
+ */
+eMB_ErrorCodeType eMB_SIM_ReplayRun(const eMB_CaptureRecordStruct *records, uint32_t recordNum, uint32_t baudrate,
+                                    eMB_SIM_ReplayModeType mode, FILE *out, eMB_SIM_ReplayResultStruct *result);
+
+/*! \brief Compare the output of a replay with a baseline and write the report as JSON:
+ *
+ *   { "transNum": [5000, 5000], "diffNum": 1,
+ *     "cpuNsPerTrans": [16246, 15102], "wallNsPerTrans": [16380, 15230],
+ *     "latencyUsMean": [9378, 9378], "latencyUsMax": [9800, 9800],
+ *     "diffs": [ { "baseline": "trans 12 3 3 SRX 9378",
+ *                  "current": "trans 12 3 3 SRD 9378" } ] }
+ *
+ * \param baseline  output of the baseline
+ * \param current   output of the replay to check
+ * \param report    stream for the report, NULL for none
+ *
+ * \return eMB_ENOERR if events and shadow are equal, eMB_EIO if they differ,
+ *    eMB_EINVAL if a stream is NULL or has no summary.
+ */
+eMB_ErrorCodeType eMB_SIM_ReplayCompare(FILE *baseline, FILE *current, FILE *report);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_PORTSIMREPLAY_H */
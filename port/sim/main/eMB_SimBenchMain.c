@@ -0,0 +1,97 @@
+/*
+ * File:   eMB_SimBenchMain.c
+ * Author: Long
+ *
+ * Runs the transaction benchmark of eMB_PortSimBench.h and prints the JSON to stdout:
+ *
+ *   gcc -std=c99 -O2 -D_DEFAULT_SOURCE -Imodbus/include -Imodbus/rtu -Imodbus/tcp \
+ *       -Iport -Iport/sim port/sim/main/eMB_SimBenchMain.c port/sim/\*.c \
+ *       modbus/src/\*.c modbus/rtu/\*.c -lm -o bench
+ *   ./bench [transNum [budgetNs [baudrate]]]
+ *
+ * The defaults are 10000 transactions per case, no budget and 115200 baud. The
+ * exit code is 0 if all cases completed within the budget, so a CI job can
+ * fail on a regression of the CPU time per transaction.
+ *
+ * Created on October 20, 2026, 07:25 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "eMB_PortSimBench.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#define eMB_SIM_BENCH_MAIN_TRANS_NUM              ( 10000UL )
+#define eMB_SIM_BENCH_MAIN_BUDGET_NS              ( 0UL )
+#define eMB_SIM_BENCH_MAIN_BAUDRATE               ( 115200UL )
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+int main(int argc, char *argv[])
+{
+  eMB_ErrorCodeType errStatus;
+  uint32_t transNum = eMB_SIM_BENCH_MAIN_TRANS_NUM;
+  uint32_t budgetNs = eMB_SIM_BENCH_MAIN_BUDGET_NS;
+  uint32_t baudrate = eMB_SIM_BENCH_MAIN_BAUDRATE;
+
+  if (argc > 1)
+  {
+    transNum = (uint32_t)strtoul(argv[1], NULL, 0);
+  }
+
+  if (argc > 2)
+  {
+    budgetNs = (uint32_t)strtoul(argv[2], NULL, 0);
+  }
+
+  if (argc > 3)
+  {
+    baudrate = (uint32_t)strtoul(argv[3], NULL, 0);
+  }
+
+  errStatus = eMB_SIM_BenchRun(baudrate, transNum, budgetNs, stdout);
+
+  if (errStatus == eMB_ETIMEDOUT)
+  {
+    (void)fprintf(stderr, "benchmark over the budget of %lu ns per transaction\n", (unsigned long)budgetNs);
+  }
+  else if (errStatus != eMB_ENOERR)
+  {
+    (void)fprintf(stderr, "benchmark failed: error %d\n", (int)errStatus);
+  }
+  else
+  {
+    /* All cases within the budget. */
+  }
+
+  return (errStatus == eMB_ENOERR) ? 0 : 1;
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+/*
+ * File:   eMB_SimBenchMicroMain.c
+ * Author: Long
+ *
+ * Runs the micro benchmarks of eMB_PortSimBench.h and prints the JSON to stdout:
+ *
+ *   gcc -std=c99 -O2 -D_DEFAULT_SOURCE -Imodbus/include -Imodbus/rtu -Imodbus/tcp \
+ *       -Iport -Iport/sim port/sim/main/eMB_SimBenchMicroMain.c port/sim/\*.c \
+ *       modbus/src/\*.c modbus/rtu/\*.c -lm -o bench_micro
+ *   ./bench_micro [repeatNum]
+ *
+ * repeatNum is the number of calls per kernel and size, 1000 if not given. The
+ * exit code is 0 if all kernels ran.
+ *
+ * Created on October 20, 2026, 07:05 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "eMB_PortSimBench.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#define eMB_SIM_BENCH_MICRO_REPEAT_NUM            ( 1000UL )
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+int main(int argc, char *argv[])
+{
+  eMB_ErrorCodeType errStatus;
+  uint32_t repeatNum = eMB_SIM_BENCH_MICRO_REPEAT_NUM;
+
+  if (argc > 1)
+  {
+    repeatNum = (uint32_t)strtoul(argv[1], NULL, 0);
+  }
+
+  errStatus = eMB_SIM_BenchMicroRun(repeatNum, stdout);
+
+  if (errStatus != eMB_ENOERR)
+  {
+    (void)fprintf(stderr, "micro benchmark failed: error %d\n", (int)errStatus);
+  }
+
+  return (errStatus == eMB_ENOERR) ? 0 : 1;
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
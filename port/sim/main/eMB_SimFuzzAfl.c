@@ -0,0 +1,77 @@
+/*
+ * File:   eMB_SimFuzzAfl.c
+ * Author: Long
+ *
+ * AFL entry point of the fuzz targets of eMB_PortSimFuzz.h. The input is read
+ * from stdin, the target is chosen when building, eMB_SIM_FuzzRTU() if
+ * eMB_SIM_FUZZ_TARGET is not given:
+ *
+ *   afl-clang-fast -std=c99 -g -D_DEFAULT_SOURCE -DeMB_SIM_FUZZ_TARGET=eMB_SIM_FuzzRTU \
+ *         -Imodbus/include -Imodbus/rtu -Imodbus/tcp -Iport -Iport/sim \
+ *         port/sim/main/eMB_SimFuzzAfl.c port/sim/\*.c modbus/src/\*.c \
+ *         modbus/rtu/\*.c -lm -o fuzz_rtu
+ *   afl-fuzz -i seeds -o findings -- ./fuzz_rtu
+ *
+ * The same binary replays a crash found by either fuzzer: ./fuzz_rtu < crash
+ *
+ * Created on October 20, 2026, 05:45 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <stdio.h>
+
+#include "eMB_PortSimFuzz.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifndef eMB_SIM_FUZZ_TARGET
+#define eMB_SIM_FUZZ_TARGET                       eMB_SIM_FuzzRTU
+#endif
+
+/* Longest input, the rest of stdin is ignored */
+#define eMB_SIM_FUZZ_INPUT_SIZE_MAX               ( 65536U )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static uint8_t eMB_SIM_FuzzInput[eMB_SIM_FUZZ_INPUT_SIZE_MAX];
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+int main(void)
+{
+  size_t size;
+
+  size = fread(eMB_SIM_FuzzInput, 1U, sizeof(eMB_SIM_FuzzInput), stdin);
+
+  return eMB_SIM_FUZZ_TARGET(eMB_SIM_FuzzInput, size);
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
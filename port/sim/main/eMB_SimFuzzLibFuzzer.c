@@ -0,0 +1,66 @@
+/*
+ * File:   eMB_SimFuzzLibFuzzer.c
+ * Author: Long
+ *
+ * libFuzzer entry point of the fuzz targets of eMB_PortSimFuzz.h. The target is
+ * chosen when building, eMB_SIM_FuzzRTU() if eMB_SIM_FUZZ_TARGET is not given:
+ *
+ *   clang -std=c99 -g -fsanitize=fuzzer,address,undefined -D_DEFAULT_SOURCE \
+ *         -DeMB_SIM_FUZZ_TARGET=eMB_SIM_FuzzHandler \
+ *         -Imodbus/include -Imodbus/rtu -Imodbus/tcp -Iport -Iport/sim \
+ *         port/sim/main/eMB_SimFuzzLibFuzzer.c port/sim/\*.c modbus/src/\*.c \
+ *         modbus/rtu/\*.c -lm -o fuzz_handler
+ *   ./fuzz_handler corpus/
+ *
+ * Created on October 20, 2026, 05:45 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_PortSimFuzz.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#ifndef eMB_SIM_FUZZ_TARGET
+#define eMB_SIM_FUZZ_TARGET                       eMB_SIM_FuzzRTU
+#endif
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  return eMB_SIM_FUZZ_TARGET(data, size);
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,229 @@
+/*
+ * File:   eMB_SimReplayMain.c
+ * Author: Long
+ *
+ * Replays a pcapng or pcap file through the master of eMB_PortSimReplay.h:
+ *
+ *   gcc -std=c99 -O2 -D_DEFAULT_SOURCE -DeMB_MASTER_RTU_CAPTURE_ENABLED -Imodbus/include \
+ *       -Imodbus/rtu -Imodbus/tcp -Iport -Iport/sim port/sim/main/eMB_SimReplayMain.c \
+ *       port/sim/\*.c modbus/src/\*.c modbus/rtu/\*.c -lm -o replay
+ *   ./replay file [original|fast [baudrate [baseline]]]
+ *
+ * Without a baseline the output of the replay goes to stdout, keep it as the
+ * baseline of later builds. With a baseline the output is compared against
+ * it and the JSON report of eMB_SIM_ReplayCompare() goes to stdout. The
+ * defaults are the original timing and 115200 baud. The exit code is 0 if the
+ * replay ran and its events and shadow equal the baseline.
+ *
+ * Created on October 20, 2026, 11:55 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eMB_PortSimReplay.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+#define eMB_SIM_REPLAY_MAIN_BAUDRATE              ( 115200UL )
+
+/* Largest file and number of frames */
+#define eMB_SIM_REPLAY_MAIN_FILE_SIZE_MAX         ( 64UL * 1024UL * 1024UL )
+#define eMB_SIM_REPLAY_MAIN_RECORD_MAX            ( 64UL * 1024UL )
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static uint8_t *eMB_SIM_ReplayMainReadFile(const char *name, uint32_t *size);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+int main(int argc, char *argv[])
+{
+  eMB_ErrorCodeType errStatus = eMB_ENOERR;
+  eMB_SIM_ReplayModeType mode = eMB_SIM_REPLAY_ORIGINAL;
+  eMB_CaptureRecordStruct *records;
+  uint32_t baudrate = eMB_SIM_REPLAY_MAIN_BAUDRATE;
+  uint32_t recordNum = 0UL;
+  uint32_t size = 0UL;
+  uint8_t *buf;
+  FILE    *baseline = NULL;
+  FILE    *out = stdout;
+
+  if (argc < 2)
+  {
+    (void)fprintf(stderr, "usage: %s file [original|fast [baudrate [baseline]]]\n", argv[0]);
+    return 1;
+  }
+
+  if (argc > 2)
+  {
+    if (strcmp(argv[2], "fast") == 0)
+    {
+      mode = eMB_SIM_REPLAY_FAST;
+    }
+    else if (strcmp(argv[2], "original") != 0)
+    {
+      (void)fprintf(stderr, "unknown mode %s\n", argv[2]);
+      return 1;
+    }
+    else
+    {
+      /* Original timing. */
+    }
+  }
+
+  if (argc > 3)
+  {
+    baudrate = (uint32_t)strtoul(argv[3], NULL, 0);
+  }
+
+  if (argc > 4)
+  {
+    /* The output is kept for the compare. */
+    baseline = fopen(argv[4], "r");
+    out      = tmpfile();
+
+    if ((baseline == NULL) || (out == NULL))
+    {
+      (void)fprintf(stderr, "cannot open %s\n", argv[4]);
+
+      if (baseline != NULL)
+      {
+        (void)fclose(baseline);
+      }
+
+      return 1;
+    }
+  }
+
+  buf     = eMB_SIM_ReplayMainReadFile(argv[1], &size);
+  records = (eMB_CaptureRecordStruct*)malloc(eMB_SIM_REPLAY_MAIN_RECORD_MAX * sizeof(eMB_CaptureRecordStruct));
+
+  if ((buf == NULL) || (records == NULL))
+  {
+    errStatus = eMB_EIO;
+    (void)fprintf(stderr, "cannot read %s\n", argv[1]);
+  }
+  else
+  {
+    errStatus = eMB_SIM_ReplayLoad(buf, size, records, eMB_SIM_REPLAY_MAIN_RECORD_MAX, &recordNum);
+
+    if (errStatus != eMB_ENOERR)
+    {
+      (void)fprintf(stderr, "cannot load %s: error %d\n", argv[1], (int)errStatus);
+    }
+  }
+
+  if (errStatus == eMB_ENOERR)
+  {
+    errStatus = eMB_SIM_ReplayRun(records, recordNum, baudrate, mode, out, NULL);
+
+    if (errStatus != eMB_ENOERR)
+    {
+      (void)fprintf(stderr, "replay failed: error %d\n", (int)errStatus);
+    }
+  }
+
+  if ((errStatus == eMB_ENOERR) && (baseline != NULL))
+  {
+    rewind(out);
+    errStatus = eMB_SIM_ReplayCompare(baseline, out, stdout);
+
+    if (errStatus == eMB_EIO)
+    {
+      (void)fprintf(stderr, "replay differs from the baseline %s\n", argv[4]);
+    }
+    else if (errStatus != eMB_ENOERR)
+    {
+      (void)fprintf(stderr, "baseline %s has no summary\n", argv[4]);
+    }
+    else
+    {
+      /* Same events and shadow. */
+    }
+  }
+
+  if (baseline != NULL)
+  {
+    (void)fclose(baseline);
+    (void)fclose(out);
+  }
+
+  free(records);
+  free(buf);
+
+  return (errStatus == eMB_ENOERR) ? 0 : 1;
+}
+
+
+
+
+
+/* Read the whole file into a buffer of malloc(). */
+static uint8_t *eMB_SIM_ReplayMainReadFile(const char *name, uint32_t *size)
+{
+  uint8_t *buf;
+  FILE    *in;
+  long     length;
+
+  in = fopen(name, "rb");
+
+  if (in == NULL)
+  {
+    return NULL;
+  }
+
+  if ((fseek(in, 0L, SEEK_END) != 0) || ((length = ftell(in)) < 0L) ||
+      ((unsigned long)length > eMB_SIM_REPLAY_MAIN_FILE_SIZE_MAX) || (fseek(in, 0L, SEEK_SET) != 0))
+  {
+    (void)fclose(in);
+    return NULL;
+  }
+
+  /* One byte more, so an empty file gets a buffer too. */
+  buf = (uint8_t*)malloc((size_t)length + 1U);
+
+  if ((buf != NULL) && (fread(buf, 1U, (size_t)length, in) != (size_t)length))
+  {
+    free(buf);
+    buf = NULL;
+  }
+
+  (void)fclose(in);
+
+  *size = (uint32_t)length;
+
+  return buf;
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
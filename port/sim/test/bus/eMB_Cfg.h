@@ -0,0 +1,17 @@
+/*
+ * File:   eMB_Cfg.h
+ * Author: Long
+ *
+ * Configuration of the bus test suite: the line utilisation of eMB_Bus.h.
+ *
+ * Created on October 20, 2026, 11:20 PM
+ */
+
+#ifndef EMB_SIMTEST_BUS_CFG_H
+#define EMB_SIMTEST_BUS_CFG_H
+
+#define eMB_RTU_BUS_ENABLED
+
+#include "../../../eMB_Cfg.h"
+
+#endif /* EMB_SIMTEST_BUS_CFG_H */
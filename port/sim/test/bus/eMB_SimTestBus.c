@@ -0,0 +1,121 @@
+/*
+ * File:   eMB_SimTestBus.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 11:20 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_SimTest.h"
+#include "eMB_Bus.h"
+#include "eMB_RTU.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Window of the test, beyond the 71 minutes of a 32 bit microsecond clock */
+#define eMB_SIM_TEST_BUS_WINDOW_S                 ( 75UL * 60UL )
+
+/* One read of ten holding registers per second: 8 request and 25 response bytes */
+#define eMB_SIM_TEST_BUS_REG_NUM                  ( 10U )
+#define eMB_SIM_TEST_BUS_TX_BYTES                 ( 8UL )
+#define eMB_SIM_TEST_BUS_RX_BYTES                 ( 25UL )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static uint16_t eMB_SIM_TestBusHoldingBuf[16];
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_TestBusLongWindow(void);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+/* Times and utilisation of a window of 75 minutes are not wrapped. */
+static void eMB_SIM_TestBusLongWindow(void)
+{
+  eMB_SIM_SlaveStruct slave;
+  eMB_BusStatsStruct stats;
+  uint64_t startUs;
+  uint64_t busyUs;
+  uint32_t i;
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetup(9600UL, 11U, 1UL) == eMB_ENOERR);
+
+  memset(&slave, 0, sizeof(slave));
+  slave.holdingBuf = eMB_SIM_TestBusHoldingBuf;
+  slave.holdingNum = (uint16_t)(sizeof(eMB_SIM_TestBusHoldingBuf) / sizeof(uint16_t));
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetSlave(1U, &slave) == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Init(&eMB_SIM_Config) == eMB_ENOERR);
+  (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+  eMB_SIM_TEST_CHECK(eMB_Enable() == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_TEST_CHECK(eMB_Bus_GetStats(&stats, true) == eMB_ENOERR);
+  startUs = eMB_SIM_PortGetTimeUs();
+
+  for (i = 0UL; i < eMB_SIM_TEST_BUS_WINDOW_S; i++)
+  {
+    eMB_SIM_TEST_CHECK(eMB_Master_RequestReadHoldingRegister(1U, 0U, eMB_SIM_TEST_BUS_REG_NUM) == eMB_ENOERR);
+    eMB_SIM_PortRunUntilIdle();
+    eMB_SIM_PortRunFor(1000000UL);
+  }
+
+  eMB_SIM_TEST_CHECK(eMB_Bus_GetStats(&stats, false) == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(stats.elapsedUs > (uint64_t)UINT32_MAX);
+  eMB_SIM_TEST_CHECK(stats.elapsedUs == (eMB_SIM_PortGetTimeUs() - startUs));
+  eMB_SIM_TEST_CHECK(stats.txBytes == eMB_SIM_TEST_BUS_WINDOW_S * eMB_SIM_TEST_BUS_TX_BYTES);
+  eMB_SIM_TEST_CHECK(stats.rxBytes == eMB_SIM_TEST_BUS_WINDOW_S * eMB_SIM_TEST_BUS_RX_BYTES);
+  eMB_SIM_TEST_CHECK(stats.txUs == (uint64_t)stats.txBytes * eMB_RTU_GetCharTime());
+
+  busyUs = stats.txUs + stats.rxUs + stats.gapUs + stats.waitUs;
+
+  eMB_SIM_TEST_CHECK(busyUs < stats.elapsedUs);
+  eMB_SIM_TEST_CHECK((busyUs + stats.idleUs) == stats.elapsedUs);
+  eMB_SIM_TEST_CHECK(stats.usePermille == (uint16_t)((busyUs * 1000ULL) / stats.elapsedUs));
+}
+
+
+
+/* Tests of the suite, run in this order by eMB_SimTest.c */
+const eMB_SIM_TestCaseStruct eMB_SIM_TestSuite[] =
+{
+  { "bus: a window longer than the 32 bit microsecond clock", eMB_SIM_TestBusLongWindow },
+};
+
+const uint16_t eMB_SIM_TestSuiteNum = (uint16_t)(sizeof(eMB_SIM_TestSuite) / sizeof(eMB_SIM_TestSuite[0]));
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+/*
+ * File:   eMB_Cfg.h
+ * Author: Long
+ *
+ * Configuration of the capture test suite: the master of port/eMB_Cfg.h with
+ * the capture of the frames.
+ *
+ * Created on October 20, 2026, 05:20 AM
+ */
+
+#ifndef EMB_SIMTEST_CAPTURE_CFG_H
+#define EMB_SIMTEST_CAPTURE_CFG_H
+
+#define eMB_MASTER_RTU_CAPTURE_ENABLED
+
+#include "../../../eMB_Cfg.h"
+
+#endif /* EMB_SIMTEST_CAPTURE_CFG_H */
@@ -0,0 +1,164 @@
+/*
+ * File:   eMB_SimTestCapture.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 05:20 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_SimTest.h"
+#include "eMB_Capture.h"
+#include "eMB_CRC.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Packets of the test: request, response, gap, too short, CRC and too long */
+#define eMB_SIM_TEST_CAPTURE_PACKET_NUM           ( 6U )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static uint16_t eMB_SIM_TestCaptureHoldingBuf[4];
+
+static uint8_t  eMB_SIM_TestCaptureExportBuf[eMB_SIM_TEST_CAPTURE_PACKET_NUM * eMB_CAPTURE_PCAPNG_BLOCK_SIZE_MAX];
+
+/* epb_flags the packets must have, the values of the pcapng specification */
+static const uint32_t eMB_SIM_TestCaptureFlagsExpected[eMB_SIM_TEST_CAPTURE_PACKET_NUM] =
+{
+  0x00000002UL,                                   /* outbound */
+  0x00000001UL,                                   /* inbound */
+  0x08000001UL,                                   /* inbound, wrong inter-frame gap */
+  0x04000001UL,                                   /* inbound, packet too short */
+  0x01000001UL,                                   /* inbound, CRC error */
+  0x02000001UL,                                   /* inbound, packet too long */
+};
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_TestCaptureEpbFlags(void);
+
+static uint32_t eMB_SIM_TestCaptureRead32(const uint8_t *buf);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+/* The error bits of the exported packets are the ones Wireshark shows. */
+static void eMB_SIM_TestCaptureEpbFlags(void)
+{
+  eMB_SIM_SlaveStruct slave;
+  uint8_t  frame[eMB_SDU_SIZE_MAX + 1U];
+  uint16_t crc;
+  uint16_t dataLen;
+  uint16_t size;
+  uint16_t pos = (uint16_t)0U;
+  uint16_t i;
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetup(115200UL, 11U, 1UL) == eMB_ENOERR);
+
+  memset(&slave, 0, sizeof(slave));
+  slave.holdingBuf = eMB_SIM_TestCaptureHoldingBuf;
+  slave.holdingNum = (uint16_t)(sizeof(eMB_SIM_TestCaptureHoldingBuf) / sizeof(uint16_t));
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetSlave(1U, &slave) == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Init(&eMB_SIM_Config) == eMB_ENOERR);
+  (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+  eMB_SIM_TEST_CHECK(eMB_Enable() == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+
+  /* A valid request and response on the line. */
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadHoldingRegister(1U, 0U, 2U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+
+  /* A valid frame with a gap, one too short and one with a wrong CRC. */
+  frame[0] = 1U;
+  frame[1] = (uint8_t)eMB_FUNC_READ_HOLDING_REGISTER;
+  frame[2] = 2U;
+  frame[3] = 0x12U;
+  frame[4] = 0x34U;
+  crc = eMB_GetCRC(frame, 5U);
+  frame[5] = (uint8_t)(crc & 0xFFU);
+  frame[6] = (uint8_t)(crc >> 8U);
+
+  eMB_Capture_Put(frame, 7U, (uint8_t)eMB_CAPTURE_FLAG_GAP);
+  eMB_Capture_Put(frame, 2U, 0U);
+  frame[4] ^= 0x01U;
+  eMB_Capture_Put(frame, 7U, 0U);
+
+  /* A frame which is one byte too long, the kept part has a valid CRC. */
+  memset(frame, 0x55, sizeof(frame));
+  crc = eMB_GetCRC(frame, (uint16_t)(eMB_SDU_SIZE_MAX - 2U));
+  frame[eMB_SDU_SIZE_MAX - 2U] = (uint8_t)(crc & 0xFFU);
+  frame[eMB_SDU_SIZE_MAX - 1U] = (uint8_t)(crc >> 8U);
+  eMB_Capture_Put(frame, (uint16_t)(eMB_SDU_SIZE_MAX + 1U), 0U);
+
+  size = eMB_Capture_ExportRecords(eMB_SIM_TestCaptureExportBuf, (uint16_t)sizeof(eMB_SIM_TestCaptureExportBuf));
+
+  /* Walk the enhanced packet blocks, the epb_flags option follows the data. */
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_SIM_TEST_CAPTURE_PACKET_NUM; i++)
+  {
+    eMB_SIM_TEST_CHECK((uint16_t)(pos + 28U) <= size);
+    eMB_SIM_TEST_CHECK(eMB_SIM_TestCaptureRead32(&eMB_SIM_TestCaptureExportBuf[pos]) == eMB_PCAPNG_BLOCK_EPB);
+
+    dataLen = (uint16_t)((eMB_SIM_TestCaptureRead32(&eMB_SIM_TestCaptureExportBuf[pos + 20U]) + 3UL) & ~3UL);
+    eMB_SIM_TEST_CHECK(eMB_SIM_TestCaptureRead32(&eMB_SIM_TestCaptureExportBuf[pos + 28U + dataLen]) ==
+                       ((4UL << 16U) | eMB_PCAPNG_OPT_EPB_FLAGS));
+    eMB_SIM_TEST_CHECK(eMB_SIM_TestCaptureRead32(&eMB_SIM_TestCaptureExportBuf[pos + 32U + dataLen]) ==
+                       eMB_SIM_TestCaptureFlagsExpected[i]);
+
+    pos = (uint16_t)(pos + eMB_SIM_TestCaptureRead32(&eMB_SIM_TestCaptureExportBuf[pos + 4U]));
+  }
+
+  eMB_SIM_TEST_CHECK(pos == size);
+}
+
+
+
+
+
+/* Read little endian, the byte order of the export. */
+static uint32_t eMB_SIM_TestCaptureRead32(const uint8_t *buf)
+{
+  return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8U) | ((uint32_t)buf[2] << 16U) | ((uint32_t)buf[3] << 24U);
+}
+
+
+
+/* Tests of the suite, run in this order by eMB_SimTest.c */
+const eMB_SIM_TestCaseStruct eMB_SIM_TestSuite[] =
+{
+  { "capture: epb_flags of the exported packets", eMB_SIM_TestCaptureEpbFlags },
+};
+
+const uint16_t eMB_SIM_TestSuiteNum = (uint16_t)(sizeof(eMB_SIM_TestSuite) / sizeof(eMB_SIM_TestSuite[0]));
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+/*
+ * File:   eMB_SimTest.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 03:10 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include <stdio.h>
+
+#include "eMB_SimTest.h"
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* Failed checks of the running test */
+static uint32_t eMB_SIM_TestFailNum;
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+int main(void)
+{
+  uint32_t failedNum = 0UL;
+  uint16_t i;
+
+  for (i = (uint16_t)0U; i < eMB_SIM_TestSuiteNum; i++)
+  {
+    eMB_SIM_TestFailNum = 0UL;
+    eMB_SIM_TestSuite[i].run();
+
+    (void)printf("%s %s\n", (eMB_SIM_TestFailNum == 0UL) ? "ok  " : "FAIL", eMB_SIM_TestSuite[i].name);
+
+    if (eMB_SIM_TestFailNum != 0UL)
+    {
+      failedNum++;
+    }
+  }
+
+  (void)printf("%lu of %u tests failed\n", (unsigned long)failedNum, (unsigned)eMB_SIM_TestSuiteNum);
+
+  return (failedNum == 0UL) ? 0 : 1;
+}
+
+void eMB_SIM_TestFail(const char *file, int line, const char *expr)
+{
+  eMB_SIM_TestFailNum++;
+
+  (void)printf("  %s:%d: check failed: %s\n", file, line, expr);
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
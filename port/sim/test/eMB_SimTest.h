@@ -0,0 +1,88 @@
+/*
+ * File:   eMB_SimTest.h
+ * Author: Long
+ *
+ * Host tests of the stack on the simulated line (eMB_PortSim.h). The tests are
+ * grouped in suites, one directory per suite with the eMB_Cfg.h it is built
+ * with. The eMB_Cfg.h of a suite defines its switches and includes the one of
+ * port/, so put the suite directory first on the include path:
+ *
+ *   gcc -std=c99 -fsanitize=address,undefined -Iport/sim/test/master -Iport/sim/test \
+ *       -Imodbus/include -Imodbus/rtu -Imodbus/tcp -Iport -Iport/sim \
+ *       port/sim/test/eMB_SimTest.c port/sim/test/master/\*.c \
+ *       port/sim/\*.c modbus/src/\*.c modbus/rtu/\*.c -lm -o simtest_master
+ *
+ * A suite lists its tests in eMB_SIM_TestSuite at the bottom of its test file.
+ * The runner prints one line per test and exits with 1 if a check failed.
+ *
+ * Created on October 20, 2026, 03:10 AM
+ */
+
+#ifndef EMB_SIMTEST_H
+#define EMB_SIMTEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_PortSim.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/*! \brief Fail the running test and leave it if cond is false. */
+#define eMB_SIM_TEST_CHECK(cond)                                                                  \
+  do                                                                                              \
+  {                                                                                               \
+    if (!(cond))                                                                                  \
+    {                                                                                             \
+      eMB_SIM_TestFail(__FILE__, __LINE__, #cond);                                                \
+      return;                                                                                     \
+    }                                                                                             \
+  } while (0)
+
+/*! \brief Test of a suite. */
+typedef struct _eMB_SIM_TestCaseStruct
+{
+  const char                 *name;
+  void                      (*run)(void);
+} eMB_SIM_TestCaseStruct;
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/*! \brief Tests of the suite, defined by the suite. */
+extern const eMB_SIM_TestCaseStruct eMB_SIM_TestSuite[];
+extern const uint16_t               eMB_SIM_TestSuiteNum;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+/*! \brief Report a failed check of the running test. */
+void eMB_SIM_TestFail(const char *file, int line, const char *expr);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB_SIMTEST_H */
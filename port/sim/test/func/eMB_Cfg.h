@@ -0,0 +1,19 @@
+/*
+ * File:   eMB_Cfg.h
+ * Author: Long
+ *
+ * Configuration of the function test suite: the master of port/eMB_Cfg.h with
+ * room for the largest register requests in the shadow store.
+ *
+ * Created on October 20, 2026, 06:15 AM
+ */
+
+#ifndef EMB_SIMTEST_FUNC_CFG_H
+#define EMB_SIMTEST_FUNC_CFG_H
+
+#include "../../../eMB_Cfg.h"
+
+#undef  eMB_MASTER_REG_HOLDING_NREGS
+#define eMB_MASTER_REG_HOLDING_NREGS                                  (125 )
+
+#endif /* EMB_SIMTEST_FUNC_CFG_H */
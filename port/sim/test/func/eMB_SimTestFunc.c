@@ -0,0 +1,343 @@
+/*
+ * File:   eMB_SimTestFunc.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 06:15 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_SimTest.h"
+#include "eMB_Utils.h"
+#include "eMB_CRC.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Slave of the simulator */
+#define eMB_SIM_TEST_FUNC_SLAVE                   ( 1U )
+
+/* Slave which is answered by the test instead of the simulator */
+#define eMB_SIM_TEST_FUNC_SLAVE_SCRIPT            ( 5U )
+
+/* Silence which lets t3.5 and the respond timeout expire */
+#define eMB_SIM_TEST_FUNC_SILENCE_US              ( 200000UL )
+
+/* Largest number of write registers of the requests 0x10 and 0x17 */
+#define eMB_SIM_TEST_FUNC_WRITE_MUL_REG_MAX       ( 120U )
+#define eMB_SIM_TEST_FUNC_READWRITE_REG_MAX       ( 121U )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* Error events taken by the stack */
+static uint32_t eMB_SIM_TestFuncErrorNum;
+
+static uint16_t eMB_SIM_TestFuncHoldingBuf[eMB_MASTER_REG_HOLDING_NREGS];
+static uint8_t  eMB_SIM_TestFuncCoilBuf[8];
+
+/* Store of the restore test, like a file mapping kept over a restart */
+static eMB_ShadowStruct eMB_SIM_TestFuncShadowMem;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_TestFuncLargestWrite(void);
+static void eMB_SIM_TestFuncWriteLimit(void);
+static void eMB_SIM_TestFuncWriteCoils(void);
+static void eMB_SIM_TestFuncBroadcastRestart(void);
+static void eMB_SIM_TestFuncShortRead(void);
+static void eMB_SIM_TestFuncShadowCrc(void);
+
+static eMB_ErrorCodeType eMB_SIM_TestFuncSetup(void);
+static void eMB_SIM_TestFuncAnswer(const uint8_t *pdu, uint16_t pduLength);
+static void eMB_SIM_TestFuncEventHook(eMB_EventType eEvent);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+/* Address, PDU and CRC of a read / write request with 121 write registers are
+ * 255 bytes, more than the PDU alone. */
+static void eMB_SIM_TestFuncLargestWrite(void)
+{
+  uint16_t holdingData[eMB_SIM_TEST_FUNC_READWRITE_REG_MAX];
+  uint16_t i;
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncSetup() == eMB_ENOERR);
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_SIM_TEST_FUNC_READWRITE_REG_MAX; i++)
+  {
+    holdingData[i] = (uint16_t)(0x0100U + i);
+  }
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadWriteMultipleHoldingRegister(eMB_SIM_TEST_FUNC_SLAVE, 0U, 1U, holdingData,
+                                                                        0U, eMB_SIM_TEST_FUNC_READWRITE_REG_MAX) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncErrorNum == 0UL);
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_SIM_TEST_FUNC_READWRITE_REG_MAX; i++)
+  {
+    eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncHoldingBuf[i] == holdingData[i]);
+  }
+}
+/* A request with more write registers than fit into a PDU is refused and
+ * nothing is sent. */
+static void eMB_SIM_TestFuncWriteLimit(void)
+{
+  uint16_t holdingData[eMB_SIM_TEST_FUNC_READWRITE_REG_MAX + 1U];
+  eMB_SIM_StatsStruct stats;
+
+  memset(holdingData, 0, sizeof(holdingData));
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncSetup() == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestWriteMultipleHoldingRegister(eMB_SIM_TEST_FUNC_SLAVE, 0U,
+                                                                    eMB_SIM_TEST_FUNC_WRITE_MUL_REG_MAX + 1U,
+                                                                    holdingData) == eMB_EINVAL);
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadWriteMultipleHoldingRegister(eMB_SIM_TEST_FUNC_SLAVE, 0U, 1U, holdingData,
+                                                                        0U, eMB_SIM_TEST_FUNC_READWRITE_REG_MAX + 1U) == eMB_EINVAL);
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_PortGetStats(&stats);
+  eMB_SIM_TEST_CHECK(stats.requestNum == 0UL);
+
+  /* The limits themselves are sent. */
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestWriteMultipleHoldingRegister(eMB_SIM_TEST_FUNC_SLAVE, 0U,
+                                                                    eMB_SIM_TEST_FUNC_WRITE_MUL_REG_MAX,
+                                                                    holdingData) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncErrorNum == 0UL);
+}
+/* The response of a write multiple coils request is checked against the byte
+ * count of the request. */
+static void eMB_SIM_TestFuncWriteCoils(void)
+{
+  uint8_t coilData[2] = { 0xA5U, 0x02U };
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncSetup() == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestWriteMultipleCoils(eMB_SIM_TEST_FUNC_SLAVE, 0U, 10U, coilData) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncErrorNum == 0UL);
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncCoilBuf[0] == 0xA5U);
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncCoilBuf[1] == 0x02U);
+}
+/* A broadcast of a previous start must not be taken for the request on the
+ * line after a restart, the response handlers would skip their checks. */
+static void eMB_SIM_TestFuncBroadcastRestart(void)
+{
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncSetup() == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestWriteHoldingRegister(0U, 0U, 0x1234U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+  eMB_SIM_TEST_CHECK(eMB_FrameIsBroadcastCalloutArr() == true);
+
+  eMB_SIM_TEST_CHECK(eMB_Disable() == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncSetup() == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_FrameIsBroadcastCalloutArr() == false);
+}
+/* Responses with the right byte count but one data byte missing are refused
+ * by every read handler instead of reading the CRC as data. */
+static void eMB_SIM_TestFuncShortRead(void)
+{
+  static const uint8_t holdingPdu[]   = { eMB_FUNC_READ_HOLDING_REGISTER, 4U, 0x12U, 0x34U, 0x56U };
+  static const uint8_t inputPdu[]     = { eMB_FUNC_READ_INPUT_REGISTER, 4U, 0x12U, 0x34U, 0x56U };
+  static const uint8_t coilPdu[]      = { eMB_FUNC_READ_COILS, 2U, 0xA5U };
+  static const uint8_t discretePdu[]  = { eMB_FUNC_READ_DISCRETE_INPUTS, 2U, 0xA5U };
+  static const uint8_t readWritePdu[] = { eMB_FUNC_READWRITE_MULTIPLE_REGISTERS, 4U, 0x12U, 0x34U, 0x56U };
+  uint16_t holdingData[1] = { 0x0001U };
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncSetup() == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadHoldingRegister(eMB_SIM_TEST_FUNC_SLAVE_SCRIPT, 0U, 2U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilSent();
+  eMB_SIM_TestFuncAnswer(holdingPdu, (uint16_t)sizeof(holdingPdu));
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncErrorNum == 1UL);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadInputRegister(eMB_SIM_TEST_FUNC_SLAVE_SCRIPT, 0U, 2U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilSent();
+  eMB_SIM_TestFuncAnswer(inputPdu, (uint16_t)sizeof(inputPdu));
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncErrorNum == 2UL);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadCoils(eMB_SIM_TEST_FUNC_SLAVE_SCRIPT, 0U, 16U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilSent();
+  eMB_SIM_TestFuncAnswer(coilPdu, (uint16_t)sizeof(coilPdu));
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncErrorNum == 3UL);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadDiscreteInputs(eMB_SIM_TEST_FUNC_SLAVE_SCRIPT, 0U, 16U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilSent();
+  eMB_SIM_TestFuncAnswer(discretePdu, (uint16_t)sizeof(discretePdu));
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncErrorNum == 4UL);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadWriteMultipleHoldingRegister(eMB_SIM_TEST_FUNC_SLAVE_SCRIPT, 0U, 2U,
+                                                                        holdingData, 0U, 1U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilSent();
+  eMB_SIM_TestFuncAnswer(readWritePdu, (uint16_t)sizeof(readWritePdu));
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncErrorNum == 5UL);
+}
+
+/* Blocks carry a CRC only in a store which is kept over a restart, and the
+ * restore keeps the blocks whose CRC matches. */
+static void eMB_SIM_TestFuncShadowCrc(void)
+{
+  eMB_ShadowBlockInfoStruct info;
+  uint16_t i;
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncSetup() == eMB_ENOERR);
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_MASTER_REG_HOLDING_NREGS; i++)
+  {
+    eMB_SIM_TestFuncHoldingBuf[i] = (uint16_t)(0x2200U + i);
+  }
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadHoldingRegister(eMB_SIM_TEST_FUNC_SLAVE, 0U, 4U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+  eMB_SIM_TEST_CHECK(eMB_Shadow_ReadBlockInfo(eMB_gShadowPtr, eMB_REG_HOLDING, eMB_SIM_TEST_FUNC_SLAVE, &info) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(info.status == (uint8_t)eMB_SHADOW_BLOCK_VALID);
+  eMB_SIM_TEST_CHECK(info.crc == (uint16_t)0U);
+
+  /* No previous image: initialized, then kept. */
+  memset(&eMB_SIM_TestFuncShadowMem, 0, sizeof(eMB_SIM_TestFuncShadowMem));
+  eMB_SIM_TEST_CHECK(eMB_Shadow_Restore(&eMB_SIM_TestFuncShadowMem, (uint32_t)sizeof(eMB_SIM_TestFuncShadowMem),
+                                        NULL) == eMB_EIO);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadHoldingRegister(eMB_SIM_TEST_FUNC_SLAVE, 0U, 4U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+  eMB_SIM_TEST_CHECK(eMB_Shadow_ReadBlockInfo(eMB_gShadowPtr, eMB_REG_HOLDING, eMB_SIM_TEST_FUNC_SLAVE, &info) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(info.crc == eMB_GetCRC((uint8_t *)eMB_SIM_TestFuncShadowMem.holdingBuf[eMB_SIM_TEST_FUNC_SLAVE - 1U],
+                                            (uint16_t)sizeof(eMB_SIM_TestFuncShadowMem.holdingBuf[0])));
+
+  eMB_SIM_TEST_CHECK(eMB_Shadow_Restore(&eMB_SIM_TestFuncShadowMem, (uint32_t)sizeof(eMB_SIM_TestFuncShadowMem),
+                                        NULL) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(eMB_Shadow_ReadBlockInfo(eMB_gShadowPtr, eMB_REG_HOLDING, eMB_SIM_TEST_FUNC_SLAVE, &info) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(info.status == (uint8_t)eMB_SHADOW_BLOCK_STALE);
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestFuncShadowMem.holdingBuf[eMB_SIM_TEST_FUNC_SLAVE - 1U][3] == (uint16_t)0x2203U);
+
+  (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+}
+
+
+
+
+
+/* Start the master with one slave on the line. */
+static eMB_ErrorCodeType eMB_SIM_TestFuncSetup(void)
+{
+  eMB_SIM_SlaveStruct slave;
+  eMB_ErrorCodeType errStatus;
+
+  eMB_SIM_TestFuncErrorNum = 0UL;
+
+  memset(eMB_SIM_TestFuncHoldingBuf, 0, sizeof(eMB_SIM_TestFuncHoldingBuf));
+  memset(eMB_SIM_TestFuncCoilBuf, 0, sizeof(eMB_SIM_TestFuncCoilBuf));
+
+  memset(&slave, 0, sizeof(slave));
+  slave.holdingBuf = eMB_SIM_TestFuncHoldingBuf;
+  slave.holdingNum = (uint16_t)(sizeof(eMB_SIM_TestFuncHoldingBuf) / sizeof(uint16_t));
+  slave.coilBuf    = eMB_SIM_TestFuncCoilBuf;
+  slave.coilNum    = (uint16_t)(sizeof(eMB_SIM_TestFuncCoilBuf) * 8U);
+
+  errStatus = eMB_SIM_PortSetup(115200UL, 11U, 1UL);
+
+  if (errStatus == eMB_ENOERR)
+  {
+    errStatus = eMB_SIM_PortSetSlave(eMB_SIM_TEST_FUNC_SLAVE, &slave);
+  }
+
+  if (errStatus == eMB_ENOERR)
+  {
+    errStatus = eMB_Init(&eMB_SIM_Config);
+  }
+
+  if (errStatus == eMB_ENOERR)
+  {
+    (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+    errStatus = eMB_Enable();
+  }
+
+  eMB_SIM_PortRunUntilIdle();
+  eMB_SIM_PortSetEventHook(eMB_SIM_TestFuncEventHook);
+
+  return errStatus;
+}
+
+/* Put the response of the scripted slave on the line, byte by byte, and let
+ * t3.5 end it. */
+static void eMB_SIM_TestFuncAnswer(const uint8_t *pdu, uint16_t pduLength)
+{
+  uint8_t  frame[eMB_SDU_SIZE_MAX];
+  uint16_t crc;
+  uint16_t i;
+
+  frame[0] = (uint8_t)eMB_SIM_TEST_FUNC_SLAVE_SCRIPT;
+  memcpy(&frame[1], pdu, pduLength);
+
+  crc = eMB_GetCRC(frame, (uint16_t)(pduLength + 1U));
+  frame[pduLength + 1U] = (uint8_t)(crc & 0xFFU);
+  frame[pduLength + 2U] = (uint8_t)(crc >> 8U);
+
+  for (i = (uint16_t)0U; i < (uint16_t)(pduLength + 3U); i++)
+  {
+    eMB_SIM_PortReceiveByte(frame[i]);
+  }
+
+  eMB_SIM_PortRunFor(eMB_SIM_TEST_FUNC_SILENCE_US);
+  eMB_SIM_PortRunUntilIdle();
+}
+
+/* Count the errors taken by the stack. */
+static void eMB_SIM_TestFuncEventHook(eMB_EventType eEvent)
+{
+  if (eEvent == eMB_EV_ERROR)
+  {
+    eMB_SIM_TestFuncErrorNum++;
+  }
+}
+
+
+
+/* Tests of the suite, run in this order by eMB_SimTest.c */
+const eMB_SIM_TestCaseStruct eMB_SIM_TestSuite[] =
+{
+  { "func: the largest write request fits the send buffer", eMB_SIM_TestFuncLargestWrite },
+  { "func: write requests beyond the register limit are refused", eMB_SIM_TestFuncWriteLimit },
+  { "func: the response of a write multiple coils request is accepted", eMB_SIM_TestFuncWriteCoils },
+  { "func: a restart forgets the broadcast of the previous start", eMB_SIM_TestFuncBroadcastRestart },
+  { "func: read responses shorter than their byte count are refused", eMB_SIM_TestFuncShortRead },
+  { "func: only a restored shadow store keeps the CRC of its blocks", eMB_SIM_TestFuncShadowCrc },
+};
+
+const uint16_t eMB_SIM_TestSuiteNum = (uint16_t)(sizeof(eMB_SIM_TestSuite) / sizeof(eMB_SIM_TestSuite[0]));
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,22 @@
+/*
+ * File:   eMB_Cfg.h
+ * Author: Long
+ *
+ * Configuration of the gateway test suite: the gateway with the queue sizes of
+ * port/eMB_Cfg.h and a few TCP connections.
+ *
+ * Created on October 20, 2026, 09:40 PM
+ */
+
+#ifndef EMB_SIMTEST_GATEWAY_CFG_H
+#define EMB_SIMTEST_GATEWAY_CFG_H
+
+#define eMB_SLAVE_TCP_ENABLED
+#define eMB_GATEWAY_ENABLED
+
+#include "../../../eMB_Cfg.h"
+
+#undef  eMB_SLAVE_TCP_CONN_MAX
+#define eMB_SLAVE_TCP_CONN_MAX                                        (  4 )
+
+#endif /* EMB_SIMTEST_GATEWAY_CFG_H */
@@ -0,0 +1,126 @@
+/*
+ * File:   eMB_SimTestGateway.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 09:40 PM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_SimTest.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static uint16_t eMB_SIM_TestGatewayHoldingBuf[8];
+
+/* Last response passed to the respond callback */
+static uint8_t  eMB_SIM_TestGatewayRspBuf[eMB_PDU_SIZE_MAX];
+static uint16_t eMB_SIM_TestGatewayRspLength;
+static uint32_t eMB_SIM_TestGatewayRspNum;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_TestGatewaySubmitFirst(void);
+
+static void eMB_SIM_TestGatewayRespond(void *ctx, uint32_t tag, const uint8_t *pduBuf, uint16_t pduLength);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+/* The request slots are free from eMB_Init() on, not only after the first
+ * eMB_Gateway_Dispatch() of the main function. */
+static void eMB_SIM_TestGatewaySubmitFirst(void)
+{
+  static const uint8_t reqPdu[] = { eMB_FUNC_READ_HOLDING_REGISTER, 0x00U, 0x02U, 0x00U, 0x03U };
+  eMB_SIM_SlaveStruct slave;
+  uint16_t i;
+
+  eMB_SIM_TestGatewayRspNum = 0UL;
+
+  for (i = (uint16_t)0U; i < (uint16_t)(sizeof(eMB_SIM_TestGatewayHoldingBuf) / sizeof(uint16_t)); i++)
+  {
+    eMB_SIM_TestGatewayHoldingBuf[i] = (uint16_t)(0x1100U + i);
+  }
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetup(115200UL, 11U, 1UL) == eMB_ENOERR);
+
+  memset(&slave, 0, sizeof(slave));
+  slave.holdingBuf = eMB_SIM_TestGatewayHoldingBuf;
+  slave.holdingNum = (uint16_t)(sizeof(eMB_SIM_TestGatewayHoldingBuf) / sizeof(uint16_t));
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetSlave(1U, &slave) == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Init(&eMB_SIM_Config) == eMB_ENOERR);
+
+  /* No main function has run yet. */
+  eMB_SIM_TEST_CHECK(eMB_Gateway_Submit((uint16_t)0U, NULL, 7UL, 1U, reqPdu, (uint16_t)sizeof(reqPdu),
+                                        eMB_SIM_TestGatewayRespond) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestGatewayRspNum == 0UL);
+
+  /* It waits for the end of the startup phase, then the next main function sends it. */
+  eMB_SIM_TEST_CHECK(eMB_Enable() == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestGatewayRspNum == 0UL);
+
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestGatewayRspNum == 1UL);
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestGatewayRspLength == (uint16_t)8U);
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestGatewayRspBuf[0] == eMB_FUNC_READ_HOLDING_REGISTER);
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestGatewayRspBuf[1] == 6U);
+  eMB_SIM_TEST_CHECK((eMB_SIM_TestGatewayRspBuf[2] == 0x11U) && (eMB_SIM_TestGatewayRspBuf[3] == 0x02U));
+  eMB_SIM_TEST_CHECK((eMB_SIM_TestGatewayRspBuf[6] == 0x11U) && (eMB_SIM_TestGatewayRspBuf[7] == 0x04U));
+}
+
+
+
+
+
+/* Keep the last response. */
+static void eMB_SIM_TestGatewayRespond(void *ctx, uint32_t tag, const uint8_t *pduBuf, uint16_t pduLength)
+{
+  (void)ctx;
+  (void)tag;
+
+  eMB_SIM_TestGatewayRspNum++;
+  eMB_SIM_TestGatewayRspLength = pduLength;
+  memcpy(eMB_SIM_TestGatewayRspBuf, pduBuf, pduLength);
+}
+
+
+
+/* Tests of the suite, run in this order by eMB_SimTest.c */
+const eMB_SIM_TestCaseStruct eMB_SIM_TestSuite[] =
+{
+  { "gateway: a request submitted before the first dispatch is queued", eMB_SIM_TestGatewaySubmitFirst },
+};
+
+const uint16_t eMB_SIM_TestSuiteNum = (uint16_t)(sizeof(eMB_SIM_TestSuite) / sizeof(eMB_SIM_TestSuite[0]));
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+/*
+ * File:   eMB_Cfg.h
+ * Author: Long
+ *
+ * Configuration of the master test suite: the master of port/eMB_Cfg.h with
+ * the response framed by its length.
+ *
+ * Created on October 20, 2026, 04:40 AM
+ */
+
+#ifndef EMB_SIMTEST_MASTER_CFG_H
+#define EMB_SIMTEST_MASTER_CFG_H
+
+#define eMB_MASTER_RTU_LENGTH_FRAMING_ENABLED
+
+#include "../../../eMB_Cfg.h"
+
+#endif /* EMB_SIMTEST_MASTER_CFG_H */
@@ -0,0 +1,202 @@
+/*
+ * File:   eMB_SimTestMaster.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 04:40 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_SimTest.h"
+#include "eMB_CRC.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Slave which is answered by the test instead of the simulator */
+#define eMB_SIM_TEST_MASTER_SLAVE                 ( 5U )
+
+/* Silence which lets t3.5 and the respond timeout expire */
+#define eMB_SIM_TEST_MASTER_SILENCE_US            ( 200000UL )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* Error events taken by the stack */
+static uint32_t eMB_SIM_TestMasterErrorNum;
+
+/* Frames sent by the master */
+static uint32_t eMB_SIM_TestMasterSentNum;
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_TestMasterLengthTrailingByte(void);
+static void eMB_SIM_TestMasterLengthNextRequest(void);
+
+static eMB_ErrorCodeType eMB_SIM_TestMasterSetup(void);
+static void eMB_SIM_TestMasterAnswer(uint16_t value0, uint16_t value1);
+static void eMB_SIM_TestMasterEventHook(eMB_EventType eEvent);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+/* A USB adapter may deliver a byte after the frame in the same burst. It must
+ * neither start a new frame nor end in a receive error. */
+static void eMB_SIM_TestMasterLengthTrailingByte(void)
+{
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestMasterSetup() == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadHoldingRegister(eMB_SIM_TEST_MASTER_SLAVE, 0U, 2U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilSent();
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestMasterSentNum == 1UL);
+
+  eMB_SIM_TestMasterAnswer(0x1234U, 0x5678U);
+  eMB_SIM_PortReceiveByte(0x00U);
+  eMB_SIM_PortRunFor(eMB_SIM_TEST_MASTER_SILENCE_US);
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_PortSetEventHook(NULL);
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestMasterErrorNum == 0UL);
+  eMB_SIM_TEST_CHECK(eMB_gShadowPtr->holdingBuf[eMB_SIM_TEST_MASTER_SLAVE - 1U][0] == 0x1234U);
+  eMB_SIM_TEST_CHECK(eMB_gShadowPtr->holdingBuf[eMB_SIM_TEST_MASTER_SLAVE - 1U][1] == 0x5678U);
+}
+
+/* The response is processed before t3.5 expires, the next request must not
+ * wait for it and must not be cut by it. */
+static void eMB_SIM_TestMasterLengthNextRequest(void)
+{
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestMasterSetup() == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadHoldingRegister(eMB_SIM_TEST_MASTER_SLAVE, 0U, 2U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilSent();
+  eMB_SIM_TestMasterAnswer(0x1111U, 0x2222U);
+
+  eMB_SIM_TEST_CHECK(eMB_Master_RequestReadHoldingRegister(eMB_SIM_TEST_MASTER_SLAVE, 0U, 2U) == eMB_ENOERR);
+  eMB_SIM_PortRunUntilSent();
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestMasterSentNum == 2UL);
+
+  eMB_SIM_TestMasterAnswer(0x3333U, 0x4444U);
+  eMB_SIM_PortRunFor(eMB_SIM_TEST_MASTER_SILENCE_US);
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_PortSetEventHook(NULL);
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestMasterErrorNum == 0UL);
+  eMB_SIM_TEST_CHECK(eMB_gShadowPtr->holdingBuf[eMB_SIM_TEST_MASTER_SLAVE - 1U][0] == 0x3333U);
+  eMB_SIM_TEST_CHECK(eMB_gShadowPtr->holdingBuf[eMB_SIM_TEST_MASTER_SLAVE - 1U][1] == 0x4444U);
+}
+
+
+
+
+
+/* Start the master on a line without simulated slaves. */
+static eMB_ErrorCodeType eMB_SIM_TestMasterSetup(void)
+{
+  eMB_ErrorCodeType errStatus;
+
+  eMB_SIM_TestMasterErrorNum = 0UL;
+  eMB_SIM_TestMasterSentNum  = 0UL;
+
+  errStatus = eMB_SIM_PortSetup(115200UL, 11U, 1UL);
+
+  if (errStatus == eMB_ENOERR)
+  {
+    errStatus = eMB_Init(&eMB_SIM_Config);
+  }
+
+  if (errStatus == eMB_ENOERR)
+  {
+    (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+    errStatus = eMB_Enable();
+  }
+
+  eMB_SIM_PortRunUntilIdle();
+  eMB_SIM_PortSetEventHook(eMB_SIM_TestMasterEventHook);
+
+  return errStatus;
+}
+
+/* Put the response to a read of two holding registers on the line, byte by byte. */
+static void eMB_SIM_TestMasterAnswer(uint16_t value0, uint16_t value1)
+{
+  uint8_t  frame[9];
+  uint16_t crc;
+  uint16_t i;
+
+  frame[0] = (uint8_t)eMB_SIM_TEST_MASTER_SLAVE;
+  frame[1] = (uint8_t)eMB_FUNC_READ_HOLDING_REGISTER;
+  frame[2] = 4U;
+  frame[3] = (uint8_t)(value0 >> 8U);
+  frame[4] = (uint8_t)(value0 & 0xFFU);
+  frame[5] = (uint8_t)(value1 >> 8U);
+  frame[6] = (uint8_t)(value1 & 0xFFU);
+
+  crc = eMB_GetCRC(frame, 7U);
+  frame[7] = (uint8_t)(crc & 0xFFU);
+  frame[8] = (uint8_t)(crc >> 8U);
+
+  for (i = (uint16_t)0U; i < (uint16_t)sizeof(frame); i++)
+  {
+    eMB_SIM_PortReceiveByte(frame[i]);
+  }
+}
+
+/* Count the frames sent and the errors taken by the stack. */
+static void eMB_SIM_TestMasterEventHook(eMB_EventType eEvent)
+{
+  if (eEvent == eMB_EV_FRAME_SENT)
+  {
+    eMB_SIM_TestMasterSentNum++;
+  }
+  else if (eEvent == eMB_EV_ERROR)
+  {
+    eMB_SIM_TestMasterErrorNum++;
+  }
+  else
+  {
+    /* Other events are not counted. */
+  }
+}
+
+
+
+/* Tests of the suite, run in this order by eMB_SimTest.c */
+const eMB_SIM_TestCaseStruct eMB_SIM_TestSuite[] =
+{
+  { "master: a byte after a length framed response is dropped", eMB_SIM_TestMasterLengthTrailingByte },
+  { "master: a request is sent before t3.5 of a length framed response", eMB_SIM_TestMasterLengthNextRequest },
+};
+
+const uint16_t eMB_SIM_TestSuiteNum = (uint16_t)(sizeof(eMB_SIM_TestSuite) / sizeof(eMB_SIM_TestSuite[0]));
+
+
+
+#ifdef __cplusplus
+}
+#endif
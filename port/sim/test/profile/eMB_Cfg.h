@@ -0,0 +1,20 @@
+/*
+ * File:   eMB_Cfg.h
+ * Author: Long
+ *
+ * Configuration of the profile test suite: the poll plan of port/eMB_ProfileCfg.h
+ * without discrete inputs, so the DRIVE_STATUS entry can never be requested.
+ *
+ * Created on October 20, 2026, 03:10 AM
+ */
+
+#ifndef EMB_SIMTEST_PROFILE_CFG_H
+#define EMB_SIMTEST_PROFILE_CFG_H
+
+#define eMB_MASTER_PROFILE_ENABLED
+
+#include "../../../eMB_Cfg.h"
+
+#undef eMB_FUNC_READ_DISCRETE_INPUTS_ENABLED
+
+#endif /* EMB_SIMTEST_PROFILE_CFG_H */
@@ -0,0 +1,181 @@
+/*
+ * File:   eMB_SimTestProfile.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 03:10 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_SimTest.h"
+#include "eMB_Utils.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Virtual time of the poll test and period of the calls of the application */
+#define eMB_SIM_TEST_PROFILE_RUN_MS               ( 3000UL )
+#define eMB_SIM_TEST_PROFILE_CALL_US              ( 1000UL )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+/* Requests sent per poll entry */
+static uint32_t eMB_SIM_TestProfileSentNum[eMB_PROFILE_POLL_NUM];
+
+static uint16_t eMB_SIM_TestProfileInputBuf[64];
+static uint16_t eMB_SIM_TestProfileHoldingBuf[16];
+static uint8_t  eMB_SIM_TestProfileCoilBuf[2];
+
+/* Read function code of every table, in the order of eMB_RegType */
+static const uint8_t eMB_SIM_TestProfileFuncCode[] =
+{
+  eMB_FUNC_READ_COILS, eMB_FUNC_READ_DISCRETE_INPUTS, eMB_FUNC_READ_INPUT_REGISTER, eMB_FUNC_READ_HOLDING_REGISTER
+};
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_TestProfileFailingEntry(void);
+
+static void eMB_SIM_TestProfileEventHook(eMB_EventType eEvent);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+/* DRIVE_STATUS reads discrete inputs, which this suite does not compile in. It
+ * fails on every poll and must not keep the other entries from their periods. */
+static void eMB_SIM_TestProfileFailingEntry(void)
+{
+  eMB_SIM_SlaveStruct slave;
+  uint32_t failedNum = 0UL;
+  uint32_t callNum;
+  uint32_t pollNum;
+  uint32_t i;
+
+  memset(eMB_SIM_TestProfileSentNum, 0, sizeof(eMB_SIM_TestProfileSentNum));
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetup(115200UL, 11U, 1UL) == eMB_ENOERR);
+
+  memset(&slave, 0, sizeof(slave));
+  slave.inputBuf   = eMB_SIM_TestProfileInputBuf;
+  slave.inputNum   = (uint16_t)(sizeof(eMB_SIM_TestProfileInputBuf) / sizeof(uint16_t));
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetSlave(1U, &slave) == eMB_ENOERR);
+
+  memset(&slave, 0, sizeof(slave));
+  slave.holdingBuf = eMB_SIM_TestProfileHoldingBuf;
+  slave.holdingNum = (uint16_t)(sizeof(eMB_SIM_TestProfileHoldingBuf) / sizeof(uint16_t));
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetSlave(2U, &slave) == eMB_ENOERR);
+
+  memset(&slave, 0, sizeof(slave));
+  slave.coilBuf    = eMB_SIM_TestProfileCoilBuf;
+  slave.coilNum    = (uint16_t)(sizeof(eMB_SIM_TestProfileCoilBuf) * 8U);
+  eMB_SIM_TEST_CHECK(eMB_SIM_PortSetSlave(3U, &slave) == eMB_ENOERR);
+
+  eMB_SIM_TEST_CHECK(eMB_Init(&eMB_SIM_Config) == eMB_ENOERR);
+  (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+  eMB_SIM_TEST_CHECK(eMB_Enable() == eMB_ENOERR);
+  eMB_SIM_PortRunUntilIdle();
+
+  eMB_SIM_PortSetEventHook(eMB_SIM_TestProfileEventHook);
+
+  callNum = (uint32_t)(eMB_SIM_TEST_PROFILE_RUN_MS * 1000UL / eMB_SIM_TEST_PROFILE_CALL_US);
+
+  for (i = 0UL; i < callNum; i++)
+  {
+    if (eMB_Profile_PollFunction() == eMB_EINVAL)
+    {
+      failedNum++;
+    }
+
+    eMB_SIM_PortRunUntilIdle();
+    eMB_SIM_PortRunFor(eMB_SIM_TEST_PROFILE_CALL_US);
+  }
+
+  eMB_SIM_PortSetEventHook(NULL);
+
+  /* The failing entry is tried once per period. */
+  pollNum = eMB_SIM_TEST_PROFILE_RUN_MS / eMB_Profile_GetPoll(eMB_PROFILE_POLL_DRIVE_STATUS)->periodMs;
+  eMB_SIM_TEST_CHECK((failedNum >= pollNum) && (failedNum <= (pollNum + 1UL)));
+  eMB_SIM_TEST_CHECK(eMB_SIM_TestProfileSentNum[eMB_PROFILE_POLL_DRIVE_STATUS] == 0UL);
+
+  /* The others keep their periods. */
+  for (i = 0UL; i < (uint32_t)eMB_PROFILE_POLL_NUM; i++)
+  {
+    if (i != (uint32_t)eMB_PROFILE_POLL_DRIVE_STATUS)
+    {
+      pollNum = eMB_SIM_TEST_PROFILE_RUN_MS / eMB_Profile_GetPoll((eMB_ProfilePollType)i)->periodMs;
+      eMB_SIM_TEST_CHECK(eMB_SIM_TestProfileSentNum[i] >= pollNum);
+    }
+  }
+}
+
+
+
+
+
+/* Count the requests of every poll entry. */
+static void eMB_SIM_TestProfileEventHook(eMB_EventType eEvent)
+{
+  const eMB_ProfileEntryStruct *pEntry;
+  uint8_t *pSendPdu;
+  uint16_t i;
+
+  if (eEvent != eMB_EV_FRAME_SENT)
+  {
+    return;
+  }
+
+  eMB_FrameGetSendPduBufferCalloutArr(&pSendPdu);
+
+  for (i = (uint16_t)0U; i < (uint16_t)eMB_PROFILE_POLL_NUM; i++)
+  {
+    pEntry = eMB_Profile_GetPoll((eMB_ProfilePollType)i);
+
+    if ((pEntry->slaveAddr == eMB_FrameGetSlaveAddressCalloutArr()) &&
+        (eMB_SIM_TestProfileFuncCode[pEntry->regType] == pSendPdu[eMB_PDU_FUNC_OFFSET]) &&
+        (pEntry->addr == (uint16_t)(((uint16_t)pSendPdu[1] << 8U) | pSendPdu[2])))
+    {
+      eMB_SIM_TestProfileSentNum[i]++;
+    }
+  }
+}
+
+
+
+/* Tests of the suite, run in this order by eMB_SimTest.c */
+const eMB_SIM_TestCaseStruct eMB_SIM_TestSuite[] =
+{
+  { "profile: a failing entry does not starve the others", eMB_SIM_TestProfileFailingEntry },
+};
+
+const uint16_t eMB_SIM_TestSuiteNum = (uint16_t)(sizeof(eMB_SIM_TestSuite) / sizeof(eMB_SIM_TestSuite[0]));
+
+
+
+#ifdef __cplusplus
+}
+#endif
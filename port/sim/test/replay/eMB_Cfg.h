@@ -0,0 +1,18 @@
+/*
+ * File:   eMB_Cfg.h
+ * Author: Long
+ *
+ * Configuration of the replay test suite: the master of port/eMB_Cfg.h with
+ * the capture of the frames, which the replay loads again.
+ *
+ * Created on October 20, 2026, 11:40 AM
+ */
+
+#ifndef EMB_SIMTEST_REPLAY_CFG_H
+#define EMB_SIMTEST_REPLAY_CFG_H
+
+#define eMB_MASTER_RTU_CAPTURE_ENABLED
+
+#include "../../../eMB_Cfg.h"
+
+#endif /* EMB_SIMTEST_REPLAY_CFG_H */
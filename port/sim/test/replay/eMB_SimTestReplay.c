@@ -0,0 +1,269 @@
+/*
+ * File:   eMB_SimTestReplay.c
+ * Author: Long
+ *
+ * Created on October 20, 2026, 11:40 AM
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/*===============================================================================================
+*                                         INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+===============================================================================================*/
+
+#include "eMB_SimTest.h"
+#include "eMB_PortSimReplay.h"
+
+
+
+/*===============================================================================================
+*                                       DEFINES AND MACROS
+===============================================================================================*/
+
+/* Requests of the capture, each with its answer */
+#define eMB_SIM_TEST_REPLAY_TRANS_NUM             ( 3U )
+#define eMB_SIM_TEST_REPLAY_RECORD_NUM            ( 2U * eMB_SIM_TEST_REPLAY_TRANS_NUM )
+
+#define eMB_SIM_TEST_REPLAY_FILE_SIZE             ( eMB_CAPTURE_PCAPNG_HEADER_SIZE + \
+                                                    (eMB_SIM_TEST_REPLAY_RECORD_NUM * eMB_CAPTURE_PCAPNG_BLOCK_SIZE_MAX) )
+
+#define eMB_SIM_TEST_REPLAY_REPORT_SIZE           ( 1024U )
+
+
+
+/*===============================================================================================
+*                                           VARIABLES
+===============================================================================================*/
+
+static uint16_t eMB_SIM_TestReplayHoldingBuf[8];
+static uint8_t  eMB_SIM_TestReplayCoilBuf[2];
+
+static uint8_t  eMB_SIM_TestReplayFile[eMB_SIM_TEST_REPLAY_FILE_SIZE];
+
+static eMB_CaptureRecordStruct eMB_SIM_TestReplayRecords[eMB_SIM_TEST_REPLAY_RECORD_NUM + 1U];
+
+
+
+/*===============================================================================================
+*                                       FUNCTION PROTOTYPES
+===============================================================================================*/
+
+static void eMB_SIM_TestReplayRoundTrip(void);
+static void eMB_SIM_TestReplayChangedEvents(void);
+
+static uint32_t eMB_SIM_TestReplayCapture(void);
+static bool eMB_SIM_TestReplayCompare(FILE *baseline, FILE *current, eMB_ErrorCodeType expected,
+                                      const char *text);
+
+
+
+/*===============================================================================================
+*                                   FUNCTIONS IMPLEMENTATIONS
+===============================================================================================*/
+
+/* Capture, pcapng, load and replay in both modes give the same events. */
+static void eMB_SIM_TestReplayRoundTrip(void)
+{
+  eMB_SIM_ReplayResultStruct result;
+  FILE    *baseline;
+  FILE    *current;
+  uint32_t size;
+  uint32_t recordNum = 0UL;
+  bool     isEqual;
+
+  size = eMB_SIM_TestReplayCapture();
+  eMB_SIM_TEST_CHECK(size != 0UL);
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_ReplayLoad(eMB_SIM_TestReplayFile, size, eMB_SIM_TestReplayRecords,
+                                        (uint32_t)(eMB_SIM_TEST_REPLAY_RECORD_NUM + 1U), &recordNum) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(recordNum == (uint32_t)eMB_SIM_TEST_REPLAY_RECORD_NUM);
+
+  baseline = tmpfile();
+  current  = tmpfile();
+  eMB_SIM_TEST_CHECK((baseline != NULL) && (current != NULL));
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_ReplayRun(eMB_SIM_TestReplayRecords, recordNum, 115200UL, eMB_SIM_REPLAY_ORIGINAL,
+                                       baseline, &result) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(result.transNum == (uint32_t)eMB_SIM_TEST_REPLAY_TRANS_NUM);
+  eMB_SIM_TEST_CHECK((result.refusedNum == 0UL) && (result.errorNum == 0UL) && (result.differNum == 0UL));
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_ReplayRun(eMB_SIM_TestReplayRecords, recordNum, 115200UL, eMB_SIM_REPLAY_FAST,
+                                       current, &result) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(result.transNum == (uint32_t)eMB_SIM_TEST_REPLAY_TRANS_NUM);
+  eMB_SIM_TEST_CHECK(result.errorNum == 0UL);
+
+  isEqual = eMB_SIM_TestReplayCompare(baseline, current, eMB_ENOERR, "\"diffNum\":0");
+
+  (void)fclose(baseline);
+  (void)fclose(current);
+
+  eMB_SIM_TEST_CHECK(isEqual == true);
+}
+
+/* A damaged answer changes the events of its request, the compare reports it. */
+static void eMB_SIM_TestReplayChangedEvents(void)
+{
+  eMB_SIM_ReplayResultStruct result;
+  FILE    *baseline;
+  FILE    *current;
+  uint32_t size;
+  uint32_t recordNum = 0UL;
+  bool     isEqual;
+
+  size = eMB_SIM_TestReplayCapture();
+  eMB_SIM_TEST_CHECK(size != 0UL);
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_ReplayLoad(eMB_SIM_TestReplayFile, size, eMB_SIM_TestReplayRecords,
+                                        (uint32_t)(eMB_SIM_TEST_REPLAY_RECORD_NUM + 1U), &recordNum) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(recordNum == (uint32_t)eMB_SIM_TEST_REPLAY_RECORD_NUM);
+
+  baseline = tmpfile();
+  current  = tmpfile();
+  eMB_SIM_TEST_CHECK((baseline != NULL) && (current != NULL));
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_ReplayRun(eMB_SIM_TestReplayRecords, recordNum, 115200UL, eMB_SIM_REPLAY_FAST,
+                                       baseline, NULL) == eMB_ENOERR);
+
+  /* The answer of the second request fails its CRC check. */
+  eMB_SIM_TEST_CHECK((eMB_SIM_TestReplayRecords[3].flags & (uint8_t)eMB_CAPTURE_FLAG_SENT) == 0U);
+  eMB_SIM_TestReplayRecords[3].data[eMB_SIM_TestReplayRecords[3].length - 1U] ^= 0x01U;
+
+  eMB_SIM_TEST_CHECK(eMB_SIM_ReplayRun(eMB_SIM_TestReplayRecords, recordNum, 115200UL, eMB_SIM_REPLAY_FAST,
+                                       current, &result) == eMB_ENOERR);
+  eMB_SIM_TEST_CHECK(result.errorNum == 1UL);
+
+  /* The write request got a receive data error instead of its execution. */
+  isEqual = eMB_SIM_TestReplayCompare(baseline, current, eMB_EIO, "\"current\":\"trans 1 1 6 SRD ");
+
+  (void)fclose(baseline);
+  (void)fclose(current);
+
+  eMB_SIM_TEST_CHECK(isEqual == true);
+}
+
+
+
+
+
+/* Run three transactions against a virtual slave and export them as a pcapng file. */
+static uint32_t eMB_SIM_TestReplayCapture(void)
+{
+  eMB_SIM_SlaveStruct slave;
+  uint16_t size;
+  uint32_t fileSize;
+
+  if (eMB_SIM_PortSetup(115200UL, 11U, 1UL) != eMB_ENOERR)
+  {
+    return 0UL;
+  }
+
+  memset(&slave, 0, sizeof(slave));
+  slave.holdingBuf = eMB_SIM_TestReplayHoldingBuf;
+  slave.holdingNum = (uint16_t)(sizeof(eMB_SIM_TestReplayHoldingBuf) / sizeof(uint16_t));
+  slave.coilBuf    = eMB_SIM_TestReplayCoilBuf;
+  slave.coilNum    = (uint16_t)(sizeof(eMB_SIM_TestReplayCoilBuf) * 8U);
+
+  if ((eMB_SIM_PortSetSlave(1U, &slave) != eMB_ENOERR) || (eMB_Init(&eMB_SIM_Config) != eMB_ENOERR))
+  {
+    return 0UL;
+  }
+
+  (void)eMB_Shadow_Attach(NULL, 0UL, NULL);
+
+  if (eMB_Enable() != eMB_ENOERR)
+  {
+    return 0UL;
+  }
+
+  eMB_SIM_PortRunUntilIdle();
+
+  /* Frames of a previous test. */
+  while (eMB_Capture_ExportRecords(eMB_SIM_TestReplayFile, (uint16_t)sizeof(eMB_SIM_TestReplayFile)) != 0U)
+  {
+  }
+
+  if (eMB_Master_RequestReadHoldingRegister(1U, 0U, 4U) != eMB_ENOERR)
+  {
+    return 0UL;
+  }
+
+  eMB_SIM_PortRunUntilIdle();
+
+  if (eMB_Master_RequestWriteHoldingRegister(1U, 2U, 0x1234U) != eMB_ENOERR)
+  {
+    return 0UL;
+  }
+
+  eMB_SIM_PortRunUntilIdle();
+
+  if (eMB_Master_RequestReadCoils(1U, 0U, 16U) != eMB_ENOERR)
+  {
+    return 0UL;
+  }
+
+  eMB_SIM_PortRunUntilIdle();
+
+  fileSize = eMB_Capture_ExportHeader(eMB_SIM_TestReplayFile, (uint16_t)sizeof(eMB_SIM_TestReplayFile));
+
+  do
+  {
+    size = eMB_Capture_ExportRecords(&eMB_SIM_TestReplayFile[fileSize],
+                                     (uint16_t)(sizeof(eMB_SIM_TestReplayFile) - fileSize));
+    fileSize += size;
+  } while (size != 0U);
+
+  return fileSize;
+}
+
+/* Compare the outputs, check the result and that the report contains text. */
+static bool eMB_SIM_TestReplayCompare(FILE *baseline, FILE *current, eMB_ErrorCodeType expected,
+                                      const char *text)
+{
+  char     report[eMB_SIM_TEST_REPLAY_REPORT_SIZE];
+  FILE    *reportFile;
+  size_t   length;
+  bool     isEqual;
+
+  reportFile = tmpfile();
+
+  if (reportFile == NULL)
+  {
+    return false;
+  }
+
+  rewind(baseline);
+  rewind(current);
+
+  isEqual = (eMB_SIM_ReplayCompare(baseline, current, reportFile) == expected) ? true : false;
+
+  rewind(reportFile);
+  length = fread(report, 1U, sizeof(report) - 1U, reportFile);
+  report[length] = '\0';
+  (void)fclose(reportFile);
+
+  return (isEqual == true) && (strstr(report, text) != NULL);
+}
+
+
+
+/* Tests of the suite, run in this order by eMB_SimTest.c */
+const eMB_SIM_TestCaseStruct eMB_SIM_TestSuite[] =
+{
+  { "replay: capture, pcapng, load, replay and compare", eMB_SIM_TestReplayRoundTrip },
+  { "replay: a changed event sequence is reported",      eMB_SIM_TestReplayChangedEvents },
+};
+
+const uint16_t eMB_SIM_TestSuiteNum = (uint16_t)(sizeof(eMB_SIM_TestSuite) / sizeof(eMB_SIM_TestSuite[0]));
+
+
+
+#ifdef __cplusplus
+}
+#endif